@@ -112,11 +112,13 @@ SOURCES += src/main.cpp \
     src/concerts/ConcertController.cpp \
     src/data/MediaInfoFile.cpp \
     src/data/MediaStatusColumn.cpp \
+    src/data/MovieListQuery.cpp \
     src/data/RatingModel.cpp \
     src/export/CsvExport.cpp \
     src/data/ActorModel.cpp \
     src/globals/Containers.cpp \
     src/globals/Random.cpp \
+    src/globals/SaveQueue.cpp \
     src/music/AllMusicId.cpp \
     src/music/MusicBrainzId.cpp \
     src/music/TheAudioDbId.cpp \
@@ -124,6 +126,7 @@ SOURCES += src/main.cpp \
     src/network/NetworkRequest.cpp \
     src/network/NetworkManager.cpp \
     src/scrapers/ScraperError.cpp \
+    src/scrapers/HtmlPattern.cpp \
     src/scrapers/music/AllMusic.cpp \
     src/scrapers/music/Discogs.cpp \
     src/scrapers/music/MusicBrainz.cpp \
@@ -140,6 +143,7 @@ SOURCES += src/main.cpp \
     src/concerts/ConcertModel.cpp \
     src/concerts/ConcertProxyModel.cpp \
     src/data/Database.cpp \
+    src/data/DatabaseService.cpp \
     src/data/ImageCache.cpp \
     src/data/ResumeTime.cpp \
     src/movies/Movie.cpp \
@@ -149,10 +153,13 @@ SOURCES += src/main.cpp \
     src/movies/MovieImages.cpp \
     src/movies/MovieModel.cpp \
     src/movies/MovieProxyModel.cpp \
+    src/movies/MovieScrapeScheduler.cpp \
+    src/movies/MovieSnapshot.cpp \
     src/data/Locale.cpp \
     src/data/Rating.cpp \
     src/data/Storage.cpp \
     src/data/StreamDetails.cpp \
+    src/data/StringPool.cpp \
     src/data/Subtitle.cpp \
     src/tv_shows/TvShow.cpp \
     src/tv_shows/TvShowEpisode.cpp \
@@ -165,16 +172,19 @@ SOURCES += src/main.cpp \
     src/ui/export/ExportDialog.cpp \
     src/ui/imports/UnpackButtons.cpp \
     src/imports/MakeMkvCon.cpp \
-    src/imports/MyFile.cpp \
     src/imports/Extractor.cpp \
-    src/imports/FileWorker.cpp \
+    src/imports/ImportPipeline.cpp \
     src/imports/DownloadFileSearcher.cpp \
     src/log/Log.cpp \
+    src/log/Perf.cpp \
     src/export/ExportTemplate.cpp \
     src/export/ExportTemplateLoader.cpp \
     src/export/MediaExport.cpp \
     src/export/SimpleEngine.cpp \
     src/file/FileFilter.cpp \
+    src/file/FileTransferQueue.cpp \
+    src/file/DirectoryScanner.cpp \
+    src/file/FileWriter.cpp \
     src/file/FilenameUtils.cpp \
     src/file/Path.cpp \
     src/data/Actor.cpp \
@@ -191,7 +201,10 @@ SOURCES += src/main.cpp \
     src/globals/Math.cpp \
     src/globals/Meta.cpp \
     src/file/NameFormatter.cpp \
+    src/file/NameMatcher.cpp \
     src/network/NetworkReplyWatcher.cpp \
+    src/network/RateLimiter.cpp \
+    src/network/ReplayTransport.cpp \
     src/network/WebsiteCache.cpp \
     src/globals/Poster.cpp \
     src/globals/ScraperInfos.cpp \
@@ -202,6 +215,7 @@ SOURCES += src/main.cpp \
     src/globals/VersionInfo.cpp \
     src/image/Image.cpp \
     src/image/ImageCapture.cpp \
+    src/image/ImageCaptureQueue.cpp \
     src/image/ImageModel.cpp \
     src/image/ImageProxyModel.cpp \
     src/image/ThumbnailDimensions.cpp \
@@ -249,6 +263,7 @@ SOURCES += src/main.cpp \
     src/music/MusicModelItem.cpp \
     src/ui/music/MusicMultiScrapeDialog.cpp \
     src/music/MusicProxyModel.cpp \
+    src/music/MusicScrapeScheduler.cpp \
     src/ui/music/MusicSearch.cpp \
     src/ui/music/MusicSearchWidget.cpp \
     src/ui/music/MusicWidget.cpp \
@@ -286,6 +301,7 @@ SOURCES += src/main.cpp \
     src/scrapers/movie/hotmovies/HotMoviesSearchJob.cpp \
     src/scrapers/movie/hotmovies/HotMoviesApi.cpp \
     src/scrapers/movie/imdb/ImdbMovie.cpp \
+    src/scrapers/movie/imdb/ImdbMovieParser.cpp \
     src/scrapers/movie/imdb/ImdbMovieSearchJob.cpp \
     src/scrapers/movie/imdb/ImdbMovieScraper.cpp \
     src/scrapers/movie/MovieScraper.cpp \
@@ -298,8 +314,10 @@ SOURCES += src/main.cpp \
     src/scrapers/movie/videobuster/VideoBuster.cpp \
     src/scrapers/movie/videobuster/VideoBusterSearchJob.cpp \
     src/scrapers/movie/videobuster/VideoBusterApi.cpp \
+    src/scrapers/movie/videobuster/VideoBusterParser.cpp \
     src/scrapers/music/TvTunes.cpp \
     src/scrapers/music/UniversalMusicScraper.cpp \
+    src/scrapers/music/MusicElementDownloads.cpp \
     src/scrapers/tv_show/ShowIdentifier.cpp \
     src/scrapers/tv_show/EpisodeIdentifier.cpp \
     src/scrapers/tv_show/TvScraper.cpp \
@@ -436,6 +454,7 @@ SOURCES += src/main.cpp \
     src/tv_shows/SeasonOrder.cpp \
     src/data/Certification.cpp \
     src/movies/MovieCrew.cpp \
+    src/movies/MovieFacetIndex.cpp \
     src/movies/MovieSet.cpp \
     src/scrapers/movie/MovieIdentifier.cpp
 
@@ -447,11 +466,13 @@ HEADERS  += Version.h \
     src/concerts/ConcertController.h \
     src/data/MediaInfoFile.h \
     src/data/MediaStatusColumn.h \
+    src/data/MovieListQuery.h \
     src/data/RatingModel.h \
     src/export/CsvExport.h \
     src/data/ActorModel.h \
     src/globals/Containers.h \
     src/globals/Random.h \
+    src/globals/SaveQueue.h \
     src/music/AllMusicId.h \
     src/music/MusicBrainzId.h \
     src/music/TheAudioDbId.h \
@@ -459,6 +480,7 @@ HEADERS  += Version.h \
     src/network/NetworkRequest.h \
     src/network/NetworkManager.h \
     src/scrapers/ScraperError.h \
+    src/scrapers/HtmlPattern.h \
     src/scrapers/music/AllMusic.h \
     src/scrapers/music/Discogs.h \
     src/scrapers/music/MusicBrainz.h \
@@ -475,6 +497,7 @@ HEADERS  += Version.h \
     src/concerts/ConcertProxyModel.h \
     src/ui/concerts/ConcertStreamDetailsWidget.h \
     src/data/Database.h \
+    src/data/DatabaseService.h \
     src/data/ImageCache.h \
     src/data/ResumeTime.h \
     src/media_centers/MediaCenterInterface.h \
@@ -485,6 +508,8 @@ HEADERS  += Version.h \
     src/movies/MovieImages.h \
     src/movies/MovieModel.h \
     src/movies/MovieProxyModel.h \
+    src/movies/MovieScrapeScheduler.h \
+    src/movies/MovieSnapshot.h \
     src/scrapers/image/ImageProvider.h \
     src/scrapers/concert/ConcertIdentifier.h \
     src/scrapers/concert/ConcertScraper.h \
@@ -496,16 +521,17 @@ HEADERS  += Version.h \
     src/data/Rating.h \
     src/data/Storage.h \
     src/data/StreamDetails.h \
+    src/data/StringPool.h \
     src/data/Subtitle.h \
     src/tv_shows/TvShow.h \
     src/tv_shows/TvShowEpisode.h \
     src/tv_shows/TvShowFileSearcher.h \
     src/imports/DownloadFileSearcher.h \
     src/imports/Extractor.h \
-    src/imports/FileWorker.h \
+    src/imports/ImportPipeline.h \
     src/imports/MakeMkvCon.h \
-    src/imports/MyFile.h \
     src/log/Log.h \
+    src/log/Perf.h \
     src/ui/export/CsvExportDialog.h \
     src/ui/export/ExportDialog.h \
     src/ui/imports/DownloadsWidget.h \
@@ -518,6 +544,9 @@ HEADERS  += Version.h \
     src/export/MediaExport.h \
     src/export/SimpleEngine.h \
     src/file/FileFilter.h \
+    src/file/FileTransferQueue.h \
+    src/file/DirectoryScanner.h \
+    src/file/FileWriter.h \
     src/file/FilenameUtils.h \
     src/file/Path.h \
     src/data/Actor.h \
@@ -535,7 +564,11 @@ HEADERS  += Version.h \
     src/globals/Math.h \
     src/globals/Meta.h \
     src/file/NameFormatter.h \
+    src/file/NameMatcher.h \
     src/network/NetworkReplyWatcher.h \
+    src/network/RateLimiter.h \
+    src/network/RequestCoalescer.h \
+    src/network/ReplayTransport.h \
     src/network/WebsiteCache.h \
     src/globals/Poster.h \
     src/globals/ScraperInfos.h \
@@ -546,6 +579,7 @@ HEADERS  += Version.h \
     src/globals/VersionInfo.h \
     src/image/Image.h \
     src/image/ImageCapture.h \
+    src/image/ImageCaptureQueue.h \
     src/image/ImageModel.h \
     src/image/ImageProxyModel.h \
     src/image/ThumbnailDimensions.h \
@@ -599,6 +633,7 @@ HEADERS  += Version.h \
     src/music/MusicModelItem.h \
     src/ui/music/MusicMultiScrapeDialog.h \
     src/music/MusicProxyModel.h \
+    src/music/MusicScrapeScheduler.h \
     src/ui/music/MusicSearch.h \
     src/ui/music/MusicSearchWidget.h \
     src/ui/music/MusicWidget.h \
@@ -628,6 +663,7 @@ HEADERS  += Version.h \
     src/scrapers/movie/hotmovies/HotMoviesSearchJob.h \
     src/scrapers/movie/hotmovies/HotMoviesApi.h \
     src/scrapers/movie/imdb/ImdbMovie.h \
+    src/scrapers/movie/imdb/ImdbMovieParser.h \
     src/scrapers/movie/imdb/ImdbMovieSearchJob.h \
     src/scrapers/movie/imdb/ImdbMovieScraper.h \
     src/scrapers/movie/ofdb/OFDb.h \
@@ -638,8 +674,10 @@ HEADERS  += Version.h \
     src/scrapers/movie/videobuster/VideoBuster.h \
     src/scrapers/movie/videobuster/VideoBusterSearchJob.h \
     src/scrapers/movie/videobuster/VideoBusterApi.h \
+    src/scrapers/movie/videobuster/VideoBusterParser.h \
     src/scrapers/music/TvTunes.h \
     src/scrapers/music/UniversalMusicScraper.h \
+    src/scrapers/music/MusicElementDownloads.h \
     src/scrapers/tv_show/ShowIdentifier.h \
     src/scrapers/tv_show/EpisodeIdentifier.h \
     src/scrapers/tv_show/TvScraper.h \
@@ -777,6 +815,7 @@ HEADERS  += Version.h \
     src/tv_shows/SeasonOrder.h \
     src/data/Certification.h \
     src/movies/MovieCrew.h \
+    src/movies/MovieFacetIndex.h \
     src/movies/MovieSet.h \
     src/scrapers/movie/MovieIdentifier.h
 
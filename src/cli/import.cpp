@@ -0,0 +1,95 @@
+#include "cli/import.h"
+
+#include "imports/DownloadFileSearcher.h"
+#include "imports/ImportPipeline.h"
+
+#include <QCommandLineOption>
+#include <QDir>
+#include <iostream>
+
+namespace mediaelch {
+namespace cli {
+
+int importDownloads(QApplication& app, QCommandLineParser& parser)
+{
+    parser.clearPositionalArguments();
+    // re-add this command so that it appears when help is printed
+    parser.addPositionalArgument("import",
+        "Extract all packages in the download directories and import the extracted files",
+        "import [import_options]");
+
+    QCommandLineOption targetOption("target",
+        "Directory that extracted media files are moved to. "
+        "If not set, they are left next to the archives.",
+        "directory");
+    QCommandLineOption passwordOption("password", "Password for encrypted archives.", "password");
+    QCommandLineOption jobsOption(
+        "jobs", "Maximum number of packages that are extracted at the same time.", "count", "0");
+    QCommandLineOption deleteArchivesOption("delete-archives", "Delete archives after they were extracted.");
+    QCommandLineOption verifyOption("verify", "Compare checksums of moved files that had to be copied.");
+
+    parser.addOption(targetOption);
+    parser.addOption(passwordOption);
+    parser.addOption(jobsOption);
+    parser.addOption(deleteArchivesOption);
+    parser.addOption(verifyOption);
+    parser.process(app);
+
+    ImportPipeline::Options options;
+    if (parser.isSet(targetOption)) {
+        options.targetDirectory = QDir(parser.value(targetOption)).absolutePath();
+    }
+    const int jobs = parser.value(jobsOption).toInt();
+    if (jobs > 0) {
+        options.maxExtractions = jobs;
+    }
+    options.deleteArchives = parser.isSet(deleteArchivesOption);
+    options.verifyChecksums = parser.isSet(verifyOption);
+
+    DownloadFileSearcher searcher(true, false);
+    searcher.scan();
+    const QMap<QString, DownloadFileSearcher::Package> packages = searcher.packages();
+    if (packages.isEmpty()) {
+        std::cout << "No packages found in the download directories." << std::endl;
+        return 0;
+    }
+
+    ImportPipeline pipeline(options);
+    for (const DownloadFileSearcher::Package& package : packages) {
+        pipeline.add(package, parser.value(passwordOption));
+    }
+
+    QObject::connect(&pipeline, &ImportPipeline::packageStarted, [](QString baseName) {
+        std::cout << "Extracting " << baseName.toStdString() << std::endl;
+    });
+    QObject::connect(&pipeline, &ImportPipeline::packageError, [](QString baseName, QString message) {
+        std::cerr << baseName.toStdString() << ": " << message.trimmed().toStdString() << std::endl;
+    });
+    QObject::connect(&pipeline, &ImportPipeline::packageFinished, [](QString baseName, bool success) {
+        std::cout << (success ? "Extracted " : "Failed to extract ") << baseName.toStdString() << std::endl;
+    });
+    QObject::connect(&pipeline, &ImportPipeline::fileImported, [](QString source, QString destination, bool success) {
+        if (success) {
+            std::cout << "Imported " << destination.toStdString() << std::endl;
+        } else {
+            std::cerr << "Failed to import " << source.toStdString() << std::endl;
+        }
+    });
+
+    int exitCode = 0;
+    QObject::connect(&pipeline, &ImportPipeline::finished, [&app, &exitCode](int failedPackages, int failedFiles) {
+        std::cout << "Done. " << failedPackages << " package(s) and " << failedFiles << " file(s) failed."
+                  << std::endl;
+        exitCode = (failedPackages > 0 || failedFiles > 0) ? 1 : 0;
+        app.quit();
+    });
+
+    pipeline.start();
+    if (pipeline.isRunning()) {
+        app.exec();
+    }
+    return exitCode;
+}
+
+} // namespace cli
+} // namespace mediaelch
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "cli/common.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Extracts all packages in the download directories and moves the
+///        extracted media files to a target directory, without any GUI.
+int importDownloads(QApplication& app, QCommandLineParser& parser);
+
+} // namespace cli
+} // namespace mediaelch
@@ -2,10 +2,16 @@
 
 #include "Version.h"
 #include "cli/common.h"
+#include "cli/info/MemoryReport.h"
+#include "cli/info/PerfReport.h"
 #include "cli/info/ScraperFeatureTable.h"
 #include "export/TableWriter.h"
 #include "globals/Manager.h"
+#include "log/Perf.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "settings/Settings.h"
 
+#include <QEventLoop>
 #include <iomanip>
 #include <iostream>
 
@@ -15,14 +21,64 @@ namespace cli {
 enum class InfoObjectType
 {
     MovieScrapers,
+    Memory,
     Unknown
 };
 
+/// \brief Reloads all movies and returns once they are in the movie model.
+///        Directories are loaded asynchronously, so we have to wait for the searcher.
+static void reloadMoviesAndWait()
+{
+    MovieFileSearcher* searcher = Manager::instance()->movieFileSearcher();
+    searcher->setMovieDirectories(Settings::instance()->directorySettings().movieDirectories());
+
+    bool loaded = false;
+    QEventLoop loop;
+    QObject::connect(searcher, &MovieFileSearcher::moviesLoaded, &loop, [&loop, &loaded]() {
+        loaded = true;
+        loop.quit();
+    });
+    searcher->reload(false);
+    // moviesLoaded() is emitted synchronously if everything was loaded from the cache.
+    if (!loaded) {
+        loop.exec();
+    }
+}
+
+static void printMemoryReport()
+{
+    reloadMoviesAndWait();
+
+    MovieMemoryReport report(std::cout);
+    report.print(Manager::instance()->movieModel()->movies());
+}
+
+static int printPerfReport(const QString& traceFile)
+{
+    perf::setEnabled(true, !traceFile.isEmpty());
+    reloadMoviesAndWait();
+
+    PerfReport report(std::cout);
+    report.print(perf::entries());
+
+    if (!traceFile.isEmpty()) {
+        if (!perf::writeChromeTrace(traceFile)) {
+            std::cerr << "Could not write trace file: " << traceFile.toStdString() << std::endl;
+            return 1;
+        }
+        std::cout << "\nTrace written to: " << traceFile.toStdString() << std::endl;
+    }
+    return 0;
+}
+
 static InfoObjectType infoTypeFromString(QString str)
 {
     if ("movie_scrapers" == str) {
         return InfoObjectType::MovieScrapers;
     }
+    if ("memory" == str) {
+        return InfoObjectType::Memory;
+    }
     return InfoObjectType::Unknown;
 }
 
@@ -31,10 +87,19 @@ int info(QApplication& app, QCommandLineParser& parser)
     parser.clearPositionalArguments();
     // re-add this command so that it appears when help is printed
     parser.addPositionalArgument("info", "Query information about MediaElch.", "info [list_options]");
-    parser.addPositionalArgument("details", "What details to show. Can be:\n - movie_scrapers", "<details>");
+    parser.addPositionalArgument("details", "What details to show. Can be:\n - movie_scrapers\n - memory", "<details>");
+
+    QCommandLineOption perfOption("perf", "Reload all movies and print timers and counters of the reload.");
+    QCommandLineOption traceOption("trace", "Used with --perf: Write a Chrome trace (JSON) to <file>.", "file");
+    parser.addOption(perfOption);
+    parser.addOption(traceOption);
 
     parser.process(app);
 
+    if (parser.isSet(perfOption)) {
+        return printPerfReport(parser.value(traceOption));
+    }
+
     const QStringList args = parser.positionalArguments();
     const QString command = args.size() < 2 ? QString() : args.at(1);
 
@@ -44,6 +109,10 @@ int info(QApplication& app, QCommandLineParser& parser)
         printer.print();
         return 0;
     }
+    case InfoObjectType::Memory: {
+        printMemoryReport();
+        return 0;
+    }
     case InfoObjectType::Unknown:
         if (command.isEmpty()) {
             std::cout << "Missing info <details>" << std::endl;
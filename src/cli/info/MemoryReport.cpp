@@ -0,0 +1,84 @@
+#include "cli/info/MemoryReport.h"
+
+#include "data/StringPool.h"
+#include "movies/Movie.h"
+#include "movies/MovieController.h"
+
+namespace mediaelch {
+namespace cli {
+
+void MovieMemoryReport::print(const QVector<Movie*>& movies)
+{
+    qint64 nfoBytes = 0;
+    int actorCount = 0;
+    int hydratedCount = 0;
+
+    for (Movie* movie : movies) {
+        addStrings(movie->genres());
+        addStrings(movie->studios());
+        addStrings(movie->countries());
+        addStrings(movie->tags());
+        for (const Actor* actor : movie->actors().actors()) {
+            addString(actor->name);
+            addString(actor->role);
+            ++actorCount;
+        }
+        nfoBytes += movie->storedNfoContentSize();
+        if (movie->controller()->isHydrated()) {
+            ++hydratedCount;
+        }
+    }
+
+    const StringPool::Statistics pool = StringPool::global().statistics();
+
+    m_out << "Memory usage of loaded movies:" << std::endl;
+
+    TableLayout layout;
+    layout.addColumn(TableColumn("Item", 34));
+    layout.addColumn(TableColumn("Value", 14, ColumnAlignment::Right));
+
+    TableWriter table(m_out, layout);
+    table.writeHeading();
+
+    const auto writeRow = [&table](const QString& item, qint64 value) {
+        table.writeCell(item);
+        table.writeCell(QString::number(value));
+    };
+
+    writeRow("Movies", movies.size());
+    writeRow("Movies with loaded details", hydratedCount);
+    writeRow("Actors", actorCount);
+    writeRow("Vocabulary strings", m_stringCount);
+    writeRow("Vocabulary bytes (unshared)", m_referencedStringBytes);
+    writeRow("Vocabulary bytes (shared)", m_sharedStringBytes);
+    writeRow("Compressed NFO bytes", nfoBytes);
+    writeRow("String pool: strings", pool.strings);
+    writeRow("String pool: bytes", pool.bytes);
+    writeRow("String pool: lookups", pool.lookups);
+    writeRow("String pool: hits", pool.hits);
+    writeRow("String pool: evicted", pool.evicted);
+}
+
+void MovieMemoryReport::addString(const QString& str)
+{
+    if (str.isEmpty()) {
+        return;
+    }
+    const qint64 bytes = str.size() * static_cast<qint64>(sizeof(QChar));
+    ++m_stringCount;
+    m_referencedStringBytes += bytes;
+    if (!m_seenStrings.contains(str.constData())) {
+        m_seenStrings.insert(str.constData());
+        m_sharedStringBytes += bytes;
+    }
+}
+
+void MovieMemoryReport::addStrings(const QStringList& strings)
+{
+    for (const QString& str : strings) {
+        addString(str);
+    }
+}
+
+} // namespace cli
+} // namespace mediaelch
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "export/TableWriter.h"
+
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <ostream>
+
+class Movie;
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Prints how much memory the loaded movies use for their strings and NFO content.
+///
+/// Strings are counted twice: once per reference, which is what they would use without
+/// sharing, and once per distinct string data, which is what they actually use.
+class MovieMemoryReport
+{
+public:
+    explicit MovieMemoryReport(std::ostream& out) : m_out{out} {}
+
+    void print(const QVector<Movie*>& movies);
+
+private:
+    void addString(const QString& str);
+    void addStrings(const QStringList& strings);
+
+    std::ostream& m_out;
+    QSet<const QChar*> m_seenStrings;
+    qint64 m_referencedStringBytes = 0;
+    qint64 m_sharedStringBytes = 0;
+    int m_stringCount = 0;
+};
+
+} // namespace cli
+} // namespace mediaelch
@@ -0,0 +1,39 @@
+#include "cli/info/PerfReport.h"
+
+namespace mediaelch {
+namespace cli {
+
+void PerfReport::print(const QVector<perf::Entry>& entries)
+{
+    m_out << "Timers and counters of the last reload:" << std::endl;
+
+    TableLayout layout;
+    layout.addColumn(TableColumn("Name", 40));
+    layout.addColumn(TableColumn("Count", 10, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Total [ms]", 12, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Avg [ms]", 10, ColumnAlignment::Right));
+    layout.addColumn(TableColumn("Max [ms]", 10, ColumnAlignment::Right));
+
+    TableWriter table(m_out, layout);
+    table.writeHeading();
+
+    const auto ms = [](double us) { return QString::number(us / 1000., 'f', 2); };
+
+    for (const perf::Entry& entry : entries) {
+        table.writeCell(entry.name);
+        table.writeCell(QString::number(entry.count));
+        if (entry.totalUs > 0) {
+            table.writeCell(ms(entry.totalUs));
+            table.writeCell(ms(static_cast<double>(entry.totalUs) / entry.count));
+            table.writeCell(ms(entry.maxUs));
+        } else {
+            // counter
+            table.writeCell(QString());
+            table.writeCell(QString());
+            table.writeCell(QString());
+        }
+    }
+}
+
+} // namespace cli
+} // namespace mediaelch
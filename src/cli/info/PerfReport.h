@@ -0,0 +1,25 @@
+#pragma once
+
+#include "export/TableWriter.h"
+#include "log/Perf.h"
+
+#include <QVector>
+#include <ostream>
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Prints timers and counters that were recorded by perf::ScopedTimer and perf::count().
+class PerfReport
+{
+public:
+    explicit PerfReport(std::ostream& out) : m_out{out} {}
+
+    void print(const QVector<perf::Entry>& entries);
+
+private:
+    std::ostream& m_out;
+};
+
+} // namespace cli
+} // namespace mediaelch
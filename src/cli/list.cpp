@@ -4,6 +4,8 @@
 #include "cli/common.h"
 #include "cli/reload.h"
 #include "concerts/Concert.h"
+#include "data/Database.h"
+#include "data/MovieListQuery.h"
 #include "export/TableWriter.h"
 #include "globals/Manager.h"
 #include "movies/Movie.h"
@@ -11,6 +13,11 @@
 #include "music/Album.h"
 #include "settings/Settings.h"
 
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
 #include <iomanip>
 #include <iostream>
 
@@ -150,6 +157,85 @@ void listTvShows()
     }
 }
 
+namespace {
+
+QJsonValue toJson(const QVariant& value)
+{
+    switch (value.userType()) {
+    case QMetaType::QStringList: return QJsonArray::fromStringList(value.toStringList());
+    case QMetaType::Bool: return value.toBool();
+    case QMetaType::LongLong: return value.toLongLong();
+    case QMetaType::Double: return value.toDouble();
+    default: return value.toString();
+    }
+}
+
+QString toTsvCell(const QVariant& value)
+{
+    static const QRegularExpression specialChars("[\\t\\r\\n]");
+    QString text = value.userType() == QMetaType::QStringList ? value.toStringList().join(", ") : value.toString();
+    return text.replace(specialChars, " ");
+}
+
+} // namespace
+
+bool streamMovies(const ListConfig& config)
+{
+    MovieListQuery query;
+    if (!config.fields.isEmpty() && !query.setFields(config.fields)) {
+        std::cerr << query.errorString().toStdString() << std::endl;
+        std::cerr << "Available fields: " << MovieListQuery::availableFieldNames().join(", ").toStdString()
+                  << std::endl;
+        return false;
+    }
+    for (const QString& filter : config.filters) {
+        if (!query.addFilter(filter)) {
+            std::cerr << query.errorString().toStdString() << std::endl;
+            return false;
+        }
+    }
+    query.setDirectory(config.directory);
+    query.setLimit(config.limit);
+
+    // Movies cached by old versions don't have list details, yet.
+    Database* database = Manager::instance()->database();
+    database->updateMissingMovieListColumns();
+
+    const QStringList fields = query.fieldNames();
+    if (config.format == ListFormat::Tsv) {
+        std::cout << fields.join("\t").toStdString() << '\n';
+    }
+
+    // Rows are written as soon as they are read. Flush regularly, so that consumers
+    // can start processing while the rest of the library is read.
+    int rows = 0;
+    const bool ok = query.exec(database->db(), [&](const QVector<QVariant>& values) {
+        if (config.format == ListFormat::JsonLines) {
+            QJsonObject json;
+            for (int i = 0; i < values.size(); ++i) {
+                json.insert(fields[i], toJson(values[i]));
+            }
+            std::cout << QJsonDocument(json).toJson(QJsonDocument::Compact).toStdString() << '\n';
+        } else {
+            QStringList cells;
+            for (const QVariant& value : values) {
+                cells << toTsvCell(value);
+            }
+            std::cout << cells.join("\t").toStdString() << '\n';
+        }
+        if (++rows % 100 == 0) {
+            std::cout.flush();
+        }
+        return true;
+    });
+    std::cout.flush();
+
+    if (!ok) {
+        std::cerr << "Could not read movies: " << query.errorString().toStdString() << std::endl;
+    }
+    return ok;
+}
+
 void listEntries(ListConfig config)
 {
     switch (config.mediaType) {
@@ -181,7 +267,28 @@ int list(QApplication& app, QCommandLineParser& parser)
     QCommandLineOption typeOption(
         "type", R"(Media type. Either "all", "movie", "concert", "music" or "tvshow")", "mediatype", "all");
 
+    QCommandLineOption formatOption("format",
+        R"(Output format. Either "table", "jsonl" or "tsv". JSON Lines and TSV are streamed )"
+        R"(from MediaElch's database and only supported for movies.)",
+        "format",
+        "table");
+    QCommandLineOption fieldsOption("fields",
+        QStringLiteral("Comma separated fields of streamed lists. Available: %1")
+            .arg(MovieListQuery::availableFieldNames().join(", ")),
+        "fields");
+    QCommandLineOption filterOption("filter",
+        R"(Filter of streamed lists, e.g. "year>=2000", "genres=Drama" or "title~star". )"
+        R"(May be given more than once.)",
+        "filter");
+    QCommandLineOption dirOption("dir", "Only list movies of this movie directory.", "directory");
+    QCommandLineOption limitOption("limit", "Maximum number of streamed entries.", "count", "0");
+
     parser.addOption(typeOption);
+    parser.addOption(formatOption);
+    parser.addOption(fieldsOption);
+    parser.addOption(filterOption);
+    parser.addOption(dirOption);
+    parser.addOption(limitOption);
     parser.process(app);
 
     ListConfig config;
@@ -192,6 +299,35 @@ int list(QApplication& app, QCommandLineParser& parser)
         return 1;
     }
 
+    const QString format = parser.value(formatOption);
+    if (format == "jsonl") {
+        config.format = ListFormat::JsonLines;
+    } else if (format == "tsv") {
+        config.format = ListFormat::Tsv;
+    } else if (format != "table") {
+        std::cerr << "Unknown format: " << format.toStdString() << std::endl;
+        return 1;
+    }
+
+    if (config.format != ListFormat::Table) {
+        if (!parser.isSet(typeOption)) {
+            config.mediaType = MediaType::Movie;
+        }
+        if (config.mediaType != MediaType::Movie) {
+            std::cerr << "Streamed lists are only supported for movies, use --type movie" << std::endl;
+            return 1;
+        }
+        if (parser.isSet(fieldsOption)) {
+            config.fields = parser.value(fieldsOption).split(",", ElchSplitBehavior::SkipEmptyParts);
+        }
+        config.filters = parser.values(filterOption);
+        if (parser.isSet(dirOption)) {
+            config.directory = QDir(parser.value(dirOption)).absolutePath();
+        }
+        config.limit = parser.value(limitOption).toInt();
+        return streamMovies(config) ? 0 : 1;
+    }
+
     listEntries(config);
 
     return 1;
@@ -4,6 +4,7 @@
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QStringList>
 
 class Album;
 class Artist;
@@ -15,10 +16,26 @@ class TvShow;
 namespace mediaelch {
 namespace cli {
 
+enum class ListFormat
+{
+    /// Human readable table, printed once all items are loaded.
+    Table,
+    /// One JSON object per line, streamed from the database.
+    JsonLines,
+    /// Tab separated values with a header line, streamed from the database.
+    Tsv
+};
+
 struct ListConfig
 {
     MediaType mediaType = MediaType::All;
     bool reload = false;
+    ListFormat format = ListFormat::Table;
+    /// Fields and filters of streamed lists, see MovieListQuery.
+    QStringList fields;
+    QStringList filters;
+    QString directory;
+    int limit = 0;
 };
 
 void printMovie(TableWriter& table, Movie& movie);
@@ -32,6 +49,9 @@ void listMusic();
 void listTvShows();
 
 void listEntries(ListConfig config);
+/// \brief Streams movies from the database as JSON Lines or TSV.
+///        Returns false if the fields or filters are invalid.
+bool streamMovies(const ListConfig& config);
 
 int list(QApplication& app, QCommandLineParser& parser);
 
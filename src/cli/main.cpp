@@ -1,8 +1,10 @@
 #include "Version.h"
 #include "cli/common.h"
+#include "cli/import.h"
 #include "cli/info.h"
 #include "cli/list.h"
 #include "cli/reload.h"
+#include "cli/scrape.h"
 #include "cli/show.h"
 #include "globals/Meta.h"
 #include "settings/Settings.h"
@@ -24,9 +26,11 @@ enum class Command
     Unknown,
     List,
     Reload,
+    Scrape,
     Add,
     Show,
     Sync,
+    Import,
     Settings,
     Info,
     Help,
@@ -41,6 +45,9 @@ static Command commandFromString(const QString& command)
     if ("reload" == command) {
         return Command::Reload;
     }
+    if ("scrape" == command) {
+        return Command::Scrape;
+    }
     if ("add" == command) {
         return Command::Add;
     }
@@ -50,6 +57,9 @@ static Command commandFromString(const QString& command)
     if ("sync" == command) {
         return Command::Sync;
     }
+    if ("import" == command) {
+        return Command::Import;
+    }
     if ("info" == command) {
         return Command::Info;
     }
@@ -76,10 +86,14 @@ Options:
 commands:
    list        List all media entries.
    reload      Reload all media files.
+   scrape      Scrape new or changed movies or music and save their NFO
+               files and artwork. Prints progress as JSON lines.
    add <path>  Add given path to MediaElch's directory settings.
    show <id>   Show an entry with the identifier <id>. <id> can be either
                MediaElch's media id, IMDb id or TheTvDb id for TV shows.
    sync        Sync MediaElch with Kodi. Uses parameters set in settings.
+   import      Extract all packages in the download directories and import
+               the extracted files.
    settings    Get or set MediaElch's settings.
    info        Get various details about MediaElch.
    help        Same as `--help`.
@@ -123,11 +137,13 @@ static int parseArguments(QApplication& app)
     case Command::Version: parser.showVersion();
     case Command::List: return mediaelch::cli::list(app, parser);
     case Command::Reload: return mediaelch::cli::reload(app, parser);
+    case Command::Scrape: return mediaelch::cli::scrape(app, parser);
     case Command::Settings:
     case Command::Sync:
     case Command::Add: printUnsupported(command); return 1;
     case Command::Show: return mediaelch::cli::show(app, parser);
     case Command::Info: return mediaelch::cli::info(app, parser);
+    case Command::Import: return mediaelch::cli::importDownloads(app, parser);
     case Command::Unknown:
         // do not process arguments so that we can show our custom help command
         if (command.isEmpty() && parser.isSet("help")) {
@@ -150,6 +166,11 @@ static int parseArguments(QApplication& app)
 
 int main(int argc, char** argv)
 {
+    // Scrapers create settings widgets, so this is a QApplication. It never shows a window,
+    // but without a display the default platform plugin would abort, e.g. in cron jobs.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
     QApplication app(argc, argv);
     registerAllMetaTypes();
 
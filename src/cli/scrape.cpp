@@ -0,0 +1,396 @@
+#include "cli/scrape.h"
+
+#include "globals/Manager.h"
+#include "globals/Meta.h"
+#include "media_centers/MediaCenterInterface.h"
+#include "movies/Movie.h"
+#include "movies/MovieController.h"
+#include "movies/MovieScrapeScheduler.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
+#include "music/Album.h"
+#include "music/AlbumController.h"
+#include "music/Artist.h"
+#include "music/ArtistController.h"
+#include "music/MusicScrapeScheduler.h"
+#include "scrapers/movie/MovieScraper.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "scrapers/music/MusicScraper.h"
+#include "scrapers/music/UniversalMusicScraper.h"
+#include "settings/Settings.h"
+
+#include <QCommandLineOption>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <iostream>
+
+namespace mediaelch {
+namespace cli {
+
+namespace {
+
+struct ScrapeConfig
+{
+    MediaType mediaType = MediaType::Movie;
+    QStringList directories;
+    QString scraperId;
+    int jobs = 0;
+    bool all = false;
+    bool onlyWithId = false;
+    bool save = true;
+};
+
+/// \brief Prints one JSON object per line, so that scripts can follow the progress.
+void printEvent(const QString& event, QJsonObject data)
+{
+    data.insert("event", event);
+    std::cout << QJsonDocument(data).toJson(QJsonDocument::Compact).toStdString() << std::endl;
+}
+
+/// \brief Counts scraped items and reports the throughput since the scrape started.
+class ScrapeStats
+{
+public:
+    explicit ScrapeStats(int total) : m_total{total} { m_timer.start(); }
+
+    void scraped(bool saved)
+    {
+        ++m_scraped;
+        if (!saved) {
+            ++m_saveFailed;
+        }
+    }
+    void skipped() { ++m_skipped; }
+    void failed() { ++m_failed; }
+
+    QJsonObject toJson(int done) const
+    {
+        const double seconds = static_cast<double>(m_timer.elapsed()) / 1000.0;
+        QJsonObject json;
+        json.insert("done", done);
+        json.insert("total", m_total);
+        json.insert("scraped", m_scraped);
+        json.insert("skipped", m_skipped);
+        json.insert("failed", m_failed);
+        json.insert("saveFailed", m_saveFailed);
+        json.insert("elapsedSeconds", seconds);
+        json.insert("itemsPerMinute", seconds > 0.0 ? done * 60.0 / seconds : 0.0);
+        return json;
+    }
+
+    bool hasFailures() const { return m_failed > 0 || m_saveFailed > 0; }
+
+private:
+    QElapsedTimer m_timer;
+    int m_total = 0;
+    int m_scraped = 0;
+    int m_skipped = 0;
+    int m_failed = 0;
+    int m_saveFailed = 0;
+};
+
+/// \brief Whether the item has no NFO file yet or its files were modified after the NFO was written.
+bool isNewOrChanged(const QString& nfoFile, const QDateTime& lastModified)
+{
+    if (nfoFile.isEmpty()) {
+        return true;
+    }
+    const QFileInfo nfo(nfoFile);
+    return !nfo.exists() || (lastModified.isValid() && lastModified > nfo.lastModified());
+}
+
+/// \brief Returns the configured directories that are selected, all if none are, or an
+///        empty list if a selected directory is not configured. All of them are reloaded
+///        from disk.
+QVector<SettingsDir> selectDirectories(const QVector<SettingsDir>& configured, const QStringList& selected)
+{
+    QVector<SettingsDir> directories;
+    for (SettingsDir dir : configured) {
+        const QString path = QDir::cleanPath(dir.path.absolutePath());
+        if (dir.disabled || (!selected.isEmpty() && !selected.contains(path))) {
+            continue;
+        }
+        dir.autoReload = true;
+        directories << dir;
+    }
+    if (directories.size() < selected.size()) {
+        std::cerr << "Only configured and enabled directories can be scraped." << std::endl;
+        return {};
+    }
+    return directories;
+}
+
+QJsonObject itemJson(const QString& title, const QString& path)
+{
+    QJsonObject json;
+    json.insert("title", title);
+    json.insert("path", path);
+    return json;
+}
+
+QJsonObject itemJson(Movie* movie)
+{
+    return itemJson(movie->name(), movie->files().isEmpty() ? QString() : movie->files().first().toString());
+}
+
+int scrapeMovies(QApplication& app, const ScrapeConfig& config)
+{
+    const QString scraperId = config.scraperId.isEmpty() ? QString(scraper::TmdbMovie::ID) : config.scraperId;
+    scraper::MovieScraper* scraper = Manager::instance()->scrapers().movieScraper(scraperId);
+    if (scraper == nullptr) {
+        std::cerr << "Unknown movie scraper: " << scraperId.toStdString() << std::endl;
+        return 1;
+    }
+
+    const QVector<SettingsDir> directories =
+        selectDirectories(Settings::instance()->directorySettings().movieDirectories(), config.directories);
+    if (directories.isEmpty()) {
+        std::cerr << "No movie directories to scrape." << std::endl;
+        return 1;
+    }
+
+    QElapsedTimer reloadTimer;
+    reloadTimer.start();
+    MovieFileSearcher* searcher = Manager::instance()->movieFileSearcher();
+    QEventLoop reloadLoop;
+    bool reloaded = false;
+    QObject::connect(searcher, &MovieFileSearcher::moviesLoaded, &reloadLoop, [&reloaded, &reloadLoop]() {
+        reloaded = true;
+        reloadLoop.quit();
+    });
+    searcher->setMovieDirectories(directories);
+    searcher->reload(false);
+    if (!reloaded) {
+        reloadLoop.exec();
+    }
+
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
+    QVector<Movie*> movies;
+    const QVector<Movie*> allMovies = Manager::instance()->movieModel()->movies();
+    for (Movie* movie : allMovies) {
+        if (config.all || isNewOrChanged(mediaCenter->nfoFilePath(movie), movie->fileLastModified())) {
+            movies << movie;
+        }
+    }
+    QJsonObject reloadStats;
+    reloadStats.insert("items", allMovies.size());
+    reloadStats.insert("selected", movies.size());
+    reloadStats.insert("elapsedSeconds", static_cast<double>(reloadTimer.elapsed()) / 1000.0);
+    printEvent("reloaded", reloadStats);
+
+    QSet<MovieScraperInfo> infos = Settings::instance()->scraperInfos<MovieScraperInfo>(scraperId);
+    if (infos.isEmpty()) {
+        infos = scraper->meta().supportedDetails;
+    }
+
+    MovieScrapeScheduler scheduler(scraper);
+    scheduler.setInfos(infos);
+    scheduler.setOnlyWithId(config.onlyWithId);
+    if (config.jobs > 0) {
+        scheduler.setMaxConcurrentItems(config.jobs);
+    }
+    for (Movie* movie : asConst(movies)) {
+        scheduler.add(movie);
+    }
+
+    ScrapeStats stats(movies.size());
+    QObject::connect(&scheduler, &MovieScrapeScheduler::movieFinished, [&](Movie* movie) {
+        const bool saved = !config.save || movie->controller()->saveData(mediaCenter);
+        stats.scraped(saved);
+        QJsonObject json = itemJson(movie);
+        json.insert("saved", saved && config.save);
+        printEvent("scraped", json);
+    });
+    QObject::connect(&scheduler, &MovieScrapeScheduler::movieSkipped, [&](Movie* movie, QString reason) {
+        stats.skipped();
+        QJsonObject json = itemJson(movie);
+        json.insert("reason", reason);
+        printEvent("skipped", json);
+    });
+    // Failed movies are never saved: their details may have been cleared before loading failed.
+    QObject::connect(&scheduler, &MovieScrapeScheduler::movieFailed, [&](Movie* movie, QString error) {
+        stats.failed();
+        QJsonObject json = itemJson(movie);
+        json.insert("error", error);
+        printEvent("error", json);
+    });
+    QObject::connect(&scheduler, &MovieScrapeScheduler::progress, [&stats](int done, int total) {
+        Q_UNUSED(total);
+        printEvent("progress", stats.toJson(done));
+    });
+    QObject::connect(&scheduler, &MovieScrapeScheduler::finished, &app, &QApplication::quit);
+
+    scheduler.start();
+    if (scheduler.isRunning()) {
+        app.exec();
+    }
+    printEvent("finished", stats.toJson(movies.size()));
+    return stats.hasFailures() ? 1 : 0;
+}
+
+/// \brief Details that the user selected for the scraper in the music search dialog.
+/// \param type "artist" or "album"
+QSet<MusicScraperInfo> musicScraperInfos(const QString& type, scraper::MusicScraper* scraper)
+{
+    const QSet<MusicScraperInfo> supported = scraper->scraperSupports();
+    // The dialog stores them by the scraper's index.
+    const int scraperNo = Manager::instance()->scrapers().musicScrapers().indexOf(scraper);
+    QSet<MusicScraperInfo> infos =
+        Settings::instance()->scraperInfos<MusicScraperInfo>(type + "/" + QString::number(scraperNo));
+    infos.intersect(supported);
+    return infos.isEmpty() ? supported : infos;
+}
+
+int scrapeMusic(QApplication& app, const ScrapeConfig& config)
+{
+    const QString scraperId =
+        config.scraperId.isEmpty() ? QString(scraper::UniversalMusicScraper::ID) : config.scraperId;
+    scraper::MusicScraper* scraper = nullptr;
+    for (scraper::MusicScraper* musicScraper : Manager::instance()->scrapers().musicScrapers()) {
+        if (musicScraper->identifier() == scraperId) {
+            scraper = musicScraper;
+        }
+    }
+    if (scraper == nullptr) {
+        std::cerr << "Unknown music scraper: " << scraperId.toStdString() << std::endl;
+        return 1;
+    }
+
+    const QVector<SettingsDir> directories =
+        selectDirectories(Settings::instance()->directorySettings().musicDirectories(), config.directories);
+    if (directories.isEmpty()) {
+        std::cerr << "No music directories to scrape." << std::endl;
+        return 1;
+    }
+
+    // Music is loaded synchronously.
+    QElapsedTimer reloadTimer;
+    reloadTimer.start();
+    Manager::instance()->musicFileSearcher()->setMusicDirectories(directories);
+    Manager::instance()->musicFileSearcher()->reload(false);
+
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
+    MusicScrapeScheduler scheduler(scraper);
+    scheduler.setArtistInfos(musicScraperInfos("artist", scraper));
+    scheduler.setAlbumInfos(musicScraperInfos("album", scraper));
+    if (config.jobs > 0) {
+        scheduler.setMaxConcurrentItems(config.jobs);
+    }
+
+    int items = 0;
+    for (Artist* artist : Manager::instance()->musicModel()->artists()) {
+        ++items;
+        if (config.all || isNewOrChanged(mediaCenter->nfoFilePath(artist), {})) {
+            scheduler.add(artist);
+        }
+        for (Album* album : artist->albums()) {
+            ++items;
+            if (config.all || isNewOrChanged(mediaCenter->nfoFilePath(album), {})) {
+                scheduler.add(album);
+            }
+        }
+    }
+    QJsonObject reloadStats;
+    reloadStats.insert("items", items);
+    reloadStats.insert("selected", scheduler.count());
+    reloadStats.insert("elapsedSeconds", static_cast<double>(reloadTimer.elapsed()) / 1000.0);
+    printEvent("reloaded", reloadStats);
+
+    // Items without results are neither reported as finished nor as skipped by the
+    // scheduler. They are counted as skipped once scraping is done.
+    ScrapeStats stats(scheduler.count());
+    int scraped = 0;
+    QObject::connect(&scheduler, &MusicScrapeScheduler::artistFinished, [&](Artist* artist) {
+        const bool saved = !config.save || artist->controller()->saveData(mediaCenter);
+        stats.scraped(saved);
+        ++scraped;
+        QJsonObject json = itemJson(artist->name(), artist->path().toString());
+        json.insert("saved", saved && config.save);
+        printEvent("scraped", json);
+    });
+    QObject::connect(&scheduler, &MusicScrapeScheduler::albumFinished, [&](Album* album) {
+        const bool saved = !config.save || album->controller()->saveData(mediaCenter);
+        stats.scraped(saved);
+        ++scraped;
+        QJsonObject json = itemJson(album->title(), album->path().toString());
+        json.insert("saved", saved && config.save);
+        printEvent("scraped", json);
+    });
+    QObject::connect(&scheduler, &MusicScrapeScheduler::progress, [&stats](int done, int total) {
+        Q_UNUSED(total);
+        printEvent("progress", stats.toJson(done));
+    });
+    QObject::connect(&scheduler, &MusicScrapeScheduler::finished, &app, &QApplication::quit);
+
+    scheduler.start();
+    if (scheduler.isRunning()) {
+        app.exec();
+    }
+    for (int i = scraped; i < scheduler.count(); ++i) {
+        stats.skipped();
+    }
+    printEvent("finished", stats.toJson(scheduler.count()));
+    return stats.hasFailures() ? 1 : 0;
+}
+
+} // namespace
+
+int scrape(QApplication& app, QCommandLineParser& parser)
+{
+    parser.clearPositionalArguments();
+    // re-add this command so that it appears when help is printed
+    parser.addPositionalArgument(
+        "scrape", "Scrape new or changed media entries and save them", "scrape [scrape_options]");
+
+    QCommandLineOption typeOption("type", R"(Media type. Either "movie" or "music")", "mediatype", "movie");
+    QCommandLineOption dirOption("dir",
+        "Only reload and scrape this configured directory. May be given more than once.",
+        "directory");
+    QCommandLineOption scraperOption("scraper",
+        QStringLiteral("Identifier of the scraper to use, see `mediaelch info movie_scrapers`. "
+                       "Defaults to \"%1\" for movies and \"%2\" for music.")
+            .arg(QString(scraper::TmdbMovie::ID), QString(scraper::UniversalMusicScraper::ID)),
+        "scraper");
+    QCommandLineOption jobsOption("jobs", "Maximum number of items that are scraped at the same time.", "count", "0");
+    QCommandLineOption allOption("all", "Scrape all items, not only those without NFO or with newer files.");
+    QCommandLineOption onlyWithIdOption("only-with-id", "Skip movies without an ID instead of searching for them.");
+    QCommandLineOption dryRunOption("dry-run", "Scrape, but don't save anything.");
+
+    parser.addOption(typeOption);
+    parser.addOption(dirOption);
+    parser.addOption(scraperOption);
+    parser.addOption(jobsOption);
+    parser.addOption(allOption);
+    parser.addOption(onlyWithIdOption);
+    parser.addOption(dryRunOption);
+    parser.process(app);
+
+    ScrapeConfig config;
+    config.mediaType = mediaTypeFromString(parser.value(typeOption));
+    for (const QString& dir : parser.values(dirOption)) {
+        config.directories << QDir::cleanPath(QDir(dir).absolutePath());
+    }
+    config.directories.removeDuplicates();
+    config.scraperId = parser.value(scraperOption);
+    config.jobs = parser.value(jobsOption).toInt();
+    config.all = parser.isSet(allOption);
+    config.onlyWithId = parser.isSet(onlyWithIdOption);
+    config.save = !parser.isSet(dryRunOption);
+
+    switch (config.mediaType) {
+    case MediaType::Movie: return scrapeMovies(app, config);
+    case MediaType::Music: return scrapeMusic(app, config);
+    case MediaType::TvShow:
+    case MediaType::Concert:
+    case MediaType::All:
+    case MediaType::Unknown: break;
+    }
+    std::cerr << "Unsupported media type: " << parser.value(typeOption).toStdString() << std::endl;
+    return 1;
+}
+
+} // namespace cli
+} // namespace mediaelch
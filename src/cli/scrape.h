@@ -0,0 +1,16 @@
+#pragma once
+
+#include "cli/common.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+
+namespace mediaelch {
+namespace cli {
+
+/// \brief Reloads the selected directories, scrapes new or changed items and
+///        saves them. Progress is printed as one JSON object per line.
+int scrape(QApplication& app, QCommandLineParser& parser);
+
+} // namespace cli
+} // namespace mediaelch
@@ -1,5 +1,6 @@
 #include "ConcertFileSearcher.h"
 
+#include "data/DatabaseService.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
@@ -88,14 +89,8 @@ void ConcertFileSearcher::scanDir(QString startPath,
             return;
         }
 
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
-        }
-
-        // Skip "Extras" folder
-        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
+        // Skip excluded and "Extras" folders
+        if (m_scanExcludes.foldersWithExtras.matches(cDir)) {
             continue;
         }
 
@@ -124,12 +119,8 @@ void ConcertFileSearcher::scanDir(QString startPath,
             return;
         }
 
-        if (Settings::instance()->advanced()->isFileExcluded(file)) {
-            continue;
-        }
-
-        // Skip Trailers and Sample files
-        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+        // Skip excluded, Trailers and Sample files
+        if (m_scanExcludes.files.matches(file)) {
             continue;
         }
         files.append(file);
@@ -202,6 +193,7 @@ void ConcertFileSearcher::clearOldConcerts(bool forceClear)
 QVector<QStringList> ConcertFileSearcher::loadContentsFromDiskIfRequired(bool forceReload)
 {
     QVector<QStringList> contents;
+    m_scanExcludes = Settings::instance()->advanced()->concertScanExcludes();
 
     for (const SettingsDir& dir : asConst(m_directories)) {
         if (dir.disabled) {
@@ -222,7 +214,7 @@ void ConcertFileSearcher::storeContentsInDatabase(const QVector<QStringList>& co
     database().transaction();
     for (const QStringList& files : contents) {
         if (m_aborted) {
-            return;
+            break;
         }
 
         bool inSeparateFolder = false;
@@ -255,6 +247,8 @@ void ConcertFileSearcher::storeContentsInDatabase(const QVector<QStringList>& co
         database().add(&concert, mediaelch::DirectoryPath(path));
     }
     database().commit();
+    // The stored concerts are read back by loadConcertsFromDatabase().
+    database().service()->flush();
 }
 
 void ConcertFileSearcher::setupDatabaseConcerts(const QVector<Concert*>& dbConcerts)
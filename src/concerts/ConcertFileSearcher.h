@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/Database.h"
+#include "file/NameMatcher.h"
 
 #include <QDir>
 #include <QString>
@@ -28,6 +29,8 @@ private:
     QVector<SettingsDir> m_directories;
     int m_progressMessageId;
     bool m_aborted = false;
+    /// Built once per scan.
+    mediaelch::ScanExcludes m_scanExcludes;
 
 private:
     Database& database();
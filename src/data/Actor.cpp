@@ -1,5 +1,7 @@
 #include "data/Actor.h"
 
+#include "data/StringPool.h"
+
 
 QDebug operator<<(QDebug dbg, const Actor& actor)
 {
@@ -21,6 +23,8 @@ void Actors::addActor(Actor actor)
         actor.order = m_actors.back()->order + 1;
     }
     auto* a = new Actor(actor);
+    a->name = mediaelch::StringPool::global().intern(a->name);
+    a->role = mediaelch::StringPool::global().intern(a->role);
     m_actors.push_back(a);
 }
 
@@ -51,6 +55,8 @@ void Actors::setActors(QVector<Actor> actors)
     removeAll();
     for (const Actor& a : actors) {
         auto* actor = new Actor(a);
+        actor->name = mediaelch::StringPool::global().intern(actor->name);
+        actor->role = mediaelch::StringPool::global().intern(actor->role);
         m_actors.push_back(actor);
     }
 }
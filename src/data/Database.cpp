@@ -1,14 +1,19 @@
 #include "Database.h"
 
 #include "concerts/Concert.h"
+#include "data/DatabaseService.h"
+#include "data/MovieListQuery.h"
 #include "data/Subtitle.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/Meta.h"
 #include "log/Log.h"
+#include "log/Perf.h"
 #include "media_centers/KodiXml.h"
 #include "media_centers/kodi/EpisodeXmlWriter.h"
 #include "movies/Movie.h"
+#include "movies/MovieSnapshot.h"
+#include "movies/file_searcher/MovieFileSearcher.h"
 #include "music/Album.h"
 #include "music/Artist.h"
 #include "settings/Settings.h"
@@ -16,12 +21,211 @@
 
 #include <QDesktopServices>
 #include <QDir>
+#include <QFile>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <QThread>
+#include <QtConcurrent>
 
 using namespace mediaelch;
 
+namespace {
+
+/// Separator for lists, e.g. genres, in movie list columns.
+const QString movieListSeparator = MovieListQuery::listSeparator();
+
+/// \brief Columns of the movies table that store the details which are shown in
+///        movie lists and used by filters, see Database::moviesInDirectory().
+const QStringList& movieListColumns()
+{
+    static const QStringList columns{"title",
+        "sortTitle",
+        "originalTitle",
+        "released",
+        "playcount",
+        "lastPlayed",
+        "certification",
+        "imdbId",
+        "tmdbId",
+        "trailer",
+        "director",
+        "setName",
+        "genres",
+        "studios",
+        "countries",
+        "tags",
+        "ratingSource",
+        "rating",
+        "votes",
+        "hasActors",
+        "streamDetailsLoaded",
+        "videoCodec",
+        "videoWidth",
+        "audioCodecs",
+        "audioChannels",
+        "subtitleLanguages"};
+    return columns;
+}
+
+/// \brief UPDATE statement for a movie's list columns and optionally its NFO content.
+QString movieListUpdateQuery(bool updateContent)
+{
+    QStringList assignments;
+    if (updateContent) {
+        assignments << "content=:content";
+    }
+    assignments << "hasListColumns=:hasListColumns";
+    for (const QString& column : movieListColumns()) {
+        assignments << QStringLiteral("%1=:%1").arg(column);
+    }
+    return QStringLiteral("UPDATE movies SET %1 WHERE idMovie=:idMovie").arg(assignments.join(", "));
+}
+
+QStringList splitMovieList(const QString& list)
+{
+    return list.isEmpty() ? QStringList{} : list.split(movieListSeparator);
+}
+
+/// \brief Values of the movie's list columns, mapped by their placeholders.
+QVariantMap movieListValues(Movie* movie)
+{
+    const Rating rating = movie->ratings().isEmpty() ? Rating{} : movie->ratings().first();
+    const auto video = movie->streamDetails()->videoDetails();
+    QStringList audioCodecs;
+    QStringList audioChannels;
+    for (const auto& audio : movie->streamDetails()->audioDetails()) {
+        audioCodecs << audio.value(StreamDetails::AudioDetails::Codec);
+        audioChannels << audio.value(StreamDetails::AudioDetails::Channels);
+    }
+    QStringList subtitleLanguages;
+    for (const auto& subtitle : movie->streamDetails()->subtitleDetails()) {
+        subtitleLanguages << subtitle.value(StreamDetails::SubtitleDetails::Language);
+    }
+
+    QVariantMap values;
+    values.insert(":hasListColumns", 1);
+    values.insert(":title", movie->name());
+    values.insert(":sortTitle", movie->sortTitle());
+    values.insert(":originalTitle", movie->originalName());
+    values.insert(":released", movie->released().isValid() ? movie->released().toString(Qt::ISODate) : "");
+    values.insert(":playcount", movie->playcount());
+    values.insert(":lastPlayed", movie->lastPlayed().isValid() ? movie->lastPlayed().toString(Qt::ISODate) : "");
+    values.insert(":certification", movie->certification().toString());
+    values.insert(":imdbId", movie->imdbId().toString());
+    values.insert(":tmdbId", movie->tmdbId().toString());
+    values.insert(":trailer", movie->trailer().toString());
+    values.insert(":director", movie->director());
+    values.insert(":setName", movie->set().name);
+    values.insert(":genres", movie->genres().join(movieListSeparator));
+    values.insert(":studios", movie->studios().join(movieListSeparator));
+    values.insert(":countries", movie->countries().join(movieListSeparator));
+    values.insert(":tags", movie->tags().join(movieListSeparator));
+    values.insert(":ratingSource", movie->ratings().isEmpty() ? "" : rating.source);
+    values.insert(":rating", rating.rating);
+    values.insert(":votes", rating.voteCount);
+    values.insert(":hasActors", movie->hasActors() ? 1 : 0);
+    values.insert(":streamDetailsLoaded", movie->streamDetailsLoaded() ? 1 : 0);
+    values.insert(":videoCodec", video.value(StreamDetails::VideoDetails::Codec));
+    values.insert(":videoWidth", video.value(StreamDetails::VideoDetails::Width).toInt());
+    values.insert(":audioCodecs", audioCodecs.join(movieListSeparator));
+    values.insert(":audioChannels", audioChannels.join(movieListSeparator));
+    values.insert(":subtitleLanguages", subtitleLanguages.join(movieListSeparator));
+    return values;
+}
+
+void bindValues(QSqlQuery& query, const QVariantMap& values)
+{
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        query.bindValue(it.key(), it.value());
+    }
+}
+
+/// \brief Sets the movie's list details from the current row of the given query.
+void loadMovieListColumns(const QSqlQuery& query, Movie* movie)
+{
+    const auto value = [&query](const char* column) { return query.value(query.record().indexOf(column)); };
+
+    movie->setName(value("title").toString());
+    movie->setSortTitle(value("sortTitle").toString());
+    movie->setOriginalName(value("originalTitle").toString());
+    movie->setReleased(QDate::fromString(value("released").toString(), Qt::ISODate));
+    movie->setPlayCount(value("playcount").toInt());
+    movie->setLastPlayed(QDateTime::fromString(value("lastPlayed").toString(), Qt::ISODate));
+    movie->setCertification(Certification(value("certification").toString()));
+    movie->setImdbId(ImdbId(value("imdbId").toString()));
+    movie->setTmdbId(TmdbId(value("tmdbId").toString()));
+    movie->setTrailer(QUrl(value("trailer").toString()));
+    movie->setDirector(value("director").toString());
+    if (!value("setName").toString().isEmpty()) {
+        MovieSet set;
+        set.name = value("setName").toString();
+        movie->setSet(set);
+    }
+    for (const QString& genre : splitMovieList(value("genres").toString())) {
+        movie->addGenre(genre);
+    }
+    for (const QString& studio : splitMovieList(value("studios").toString())) {
+        movie->addStudio(studio);
+    }
+    for (const QString& country : splitMovieList(value("countries").toString())) {
+        movie->addCountry(country);
+    }
+    for (const QString& tag : splitMovieList(value("tags").toString())) {
+        movie->addTag(tag);
+    }
+    if (!value("ratingSource").toString().isEmpty()) {
+        Rating rating;
+        rating.source = value("ratingSource").toString();
+        rating.rating = value("rating").toDouble();
+        rating.voteCount = value("votes").toInt();
+        movie->ratings().addRating(rating);
+    }
+    movie->setHasUnloadedActors(value("hasActors").toInt() == 1);
+
+    StreamDetails* streamDetails = movie->streamDetails();
+    if (!value("videoCodec").toString().isEmpty()) {
+        streamDetails->setVideoDetail(StreamDetails::VideoDetails::Codec, value("videoCodec").toString());
+    }
+    if (value("videoWidth").toInt() > 0) {
+        streamDetails->setVideoDetail(StreamDetails::VideoDetails::Width, value("videoWidth").toString());
+    }
+    const QStringList audioCodecs = splitMovieList(value("audioCodecs").toString());
+    const QStringList audioChannels = splitMovieList(value("audioChannels").toString());
+    for (int i = 0; i < audioCodecs.size() && i < audioChannels.size(); ++i) {
+        streamDetails->setAudioDetail(i, StreamDetails::AudioDetails::Codec, audioCodecs.at(i));
+        streamDetails->setAudioDetail(i, StreamDetails::AudioDetails::Channels, audioChannels.at(i));
+    }
+    const QStringList subtitleLanguages = splitMovieList(value("subtitleLanguages").toString());
+    for (int i = 0; i < subtitleLanguages.size(); ++i) {
+        streamDetails->setSubtitleDetail(i, StreamDetails::SubtitleDetails::Language, subtitleLanguages.at(i));
+    }
+    movie->setStreamDetailsLoaded(value("streamDetailsLoaded").toInt() == 1);
+}
+
+/// \brief Returns the id of the settings of the show in the given directory.
+///        They are created if they don't exist yet.
+int showsSettingsIdOf(QSqlDatabase& db, const QByteArray& dir)
+{
+    QSqlQuery query(db);
+    query.prepare("SELECT idShow FROM showsSettings WHERE dir=:dir");
+    query.bindValue(":dir", dir);
+    query.exec();
+    if (query.next()) {
+        return query.value(0).toInt();
+    }
+
+    query.prepare("INSERT INTO showsSettings(showMissingEpisodes, hideSpecialsInMissingEpisodes, dir) VALUES(:show, "
+                  ":hide, :dir)");
+    query.bindValue(":dir", dir);
+    query.bindValue(":show", 0);
+    query.bindValue(":hide", 0);
+    query.exec();
+    return query.lastInsertId().toInt();
+}
+
+} // namespace
+
 Database::Database(QObject* parent) : QObject(parent)
 {
     mediaelch::DirectoryPath dataLocation = Settings::instance()->databaseDir();
@@ -218,13 +422,59 @@ Database::Database(QObject* parent) : QObject(parent)
             query.exec();
 
             myDbVersion = 16;
-            Q_UNUSED(myDbVersion);
             updateDbVersion(16);
         }
 
-        query.prepare("PRAGMA synchronous=0;");
+        if (myDbVersion < 17) {
+            // Details shown in movie lists. Movies cached by older versions have "hasListColumns" set
+            // to 0 and are parsed and updated on next load, see MovieFileSearcher::reload().
+            query.prepare("ALTER TABLE movies ADD COLUMN \"hasListColumns\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            const QStringList integerColumns{"playcount", "votes", "hasActors", "streamDetailsLoaded", "videoWidth"};
+            for (const QString& column : movieListColumns()) {
+                QString type = "text NOT NULL DEFAULT ''";
+                if (integerColumns.contains(column)) {
+                    type = "integer NOT NULL DEFAULT 0";
+                } else if (column == "rating") {
+                    type = "real NOT NULL DEFAULT 0";
+                }
+                query.prepare(QStringLiteral("ALTER TABLE movies ADD COLUMN \"%1\" %2;").arg(column, type));
+                query.exec();
+            }
+
+            myDbVersion = 17;
+            updateDbVersion(17);
+        }
+
+        if (myDbVersion < 18) {
+            // Details of missing episodes, so that they don't have to be parsed, see showsEpisodes().
+            // Episodes cached by older versions have "hasDetails" set to 0 until the show is updated.
+            query.prepare("ALTER TABLE showsEpisodes ADD COLUMN \"hasDetails\" integer NOT NULL DEFAULT 0;");
+            query.exec();
+            query.prepare("ALTER TABLE showsEpisodes ADD COLUMN \"title\" text NOT NULL DEFAULT '';");
+            query.exec();
+            query.prepare("ALTER TABLE showsEpisodes ADD COLUMN \"firstAired\" text NOT NULL DEFAULT '';");
+            query.exec();
+
+            myDbVersion = 18;
+            Q_UNUSED(myDbVersion);
+            updateDbVersion(18);
+        }
+
+        // Readers must not block the writer of the database service and vice versa.
+        query.prepare("PRAGMA journal_mode=WAL;");
         query.exec();
+    }
 
+    m_service = new DatabaseService(m_db->databaseName(), this);
+
+    // The database service is the only writer. The main connection is only used for reading.
+    m_db->close();
+    m_db->setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=5000");
+    if (!m_db->open()) {
+        qCWarning(generic) << "Could not open cache database for reading";
+    } else {
+        QSqlQuery query(*m_db);
         query.prepare("PRAGMA cache_size=20000;");
         query.exec();
     }
@@ -232,6 +482,9 @@ Database::Database(QObject* parent) : QObject(parent)
 
 Database::~Database()
 {
+    // Commits all queued writes.
+    delete m_service;
+    m_service = nullptr;
     if (m_db != nullptr && m_db->isOpen()) {
         m_db->close();
     }
@@ -271,145 +524,309 @@ void Database::updateDbVersion(int version)
  */
 QSqlDatabase Database::db()
 {
+    // Connections must only be used in the thread that created them.
+    if (QThread::currentThread() != thread()) {
+        return m_service->readConnection();
+    }
     return *m_db;
 }
 
+DatabaseService* Database::service()
+{
+    return m_service;
+}
+
 void Database::transaction()
 {
-    db().transaction();
+    m_service->holdWrites();
 }
 
 void Database::commit()
 {
-    db().commit();
+    m_service->releaseWrites();
 }
 
 void Database::clearAllMovies()
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM movies");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='movies'");
-    query.exec();
-    query.prepare("DELETE FROM movieFiles");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='movieFiles'");
-    query.exec();
-    query.prepare("DELETE FROM movieSubtitles");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
-    query.exec();
+    m_service->write([](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM movies");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='movies'");
+        query.exec();
+        query.prepare("DELETE FROM movieFiles");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='movieFiles'");
+        query.exec();
+        query.prepare("DELETE FROM movieSubtitles");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
+        query.exec();
+    });
+
+    MovieSnapshot::removeAll();
 }
 
 void Database::clearMoviesInDirectory(DirectoryPath path)
 {
-    QMutexLocker locker(&m_mutex);
+    const QByteArray pathValue = path.toString().toUtf8();
+    m_service->write([pathValue](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM movieFiles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
+        query.bindValue(":path", pathValue);
+        query.exec();
+        query.prepare("DELETE FROM movieSubtitles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
+        query.bindValue(":path", pathValue);
+        query.exec();
+        query.prepare("DELETE FROM movies WHERE path=:path");
+        query.bindValue(":path", pathValue);
+        query.exec();
+    });
 
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM movieFiles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    query.prepare("DELETE FROM movieSubtitles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    query.prepare("DELETE FROM movies WHERE path=:path");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    MovieSnapshot(path).remove();
 }
 
 void Database::add(Movie* movie, DirectoryPath path)
 {
-    QMutexLocker locker(&m_mutex);
+    perf::ScopedTimer timer("db.write.movie");
+
+    QVariantMap values = movieListValues(movie);
+    const QByteArray content = movie->nfoContentUtf8();
+    values.insert(":content", content.isEmpty() ? "" : content);
+    values.insert(":lastModified",
+        movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
+    values.insert(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
+    values.insert(":hasPoster", movie->hasImage(ImageType::MoviePoster) ? 1 : 0);
+    values.insert(":hasBackdrop", movie->hasImage(ImageType::MovieBackdrop) ? 1 : 0);
+    values.insert(":hasLogo", movie->hasImage(ImageType::MovieLogo) ? 1 : 0);
+    values.insert(":hasClearArt", movie->hasImage(ImageType::MovieClearArt) ? 1 : 0);
+    values.insert(":hasCdArt", movie->hasImage(ImageType::MovieCdArt) ? 1 : 0);
+    values.insert(":hasBanner", movie->hasImage(ImageType::MovieBanner) ? 1 : 0);
+    values.insert(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
+    values.insert(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
+    values.insert(":discType", static_cast<int>(movie->discType()));
+    values.insert(":path", path.toString().toUtf8());
+    QVector<QVariantMap> subtitles;
+    for (const Subtitle* subtitle : movie->subtitles()) {
+        subtitles.push_back({{":files", subtitle->files().join("%§%")},
+            {":language", subtitle->language().isEmpty() ? "" : subtitle->language()},
+            {":forced", subtitle->forced() ? 1 : 0}});
+    }
+    const mediaelch::FileList files = movie->files();
+    const ColorLabel label = movie->label();
+
+    const QString insertQuery =
+        QStringLiteral("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
+                       "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path, "
+                       "hasListColumns, %1) "
+                       "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
+                       ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path, "
+                       ":hasListColumns, :%2)")
+            .arg(movieListColumns().join(", "), movieListColumns().join(", :"));
+
+    // Only values are passed to the writer thread; it must not access the movie.
+    const int insertId = m_service->writeAndWait<int>([&](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare(insertQuery);
+        bindValues(query, values);
+        query.exec();
+        const int idMovie = query.lastInsertId().toInt();
 
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
-                  "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
-                  "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
-                  ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
-    query.bindValue(
-        ":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
-    query.bindValue(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
-    query.bindValue(":hasPoster", movie->hasImage(ImageType::MoviePoster) ? 1 : 0);
-    query.bindValue(":hasBackdrop", movie->hasImage(ImageType::MovieBackdrop) ? 1 : 0);
-    query.bindValue(":hasLogo", movie->hasImage(ImageType::MovieLogo) ? 1 : 0);
-    query.bindValue(":hasClearArt", movie->hasImage(ImageType::MovieClearArt) ? 1 : 0);
-    query.bindValue(":hasCdArt", movie->hasImage(ImageType::MovieCdArt) ? 1 : 0);
-    query.bindValue(":hasBanner", movie->hasImage(ImageType::MovieBanner) ? 1 : 0);
-    query.bindValue(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
-    query.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
-    query.bindValue(":discType", static_cast<int>(movie->discType()));
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    int insertId = query.lastInsertId().toInt();
+        for (const mediaelch::FilePath& file : files) {
+            query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
+            query.bindValue(":idMovie", idMovie);
+            query.bindValue(":file", file.toString().toUtf8());
+            query.exec();
+        }
+
+        for (const QVariantMap& subtitle : subtitles) {
+            query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
+                          ":language, :forced)");
+            query.bindValue(":idMovie", idMovie);
+            bindValues(query, subtitle);
+            query.exec();
+        }
 
+        writeLabel(db, files, label);
+        return idMovie;
+    });
+
+    movie->setDatabaseId(insertId);
+}
+
+void Database::update(Movie* movie)
+{
+    // Only values are captured: the movie may be changed or deleted before the write is executed.
+    const int idMovie = movie->databaseId();
+    QVariantMap values = movieListValues(movie);
+    const QByteArray content = movie->nfoContentUtf8();
+    values.insert(":content", content.isEmpty() ? "" : content);
+    values.insert(":idMovie", idMovie);
+    QStringList files;
     for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        files << file.toString();
     }
-
+    QVector<QVariantMap> subtitles;
     for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
+        subtitles.push_back({{":files", subtitle->files().join("%§%")},
+            {":language", subtitle->language().isEmpty() ? "" : subtitle->language()},
+            {":forced", subtitle->forced() ? 1 : 0}});
     }
 
-    setLabel(movie->files(), movie->label());
+    const DirectoryPath snapshotDir = MovieSnapshot::snapshotDir();
 
-    movie->setDatabaseId(insertId);
+    m_service->write([idMovie, values, files, subtitles, snapshotDir](QSqlDatabase& db) {
+        invalidateMovieSnapshot(db, snapshotDir, idMovie);
+
+        QSqlQuery query(db);
+        query.prepare(movieListUpdateQuery(true));
+        bindValues(query, values);
+        query.exec();
+
+        query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+        query.bindValue(":idMovie", idMovie);
+        query.exec();
+        for (const QString& file : files) {
+            query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
+            query.bindValue(":idMovie", idMovie);
+            query.bindValue(":file", file.toUtf8());
+            query.exec();
+        }
+
+        query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+        query.bindValue(":idMovie", idMovie);
+        query.exec();
+        for (const QVariantMap& subtitle : subtitles) {
+            query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
+                          ":language, :forced)");
+            query.bindValue(":idMovie", idMovie);
+            bindValues(query, subtitle);
+            query.exec();
+        }
+    });
 }
 
-void Database::update(Movie* movie)
+void Database::updateListColumns(Movie* movie)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
+    QVariantMap values = movieListValues(movie);
+    values.insert(":idMovie", movie->databaseId());
+    m_service->write([values](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare(movieListUpdateQuery(false));
+        bindValues(query, values);
+        if (!query.exec()) {
+            qCWarning(generic) << "[Database] Could not store list details:" << query.lastError().text();
+        }
+    });
+}
 
-    query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
-    for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":file", file.toString().toUtf8());
+void Database::updateMissingMovieListColumns()
+{
+    perf::ScopedTimer timer("db.write.missingMovieListColumns");
+    // Movies are parsed in chunks, so that not all NFO contents are in memory at once.
+    // Movies without NFO content keep their empty list columns; they are loaded from disk.
+    const int chunkSize = 200;
+    while (true) {
+        // The main connection only sees the previous chunk once it is committed.
+        m_service->flush();
+        QSqlQuery query(db());
+        query.prepare("SELECT idMovie, content FROM movies WHERE hasListColumns=0 AND length(content)>0 LIMIT :limit");
+        query.bindValue(":limit", chunkSize);
         query.exec();
+        QVector<Movie*> movies;
+        while (query.next()) {
+            auto* movie = new Movie();
+            movie->setDatabaseId(query.value(0).toInt());
+            movie->setNfoContent(QString::fromUtf8(query.value(1).toByteArray()));
+            movies << movie;
+        }
+        if (movies.isEmpty()) {
+            break;
+        }
+        qCDebug(generic) << "[Database] Storing list details of" << movies.size() << "movies";
+        QtConcurrent::blockingMap(movies, MovieFileSearcher::loadMovieData);
+        QVector<QVariantMap> valuesList;
+        for (Movie* movie : asConst(movies)) {
+            QVariantMap values = movieListValues(movie);
+            values.insert(":idMovie", movie->databaseId());
+            valuesList << values;
+        }
+        qDeleteAll(movies);
+
+        // The chunk is written in one transaction.  If it fails, the same movies would be
+        // selected again, so stop; their list details are loaded from disk instead.
+        const bool stored = m_service->writeAndWait<bool>([&valuesList](QSqlDatabase& db) {
+            QSqlQuery update(db);
+            update.prepare(movieListUpdateQuery(false));
+            for (const QVariantMap& values : asConst(valuesList)) {
+                bindValues(update, values);
+                if (!update.exec()) {
+                    qCWarning(generic) << "[Database] Could not store list details:" << update.lastError().text();
+                    return false;
+                }
+            }
+            return true;
+        });
+        if (!stored) {
+            break;
+        }
+    }
+}
+
+QHash<int, QString> Database::movieNfoContents(const QVector<int>& movieIds)
+{
+    perf::ScopedTimer timer("db.read.movieNfoContents");
+    QHash<int, QString> contents;
+    if (movieIds.isEmpty()) {
+        return contents;
     }
 
-    query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
-    query.bindValue(":idMovie", movie->databaseId());
+    QStringList ids;
+    for (int id : movieIds) {
+        ids << QString::number(id);
+    }
+    QSqlQuery query(db());
+    query.prepare(QStringLiteral("SELECT idMovie, content FROM movies WHERE idMovie IN (%1)").arg(ids.join(",")));
     query.exec();
-    for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
+    while (query.next()) {
+        contents.insert(query.value(0).toInt(), QString::fromUtf8(query.value(1).toByteArray()));
+    }
+    return contents;
+}
+
+void Database::invalidateMovieSnapshot(QSqlDatabase db, const DirectoryPath& snapshotDir, int idMovie)
+{
+    QSqlQuery query(db);
+    query.prepare("SELECT path FROM movies WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", idMovie);
+    query.exec();
+    if (query.next()) {
+        const DirectoryPath movieDirectory(QString::fromUtf8(query.value(0).toByteArray()));
+        QFile::remove(MovieSnapshot::snapshotFilePath(snapshotDir, movieDirectory));
     }
 }
 
 QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
 {
-    QMutexLocker locker(&m_mutex);
-    transaction();
-    QSqlQuery query(db());
-    query.prepare("SELECT M.idMovie, M.content, M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, "
-                  "M.hasLogo, M.hasClearArt, "
-                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, MF.file, L.color "
-                  "FROM movies M "
-                  "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
-                  "LEFT JOIN labels L ON MF.file=L.fileName "
-                  "WHERE path=:path "
-                  "ORDER BY M.idMovie, MF.file");
+    perf::ScopedTimer timer("db.read.movies");
+    // All queries read the same snapshot of the database.
+    QSqlDatabase database = db();
+    database.transaction();
+    QSqlQuery query(database);
+    // The NFO content is only selected for movies without list columns.  All other movies
+    // are "light" and parse their NFO content once they are hydrated.
+    const QString selectQuery =
+        QStringLiteral("SELECT M.idMovie, CASE WHEN M.hasListColumns=1 THEN '' ELSE M.content END AS content, "
+                       "length(M.content)=0 AS hasNoContent, M.lastModified, M.inSeparateFolder, M.hasPoster, "
+                       "M.hasBackdrop, M.hasLogo, M.hasClearArt, M.hasCdArt, M.hasBanner, M.hasThumb, "
+                       "M.hasExtraFanarts, M.discType, M.hasListColumns, M.%1, MF.file, L.color "
+                       "FROM movies M "
+                       "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
+                       "LEFT JOIN labels L ON MF.file=L.fileName "
+                       "WHERE path=:path "
+                       "ORDER BY M.idMovie, MF.file")
+            .arg(movieListColumns().join(", M."));
+    query.prepare(selectQuery);
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
 
@@ -448,6 +865,13 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
             movie->images().setHasExtraFanarts(query.value(query.record().indexOf("hasExtraFanarts")).toInt() == 1);
             movie->setDiscType(static_cast<DiscType>(query.value(query.record().indexOf("discType")).toInt()));
             movie->setLabel(label);
+            // Movies without NFO content are loaded from disk, as there may be a new NFO file.
+            if (query.value(query.record().indexOf("hasListColumns")).toInt() == 1
+                && query.value(query.record().indexOf("hasNoContent")).toInt() == 0) {
+                loadMovieListColumns(query, movie);
+                movie->controller()->setInfoLoaded(true);
+                movie->controller()->setHydrated(false);
+            }
             movie->setChanged(false);
             movies.insert(query.value(query.record().indexOf("idMovie")).toInt(), movie);
         }
@@ -473,72 +897,94 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path)
         movie->addSubtitle(subtitle, true);
     }
 
-    commit();
+    database.commit();
 
     return movies.values().toVector();
 }
 
 void Database::clearAllConcerts()
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM concerts");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='concerts'");
-    query.exec();
-    query.prepare("DELETE FROM concertFiles");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='concertFiles'");
-    query.exec();
+    m_service->write([](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM concerts");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='concerts'");
+        query.exec();
+        query.prepare("DELETE FROM concertFiles");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='concertFiles'");
+        query.exec();
+    });
 }
 
 void Database::clearConcertsInDirectory(DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM concertFiles WHERE idConcert IN (SELECT idConcert FROM concerts WHERE path=:path)");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    query.prepare("DELETE FROM concerts WHERE path=:path");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    const QByteArray pathValue = path.toString().toUtf8();
+    m_service->write([pathValue](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare(
+            "DELETE FROM concertFiles WHERE idConcert IN (SELECT idConcert FROM concerts WHERE path=:path)");
+        query.bindValue(":path", pathValue);
+        query.exec();
+        query.prepare("DELETE FROM concerts WHERE path=:path");
+        query.bindValue(":path", pathValue);
+        query.exec();
+    });
 }
 
 void Database::add(Concert* concert, DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO concerts(content, inSeparateFolder, path) "
-                  "VALUES(:content, :inSeparateFolder, :path)");
-    query.bindValue(":content", concert->nfoContent().isEmpty() ? "" : concert->nfoContent().toUtf8());
-    query.bindValue(":inSeparateFolder", (concert->inSeparateFolder() ? 1 : 0));
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    int insertId = query.lastInsertId().toInt();
-
-    for (const FilePath& file : concert->files()) {
-        query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
-        query.bindValue(":idConcert", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
+    const QByteArray content = concert->nfoContent().toUtf8();
+    const bool inSeparateFolder = concert->inSeparateFolder();
+    const FileList files = concert->files();
+
+    const int insertId = m_service->writeAndWait<int>([&](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO concerts(content, inSeparateFolder, path) "
+                      "VALUES(:content, :inSeparateFolder, :path)");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":inSeparateFolder", (inSeparateFolder ? 1 : 0));
+        query.bindValue(":path", path.toString().toUtf8());
         query.exec();
-    }
+        const int idConcert = query.lastInsertId().toInt();
+
+        for (const FilePath& file : files) {
+            query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
+            query.bindValue(":idConcert", idConcert);
+            query.bindValue(":file", file.toString().toUtf8());
+            query.exec();
+        }
+        return idConcert;
+    });
     concert->setDatabaseId(insertId);
 }
 
 void Database::update(Concert* concert)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE concerts SET content=:content WHERE idConcert=:id");
-    query.bindValue(":content", concert->nfoContent().isEmpty() ? "" : concert->nfoContent());
-    query.bindValue(":id", concert->databaseId());
-    query.exec();
-
-    query.prepare("DELETE FROM concertFiles WHERE idConcert=:idConcert");
-    query.bindValue(":idConcert", concert->databaseId());
-    query.exec();
+    const int idConcert = concert->databaseId();
+    const QString content = concert->nfoContent();
+    QStringList files;
     for (const FilePath& file : concert->files()) {
-        query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
-        query.bindValue(":idConcert", concert->databaseId());
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        files << file.toString();
     }
+
+    m_service->write([idConcert, content, files](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("UPDATE concerts SET content=:content WHERE idConcert=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":id", idConcert);
+        query.exec();
+
+        query.prepare("DELETE FROM concertFiles WHERE idConcert=:idConcert");
+        query.bindValue(":idConcert", idConcert);
+        query.exec();
+        for (const QString& file : files) {
+            query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
+            query.bindValue(":idConcert", idConcert);
+            query.bindValue(":file", file.toUtf8());
+            query.exec();
+        }
+    });
 }
 
 QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
@@ -569,144 +1015,195 @@ QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
 
 void Database::add(TvShow* show, DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO shows(dir, content, path) "
-                  "VALUES(:dir, :content, :path)");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.bindValue(":content", show->nfoContent().isEmpty() ? "" : show->nfoContent().toUtf8());
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    show->setDatabaseId(query.lastInsertId().toInt());
+    const QByteArray dir = show->dir().toString().toUtf8();
+    const QByteArray content = show->nfoContent().toUtf8();
+    const QString tvdbId = show->tvdbId().toString();
+    const QString episodeGuideUrl = show->episodeGuideUrl();
+
+    int idShow = -1;
+    bool showMissingEpisodes = false;
+    bool hideSpecialsInMissingEpisodes = false;
+    m_service->writeAndWait([&](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO shows(dir, content, path) "
+                      "VALUES(:dir, :content, :path)");
+        query.bindValue(":dir", dir);
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":path", path.toString().toUtf8());
+        query.exec();
+        idShow = query.lastInsertId().toInt();
 
-    query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
-    if (query.next()) {
-        show->setShowMissingEpisodes(query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1);
-        show->setHideSpecialsInMissingEpisodes(
-            query.value(query.record().indexOf("hideSpecialsInMissingEpisodes")).toInt() == 1);
-    } else {
-        query.prepare("INSERT INTO showsSettings(showMissingEpisodes, hideSpecialsInMissingEpisodes, dir, tvdbid, url) "
-                      "VALUES(0, 0, :dir, :tvdbid, :url)");
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
+        query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
+        query.bindValue(":dir", dir);
         query.exec();
-        show->setShowMissingEpisodes(false);
-        show->setHideSpecialsInMissingEpisodes(false);
-    }
+        if (query.next()) {
+            showMissingEpisodes = query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1;
+            hideSpecialsInMissingEpisodes =
+                query.value(query.record().indexOf("hideSpecialsInMissingEpisodes")).toInt() == 1;
+        } else {
+            query.prepare(
+                "INSERT INTO showsSettings(showMissingEpisodes, hideSpecialsInMissingEpisodes, dir, tvdbid, url) "
+                "VALUES(0, 0, :dir, :tvdbid, :url)");
+            query.bindValue(":dir", dir);
+            query.bindValue(":tvdbid", tvdbId);
+            query.bindValue(":url", episodeGuideUrl.isEmpty() ? "" : episodeGuideUrl);
+            query.exec();
+        }
+    });
+
+    show->setDatabaseId(idShow);
+    show->setShowMissingEpisodes(showMissingEpisodes);
+    show->setHideSpecialsInMissingEpisodes(hideSpecialsInMissingEpisodes);
 }
 
 void Database::setShowMissingEpisodes(TvShow* show, bool showMissing)
 {
-    QSqlQuery query(db());
-
-    query.prepare("SELECT showMissingEpisodes FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
-    if (query.next()) {
-        query.prepare("UPDATE showsSettings SET showMissingEpisodes=:show, url=:url, tvdbid=:tvdbid WHERE dir=:dir");
-        query.bindValue(":show", showMissing ? 1 : 0);
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.exec();
-    } else {
-        query.prepare(
-            "INSERT INTO showsSettings(showMissingEpisodes, dir, tvdbid, url) VALUES(:show, :dir, :tvdbid, :url)");
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
-        query.bindValue(":show", showMissing ? 1 : 0);
+    const QByteArray dir = show->dir().toString().toUtf8();
+    const QString tvdbId = show->tvdbId().toString();
+    const QString url = show->episodeGuideUrl();
+
+    m_service->write([dir, tvdbId, url, showMissing](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("SELECT showMissingEpisodes FROM showsSettings WHERE dir=:dir");
+        query.bindValue(":dir", dir);
         query.exec();
-    }
+        if (query.next()) {
+            query.prepare(
+                "UPDATE showsSettings SET showMissingEpisodes=:show, url=:url, tvdbid=:tvdbid WHERE dir=:dir");
+            query.bindValue(":show", showMissing ? 1 : 0);
+            query.bindValue(":dir", dir);
+            query.bindValue(":tvdbid", tvdbId);
+            query.bindValue(":url", url.isEmpty() ? "" : url);
+            query.exec();
+        } else {
+            query.prepare(
+                "INSERT INTO showsSettings(showMissingEpisodes, dir, tvdbid, url) VALUES(:show, :dir, :tvdbid, :url)");
+            query.bindValue(":dir", dir);
+            query.bindValue(":url", url.isEmpty() ? "" : url);
+            query.bindValue(":tvdbid", tvdbId);
+            query.bindValue(":show", showMissing ? 1 : 0);
+            query.exec();
+        }
+    });
 }
 
 void Database::setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials)
 {
-    QSqlQuery query(db());
-
-    query.prepare("SELECT hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
-    if (query.next()) {
-        query.prepare(
-            "UPDATE showsSettings SET hideSpecialsInMissingEpisodes=:hide, url=:url, tvdbid=:tvdbid WHERE dir=:dir");
-        query.bindValue(":show", hideSpecials ? 1 : 0);
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
+    const QByteArray dir = show->dir().toString().toUtf8();
+    const QString tvdbId = show->tvdbId().toString();
+    const QString url = show->episodeGuideUrl();
+
+    m_service->write([dir, tvdbId, url, hideSpecials](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("SELECT hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
+        query.bindValue(":dir", dir);
         query.exec();
-    } else {
-        query.prepare("INSERT INTO showsSettings(hideSpecialsInMissingEpisodes, dir, tvdbid, url) VALUES(:hide, :dir, "
-                      ":tvdbid, :url)");
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-        query.bindValue(":tvdbid", show->tvdbId().toString());
-        query.bindValue(":hide", hideSpecials ? 1 : 0);
-        query.exec();
-    }
+        if (query.next()) {
+            query.prepare("UPDATE showsSettings SET hideSpecialsInMissingEpisodes=:hide, url=:url, tvdbid=:tvdbid "
+                          "WHERE dir=:dir");
+            query.bindValue(":hide", hideSpecials ? 1 : 0);
+            query.bindValue(":dir", dir);
+            query.bindValue(":tvdbid", tvdbId);
+            query.bindValue(":url", url.isEmpty() ? "" : url);
+            query.exec();
+        } else {
+            query.prepare("INSERT INTO showsSettings(hideSpecialsInMissingEpisodes, dir, tvdbid, url) VALUES(:hide, "
+                          ":dir, :tvdbid, :url)");
+            query.bindValue(":dir", dir);
+            query.bindValue(":url", url.isEmpty() ? "" : url);
+            query.bindValue(":tvdbid", tvdbId);
+            query.bindValue(":hide", hideSpecials ? 1 : 0);
+            query.exec();
+        }
+    });
 }
 
 void Database::add(TvShowEpisode* episode, DirectoryPath path, int idShow)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
-                  "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
-    query.bindValue(":idShow", idShow);
-    query.bindValue(":path", path.toString().toUtf8());
-    query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
-    query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
-    query.exec();
-    int insertId = query.lastInsertId().toInt();
-    for (const FilePath& file : episode->files()) {
-        query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
+    const QString content = episode->nfoContent();
+    const int seasonNumber = episode->seasonNumber().toInt();
+    const int episodeNumber = episode->episodeNumber().toInt();
+    const FileList files = episode->files();
+
+    const int insertId = m_service->writeAndWait<int>([&](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
+                      "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
+        query.bindValue(":content", content.isEmpty() ? "" : content.toUtf8());
+        query.bindValue(":idShow", idShow);
+        query.bindValue(":path", path.toString().toUtf8());
+        query.bindValue(":seasonNumber", seasonNumber);
+        query.bindValue(":episodeNumber", episodeNumber);
         query.exec();
-    }
+        const int idEpisode = query.lastInsertId().toInt();
+        for (const FilePath& file : files) {
+            query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
+            query.bindValue(":idEpisode", idEpisode);
+            query.bindValue(":file", file.toString().toUtf8());
+            query.exec();
+        }
+        return idEpisode;
+    });
     episode->setDatabaseId(insertId);
 }
 
 void Database::update(TvShow* show)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE shows SET content=:content, dir=:dir WHERE idShow=:id");
-    query.bindValue(":content", show->nfoContent().isEmpty() ? "" : show->nfoContent());
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.bindValue(":id", show->databaseId());
-    query.exec();
+    const int idShow = show->databaseId();
+    const QString content = show->nfoContent();
+    const QByteArray dir = show->dir().toString().toUtf8();
+    const bool showMissingEpisodes = show->showMissingEpisodes();
+    const bool hideSpecialsInMissingEpisodes = show->hideSpecialsInMissingEpisodes();
+    const QString tvdbId = show->tvdbId().toString();
+    const QString url = show->episodeGuideUrl();
+
+    m_service->write([=](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("UPDATE shows SET content=:content, dir=:dir WHERE idShow=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":dir", dir);
+        query.bindValue(":id", idShow);
+        query.exec();
 
-    int id = showsSettingsId(show);
-    query.prepare("UPDATE showsSettings SET showMissingEpisodes=:show, hideSpecialsInMissingEpisodes=:hide, url=:url, "
-                  "tvdbid=:tvdbid WHERE idShow=:idShow");
-    query.bindValue(":show", show->showMissingEpisodes());
-    query.bindValue(":hide", show->hideSpecialsInMissingEpisodes());
-    query.bindValue(":idShow", id);
-    query.bindValue(":tvdbid", show->tvdbId().toString());
-    query.bindValue(":url", show->episodeGuideUrl().isEmpty() ? "" : show->episodeGuideUrl());
-    query.exec();
+        const int id = showsSettingsIdOf(db, dir);
+        query.prepare("UPDATE showsSettings SET showMissingEpisodes=:show, hideSpecialsInMissingEpisodes=:hide, "
+                      "url=:url, tvdbid=:tvdbid WHERE idShow=:idShow");
+        query.bindValue(":show", showMissingEpisodes);
+        query.bindValue(":hide", hideSpecialsInMissingEpisodes);
+        query.bindValue(":idShow", id);
+        query.bindValue(":tvdbid", tvdbId);
+        query.bindValue(":url", url.isEmpty() ? "" : url);
+        query.exec();
+    });
 }
 
 void Database::update(TvShowEpisode* episode)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE episodes SET content=:content WHERE idEpisode=:id");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent());
-    query.bindValue(":id", episode->databaseId());
-    query.exec();
+    const int idEpisode = episode->databaseId();
+    const QString content = episode->nfoContent();
+    QStringList files;
+    for (const FilePath& file : episode->files()) {
+        files << file.toString();
+    }
 
-    query.prepare("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
-    query.bindValue(":idEpisode", episode->databaseId());
-    query.exec();
+    m_service->write([idEpisode, content, files](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("UPDATE episodes SET content=:content WHERE idEpisode=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":id", idEpisode);
+        query.exec();
 
-    for (const FilePath& file : episode->files()) {
-        query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", episode->databaseId());
-        query.bindValue(":file", file.toString().toUtf8());
+        query.prepare("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
+        query.bindValue(":idEpisode", idEpisode);
         query.exec();
-    }
+
+        for (const QString& file : files) {
+            query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
+            query.bindValue(":idEpisode", idEpisode);
+            query.bindValue(":file", file.toUtf8());
+            query.exec();
+        }
+    });
 }
 
 int Database::showCount(DirectoryPath path)
@@ -782,57 +1279,67 @@ QVector<TvShowEpisode*> Database::episodes(int idShow)
 
 void Database::clearAllTvShows()
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM shows");
-    query.exec();
-    query.prepare("DELETE FROM episodes");
-    query.exec();
-    query.prepare("DELETE FROM episodeFiles");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='shows'");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='episodes'");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='episodeFiles'");
-    query.exec();
+    m_service->write([](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM shows");
+        query.exec();
+        query.prepare("DELETE FROM episodes");
+        query.exec();
+        query.prepare("DELETE FROM episodeFiles");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='shows'");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='episodes'");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='episodeFiles'");
+        query.exec();
+    });
 }
 
 void Database::clearTvShowsInDirectory(DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM shows WHERE path=:path");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    query.prepare("DELETE FROM episodeFiles WHERE idEpisode IN (SELECT idEpisode FROM episodes WHERE path=:path)");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    query.prepare("DELETE FROM episodes WHERE path=:path");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    const QByteArray pathValue = path.toString().toUtf8();
+    m_service->write([pathValue](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM shows WHERE path=:path");
+        query.bindValue(":path", pathValue);
+        query.exec();
+        query.prepare(
+            "DELETE FROM episodeFiles WHERE idEpisode IN (SELECT idEpisode FROM episodes WHERE path=:path)");
+        query.bindValue(":path", pathValue);
+        query.exec();
+        query.prepare("DELETE FROM episodes WHERE path=:path");
+        query.bindValue(":path", pathValue);
+        query.exec();
+    });
 }
 
 void Database::clearTvShowInDirectory(DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("SELECT idShow FROM shows WHERE dir=:dir");
-    query.bindValue(":dir", path.toString().toUtf8());
-    query.exec();
-    if (!query.next()) {
-        return;
-    }
-    int idShow = query.value(0).toInt();
+    const QByteArray dir = path.toString().toUtf8();
+    m_service->write([dir](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("SELECT idShow FROM shows WHERE dir=:dir");
+        query.bindValue(":dir", dir);
+        query.exec();
+        if (!query.next()) {
+            return;
+        }
+        const int idShow = query.value(0).toInt();
 
-    query.prepare("DELETE FROM episodeFiles WHERE idEpisode IN (SELECT idEpisode FROM episodes WHERE idShow=:idShow)");
-    query.bindValue(":idShow", idShow);
-    query.exec();
+        query.prepare(
+            "DELETE FROM episodeFiles WHERE idEpisode IN (SELECT idEpisode FROM episodes WHERE idShow=:idShow)");
+        query.bindValue(":idShow", idShow);
+        query.exec();
 
-    query.prepare("DELETE FROM shows WHERE idShow=:idShow");
-    query.bindValue(":idShow", idShow);
-    query.exec();
+        query.prepare("DELETE FROM shows WHERE idShow=:idShow");
+        query.bindValue(":idShow", idShow);
+        query.exec();
 
-    query.prepare("DELETE FROM episodes WHERE idShow=:idShow");
-    query.bindValue(":idShow", idShow);
-    query.exec();
+        query.prepare("DELETE FROM episodes WHERE idShow=:idShow");
+        query.bindValue(":idShow", idShow);
+        query.exec();
+    });
 }
 
 int Database::episodeCount()
@@ -846,67 +1353,67 @@ int Database::episodeCount()
 
 int Database::showsSettingsId(TvShow* show)
 {
-    QSqlQuery query(db());
-    query.prepare("SELECT idShow FROM showsSettings WHERE dir=:dir");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.exec();
-    if (query.next()) {
-        return query.value(0).toInt();
-    }
-
-    query.prepare("INSERT INTO showsSettings(showMissingEpisodes, hideSpecialsInMissingEpisodes, dir) VALUES(:show, "
-                  ":hide, :dir)");
-    query.bindValue(":dir", show->dir().toString().toUtf8());
-    query.bindValue(":show", 0);
-    query.bindValue(":hide", 0);
-    query.exec();
-    return query.lastInsertId().toInt();
+    const QByteArray dir = show->dir().toString().toUtf8();
+    return m_service->writeAndWait<int>([&dir](QSqlDatabase& db) { return showsSettingsIdOf(db, dir); });
 }
 
 void Database::clearEpisodeList(int showsSettingsId)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE showsEpisodes SET updated=0 WHERE idShow=:idShow");
-    query.bindValue(":idShow", showsSettingsId);
-    query.exec();
+    m_service->write([showsSettingsId](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("UPDATE showsEpisodes SET updated=0 WHERE idShow=:idShow");
+        query.bindValue(":idShow", showsSettingsId);
+        query.exec();
+    });
 }
 
 void Database::addEpisodeToShowList(TvShowEpisode* episode, int showsSettingsId, TvDbId tvdbid)
 {
     kodi::EpisodeXmlWriterGeneric xmlWriter(KodiVersion::latest(), {episode});
     const QByteArray xmlContent = xmlWriter.getEpisodeXml();
-
-    QSqlQuery query(db());
-    query.prepare("SELECT idEpisode FROM showsEpisodes WHERE tvdbid=:tvdbid");
-    query.bindValue(":tvdbid", tvdbid.toString());
-    query.exec();
-    if (query.next()) {
-        const int idEpisode = query.value(0).toInt();
-        query.prepare("UPDATE showsEpisodes SET seasonNumber=:seasonNumber, episodeNumber=:episodeNumber, updated=1, "
-                      "content=:content WHERE idEpisode=:idEpisode");
-        query.bindValue(":content", xmlContent.isEmpty() ? "" : xmlContent);
-        query.bindValue(":idEpisode", idEpisode);
-        query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
-        query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
+    const QString tvdbId = tvdbid.toString();
+    const int seasonNumber = episode->seasonNumber().toInt();
+    const int episodeNumber = episode->episodeNumber().toInt();
+    const QString title = episode->title();
+    const QString firstAired = episode->firstAired().isValid() ? episode->firstAired().toString(Qt::ISODate) : "";
+
+    m_service->write([=](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("SELECT idEpisode FROM showsEpisodes WHERE tvdbid=:tvdbid");
+        query.bindValue(":tvdbid", tvdbId);
         query.exec();
-    } else {
-        query.prepare("INSERT INTO showsEpisodes(content, idShow, seasonNumber, episodeNumber, tvdbid, updated) "
-                      "VALUES(:content, :idShow, :seasonNumber, :episodeNumber, :tvdbid, 1)");
+        if (query.next()) {
+            const int idEpisode = query.value(0).toInt();
+            query.prepare(
+                "UPDATE showsEpisodes SET seasonNumber=:seasonNumber, episodeNumber=:episodeNumber, updated=1, "
+                "content=:content, hasDetails=1, title=:title, firstAired=:firstAired "
+                "WHERE idEpisode=:idEpisode");
+            query.bindValue(":idEpisode", idEpisode);
+        } else {
+            query.prepare(
+                "INSERT INTO showsEpisodes(content, idShow, seasonNumber, episodeNumber, tvdbid, updated, "
+                "hasDetails, title, firstAired) "
+                "VALUES(:content, :idShow, :seasonNumber, :episodeNumber, :tvdbid, 1, 1, :title, :firstAired)");
+            query.bindValue(":idShow", showsSettingsId);
+            query.bindValue(":tvdbid", tvdbId);
+        }
         query.bindValue(":content", xmlContent.isEmpty() ? "" : xmlContent);
-        query.bindValue(":idShow", showsSettingsId);
-        query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
-        query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
-        query.bindValue(":tvdbid", tvdbid.toString());
+        query.bindValue(":seasonNumber", seasonNumber);
+        query.bindValue(":episodeNumber", episodeNumber);
+        query.bindValue(":title", title);
+        query.bindValue(":firstAired", firstAired);
         query.exec();
-    }
+    });
 }
 
 void Database::cleanUpEpisodeList(int showsSettingsId)
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM showsEpisodes WHERE idShow=:idShow AND updated=0");
-    query.bindValue(":idShow", showsSettingsId);
-    query.exec();
+    m_service->write([showsSettingsId](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM showsEpisodes WHERE idShow=:idShow AND updated=0");
+        query.bindValue(":idShow", showsSettingsId);
+        query.exec();
+    });
 }
 
 QVector<TvShowEpisode*> Database::showsEpisodes(TvShow* show)
@@ -914,62 +1421,124 @@ QVector<TvShowEpisode*> Database::showsEpisodes(TvShow* show)
     int id = showsSettingsId(show);
     QVector<TvShowEpisode*> episodes;
     QSqlQuery query(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM showsEpisodes WHERE idShow=:idShow");
+    // The NFO content is only needed for rows cached by older versions without list details.
+    // Light episodes load it on demand, see showsEpisodeContent().
+    query.prepare("SELECT idEpisode, seasonNumber, episodeNumber, hasDetails, title, firstAired, "
+                  "CASE WHEN hasDetails=1 THEN '' ELSE content END AS content "
+                  "FROM showsEpisodes WHERE idShow=:idShow");
     query.bindValue(":idShow", id);
     query.exec();
+    const QSqlRecord record = query.record();
+    const int idIndex = record.indexOf("idEpisode");
+    const int contentIndex = record.indexOf("content");
+    const int seasonIndex = record.indexOf("seasonNumber");
+    const int episodeIndex = record.indexOf("episodeNumber");
+    const int hasDetailsIndex = record.indexOf("hasDetails");
+    const int titleIndex = record.indexOf("title");
+    const int firstAiredIndex = record.indexOf("firstAired");
     while (query.next()) {
         auto* episode = new TvShowEpisode(QStringList(), show);
-        episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
-        episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        episode->setSeason(SeasonNumber(query.value(seasonIndex).toInt()));
+        episode->setEpisode(EpisodeNumber(query.value(episodeIndex).toInt()));
+        if (query.value(hasDetailsIndex).toInt() == 1) {
+            // Light episode: its NFO content is only loaded and parsed once it's opened.
+            episode->setTitle(query.value(titleIndex).toString());
+            episode->setFirstAired(QDate::fromString(query.value(firstAiredIndex).toString(), Qt::ISODate));
+            episode->setEpisodeListId(query.value(idIndex).toInt());
+            episode->setChanged(false);
+            episode->setHydrated(false);
+        } else {
+            episode->setNfoContent(QString::fromUtf8(query.value(contentIndex).toByteArray()));
+        }
         episodes.append(episode);
     }
     return episodes;
 }
 
-void Database::addImport(QString fileName, QString type, DirectoryPath path)
+QString Database::showsEpisodeContent(int idEpisode)
 {
-    int id = 1;
     QSqlQuery query(db());
-    query.prepare("SELECT MAX(id) FROM importCache");
+    query.prepare("SELECT content FROM showsEpisodes WHERE idEpisode=:idEpisode");
+    query.bindValue(":idEpisode", idEpisode);
     query.exec();
-    if (query.next()) {
-        id = query.value(0).toInt() + 1;
+    if (!query.next()) {
+        return QString();
     }
-
-    query.prepare("INSERT INTO importCache(id, filename, type, path) VALUES(:id, :filename, :type, :path)");
-    query.bindValue(":id", id);
-    query.bindValue(":filename", fileName);
-    query.bindValue(":type", type);
-    query.bindValue(":path", path.toString());
-    query.exec();
+    return QString::fromUtf8(query.value(0).toByteArray());
 }
 
-bool Database::guessImport(QString fileName, QString& type, QString& path)
+void Database::addImport(QString fileName, QString type, DirectoryPath path)
 {
-    qreal bestMatch = 0;
-
-    QSqlQuery query(db());
-    query.prepare("SELECT filename, type, path FROM importCache");
-    query.exec();
-    while (query.next()) {
-        qreal p = helper::similarity(fileName, query.value(query.record().indexOf("filename")).toString());
-        if (p > 0.7 && p > bestMatch) {
-            bestMatch = p;
-            type = query.value(query.record().indexOf("type")).toString();
-            path = query.value(query.record().indexOf("path")).toString();
+    const QString pathValue = path.toString();
+    m_service->write([fileName, type, pathValue](QSqlDatabase& db) {
+        int id = 1;
+        QSqlQuery query(db);
+        query.prepare("SELECT MAX(id) FROM importCache");
+        query.exec();
+        if (query.next()) {
+            id = query.value(0).toInt() + 1;
         }
-    }
 
-    return (bestMatch != 0);
+        query.prepare("INSERT INTO importCache(id, filename, type, path) VALUES(:id, :filename, :type, :path)");
+        query.bindValue(":id", id);
+        query.bindValue(":filename", fileName);
+        query.bindValue(":type", type);
+        query.bindValue(":path", pathValue);
+        query.exec();
+    });
+}
+
+void Database::guessImports(QStringList fileNames,
+    QObject* context,
+    std::function<void(QHash<QString, ImportGuess>)> callback)
+{
+    const auto guess = [fileNames](QSqlDatabase& db) {
+        QHash<QString, qreal> bestMatches;
+        QHash<QString, ImportGuess> guesses;
+        QSqlQuery query(db);
+        query.prepare("SELECT filename, type, path FROM importCache");
+        query.exec();
+        while (query.next()) {
+            const QString cachedFileName = query.value(query.record().indexOf("filename")).toString();
+            for (const QString& fileName : fileNames) {
+                const qreal p = helper::similarity(fileName, cachedFileName);
+                if (p > 0.7 && p > bestMatches.value(fileName, 0)) {
+                    bestMatches.insert(fileName, p);
+                    guesses.insert(fileName,
+                        {query.value(query.record().indexOf("type")).toString(),
+                            query.value(query.record().indexOf("path")).toString()});
+                }
+            }
+        }
+        return guesses;
+    };
+    m_service->read<QHash<QString, ImportGuess>>(guess, context, std::move(callback));
 }
 
 void Database::setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLabel)
 {
-    // no locker, as this function is called by add()
+    const DirectoryPath snapshotDir = MovieSnapshot::snapshotDir();
+    m_service->write([fileNames, colorLabel, snapshotDir](QSqlDatabase& db) {
+        // Labels are part of movie snapshots.
+        QSqlQuery query(db);
+        for (const mediaelch::FilePath& fileName : fileNames) {
+            query.prepare("SELECT idMovie FROM movieFiles WHERE file=:file");
+            query.bindValue(":file", fileName.toString().toUtf8());
+            query.exec();
+            if (query.next()) {
+                invalidateMovieSnapshot(db, snapshotDir, query.value(0).toInt());
+                break;
+            }
+        }
+
+        writeLabel(db, fileNames, colorLabel);
+    });
+}
 
+void Database::writeLabel(QSqlDatabase& db, const mediaelch::FileList& fileNames, ColorLabel colorLabel)
+{
     int color = static_cast<int>(colorLabel);
-    QSqlQuery query(db());
+    QSqlQuery query(db);
     int id = 1;
     query.prepare("SELECT MAX(idLabel) FROM labels");
     query.exec();
@@ -999,7 +1568,6 @@ void Database::setLabel(const mediaelch::FileList& fileNames, ColorLabel colorLa
 
 ColorLabel Database::getLabel(const mediaelch::FileList& fileNames)
 {
-    QMutexLocker locker(&m_mutex);
 
     if (fileNames.isEmpty()) {
         return ColorLabel::NoLabel;
@@ -1018,42 +1586,56 @@ ColorLabel Database::getLabel(const mediaelch::FileList& fileNames)
 
 void Database::clearAllArtists()
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM artists");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='artists'");
-    query.exec();
+    m_service->write([](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM artists");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='artists'");
+        query.exec();
+    });
     clearAllAlbums();
 }
 
 void Database::clearArtistsInDirectory(DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM artists WHERE path=:path");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    const QByteArray pathValue = path.toString().toUtf8();
+    m_service->write([pathValue](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM artists WHERE path=:path");
+        query.bindValue(":path", pathValue);
+        query.exec();
+    });
     clearAlbumsInDirectory(path);
 }
 
 void Database::add(Artist* artist, DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO artists(content, dir, path) "
-                  "VALUES(:content, :dir, :path)");
-    query.bindValue(":content", artist->nfoContent().isEmpty() ? "" : artist->nfoContent().toUtf8());
-    query.bindValue(":dir", artist->path().toString().toUtf8());
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    artist->setDatabaseId(query.lastInsertId().toInt());
+    const QByteArray content = artist->nfoContent().toUtf8();
+    const QByteArray dir = artist->path().toString().toUtf8();
+    const int insertId = m_service->writeAndWait<int>([&](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO artists(content, dir, path) "
+                      "VALUES(:content, :dir, :path)");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":dir", dir);
+        query.bindValue(":path", path.toString().toUtf8());
+        query.exec();
+        return query.lastInsertId().toInt();
+    });
+    artist->setDatabaseId(insertId);
 }
 
 void Database::update(Artist* artist)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE artists SET content=:content WHERE idArtist=:id");
-    query.bindValue(":content", artist->nfoContent().isEmpty() ? "" : artist->nfoContent());
-    query.bindValue(":id", artist->databaseId());
-    query.exec();
+    const int id = artist->databaseId();
+    const QString content = artist->nfoContent();
+    m_service->write([id, content](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("UPDATE artists SET content=:content WHERE idArtist=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":id", id);
+        query.exec();
+    });
 }
 
 QVector<Artist*> Database::artistsInDirectory(DirectoryPath path)
@@ -1075,41 +1657,56 @@ QVector<Artist*> Database::artistsInDirectory(DirectoryPath path)
 
 void Database::clearAllAlbums()
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM albums");
-    query.exec();
-    query.prepare("DELETE FROM sqlite_sequence WHERE name='albums'");
-    query.exec();
+    m_service->write([](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM albums");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='albums'");
+        query.exec();
+    });
 }
 
 void Database::clearAlbumsInDirectory(DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("DELETE FROM albums WHERE path=:path");
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
+    const QByteArray pathValue = path.toString().toUtf8();
+    m_service->write([pathValue](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM albums WHERE path=:path");
+        query.bindValue(":path", pathValue);
+        query.exec();
+    });
 }
 
 void Database::add(Album* album, DirectoryPath path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO albums(idArtist, content, dir, path) "
-                  "VALUES(:idArtist, :content, :dir, :path)");
-    query.bindValue(":idArtist", album->artistObj()->databaseId());
-    query.bindValue(":content", album->nfoContent().isEmpty() ? "" : album->nfoContent().toUtf8());
-    query.bindValue(":dir", album->path().toString().toUtf8());
-    query.bindValue(":path", path.toString().toUtf8());
-    query.exec();
-    album->setDatabaseId(query.lastInsertId().toInt());
+    const int idArtist = album->artistObj()->databaseId();
+    const QByteArray content = album->nfoContent().toUtf8();
+    const QByteArray dir = album->path().toString().toUtf8();
+    const int insertId = m_service->writeAndWait<int>([&](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO albums(idArtist, content, dir, path) "
+                      "VALUES(:idArtist, :content, :dir, :path)");
+        query.bindValue(":idArtist", idArtist);
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":dir", dir);
+        query.bindValue(":path", path.toString().toUtf8());
+        query.exec();
+        return query.lastInsertId().toInt();
+    });
+    album->setDatabaseId(insertId);
 }
 
 void Database::update(Album* album)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE albums SET content=:content WHERE idAlbum=:id");
-    query.bindValue(":content", album->nfoContent().isEmpty() ? "" : album->nfoContent());
-    query.bindValue(":id", album->databaseId());
-    query.exec();
+    const int id = album->databaseId();
+    const QString content = album->nfoContent();
+    m_service->write([id, content](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("UPDATE albums SET content=:content WHERE idAlbum=:id");
+        query.bindValue(":content", content.isEmpty() ? "" : content);
+        query.bindValue(":id", id);
+        query.exec();
+    });
 }
 
 QVector<Album*> Database::albums(Artist* artist)
@@ -5,11 +5,12 @@
 #include "tv_shows/TvDbId.h"
 
 #include <QDateTime>
-#include <QMutex>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
 #include <QVector>
+#include <functional>
 
 class Album;
 class Artist;
@@ -18,20 +19,41 @@ class Movie;
 class TvShow;
 class TvShowEpisode;
 
+namespace mediaelch {
+class DatabaseService;
+}
+
 class Database : public QObject
 {
     Q_OBJECT
 public:
     explicit Database(QObject* parent = nullptr);
     ~Database() override;
+    /// \brief Read-only connection of the calling thread.  It only sees committed writes,
+    ///        so callers that read their own writes have to flush() the service() first.
+    ///        Reads that shouldn't block the UI use service()->read() instead.
     QSqlDatabase db();
+    /// \brief The database's only writer and its asynchronous readers. All methods of
+    ///        this class that change the database queue their writes there.
+    mediaelch::DatabaseService* service();
+    /// \brief Writes until commit() are committed in one transaction.
     void transaction();
     void commit();
     void clearAllMovies();
     void clearMoviesInDirectory(mediaelch::DirectoryPath path);
     void add(Movie* movie, mediaelch::DirectoryPath path);
     void update(Movie* movie);
+    /// \brief Stores the movie's details that are shown in movie lists, e.g. for movies
+    ///        that were cached before these details were stored in the database.
+    void updateListColumns(Movie* movie);
+    /// \brief Parses and stores the list details of all movies that were cached before
+    ///        these details were stored, e.g. before they are read by MovieListQuery.
+    void updateMissingMovieListColumns();
+    /// \brief Loads all movies of the given directory. Movies are "light", i.e. only the
+    ///        details shown in movie lists are loaded, see MovieController::hydrate().
     QVector<Movie*> moviesInDirectory(mediaelch::DirectoryPath path);
+    /// \brief Returns the NFO content of the given movies, mapped by their database id.
+    QHash<int, QString> movieNfoContents(const QVector<int>& movieIds);
 
     void clearAllConcerts();
     void clearConcertsInDirectory(mediaelch::DirectoryPath path);
@@ -58,6 +80,8 @@ public:
     void cleanUpEpisodeList(int showsSettingsId);
     void addEpisodeToShowList(TvShowEpisode* episode, int showsSettingsId, TvDbId tvdbid);
     QVector<TvShowEpisode*> showsEpisodes(TvShow* show);
+    /// \brief NFO content of an entry of a show's episode list, see TvShowEpisode::episodeListId().
+    QString showsEpisodeContent(int idEpisode);
 
     void clearAllArtists();
     void clearArtistsInDirectory(mediaelch::DirectoryPath path);
@@ -71,14 +95,28 @@ public:
     void update(Album* album);
     QVector<Album*> albums(Artist* artist);
 
+    struct ImportGuess
+    {
+        QString type;
+        QString path;
+    };
     void addImport(QString fileName, QString type, mediaelch::DirectoryPath path);
-    bool guessImport(QString fileName, QString& type, QString& path);
+    /// \brief Guesses type and directory of the given imports by the names of previous
+    ///        imports.  The guesses are read in the background and passed to callback in
+    ///        context's thread, mapped by file name.  Files without a guess are missing.
+    void guessImports(QStringList fileNames,
+        QObject* context,
+        std::function<void(QHash<QString, ImportGuess>)> callback);
 
     void setLabel(const mediaelch::FileList& fileNames, ColorLabel color);
     ColorLabel getLabel(const mediaelch::FileList& fileNames);
 
 private:
-    QMutex m_mutex;
     QSqlDatabase* m_db;
+    mediaelch::DatabaseService* m_service = nullptr;
     void updateDbVersion(int version);
+    /// \brief Removes the snapshot of the directory that contains the given movie.
+    /// \param snapshotDir See MovieSnapshot::snapshotDir(); must be determined on the main thread.
+    static void invalidateMovieSnapshot(QSqlDatabase db, const mediaelch::DirectoryPath& snapshotDir, int idMovie);
+    static void writeLabel(QSqlDatabase& db, const mediaelch::FileList& fileNames, ColorLabel color);
 };
@@ -0,0 +1,272 @@
+#include "data/DatabaseService.h"
+
+#include "log/Log.h"
+#include "log/Perf.h"
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThreadStorage>
+
+namespace {
+
+/// Time the writer waits for further writes before committing a transaction.
+constexpr int COALESCE_INTERVAL_MS = 250;
+
+const char* const CONNECT_OPTIONS = "QSQLITE_BUSY_TIMEOUT=5000";
+const char* const READ_CONNECT_OPTIONS = "QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=5000";
+
+/// \brief Read-only connections of a single thread, mapped by their database file.
+///        Removed when their thread finishes.
+struct ReadConnections
+{
+    ~ReadConnections()
+    {
+        for (const QString& name : names) {
+            {
+                QSqlDatabase db = QSqlDatabase::database(name, false);
+                db.close();
+            }
+            QSqlDatabase::removeDatabase(name);
+        }
+    }
+
+    QHash<QString, QString> names;
+};
+
+QThreadStorage<ReadConnections*> readConnections;
+QAtomicInt readConnectionCounter;
+
+} // namespace
+
+namespace mediaelch {
+
+DatabaseService::DatabaseService(QString databaseFile, QObject* parent) :
+    QObject(parent), m_databaseFile{std::move(databaseFile)}, m_writer(*this)
+{
+    m_writer.start();
+}
+
+DatabaseService::~DatabaseService()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+        m_jobsQueued.wakeAll();
+    }
+    m_writer.wait();
+
+    // Reads in the thread pool refer to this service.
+    QMutexLocker locker(&m_mutex);
+    while (m_reads > 0) {
+        m_jobsDone.wait(&m_mutex);
+    }
+}
+
+qint64 DatabaseService::enqueue(WriteJob job)
+{
+    m_jobs.push_back(std::move(job));
+    m_jobsQueued.wakeAll();
+    return ++m_queuedTicket;
+}
+
+void DatabaseService::write(WriteJob job)
+{
+    QMutexLocker locker(&m_mutex);
+    enqueue(std::move(job));
+}
+
+void DatabaseService::writeAndWait(WriteJob job)
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 ticket = enqueue(std::move(job));
+    while (m_executedTicket < ticket) {
+        m_jobsDone.wait(&m_mutex);
+    }
+}
+
+void DatabaseService::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_jobs.isEmpty() && !m_writing) {
+        return;
+    }
+    ++m_flushRequests;
+    m_jobsQueued.wakeAll();
+    while (!m_jobs.isEmpty() || m_writing) {
+        m_jobsDone.wait(&m_mutex);
+    }
+    --m_flushRequests;
+}
+
+void DatabaseService::holdWrites()
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_holds;
+}
+
+void DatabaseService::releaseWrites()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_holds == 0) {
+        qCWarning(generic) << "[DatabaseService] Writes were released without being held";
+        return;
+    }
+    if (--m_holds == 0) {
+        m_jobsQueued.wakeAll();
+    }
+}
+
+qint64 DatabaseService::beginRead()
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_reads;
+    return m_queuedTicket;
+}
+
+void DatabaseService::endRead()
+{
+    QMutexLocker locker(&m_mutex);
+    --m_reads;
+    m_jobsDone.wakeAll();
+}
+
+void DatabaseService::waitForCommit(qint64 ticket)
+{
+    QMutexLocker locker(&m_mutex);
+    // The writer executes and commits all queued jobs before it stops.
+    while (m_committedTicket < ticket) {
+        m_jobsDone.wait(&m_mutex);
+    }
+}
+
+QSqlDatabase DatabaseService::readConnection()
+{
+    if (!readConnections.hasLocalData()) {
+        readConnections.setLocalData(new ReadConnections);
+    }
+    ReadConnections* connections = readConnections.localData();
+    if (!connections->names.contains(m_databaseFile)) {
+        const QString name = QStringLiteral("mediaDbRead-%1").arg(readConnectionCounter.fetchAndAddRelaxed(1));
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+        db.setDatabaseName(m_databaseFile);
+        db.setConnectOptions(READ_CONNECT_OPTIONS);
+        if (!db.open()) {
+            qCWarning(generic) << "[DatabaseService] Could not open read connection:" << db.lastError().text();
+        }
+        connections->names.insert(m_databaseFile, name);
+    }
+    return QSqlDatabase::database(connections->names.value(m_databaseFile));
+}
+
+qint64 DatabaseService::transactionCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_transactionCount;
+}
+
+qint64 DatabaseService::writeCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_writeCount;
+}
+
+bool DatabaseService::shouldCommit(qint64 elapsedMs) const
+{
+    // Give further writes the chance to be part of the same transaction,
+    // unless someone is waiting for them.
+    return m_stop || m_flushRequests > 0 || (m_holds == 0 && elapsedMs >= COALESCE_INTERVAL_MS);
+}
+
+void DatabaseService::runWriter()
+{
+    const QString connectionName = QStringLiteral("mediaDbWriter");
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(m_databaseFile);
+        db.setConnectOptions(CONNECT_OPTIONS);
+        if (!db.open()) {
+            qCWarning(generic) << "[DatabaseService] Could not open write connection:" << db.lastError().text();
+        }
+        {
+            // The database is a cache, so durability is less important than speed.
+            QSqlQuery pragma(db);
+            pragma.exec("PRAGMA synchronous=0;");
+        }
+
+        QMutexLocker locker(&m_mutex);
+        while (true) {
+            while (m_jobs.isEmpty() && !m_stop) {
+                m_jobsQueued.wait(&m_mutex);
+            }
+            if (m_jobs.isEmpty()) {
+                break; // stopped
+            }
+
+            m_writing = true;
+            locker.unlock();
+            db.transaction();
+            locker.relock();
+
+            // Jobs are executed as soon as they are queued, so that writeAndWait() doesn't
+            // have to wait for the commit.  The transaction is committed after the coalesce
+            // interval, unless writes are held.
+            QElapsedTimer timer;
+            timer.start();
+            qint64 jobCount = 0;
+            while (!m_jobs.isEmpty() || !shouldCommit(timer.elapsed())) {
+                if (m_jobs.isEmpty()) {
+                    if (m_holds > 0) {
+                        m_jobsQueued.wait(&m_mutex);
+                    } else {
+                        // The interval may have run out since the loop condition was checked.
+                        // A negative timeout would wait forever, so commit right away instead.
+                        const qint64 remainingMs = qMax<qint64>(0, COALESCE_INTERVAL_MS - timer.elapsed());
+                        if (remainingMs == 0) {
+                            break;
+                        }
+                        m_jobsQueued.wait(&m_mutex, static_cast<unsigned long>(remainingMs));
+                    }
+                    continue;
+                }
+                QVector<WriteJob> jobs;
+                jobs.swap(m_jobs);
+                locker.unlock();
+                {
+                    perf::ScopedTimer jobsTimer("db.write.jobs");
+                    for (WriteJob& job : jobs) {
+                        job(db);
+                    }
+                }
+                locker.relock();
+                jobCount += jobs.size();
+                m_executedTicket += jobs.size();
+                m_jobsDone.wakeAll();
+            }
+
+            locker.unlock();
+            {
+                perf::ScopedTimer commitTimer("db.write.commit");
+                if (!db.commit()) {
+                    qCWarning(generic) << "[DatabaseService] Could not commit" << jobCount
+                                       << "writes:" << db.lastError().text();
+                }
+            }
+            locker.relock();
+
+            m_writing = false;
+            m_committedTicket = m_executedTicket;
+            ++m_transactionCount;
+            m_writeCount += jobCount;
+            m_jobsDone.wakeAll();
+        }
+
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+} // namespace mediaelch
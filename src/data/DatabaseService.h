@@ -0,0 +1,167 @@
+#pragma once
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QMutex>
+#include <QObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtConcurrent>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Asynchronous access to the cache database.
+///
+/// All writes are queued and executed by a dedicated thread that owns the only
+/// connection that may write to the database.  Writes that are queued shortly after
+/// each other are executed in one transaction.  Reads run on the global thread pool,
+/// each pool thread using its own read-only connection.  The database is expected to
+/// be in WAL mode so that readers and the writer don't block each other.
+///
+/// writeAndWait() returns once its job was executed, e.g. to get the id of an inserted
+/// row.  The job's transaction may still be open, so other connections only see its
+/// changes after flush().  Reads wait until the writes that were queued before them
+/// are committed, but don't commit them early.
+///
+/// \par Example
+/// \code{cpp}
+///   service.write([idMovie](QSqlDatabase& db) {
+///       QSqlQuery query(db);
+///       query.prepare("DELETE FROM movies WHERE idMovie=:idMovie");
+///       query.bindValue(":idMovie", idMovie);
+///       query.exec();
+///   });
+///   const int id = service.writeAndWait<int>([](QSqlDatabase& db) {
+///       QSqlQuery query(db);
+///       query.exec("INSERT INTO importCache(filename, type, path) VALUES('a', 'movie', '/')");
+///       return query.lastInsertId().toInt();
+///   });
+///   service.read<int>(countMovies, this, [](int count) { qCDebug(generic) << count; });
+/// \endcode
+class DatabaseService : public QObject
+{
+    Q_OBJECT
+
+public:
+    using WriteJob = std::function<void(QSqlDatabase&)>;
+
+    explicit DatabaseService(QString databaseFile, QObject* parent = nullptr);
+    /// \brief Commits all queued writes and stops the writer thread.
+    ~DatabaseService() override;
+
+    /// \brief Queues the given job. It is executed on the writer thread inside a transaction.
+    void write(WriteJob job);
+    /// \brief Queues the given job and blocks until it was executed, but not necessarily
+    ///        committed.  Must not be called from a write job.
+    void writeAndWait(WriteJob job);
+    /// \brief Like writeAndWait() and returns the job's result.
+    template<typename T>
+    T writeAndWait(std::function<T(QSqlDatabase&)> job);
+    /// \brief Blocks until all queued writes are committed.
+    void flush();
+    /// \brief Delays committing queued writes until releaseWrites() is called, so that
+    ///        writes of a long running batch end up in a single transaction.
+    ///        flush() still commits immediately.  Calls may be nested.
+    void holdWrites();
+    void releaseWrites();
+
+    /// \brief Runs the given job on a read-only connection in the global thread pool.
+    ///        Don't wait for the result while writes are held, see holdWrites().
+    template<typename T>
+    QFuture<T> read(std::function<T(QSqlDatabase&)> job);
+    /// \brief Runs the given job like read() and calls callback with its result in the
+    ///        context object's thread.  The callback isn't called if context is destroyed.
+    template<typename T>
+    void read(std::function<T(QSqlDatabase&)> job, QObject* context, std::function<void(T)> callback);
+
+    /// \brief Read-only connection of the calling thread. Opened on first use and
+    ///        closed when the thread finishes.
+    QSqlDatabase readConnection();
+
+    /// \brief Number of committed transactions and of the write jobs that they contained.
+    qint64 transactionCount() const;
+    qint64 writeCount() const;
+
+private:
+    class WriterThread : public QThread
+    {
+    public:
+        explicit WriterThread(DatabaseService& service) : m_service{service} {}
+        void run() override { m_service.runWriter(); }
+
+    private:
+        DatabaseService& m_service;
+    };
+
+    /// \brief Queues the job and returns its ticket, see m_executedTicket. Requires m_mutex.
+    qint64 enqueue(WriteJob job);
+    /// \brief Registers a read and returns the ticket of the last queued job.
+    ///        The destructor waits for all reads that haven't called endRead() yet.
+    qint64 beginRead();
+    void endRead();
+    /// \brief Blocks until the job with the given ticket and all jobs before it are committed.
+    void waitForCommit(qint64 ticket);
+    void runWriter();
+    /// \brief Whether the writer should commit its open transaction. Requires m_mutex.
+    bool shouldCommit(qint64 elapsedMs) const;
+
+private:
+    const QString m_databaseFile;
+    WriterThread m_writer;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_jobsQueued;
+    QWaitCondition m_jobsDone;
+    QVector<WriteJob> m_jobs;
+    /// Tickets of the last queued, the last executed and the last committed job.
+    qint64 m_queuedTicket = 0;
+    qint64 m_executedTicket = 0;
+    qint64 m_committedTicket = 0;
+    /// A transaction is open, i.e. executed jobs may not be committed yet.
+    bool m_writing = false;
+    bool m_stop = false;
+    int m_flushRequests = 0;
+    int m_holds = 0;
+    int m_reads = 0;
+    qint64 m_transactionCount = 0;
+    qint64 m_writeCount = 0;
+};
+
+template<typename T>
+T DatabaseService::writeAndWait(std::function<T(QSqlDatabase&)> job)
+{
+    T result{};
+    // The job is executed before this function returns, so it may refer to locals.
+    writeAndWait([&result, &job](QSqlDatabase& db) { result = job(db); });
+    return result;
+}
+
+template<typename T>
+QFuture<T> DatabaseService::read(std::function<T(QSqlDatabase&)> job)
+{
+    const qint64 ticket = beginRead();
+    return QtConcurrent::run([this, job, ticket]() {
+        waitForCommit(ticket);
+        QSqlDatabase db = readConnection();
+        T result = job(db);
+        endRead();
+        return result;
+    });
+}
+
+template<typename T>
+void DatabaseService::read(std::function<T(QSqlDatabase&)> job, QObject* context, std::function<void(T)> callback)
+{
+    auto* watcher = new QFutureWatcher<T>(context);
+    connect(watcher, &QFutureWatcher<T>::finished, context, [watcher, callback]() {
+        callback(watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(read(std::move(job)));
+}
+
+} // namespace mediaelch
@@ -8,6 +8,7 @@
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "log/Log.h"
+#include "log/Perf.h"
 #include "settings/Settings.h"
 
 ImageCache::ImageCache(QObject* parent) : QObject(parent)
@@ -62,6 +63,7 @@ QImage ImageCache::image(mediaelch::FilePath path, int width, int height, int& o
     }
 
     if (update) {
+        mediaelch::perf::count("imageCache.misses");
         QImage origImg = helper::getImage(path);
         origWidth = origImg.width();
         origHeight = origImg.height();
@@ -77,6 +79,7 @@ QImage ImageCache::image(mediaelch::FilePath path, int width, int height, int& o
         return img;
     }
 
+    mediaelch::perf::count("imageCache.hits");
     return helper::getImage(mediaelch::FilePath(m_cacheDir.filePath(files.first())));
 }
 
@@ -265,8 +265,9 @@ QString MediaInfoFile::audioCodec(int streamIndex) const
         }
     }
 
-    if (Settings::instance()->advanced()->audioCodecMappings().contains(audioCodec)) {
-        return Settings::instance()->advanced()->audioCodecMappings().value(audioCodec);
+    const QHash<QString, QString>& audioCodecMappings = Settings::instance()->advanced()->audioCodecMappings();
+    if (audioCodecMappings.contains(audioCodec)) {
+        return audioCodecMappings.value(audioCodec);
     }
     return audioCodec;
 }
@@ -311,8 +312,9 @@ QString MediaInfoFile::parseVideoFormat(QString format, QString version) const
     if (!format.isEmpty() && format == "mpeg video") {
         format = (version.toLower() == "version 2") ? "mpeg2" : "mpeg";
     }
-    if (Settings::instance()->advanced()->videoCodecMappings().contains(format)) {
-        return Settings::instance()->advanced()->videoCodecMappings().value(format);
+    const QHash<QString, QString>& videoCodecMappings = Settings::instance()->advanced()->videoCodecMappings();
+    if (videoCodecMappings.contains(format)) {
+        return videoCodecMappings.value(format);
     }
     return format.toLower();
 }
@@ -0,0 +1,259 @@
+#include "data/MovieListQuery.h"
+
+#include <QRegularExpression>
+#include <QSqlError>
+#include <QSqlQuery>
+
+namespace mediaelch {
+
+const QVector<MovieListQuery::Field>& MovieListQuery::availableFields()
+{
+    static const QVector<Field> fields{
+        {"id", "M.idMovie", FieldType::Integer},
+        {"title", "M.title", FieldType::Text},
+        {"sortTitle", "M.sortTitle", FieldType::Text},
+        {"originalTitle", "M.originalTitle", FieldType::Text},
+        {"year", "CAST(substr(M.released, 1, 4) AS INTEGER)", FieldType::Integer},
+        {"released", "M.released", FieldType::Text},
+        {"imdbId", "M.imdbId", FieldType::Text},
+        {"tmdbId", "M.tmdbId", FieldType::Text},
+        {"certification", "M.certification", FieldType::Text},
+        {"director", "M.director", FieldType::Text},
+        {"set", "M.setName", FieldType::Text},
+        {"genres", "M.genres", FieldType::List},
+        {"studios", "M.studios", FieldType::List},
+        {"countries", "M.countries", FieldType::List},
+        {"tags", "M.tags", FieldType::List},
+        {"rating", "M.rating", FieldType::Real},
+        {"votes", "M.votes", FieldType::Integer},
+        {"playcount", "M.playcount", FieldType::Integer},
+        {"lastPlayed", "M.lastPlayed", FieldType::Text},
+        {"trailer", "M.trailer", FieldType::Text},
+        {"videoCodec", "M.videoCodec", FieldType::Text},
+        {"videoWidth", "M.videoWidth", FieldType::Integer},
+        {"audioCodecs", "M.audioCodecs", FieldType::List},
+        {"audioChannels", "M.audioChannels", FieldType::List},
+        {"subtitleLanguages", "M.subtitleLanguages", FieldType::List},
+        {"poster", "M.hasPoster", FieldType::Boolean},
+        {"backdrop", "M.hasBackdrop", FieldType::Boolean},
+        {"directory", "M.path", FieldType::Text, true},
+        {"files",
+            QStringLiteral("(SELECT group_concat(MF.file, '%1') FROM movieFiles MF WHERE MF.idMovie=M.idMovie)")
+                .arg(listSeparator()),
+            FieldType::List,
+            true},
+    };
+    return fields;
+}
+
+QStringList MovieListQuery::availableFieldNames()
+{
+    QStringList names;
+    for (const Field& field : availableFields()) {
+        names << field.name;
+    }
+    return names;
+}
+
+const MovieListQuery::Field* MovieListQuery::findField(const QString& name)
+{
+    for (const Field& field : availableFields()) {
+        if (field.name.compare(name, Qt::CaseInsensitive) == 0) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+MovieListQuery::MovieListQuery()
+{
+    setFields({"id", "title", "year", "imdbId"});
+}
+
+bool MovieListQuery::setFields(const QStringList& fieldNames)
+{
+    QVector<const Field*> fields;
+    for (const QString& name : fieldNames) {
+        const Field* field = findField(name.trimmed());
+        if (field == nullptr) {
+            m_error = QStringLiteral("Unknown field: %1").arg(name);
+            return false;
+        }
+        fields << field;
+    }
+    if (fields.isEmpty()) {
+        m_error = QStringLiteral("No fields selected");
+        return false;
+    }
+    m_fields = fields;
+    return true;
+}
+
+QStringList MovieListQuery::fieldNames() const
+{
+    QStringList names;
+    for (const Field* field : m_fields) {
+        names << field->name;
+    }
+    return names;
+}
+
+bool MovieListQuery::addFilter(const QString& filter)
+{
+    static const QRegularExpression filterRx(R"(^\s*(\w+)\s*(>=|<=|!=|=|~|>|<)(.*)$)");
+    const QRegularExpressionMatch match = filterRx.match(filter);
+    if (!match.hasMatch()) {
+        m_error = QStringLiteral("Invalid filter: %1").arg(filter);
+        return false;
+    }
+    const Field* field = findField(match.captured(1));
+    if (field == nullptr) {
+        m_error = QStringLiteral("Unknown field in filter: %1").arg(filter);
+        return false;
+    }
+    const QString op = match.captured(2);
+    const QString value = match.captured(3).trimmed();
+    const QString placeholder = QStringLiteral(":f%1").arg(m_filters.size());
+
+    Filter result;
+    switch (field->type) {
+    case FieldType::List:
+        if (op == "=" || op == "!=") {
+            // Compare whole elements: "%§%Drama%§%" must be part of "%§%Action%§%Drama%§%".
+            // The separator contains "%" itself, which must not be a wildcard.
+            result.condition = QStringLiteral("('%1' || %2 || '%1') LIKE %3 ESCAPE '\\'")
+                                   .arg(listSeparator(), field->sql, placeholder);
+            const QString separator = escapeLike(listSeparator());
+            result.value = "%" + separator + escapeLike(value) + separator + "%";
+            if (op == "!=") {
+                result.condition = "NOT " + result.condition;
+            }
+        } else if (op == "~") {
+            result.condition = QStringLiteral("%1 LIKE %2 ESCAPE '\\'").arg(field->sql, placeholder);
+            result.value = "%" + escapeLike(value) + "%";
+        } else {
+            m_error = QStringLiteral("Lists can only be filtered with =, != or ~: %1").arg(filter);
+            return false;
+        }
+        break;
+    case FieldType::Text:
+        if (op == "~") {
+            result.condition = QStringLiteral("%1 LIKE %2 ESCAPE '\\'").arg(field->sql, placeholder);
+            result.value = "%" + escapeLike(value) + "%";
+        } else {
+            result.condition = QStringLiteral("%1 %2 %3").arg(field->sql, op == "!=" ? "<>" : op, placeholder);
+            if (!field->utf8Blob && (op == "=" || op == "!=")) {
+                result.condition += " COLLATE NOCASE";
+            }
+            result.value = value;
+        }
+        if (field->utf8Blob && op != "~") {
+            result.value = value.toUtf8();
+        }
+        break;
+    case FieldType::Integer:
+    case FieldType::Real:
+    case FieldType::Boolean: {
+        bool ok = false;
+        double number = value.toDouble(&ok);
+        if (field->type == FieldType::Boolean && !ok) {
+            const QString lower = value.toLower();
+            ok = (lower == "true" || lower == "yes" || lower == "false" || lower == "no");
+            number = (lower == "true" || lower == "yes") ? 1 : 0;
+        }
+        if (!ok || op == "~") {
+            m_error = QStringLiteral("Invalid number filter: %1").arg(filter);
+            return false;
+        }
+        result.condition = QStringLiteral("%1 %2 %3").arg(field->sql, op == "!=" ? "<>" : op, placeholder);
+        result.value = number;
+        break;
+    }
+    }
+    m_filters << result;
+    return true;
+}
+
+QString MovieListQuery::sql() const
+{
+    QStringList columns;
+    for (const Field* field : m_fields) {
+        columns << field->sql;
+    }
+    QStringList conditions;
+    if (!m_directory.isEmpty()) {
+        conditions << "M.path=:path";
+    }
+    for (const Filter& filter : m_filters) {
+        conditions << filter.condition;
+    }
+
+    QString sql = QStringLiteral("SELECT %1 FROM movies M").arg(columns.join(", "));
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    // Rows are returned in the order of the primary key, so no sorting is needed.
+    sql += " ORDER BY M.idMovie";
+    if (m_limit > 0) {
+        sql += QStringLiteral(" LIMIT %1").arg(m_limit);
+    }
+    return sql;
+}
+
+bool MovieListQuery::exec(QSqlDatabase db, const RowCallback& callback)
+{
+    QSqlQuery query(db);
+    // Rows are only read once. Don't let Qt cache them.
+    query.setForwardOnly(true);
+    if (!query.prepare(sql())) {
+        m_error = query.lastError().text();
+        return false;
+    }
+    if (!m_directory.isEmpty()) {
+        query.bindValue(":path", m_directory.toUtf8());
+    }
+    for (int i = 0; i < m_filters.size(); ++i) {
+        query.bindValue(QStringLiteral(":f%1").arg(i), m_filters[i].value);
+    }
+    if (!query.exec()) {
+        m_error = query.lastError().text();
+        return false;
+    }
+
+    QVector<QVariant> values(m_fields.size());
+    while (query.next()) {
+        for (int i = 0; i < m_fields.size(); ++i) {
+            values[i] = readValue(*m_fields[i], query.value(i));
+        }
+        if (!callback(values)) {
+            break;
+        }
+    }
+    return true;
+}
+
+QString MovieListQuery::escapeLike(QString text)
+{
+    text.replace("\\", "\\\\");
+    text.replace("%", "\\%");
+    text.replace("_", "\\_");
+    return text;
+}
+
+QVariant MovieListQuery::readValue(const Field& field, const QVariant& value)
+{
+    switch (field.type) {
+    case FieldType::Integer: return value.toLongLong();
+    case FieldType::Real: return value.toDouble();
+    case FieldType::Boolean: return value.toInt() != 0;
+    case FieldType::List: {
+        const QString text = QString::fromUtf8(value.toByteArray());
+        return text.isEmpty() ? QStringList{} : text.split(listSeparator());
+    }
+    case FieldType::Text: break;
+    }
+    // Text is read as bytes, because paths are stored as UTF-8 blobs.
+    return QString::fromUtf8(value.toByteArray());
+}
+
+} // namespace mediaelch
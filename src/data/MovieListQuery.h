@@ -0,0 +1,109 @@
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Reads movies' list details straight from the database, one row at a time.
+///
+/// The database stores the details that are shown in movie lists in columns of their
+/// own, see Database::updateListColumns(). This query selects only the columns of the
+/// requested fields and translates filters into the WHERE clause, so that SQLite skips
+/// non-matching movies. Rows are passed to a callback as soon as they are read; no
+/// Movie objects are created and nothing is kept in memory.
+///
+/// Movies cached by older versions have no list columns yet. Call
+/// Database::updateMissingMovieListColumns() before running the query.
+///
+/// \par Example
+/// \code{cpp}
+///   MovieListQuery query;
+///   query.setFields({"title", "year", "genres"});
+///   query.addFilter("year>=2000");
+///   query.addFilter("genres=Drama");
+///   query.exec(database->db(), [](const QVector<QVariant>& values) {
+///       qCDebug(generic) << values;
+///       return true;
+///   });
+/// \endcode
+class MovieListQuery
+{
+public:
+    enum class FieldType
+    {
+        Text,
+        Integer,
+        Real,
+        Boolean,
+        /// Stored as one string, see listSeparator(). Values are QStringLists.
+        List
+    };
+
+    struct Field
+    {
+        QString name;
+        /// SQL expression for the field; "M" is the movies table.
+        QString sql;
+        FieldType type;
+        /// Paths are stored as UTF-8 encoded blobs and must be compared as such.
+        bool utf8Blob = false;
+    };
+
+    /// \brief Called for each row with the values of the selected fields, in order.
+    ///        Return false to stop reading further rows.
+    using RowCallback = std::function<bool(const QVector<QVariant>& values)>;
+
+    /// \brief Separator of list columns' values, e.g. of genres.
+    static QString listSeparator() { return QStringLiteral("%§%"); }
+    static const QVector<Field>& availableFields();
+    static QStringList availableFieldNames();
+
+public:
+    MovieListQuery();
+
+    /// \brief Selects the given fields. Returns false if a field is unknown.
+    bool setFields(const QStringList& fieldNames);
+    QStringList fieldNames() const;
+    /// \brief Adds a filter such as "title~star", "genres=Drama" or "year>=2000".
+    ///
+    /// Operators are "=" and "!=" (case-insensitive for text, element-wise for lists),
+    /// "~" (contains) as well as "<", "<=", ">" and ">=" for numbers and text.
+    /// Returns false if the filter is invalid.
+    bool addFilter(const QString& filter);
+    /// \brief Only read movies in the given movie directory, as stored in the database.
+    void setDirectory(const QString& directory) { m_directory = directory; }
+    /// \brief Maximum number of rows. Zero means no limit.
+    void setLimit(int limit) { m_limit = qMax(0, limit); }
+
+    /// \brief SELECT statement of this query, with placeholders for the filters' values.
+    QString sql() const;
+    /// \brief Runs the query. Returns false on errors, see errorString().
+    bool exec(QSqlDatabase db, const RowCallback& callback);
+
+    QString errorString() const { return m_error; }
+
+private:
+    struct Filter
+    {
+        QString condition;
+        QVariant value;
+    };
+
+    static const Field* findField(const QString& name);
+    static QString escapeLike(QString text);
+    static QVariant readValue(const Field& field, const QVariant& value);
+
+private:
+    QVector<const Field*> m_fields;
+    QVector<Filter> m_filters;
+    QString m_directory;
+    int m_limit = 0;
+    QString m_error;
+};
+
+} // namespace mediaelch
@@ -2,6 +2,7 @@
 
 #include "data/MediaInfoFile.h"
 #include "log/Log.h"
+#include "log/Perf.h"
 
 #include <QApplication>
 #include <QDir>
@@ -114,6 +115,7 @@ void StreamDetails::loadStreamDetails()
 
 void StreamDetails::loadWithLibrary()
 {
+    mediaelch::perf::ScopedTimer timer("mediainfo.load");
     mediaelch::FilePath filePath = m_files.first();
     if (m_files.size() == 1 && filePath.toString().endsWith("index.bdmv")) {
         QFileInfo fi(filePath.toString());
@@ -0,0 +1,83 @@
+#include "data/StringPool.h"
+
+#include <QMutexLocker>
+
+namespace mediaelch {
+
+constexpr int StringPool::MIN_SWEEP_SIZE;
+
+StringPool& StringPool::global()
+{
+    static StringPool pool;
+    return pool;
+}
+
+QString StringPool::intern(const QString& str)
+{
+    if (str.isEmpty()) {
+        return str;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    ++m_lookups;
+    auto it = m_strings.constFind(str);
+    if (it != m_strings.constEnd()) {
+        ++m_hits;
+        return *it;
+    }
+    if (m_strings.size() >= m_sweepSize) {
+        // Amortized: The pool has to double in size before it is swept again.
+        releaseUnusedLocked();
+        m_sweepSize = qMax(MIN_SWEEP_SIZE, 2 * static_cast<int>(m_strings.size()));
+    }
+    return *m_strings.insert(str);
+}
+
+int StringPool::releaseUnused()
+{
+    QMutexLocker locker(&m_mutex);
+    return releaseUnusedLocked();
+}
+
+int StringPool::releaseUnusedLocked()
+{
+    // A detached string is only referenced by the pool.  Other references can only
+    // be created through intern(), which is blocked by the mutex.
+    int removed = 0;
+    for (auto it = m_strings.begin(); it != m_strings.end();) {
+        if (it->isDetached()) {
+            it = m_strings.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    m_evicted += removed;
+    return removed;
+}
+
+StringPool::Statistics StringPool::statistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    Statistics stats;
+    stats.strings = m_strings.size();
+    for (const QString& str : m_strings) {
+        stats.bytes += str.size() * static_cast<qint64>(sizeof(QChar));
+    }
+    stats.lookups = m_lookups;
+    stats.hits = m_hits;
+    stats.evicted = m_evicted;
+    return stats;
+}
+
+void StringPool::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_strings.clear();
+    m_sweepSize = MIN_SWEEP_SIZE;
+    m_lookups = 0;
+    m_hits = 0;
+    m_evicted = 0;
+}
+
+} // namespace mediaelch
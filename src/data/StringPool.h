@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+namespace mediaelch {
+
+/// \brief Thread-safe pool for strings that are repeated across many media items,
+///        e.g. genres, studios or actor names.
+///
+/// QString is implicitly shared: interning a string returns the pooled copy, which
+/// shares its data with all other interned copies.  Each distinct string is therefore
+/// only stored once, no matter how many movies or episodes reference it.
+/// Strings that are only referenced by the pool itself are evicted once the pool
+/// has doubled in size since the last eviction, or explicitly by releaseUnused().
+///
+/// \par Example
+/// \code{cpp}
+///   QString genre = StringPool::global().intern(genreFromNfo);
+/// \endcode
+class StringPool
+{
+public:
+    struct Statistics
+    {
+        /// Number of distinct strings in the pool.
+        int strings = 0;
+        /// Bytes used by the pooled strings' data.
+        qint64 bytes = 0;
+        /// Number of intern() calls and how many of them returned an existing string.
+        qint64 lookups = 0;
+        qint64 hits = 0;
+        /// Number of strings that were evicted because nothing referenced them anymore.
+        qint64 evicted = 0;
+    };
+
+public:
+    StringPool() = default;
+
+    /// \brief Pool that is shared by all media items.
+    static StringPool& global();
+
+    /// \brief Returns a copy of the given string that shares its data with all other
+    ///        interned copies of an equal string.
+    QString intern(const QString& str);
+
+    Statistics statistics() const;
+
+    /// \brief Removes all strings that are not referenced outside of the pool anymore,
+    ///        e.g. genres of movies that were deleted.
+    /// \returns Number of removed strings.
+    int releaseUnused();
+
+    /// \brief Removes all strings from the pool. Strings that were interned before
+    ///        stay valid but won't share their data with strings interned afterwards.
+    void clear();
+
+private:
+    int releaseUnusedLocked();
+
+private:
+    /// Pools smaller than this are never swept automatically.
+    static constexpr int MIN_SWEEP_SIZE = 1024;
+
+    mutable QMutex m_mutex;
+    QSet<QString> m_strings;
+    int m_sweepSize = MIN_SWEEP_SIZE;
+    qint64 m_lookups = 0;
+    qint64 m_hits = 0;
+    qint64 m_evicted = 0;
+};
+
+} // namespace mediaelch
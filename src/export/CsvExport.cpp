@@ -8,6 +8,9 @@
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 
+#include <QThread>
+#include <QtConcurrent>
+
 static QString ratingsToString(const Ratings& ratings)
 {
     QStringList out;
@@ -96,6 +99,456 @@ static QString getStreamDetails(const StreamDetails* streamDetails, StreamDetail
     return values.join(", ");
 }
 
+namespace {
+
+using Format = mediaelch::CsvMediaExport::Format;
+
+/// Row of the episode export. Show columns are taken from the episode's TV show.
+struct EpisodeRow
+{
+    TvShow* show;
+    TvShowEpisode* episode;
+};
+
+/// Row of the album export. Artist columns are taken from the album's artist.
+struct AlbumRow
+{
+    Artist* artist;
+    Album* album;
+};
+
+template<class Row>
+using Accessor = std::function<QString(const Row& row)>;
+
+template<class Row>
+struct Column
+{
+    QString name;
+    Accessor<Row> value;
+};
+
+/// Number of rows that are formatted by one task of a parallel export.
+constexpr int rowsPerChunk = 1000;
+
+void appendJsonString(QString& out, const QString& text)
+{
+    out += '"';
+    for (const QChar c : text) {
+        switch (c.unicode()) {
+        case '"': out += QLatin1String("\\\""); break;
+        case '\\': out += QLatin1String("\\\\"); break;
+        case '\n': out += QLatin1String("\\n"); break;
+        case '\r': out += QLatin1String("\\r"); break;
+        case '\t': out += QLatin1String("\\t"); break;
+        default:
+            if (c.unicode() < 0x20) {
+                out += QStringLiteral("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+/// \brief Formats rows of the given columns as CSV or JSON Lines.
+/// Formatting only reads the rows, so one formatter can be used by several threads.
+template<class Row>
+class RowFormatter
+{
+public:
+    RowFormatter(QVector<Column<Row>> columns, Format format, QString separator, QString replacement) :
+        m_columns{std::move(columns)},
+        m_format{format},
+        m_separator{std::move(separator)},
+        m_replacement{std::move(replacement)}
+    {
+        for (const Column<Row>& column : asConst(m_columns)) {
+            QString key;
+            appendJsonString(key, column.name);
+            m_jsonKeys << key + ':';
+        }
+    }
+
+    void appendHeader(QString& out) const
+    {
+        if (m_format != Format::Csv || m_columns.isEmpty()) {
+            return;
+        }
+        for (int i = 0; i < m_columns.size(); ++i) {
+            if (i > 0) {
+                out += m_separator;
+            }
+            appendCsvCell(out, m_columns[i].name);
+        }
+        out += '\n';
+    }
+
+    void appendRows(QString& out, const Row* begin, const Row* end) const
+    {
+        if (m_columns.isEmpty()) {
+            return;
+        }
+        for (const Row* row = begin; row != end; ++row) {
+            if (m_format == Format::Csv) {
+                appendCsvRow(out, *row);
+            } else {
+                appendJsonRow(out, *row);
+            }
+        }
+    }
+
+private:
+    void appendCsvRow(QString& out, const Row& row) const
+    {
+        for (int i = 0; i < m_columns.size(); ++i) {
+            if (i > 0) {
+                out += m_separator;
+            }
+            appendCsvCell(out, m_columns[i].value(row));
+        }
+        out += '\n';
+    }
+
+    void appendJsonRow(QString& out, const Row& row) const
+    {
+        out += '{';
+        for (int i = 0; i < m_columns.size(); ++i) {
+            if (i > 0) {
+                out += ',';
+            }
+            out += m_jsonKeys[i];
+            appendJsonString(out, m_columns[i].value(row));
+        }
+        out += QLatin1String("}\n");
+    }
+
+    void appendCsvCell(QString& out, const QString& text) const
+    {
+        if (!text.contains(m_separator) && !text.contains('\n') && !text.contains('\r')) {
+            out += text;
+            return;
+        }
+        out += QString(text)
+                   .replace(m_separator, m_replacement)
+                   .replace("\r\n", "\\n")
+                   .replace("\n", "\\n")
+                   .replace("\r", "\\n");
+    }
+
+private:
+    QVector<Column<Row>> m_columns;
+    /// Escaped JSON keys including the colon, e.g. `"movie_title":`.
+    QVector<QString> m_jsonKeys;
+    Format m_format;
+    QString m_separator;
+    QString m_replacement;
+};
+
+/// \brief Resolves the selected fields into columns once per export.
+template<class Row, class Field>
+QVector<Column<Row>> columnsOf(const QVector<Field>& fields, QString (*name)(Field), Accessor<Row> (*value)(Field))
+{
+    QVector<Column<Row>> columns;
+    for (const Field field : fields) {
+        columns << Column<Row>{name(field), value(field)};
+    }
+    return columns;
+}
+
+/// \brief Group ends for exports that call their callback after each row.
+QVector<int> eachRow(int rowCount)
+{
+    QVector<int> ends;
+    ends.reserve(rowCount);
+    for (int i = 1; i <= rowCount; ++i) {
+        ends << i;
+    }
+    return ends;
+}
+
+/// \brief Writes the header and all rows to the stream.
+///
+/// Exports with more than one chunk are formatted in parallel, a few chunks at a time
+/// so that memory usage stays bounded. The chunks are written in order and the callback
+/// is only called in the calling thread.
+///
+/// \param groupEnds Number of rows up to and including each group of rows, e.g. each
+///                  TV show of an episode export. The callback is called once per group
+///                  after its last row has been written.
+template<class Row>
+void writeRows(QTextStream& out,
+    const RowFormatter<Row>& formatter,
+    const QVector<Row>& rows,
+    const QVector<int>& groupEnds,
+    const std::function<void()>& callback)
+{
+    int group = 0;
+    const auto rowsWritten = [&](int count) {
+        for (; group < groupEnds.size() && groupEnds[group] <= count; ++group) {
+            callback();
+        }
+    };
+
+    QString header;
+    formatter.appendHeader(header);
+    out << header;
+
+    std::function<QString(int chunk)> formatChunk = [&formatter, &rows](int chunk) -> QString {
+        const int first = chunk * rowsPerChunk;
+        const int last = qMin(first + rowsPerChunk, rows.size());
+        QString text;
+        formatter.appendRows(text, rows.constData() + first, rows.constData() + last);
+        return text;
+    };
+
+    const int chunkCount = (rows.size() + rowsPerChunk - 1) / rowsPerChunk;
+    const int chunksPerBatch = qMax(1, QThread::idealThreadCount()) * 2;
+    for (int batch = 0; batch < chunkCount; batch += chunksPerBatch) {
+        QVector<int> chunks;
+        for (int chunk = batch; chunk < qMin(batch + chunksPerBatch, chunkCount); ++chunk) {
+            chunks << chunk;
+        }
+        const QVector<QString> texts = (chunks.size() == 1)
+                                           ? QVector<QString>{formatChunk(chunks.first())}
+                                           : QtConcurrent::blockingMapped<QVector<QString>>(chunks, formatChunk);
+        for (int i = 0; i < texts.size(); ++i) {
+            out << texts[i];
+            rowsWritten(qMin((chunks[i] + 1) * rowsPerChunk, rows.size()));
+        }
+    }
+    // Groups without rows at the end, e.g. TV shows without episodes.
+    rowsWritten(rows.size());
+}
+
+const StreamDetails* streamDetailsOf(Movie* movie)
+{
+    return movie->streamDetails();
+}
+
+const StreamDetails* streamDetailsOf(Concert* concert)
+{
+    return concert->streamDetails();
+}
+
+const StreamDetails* streamDetailsOf(const EpisodeRow& row)
+{
+    return row.episode->streamDetails();
+}
+
+template<class Row, class Detail>
+Accessor<Row> streamDetail(Detail detail)
+{
+    return [detail](const Row& row) { return getStreamDetails(streamDetailsOf(row), detail); };
+}
+
+Accessor<Movie*> movieValue(mediaelch::CsvMovieExport::Field field)
+{
+    using Field = mediaelch::CsvMovieExport::Field;
+    using Video = StreamDetails::VideoDetails;
+    using Audio = StreamDetails::AudioDetails;
+    switch (field) {
+    case Field::Imdbid: return [](Movie* movie) { return movie->imdbId().toString(); };
+    case Field::Tmdbid: return [](Movie* movie) { return movie->tmdbId().toString(); };
+    case Field::Title: return [](Movie* movie) { return movie->name(); };
+    case Field::OriginalTitle: return [](Movie* movie) { return movie->originalName(); };
+    case Field::SortTitle: return [](Movie* movie) { return movie->sortTitle(); };
+    case Field::Overview: return [](Movie* movie) { return movie->overview(); };
+    case Field::Outline: return [](Movie* movie) { return movie->outline(); };
+    case Field::Ratings: return [](Movie* movie) { return ratingsToString(movie->ratings()); };
+    case Field::UserRating: return [](Movie* movie) { return QString::number(movie->userRating()); };
+    case Field::IsImdbTop250: return [](Movie* movie) { return QString::number(movie->top250()); };
+    case Field::ReleaseDate:
+        return [](Movie* movie) {
+            return movie->released().isValid() ? movie->released().toString(Qt::ISODate) : QString();
+        };
+    case Field::Tagline: return [](Movie* movie) { return movie->tagline(); };
+    case Field::Runtime: return [](Movie* movie) { return QString::number(movie->runtime().count()); };
+    case Field::Certification: return [](Movie* movie) { return movie->certification().toString(); };
+    case Field::Writers: return [](Movie* movie) { return movie->writer(); };
+    case Field::Directors: return [](Movie* movie) { return movie->director(); };
+    case Field::Genres: return [](Movie* movie) { return movie->genres().join(", "); };
+    case Field::Countries: return [](Movie* movie) { return movie->countries().join(", "); };
+    case Field::Studios: return [](Movie* movie) { return movie->studios().join(", "); };
+    case Field::Tags: return [](Movie* movie) { return movie->tags().join(", "); };
+    case Field::Trailer: return [](Movie* movie) { return movie->trailer().toString(); };
+    case Field::Actors: return [](Movie* movie) { return actorsToString(movie->actors()); };
+    case Field::PlayCount: return [](Movie* movie) { return QString::number(movie->playcount()); };
+    case Field::LastPlayed: return [](Movie* movie) { return movie->lastPlayed().toString(Qt::ISODate); };
+    case Field::MovieSet: return [](Movie* movie) { return movie->set().name; };
+    case Field::Directory: return [](Movie* movie) { return dirFromFileList(movie->files()); };
+    case Field::Filenames: return [](Movie* movie) { return filesToString(movie->files()); };
+    case Field::StreamDetails_Video_DurationInSeconds: return streamDetail<Movie*>(Video::DurationInSeconds);
+    case Field::StreamDetails_Video_Aspect: return streamDetail<Movie*>(Video::Aspect);
+    case Field::StreamDetails_Video_Width: return streamDetail<Movie*>(Video::Width);
+    case Field::StreamDetails_Video_Height: return streamDetail<Movie*>(Video::Height);
+    case Field::StreamDetails_Video_Codec: return streamDetail<Movie*>(Video::Codec);
+    case Field::StreamDetails_Audio_Language: return streamDetail<Movie*>(Audio::Language);
+    case Field::StreamDetails_Audio_Codec: return streamDetail<Movie*>(Audio::Codec);
+    case Field::StreamDetails_Audio_Channels: return streamDetail<Movie*>(Audio::Channels);
+    case Field::StreamDetails_Subtitle_Language:
+        return streamDetail<Movie*>(StreamDetails::SubtitleDetails::Language);
+    }
+    return [](Movie*) { return QString(); };
+}
+
+Accessor<TvShow*> tvShowValue(mediaelch::CsvTvShowExport::Field field)
+{
+    using Field = mediaelch::CsvTvShowExport::Field;
+    switch (field) {
+    case Field::ShowTmdbId: return [](TvShow* show) { return show->tmdbId().toString(); };
+    case Field::ShowImdbId: return [](TvShow* show) { return show->imdbId().toString(); };
+    case Field::ShowTvDbId: return [](TvShow* show) { return show->tvdbId().toString(); };
+    case Field::ShowTvMazeId: return [](TvShow* show) { return show->tvmazeId().toString(); };
+    case Field::ShowTitle: return [](TvShow* show) { return show->title(); };
+    case Field::ShowSortTitle: return [](TvShow* show) { return show->sortTitle(); };
+    case Field::ShowOriginalTitle: return [](TvShow* show) { return show->originalTitle(); };
+    case Field::ShowFirstAired: return [](TvShow* show) { return show->firstAired().toString(Qt::ISODate); };
+    case Field::ShowNetwork: return [](TvShow* show) { return show->network(); };
+    case Field::ShowCertification: return [](TvShow* show) { return show->certification().toString(); };
+    case Field::ShowGenres: return [](TvShow* show) { return show->genres().join(", "); };
+    case Field::ShowTags: return [](TvShow* show) { return show->tags().join(", "); };
+    case Field::ShowRuntime: return [](TvShow* show) { return QString::number(show->runtime().count()); };
+    case Field::ShowRatings: return [](TvShow* show) { return ratingsToString(show->ratings()); };
+    case Field::ShowUserRating: return [](TvShow* show) { return QString::number(show->userRating()); };
+    case Field::ShowActors: return [](TvShow* show) { return actorsToString(show->actors()); };
+    case Field::ShowOverview: return [](TvShow* show) { return show->overview(); };
+    case Field::ShowIsImdbTop250: return [](TvShow* show) { return QString::number(show->top250()); };
+    case Field::ShowDirectory: return [](TvShow* show) { return show->dir().toNativePathString(); };
+    }
+    return [](TvShow*) { return QString(); };
+}
+
+Accessor<EpisodeRow> tvEpisodeValue(mediaelch::CsvTvEpisodeExport::Field field)
+{
+    using Field = mediaelch::CsvTvEpisodeExport::Field;
+    using Video = StreamDetails::VideoDetails;
+    using Audio = StreamDetails::AudioDetails;
+    switch (field) {
+    case Field::ShowTmdbId: return [](const EpisodeRow& row) { return row.show->tmdbId().toString(); };
+    case Field::ShowImdbId: return [](const EpisodeRow& row) { return row.show->imdbId().toString(); };
+    case Field::ShowTvDbId: return [](const EpisodeRow& row) { return row.show->tvdbId().toString(); };
+    case Field::ShowTvMazeId: return [](const EpisodeRow& row) { return row.show->tvmazeId().toString(); };
+    case Field::ShowTitle: return [](const EpisodeRow& row) { return row.show->title(); };
+    case Field::EpisodeSeason: return [](const EpisodeRow& row) { return row.episode->seasonNumber().toString(); };
+    case Field::EpisodeNumber: return [](const EpisodeRow& row) { return row.episode->episodeNumber().toString(); };
+    case Field::EpisodeTmdbId: return [](const EpisodeRow& row) { return row.episode->tmdbId().toString(); };
+    case Field::EpisodeImdbId: return [](const EpisodeRow& row) { return row.episode->imdbId().toString(); };
+    case Field::EpisodeTvDbId: return [](const EpisodeRow& row) { return row.episode->tvdbId().toString(); };
+    case Field::EpisodeTvMazeId: return [](const EpisodeRow& row) { return row.episode->tvmazeId().toString(); };
+    case Field::EpisodeFirstAired:
+        return [](const EpisodeRow& row) { return row.episode->firstAired().toString(Qt::ISODate); };
+    case Field::EpisodeTitle: return [](const EpisodeRow& row) { return row.episode->title(); };
+    case Field::EpisodeOverview: return [](const EpisodeRow& row) { return row.episode->overview(); };
+    case Field::EpisodeUserRating:
+        return [](const EpisodeRow& row) { return QString::number(row.episode->userRating()); };
+    case Field::EpisodeWriters: return [](const EpisodeRow& row) { return row.episode->writers().join(", "); };
+    case Field::EpisodeDirectors: return [](const EpisodeRow& row) { return row.episode->directors().join(", "); };
+    case Field::EpisodeActors: return [](const EpisodeRow& row) { return actorsToString(row.episode->actors()); };
+    case Field::EpisodeDirectory: return [](const EpisodeRow& row) { return dirFromFileList(row.episode->files()); };
+    case Field::EpisodeFilenames: return [](const EpisodeRow& row) { return filesToString(row.episode->files()); };
+    case Field::EpisodeStreamDetails_Video_DurationInSeconds:
+        return streamDetail<EpisodeRow>(Video::DurationInSeconds);
+    case Field::EpisodeStreamDetails_Video_Aspect: return streamDetail<EpisodeRow>(Video::Aspect);
+    case Field::EpisodeStreamDetails_Video_Width: return streamDetail<EpisodeRow>(Video::Width);
+    case Field::EpisodeStreamDetails_Video_Height: return streamDetail<EpisodeRow>(Video::Height);
+    case Field::EpisodeStreamDetails_Video_Codec: return streamDetail<EpisodeRow>(Video::Codec);
+    case Field::EpisodeStreamDetails_Audio_Language: return streamDetail<EpisodeRow>(Audio::Language);
+    case Field::EpisodeStreamDetails_Audio_Codec: return streamDetail<EpisodeRow>(Audio::Codec);
+    case Field::EpisodeStreamDetails_Audio_Channels: return streamDetail<EpisodeRow>(Audio::Channels);
+    case Field::EpisodeStreamDetails_Subtitle_Language:
+        return streamDetail<EpisodeRow>(StreamDetails::SubtitleDetails::Language);
+    }
+    return [](const EpisodeRow&) { return QString(); };
+}
+
+Accessor<Concert*> concertValue(mediaelch::CsvConcertExport::Field field)
+{
+    using Field = mediaelch::CsvConcertExport::Field;
+    using Video = StreamDetails::VideoDetails;
+    using Audio = StreamDetails::AudioDetails;
+    switch (field) {
+    case Field::TmdbId: return [](Concert* concert) { return concert->tmdbId().toString(); };
+    case Field::ImdbId: return [](Concert* concert) { return concert->imdbId().toString(); };
+    case Field::Title: return [](Concert* concert) { return concert->title(); };
+    case Field::OriginalTitle: return [](Concert* concert) { return concert->originalTitle(); };
+    case Field::Artist: return [](Concert* concert) { return concert->artist(); };
+    case Field::Album: return [](Concert* concert) { return concert->album(); };
+    case Field::Overview: return [](Concert* concert) { return concert->overview(); };
+    case Field::Ratings: return [](Concert* concert) { return ratingsToString(concert->ratings()); };
+    case Field::UserRating: return [](Concert* concert) { return QString::number(concert->userRating()); };
+    case Field::ReleaseDate: return [](Concert* concert) { return concert->released().toString(Qt::ISODate); };
+    case Field::Tagline: return [](Concert* concert) { return concert->tagline(); };
+    case Field::Runtime: return [](Concert* concert) { return QString::number(concert->runtime().count()); };
+    case Field::Certification: return [](Concert* concert) { return concert->certification().toString(); };
+    case Field::Genres: return [](Concert* concert) { return concert->genres().join(", "); };
+    case Field::Tags: return [](Concert* concert) { return concert->tags().join(", "); };
+    case Field::TrailerUrl: return [](Concert* concert) { return concert->trailer().toString(); };
+    case Field::Playcount: return [](Concert* concert) { return QString::number(concert->playcount()); };
+    case Field::LastPlayed: return [](Concert* concert) { return concert->lastPlayed().toString(Qt::ISODate); };
+    case Field::Directory: return [](Concert* concert) { return dirFromFileList(concert->files()); };
+    case Field::Filenames: return [](Concert* concert) { return filesToString(concert->files()); };
+    case Field::StreamDetails_Video_DurationInSeconds: return streamDetail<Concert*>(Video::DurationInSeconds);
+    case Field::StreamDetails_Video_Aspect: return streamDetail<Concert*>(Video::Aspect);
+    case Field::StreamDetails_Video_Width: return streamDetail<Concert*>(Video::Width);
+    case Field::StreamDetails_Video_Height: return streamDetail<Concert*>(Video::Height);
+    case Field::StreamDetails_Video_Codec: return streamDetail<Concert*>(Video::Codec);
+    case Field::StreamDetails_Audio_Language: return streamDetail<Concert*>(Audio::Language);
+    case Field::StreamDetails_Audio_Codec: return streamDetail<Concert*>(Audio::Codec);
+    case Field::StreamDetails_Audio_Channels: return streamDetail<Concert*>(Audio::Channels);
+    case Field::StreamDetails_Subtitle_Language:
+        return streamDetail<Concert*>(StreamDetails::SubtitleDetails::Language);
+    }
+    return [](Concert*) { return QString(); };
+}
+
+Accessor<Artist*> artistValue(mediaelch::CsvArtistExport::Field field)
+{
+    using Field = mediaelch::CsvArtistExport::Field;
+    switch (field) {
+    case Field::ArtistName: return [](Artist* artist) { return artist->name(); };
+    case Field::ArtistGenres: return [](Artist* artist) { return artist->genres().join(", "); };
+    case Field::ArtistStyles: return [](Artist* artist) { return artist->styles().join(", "); };
+    case Field::ArtistMoods: return [](Artist* artist) { return artist->moods().join(", "); };
+    case Field::ArtistYearsActive: return [](Artist* artist) { return artist->yearsActive(); };
+    case Field::ArtistFormed: return [](Artist* artist) { return artist->formed(); };
+    case Field::ArtistBiography: return [](Artist* artist) { return artist->biography(); };
+    case Field::ArtistBorn: return [](Artist* artist) { return artist->born(); };
+    case Field::ArtistDied: return [](Artist* artist) { return artist->died(); };
+    case Field::ArtistDisbanded: return [](Artist* artist) { return artist->disbanded(); };
+    case Field::ArtistMusicBrainzId: return [](Artist* artist) { return artist->mbId().toString(); };
+    case Field::ArtistAllMusicId: return [](Artist* artist) { return artist->allMusicId().toString(); };
+    case Field::ArtistDirectory: return [](Artist* artist) { return artist->path().toNativePathString(); };
+    }
+    return [](Artist*) { return QString(); };
+}
+
+Accessor<AlbumRow> albumValue(mediaelch::CsvAlbumExport::Field field)
+{
+    using Field = mediaelch::CsvAlbumExport::Field;
+    switch (field) {
+    case Field::ArtistName: return [](const AlbumRow& row) { return row.artist->name(); };
+    case Field::AlbumTitle: return [](const AlbumRow& row) { return row.album->title(); };
+    case Field::AlbumArtistName: return [](const AlbumRow& row) { return row.album->artist(); };
+    case Field::AlbumGenres: return [](const AlbumRow& row) { return row.album->genres().join(", "); };
+    case Field::AlbumStyles: return [](const AlbumRow& row) { return row.album->styles().join(", "); };
+    case Field::AlbumMoods: return [](const AlbumRow& row) { return row.album->moods().join(", "); };
+    case Field::AlbumReview: return [](const AlbumRow& row) { return row.album->review(); };
+    case Field::AlbumReleaseDate: return [](const AlbumRow& row) { return row.album->releaseDate(); };
+    case Field::AlbumLabel: return [](const AlbumRow& row) { return row.album->label(); };
+    case Field::AlbumRating: return [](const AlbumRow& row) { return QString::number(row.album->rating()); };
+    case Field::AlbumYear: return [](const AlbumRow& row) { return QString::number(row.album->year()); };
+    case Field::AlbumMusicBrainzId: return [](const AlbumRow& row) { return row.album->mbAlbumId().toString(); };
+    case Field::AlbumMusicBrainzReleaseGroupId:
+        return [](const AlbumRow& row) { return row.album->mbReleaseGroupId().toString(); };
+    case Field::AlbumAllMusicId: return [](const AlbumRow& row) { return row.album->allMusicId().toString(); };
+    case Field::AlbumDirectory: return [](const AlbumRow& row) { return row.album->path().toNativePathString(); };
+    }
+    return [](const AlbumRow&) { return QString(); };
+}
+
+} // namespace
+
 namespace mediaelch {
 
 CsvMovieExport::CsvMovieExport(QTextStream& outStream, QVector<CsvMovieExport::Field> fields, QObject* parent) :
@@ -105,68 +558,9 @@ CsvMovieExport::CsvMovieExport(QTextStream& outStream, QVector<CsvMovieExport::F
 
 void CsvMovieExport::exportMovies(const QVector<Movie*>& movies, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Movie* movie : asConst(movies)) {
-        const auto* st = movie->streamDetails();
-        csv.addRow({
-            {s(Field::Imdbid), movie->imdbId().toString()},
-            {s(Field::Tmdbid), movie->tmdbId().toString()},
-            {s(Field::Title), movie->name()},
-            {s(Field::OriginalTitle), movie->originalName()},
-            {s(Field::SortTitle), movie->sortTitle()},
-            {s(Field::Overview), movie->overview()},
-            {s(Field::Outline), movie->outline()},
-            {s(Field::Ratings), ratingsToString(movie->ratings())},
-            {s(Field::UserRating), QString::number(movie->userRating())},
-            {s(Field::IsImdbTop250), QString::number(movie->top250())},
-            {s(Field::ReleaseDate), movie->released().isValid() ? movie->released().toString(Qt::ISODate) : ""},
-            {s(Field::Tagline), movie->tagline()},
-            {s(Field::Runtime), QString::number(movie->runtime().count())},
-            {s(Field::Certification), movie->certification().toString()},
-            {s(Field::Writers), movie->writer()},
-            {s(Field::Directors), movie->director()},
-            {s(Field::Genres), movie->genres().join(", ")},
-            {s(Field::Countries), movie->countries().join(", ")},
-            {s(Field::Studios), movie->studios().join(", ")},
-            {s(Field::Tags), movie->tags().join(", ")},
-            {s(Field::Trailer), movie->trailer().toString()},
-            {s(Field::Actors), actorsToString(movie->actors())},
-            {s(Field::PlayCount), QString::number(movie->playcount())},
-            {s(Field::LastPlayed), movie->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::MovieSet), movie->set().name},
-            {s(Field::Directory), dirFromFileList(movie->files())},
-            {s(Field::Filenames), filesToString(movie->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-        });
-        callback();
-    }
-}
-
-QVector<QString> CsvMovieExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
-    }
-    return out;
+    const RowFormatter<Movie*> formatter(
+        columnsOf(m_fields, &CsvMovieExport::fieldToString, &movieValue), m_format, m_separator, m_replacement);
+    writeRows(m_out, formatter, movies, eachRow(movies.size()), callback);
 }
 
 QString CsvMovieExport::fieldToString(Field field)
@@ -219,49 +613,9 @@ CsvTvShowExport::CsvTvShowExport(QTextStream& outStream, QVector<CsvTvShowExport
 
 void CsvTvShowExport::exportTvShows(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (TvShow* show : shows) {
-        csv.addRow({
-            {s(Field::ShowTmdbId), show->tmdbId().toString()},
-            {s(Field::ShowImdbId), show->imdbId().toString()},
-            {s(Field::ShowTvDbId), show->tvdbId().toString()},
-            {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-            {s(Field::ShowTitle), show->title()},
-            {s(Field::ShowSortTitle), show->sortTitle()},
-            {s(Field::ShowOriginalTitle), show->originalTitle()},
-            {s(Field::ShowFirstAired), show->firstAired().toString(Qt::ISODate)},
-            {s(Field::ShowNetwork), show->network()},
-            {s(Field::ShowCertification), show->certification().toString()},
-            {s(Field::ShowGenres), show->genres().join(", ")},
-            {s(Field::ShowTags), show->tags().join(", ")},
-            {s(Field::ShowRuntime), QString::number(show->runtime().count())},
-            {s(Field::ShowRatings), ratingsToString(show->ratings())},
-            {s(Field::ShowUserRating), QString::number(show->userRating())},
-            {s(Field::ShowActors), actorsToString(show->actors())},
-            {s(Field::ShowOverview), show->overview()},
-            {s(Field::ShowIsImdbTop250), QString::number(show->top250())},
-            {s(Field::ShowDirectory), show->dir().toNativePathString()} //
-        });
-
-        callback();
-    }
-}
-
-QVector<QString> CsvTvShowExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
-    }
-    return out;
+    const RowFormatter<TvShow*> formatter(
+        columnsOf(m_fields, &CsvTvShowExport::fieldToString, &tvShowValue), m_format, m_separator, m_replacement);
+    writeRows(m_out, formatter, shows, eachRow(shows.size()), callback);
 }
 
 QString CsvTvShowExport::fieldToString(CsvTvShowExport::Field field)
@@ -300,66 +654,19 @@ CsvTvEpisodeExport::CsvTvEpisodeExport(QTextStream& outStream,
 
 void CsvTvEpisodeExport::exportEpisodes(const QVector<TvShow*>& shows, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
+    const RowFormatter<EpisodeRow> formatter(
+        columnsOf(m_fields, &CsvTvEpisodeExport::fieldToString, &tvEpisodeValue), m_format, m_separator, m_replacement);
 
+    QVector<EpisodeRow> rows;
+    QVector<int> showEnds;
+    showEnds.reserve(shows.size());
     for (TvShow* show : shows) {
-        for (TvShowEpisode* episode : asConst(show->episodes())) {
-            const auto* st = episode->streamDetails();
-            csv.addRow({
-                {s(Field::ShowTmdbId), show->tmdbId().toString()},
-                {s(Field::ShowImdbId), show->imdbId().toString()},
-                {s(Field::ShowTvDbId), show->tvdbId().toString()},
-                {s(Field::ShowTvMazeId), show->tvmazeId().toString()},
-                {s(Field::ShowTitle), show->title()},
-                {s(Field::EpisodeSeason), episode->seasonNumber().toString()},
-                {s(Field::EpisodeNumber), episode->episodeNumber().toString()},
-                {s(Field::EpisodeTmdbId), episode->tmdbId().toString()},
-                {s(Field::EpisodeImdbId), episode->imdbId().toString()},
-                {s(Field::EpisodeTvDbId), episode->tvdbId().toString()},
-                {s(Field::EpisodeTvMazeId), episode->tvmazeId().toString()},
-                {s(Field::EpisodeFirstAired), episode->firstAired().toString(Qt::ISODate)},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeOverview), episode->overview()},
-                {s(Field::EpisodeTitle), episode->title()},
-                {s(Field::EpisodeUserRating), QString::number(episode->userRating())},
-                {s(Field::EpisodeActors), actorsToString(episode->actors())},
-                {s(Field::EpisodeDirectory), dirFromFileList(episode->files())},
-                {s(Field::EpisodeFilenames), filesToString(episode->files())},
-                {s(Field::EpisodeStreamDetails_Video_DurationInSeconds),
-                    getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-                {s(Field::EpisodeStreamDetails_Video_Aspect),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-                {s(Field::EpisodeStreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-                {s(Field::EpisodeStreamDetails_Video_Height),
-                    getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-                {s(Field::EpisodeStreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Language),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-                {s(Field::EpisodeStreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-                {s(Field::EpisodeStreamDetails_Audio_Channels),
-                    getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-                {s(Field::EpisodeStreamDetails_Subtitle_Language),
-                    getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-            });
+        for (TvShowEpisode* episode : show->episodes()) {
+            rows << EpisodeRow{show, episode};
         }
-        callback();
+        showEnds << rows.size();
     }
-}
-
-QVector<QString> CsvTvEpisodeExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
-    }
-    return out;
+    writeRows(m_out, formatter, rows, showEnds, callback);
 }
 
 QString CsvTvEpisodeExport::fieldToString(CsvTvEpisodeExport::Field field)
@@ -405,62 +712,9 @@ CsvConcertExport::CsvConcertExport(QTextStream& outStream, QVector<CsvConcertExp
 
 void CsvConcertExport::exportConcerts(const QVector<Concert*>& concerts, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Concert* concert : asConst(concerts)) {
-        const auto* st = concert->streamDetails();
-        csv.addRow({
-            {s(Field::TmdbId), concert->tmdbId().toString()},
-            {s(Field::ImdbId), concert->imdbId().toString()},
-            {s(Field::Title), concert->title()},
-            {s(Field::OriginalTitle), concert->originalTitle()},
-            {s(Field::Artist), concert->artist()},
-            {s(Field::Album), concert->album()},
-            {s(Field::Overview), concert->overview()},
-            {s(Field::Ratings), ratingsToString(concert->ratings())},
-            {s(Field::UserRating), QString::number(concert->userRating())},
-            {s(Field::ReleaseDate), concert->released().toString(Qt::ISODate)},
-            {s(Field::Tagline), concert->tagline()},
-            {s(Field::Runtime), QString::number(concert->runtime().count())},
-            {s(Field::Certification), concert->certification().toString()},
-            {s(Field::Genres), concert->genres().join(", ")},
-            {s(Field::Tags), concert->tags().join(", ")},
-            {s(Field::TrailerUrl), concert->trailer().toString()},
-            {s(Field::Playcount), QString::number(concert->playcount())},
-            {s(Field::LastPlayed), concert->lastPlayed().toString(Qt::ISODate)},
-            {s(Field::Directory), dirFromFileList(concert->files())},
-            {s(Field::Filenames), filesToString(concert->files())},
-            {s(Field::StreamDetails_Video_DurationInSeconds),
-                getStreamDetails(st, StreamDetails::VideoDetails::DurationInSeconds)},
-            {s(Field::StreamDetails_Video_Aspect), getStreamDetails(st, StreamDetails::VideoDetails::Aspect)},
-            {s(Field::StreamDetails_Video_Width), getStreamDetails(st, StreamDetails::VideoDetails::Width)},
-            {s(Field::StreamDetails_Video_Height), getStreamDetails(st, StreamDetails::VideoDetails::Height)},
-            {s(Field::StreamDetails_Video_Codec), getStreamDetails(st, StreamDetails::VideoDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Language), getStreamDetails(st, StreamDetails::AudioDetails::Language)},
-            {s(Field::StreamDetails_Audio_Codec), getStreamDetails(st, StreamDetails::AudioDetails::Codec)},
-            {s(Field::StreamDetails_Audio_Channels), getStreamDetails(st, StreamDetails::AudioDetails::Channels)},
-            {s(Field::StreamDetails_Subtitle_Language),
-                getStreamDetails(st, StreamDetails::SubtitleDetails::Language)} //
-
-        });
-        callback();
-    }
-}
-
-QVector<QString> CsvConcertExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
-    }
-    return out;
+    const RowFormatter<Concert*> formatter(
+        columnsOf(m_fields, &CsvConcertExport::fieldToString, &concertValue), m_format, m_separator, m_replacement);
+    writeRows(m_out, formatter, concerts, eachRow(concerts.size()), callback);
 }
 
 QString CsvConcertExport::fieldToString(CsvConcertExport::Field field)
@@ -506,42 +760,9 @@ CsvArtistExport::CsvArtistExport(QTextStream& outStream, QVector<CsvArtistExport
 
 void CsvArtistExport::exportArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
-
-    for (Artist* artist : asConst(artists)) {
-        csv.addRow({
-            {s(Field::ArtistName), artist->name()},
-            {s(Field::ArtistGenres), artist->genres().join(", ")},
-            {s(Field::ArtistStyles), artist->styles().join(", ")},
-            {s(Field::ArtistMoods), artist->moods().join(", ")},
-            {s(Field::ArtistYearsActive), artist->yearsActive()},
-            {s(Field::ArtistFormed), artist->formed()},
-            {s(Field::ArtistBiography), artist->biography()},
-            {s(Field::ArtistBorn), artist->born()},
-            {s(Field::ArtistDied), artist->died()},
-            {s(Field::ArtistDisbanded), artist->disbanded()},
-            {s(Field::ArtistMusicBrainzId), artist->mbId().toString()},
-            {s(Field::ArtistAllMusicId), artist->allMusicId().toString()},
-            {s(Field::ArtistDirectory), artist->path().toNativePathString()} //
-        });
-        callback();
-    }
-}
-
-QVector<QString> CsvArtistExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
-    }
-    return out;
+    const RowFormatter<Artist*> formatter(
+        columnsOf(m_fields, &CsvArtistExport::fieldToString, &artistValue), m_format, m_separator, m_replacement);
+    writeRows(m_out, formatter, artists, eachRow(artists.size()), callback);
 }
 
 QString CsvArtistExport::fieldToString(CsvArtistExport::Field field)
@@ -572,47 +793,20 @@ CsvAlbumExport::CsvAlbumExport(QTextStream& outStream, QVector<CsvAlbumExport::F
 
 void CsvAlbumExport::exportAlbumsOfArtists(const QVector<Artist*>& artists, std::function<void()> callback)
 {
-    CsvExport csv(m_out);
-    csv.setFieldsInOrder(fieldsToStrings());
-    csv.setSeparator(m_separator);
-    csv.setReplacement(m_replacement);
-
-    const auto s = [](Field field) { return fieldToString(field); };
-
-    csv.writeHeader();
+    const RowFormatter<AlbumRow> formatter(
+        columnsOf(m_fields, &CsvAlbumExport::fieldToString, &albumValue), m_format, m_separator, m_replacement);
 
-    for (Artist* artist : asConst(artists)) {
-        const auto albums = artist->albums();
+    QVector<AlbumRow> rows;
+    QVector<int> artistEnds;
+    artistEnds.reserve(artists.size());
+    for (Artist* artist : artists) {
+        const QVector<Album*> albums = artist->albums();
         for (Album* album : albums) {
-            csv.addRow({
-                {s(Field::ArtistName), artist->name()},
-                {s(Field::AlbumTitle), album->title()},
-                {s(Field::AlbumArtistName), album->artist()},
-                {s(Field::AlbumGenres), album->genres().join(", ")},
-                {s(Field::AlbumStyles), album->styles().join(", ")},
-                {s(Field::AlbumMoods), album->moods().join(", ")},
-                {s(Field::AlbumReview), album->review()},
-                {s(Field::AlbumReleaseDate), album->releaseDate()},
-                {s(Field::AlbumLabel), album->label()},
-                {s(Field::AlbumRating), QString::number(album->rating())},
-                {s(Field::AlbumYear), QString::number(album->year())},
-                {s(Field::AlbumMusicBrainzId), album->mbAlbumId().toString()},
-                {s(Field::AlbumMusicBrainzReleaseGroupId), album->mbReleaseGroupId().toString()},
-                {s(Field::AlbumAllMusicId), album->allMusicId().toString()},
-                {s(Field::AlbumDirectory), album->path().toNativePathString()} //
-            });
+            rows << AlbumRow{artist, album};
         }
-        callback();
-    }
-}
-
-QVector<QString> CsvAlbumExport::fieldsToStrings() const
-{
-    QVector<QString> out;
-    for (const Field field : asConst(m_fields)) {
-        out << fieldToString(field);
+        artistEnds << rows.size();
     }
-    return out;
+    writeRows(m_out, formatter, rows, artistEnds, callback);
 }
 
 QString CsvAlbumExport::fieldToString(CsvAlbumExport::Field field)
@@ -637,48 +831,4 @@ QString CsvAlbumExport::fieldToString(CsvAlbumExport::Field field)
     return "unknown";
 }
 
-void CsvExport::writeHeader()
-{
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(*i);
-    ++i;
-
-    for (; i != m_fieldsInOrder.cend(); ++i) {
-        m_out << m_separator;
-        writeEscaped(*i);
-    }
-    m_out << "\n";
-}
-
-void CsvExport::addRow(const QMap<QString, QString>& values)
-{
-    if (m_fieldsInOrder.isEmpty()) {
-        return;
-    }
-
-    QVector<QString>::const_iterator i = m_fieldsInOrder.cbegin();
-    writeEscaped(values.value(*i));
-    ++i;
-
-    for (; i != m_fieldsInOrder.cend(); ++i) {
-        m_out << m_separator;
-        writeEscaped(values.value(*i));
-    }
-    m_out << "\n";
-}
-
-void CsvExport::writeEscaped(const QString& text)
-{
-    if (!text.contains(m_separator) && !text.contains("\n")) {
-        m_out << text;
-        return;
-    }
-
-    m_out << (QString(text)
-                  .replace(m_separator, m_replacement)
-                  .replace("\r\n", "\\n")
-                  .replace("\n", "\\n")
-                  .replace("\r", "\\n"));
-}
-
 } // namespace mediaelch
@@ -3,7 +3,6 @@
 #include "data/Rating.h"
 #include "globals/Meta.h"
 
-#include <QMap>
 #include <QObject>
 #include <QRegularExpression>
 #include <QString>
@@ -19,19 +18,35 @@ class Artist;
 
 namespace mediaelch {
 
+/// \brief Base class for exports of media items as CSV or JSON Lines.
+///
+/// The selected fields are resolved once into a list of columns. Only the selected
+/// columns are formatted per item and rows are written straight into the stream.
+/// Large exports are formatted in parallel chunks that are written in order.
 class CsvMediaExport : public QObject
 {
     Q_OBJECT
 
+public:
+    enum class Format
+    {
+        /// Header line and one line per item; cells are separated by the separator.
+        Csv,
+        /// One JSON object per line with the field names as keys, see https://jsonlines.org/
+        JsonLines
+    };
+
 public:
     explicit CsvMediaExport(QTextStream& outStream, QObject* parent = nullptr) : QObject(parent), m_out{outStream} {}
 
 public:
     void setSeparator(QString separator) { m_separator = std::move(separator); }
     void setReplacement(QString replacement) { m_replacement = std::move(replacement); }
+    void setFormat(Format format) { m_format = format; }
 
 protected:
     QTextStream& m_out;
+    Format m_format = Format::Csv;
     QString m_separator = "\t";
     QString m_replacement = " ";
 };
@@ -92,9 +107,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -139,9 +151,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -195,9 +204,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -251,9 +257,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -291,9 +294,6 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
@@ -333,37 +333,8 @@ public:
     /// \brief Returns a string representation of the field that can be used for serializing.
     static QString fieldToString(Field field);
 
-private:
-    QVector<QString> fieldsToStrings() const;
-
 private:
     QVector<Field> m_fields;
 };
 
-
-class CsvExport : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit CsvExport(QTextStream& outStream, QObject* parent = nullptr) : QObject(parent), m_out{outStream} {}
-
-    void setFieldsInOrder(QVector<QString> fieldsInOrder) { m_fieldsInOrder = std::move(fieldsInOrder); }
-    void setSeparator(QString separator) { m_separator = std::move(separator); }
-    void setReplacement(QString replacement) { m_replacement = std::move(replacement); }
-
-    /// \brief Writes a CSV header using the given fieldsInOrder
-    void writeHeader();
-    void addRow(const QMap<QString, QString>& values);
-
-private:
-    void writeEscaped(const QString& text);
-
-private:
-    QTextStream& m_out;
-    QVector<QString> m_fieldsInOrder;
-    QString m_separator;
-    QString m_replacement;
-};
-
 } // namespace mediaelch
@@ -30,7 +30,9 @@ void MediaExport::doExport(ExportTemplate& exportTemplate,
         connect(&engine, &SimpleEngine::sigItemExported, [&]() { emit sigItemExported(); });
 
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::Movies)) {
-            engine.exportMovies(Manager::instance()->movieModel()->movies());
+            const QVector<Movie*>& movies = Manager::instance()->movieModel()->movies();
+            MovieController::hydrate(movies);
+            engine.exportMovies(movies);
         }
 
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::TvShows)) {
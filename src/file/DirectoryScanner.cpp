@@ -0,0 +1,276 @@
+#include "file/DirectoryScanner.h"
+
+#include "globals/Meta.h"
+#include "log/Log.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSet>
+#include <QStorageInfo>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#    include <dirent.h>
+#    include <fcntl.h>
+#    include <sys/stat.h>
+#    include <sys/types.h>
+#endif
+
+namespace {
+
+#ifdef Q_OS_UNIX
+/// \brief Determines an entry's type, if possible without stat().
+/// Returns false if the entry can't be stat'ed, e.g. a broken symlink.
+bool entryType(int dirFd, const dirent* entry, bool& isDir, bool& isFile, bool& isLink)
+{
+#    ifdef DT_UNKNOWN
+    if (entry->d_type == DT_DIR) {
+        isDir = true;
+        return true;
+    }
+    if (entry->d_type == DT_REG) {
+        isFile = true;
+        return true;
+    }
+    if (entry->d_type != DT_LNK && entry->d_type != DT_UNKNOWN) {
+        return true; // sockets, pipes, devices, ...
+    }
+#    endif
+    struct stat entryStat = {};
+    if (::fstatat(dirFd, entry->d_name, &entryStat, AT_SYMLINK_NOFOLLOW) != 0) {
+        return false;
+    }
+    isLink = S_ISLNK(entryStat.st_mode);
+    if (isLink && ::fstatat(dirFd, entry->d_name, &entryStat, 0) != 0) {
+        return false;
+    }
+    isDir = S_ISDIR(entryStat.st_mode);
+    isFile = S_ISREG(entryStat.st_mode);
+    return true;
+}
+#endif
+
+class Task : public QRunnable
+{
+public:
+    explicit Task(std::function<void()> run) : m_run{std::move(run)} {}
+    void run() override { m_run(); }
+
+private:
+    std::function<void()> m_run;
+};
+
+} // namespace
+
+namespace mediaelch {
+
+struct DirectoryScanner::State
+{
+    explicit State(const Consumer& callback) : consumer{callback} {}
+
+    const Consumer& consumer;
+    /// Serializes calls to the consumer.
+    QMutex consumerMutex;
+
+    QMutex mutex;
+    QWaitCondition done;
+    int pendingDirectories = 0;
+    /// Scanned directories, used to stop symlink loops.
+    QSet<QString> visited;
+    std::vector<std::unique_ptr<QThreadPool>> pools;
+
+    bool markVisited(const QString& id)
+    {
+        QMutexLocker lock(&mutex);
+        if (visited.contains(id)) {
+            return false;
+        }
+        visited.insert(id);
+        return true;
+    }
+};
+
+DirectoryScanner::DirectoryScanner(Options options) :
+    m_options{std::move(options)}, m_nameFilter{NameMatcher::fromWildcards(m_options.nameFilters, Qt::CaseInsensitive)}
+{
+}
+
+void DirectoryScanner::scan(const QStringList& roots, const Consumer& consumer)
+{
+    State state(consumer);
+    QHash<QString, int> volumes;
+
+    for (const QString& root : roots) {
+        const QString path = QDir::cleanPath(root);
+        const QStorageInfo storage(path);
+        const QString volume = storage.isValid() ? storage.rootPath() : QString();
+        if (!volumes.contains(volume)) {
+            auto pool = std::make_unique<QThreadPool>();
+            pool->setMaxThreadCount(qMax(1, m_options.maxConcurrencyPerVolume));
+            volumes.insert(volume, static_cast<int>(state.pools.size()));
+            state.pools.push_back(std::move(pool));
+        }
+        enqueue(state, volumes.value(volume), path);
+    }
+
+    QMutexLocker lock(&state.mutex);
+    while (state.pendingDirectories > 0) {
+        state.done.wait(&state.mutex);
+    }
+    lock.unlock();
+
+    // The last tasks may still be returning.
+    for (const auto& pool : state.pools) {
+        pool->waitForDone();
+    }
+}
+
+void DirectoryScanner::enqueue(State& state, int volume, const QString& path)
+{
+    {
+        QMutexLocker lock(&state.mutex);
+        ++state.pendingDirectories;
+    }
+    state.pools[static_cast<size_t>(volume)]->start(new Task([this, &state, volume, path]() {
+        listDirectory(state, volume, path);
+        QMutexLocker lock(&state.mutex);
+        if (--state.pendingDirectories == 0) {
+            state.done.wakeAll();
+        }
+    }));
+}
+
+void DirectoryScanner::listDirectory(State& state, int volume, const QString& path)
+{
+    if (isAborted()) {
+        return;
+    }
+
+    Directory directory;
+    directory.path = path;
+    directory.name = QDir(path).dirName();
+    QStringList subDirectories;
+    if (!readDirectory(state, directory, subDirectories)) {
+        return;
+    }
+
+    // Queue subdirectories first so that idle threads can start listing them.
+    if (m_options.recursive) {
+        for (const QString& subDirectory : asConst(subDirectories)) {
+            enqueue(state, volume, subDirectory);
+        }
+    }
+
+    if (!directory.entries.isEmpty()) {
+        QMutexLocker lock(&state.consumerMutex);
+        if (!isAborted()) {
+            state.consumer(directory);
+        }
+    }
+}
+
+#ifdef Q_OS_UNIX
+
+bool DirectoryScanner::readDirectory(State& state, Directory& directory, QStringList& subDirectories) const
+{
+    DIR* dir = ::opendir(QFile::encodeName(directory.path).constData());
+    if (dir == nullptr) {
+        qCDebug(generic) << "[DirectoryScanner] Can't open directory:" << directory.path;
+        return false;
+    }
+    const int fd = ::dirfd(dir);
+
+    struct stat dirStat = {};
+    if (::fstat(fd, &dirStat) == 0) {
+        const QString id = QString::number(dirStat.st_dev) + ':' + QString::number(dirStat.st_ino);
+        if (!state.markVisited(id)) {
+            ::closedir(dir);
+            return false;
+        }
+    }
+
+    while (const dirent* entry = ::readdir(dir)) {
+        if (isAborted()) {
+            break;
+        }
+        // Skips ".", ".." and hidden entries.
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        bool isDir = false;
+        bool isFile = false;
+        bool isLink = false;
+        if (!entryType(fd, entry, isDir, isFile, isLink)) {
+            continue;
+        }
+        if (!isDir && !isFile) {
+            continue; // sockets, pipes, devices, ...
+        }
+
+        QString name = QFile::decodeName(entry->d_name);
+        if (isDir && (!isLink || m_options.followSymlinks)) {
+            subDirectories << directory.filePath(name);
+        }
+        if (m_nameFilter.isEmpty() || m_nameFilter.matches(name)) {
+            directory.entries << makeEntry(directory, std::move(name), isDir, isFile);
+        }
+    }
+
+    ::closedir(dir);
+    return true;
+}
+
+#else
+
+bool DirectoryScanner::readDirectory(State& state, Directory& directory, QStringList& subDirectories) const
+{
+    // QFileInfo objects returned by QDir already contain the entries' metadata on Windows.
+    QDir dir(directory.path);
+    if (!dir.exists() || !state.markVisited(dir.canonicalPath())) {
+        return false;
+    }
+
+    const QFileInfoList infos = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files);
+    for (const QFileInfo& info : infos) {
+        if (isAborted()) {
+            break;
+        }
+        const bool isDir = info.isDir();
+        QString name = info.fileName();
+        if (isDir && (!info.isSymLink() || m_options.followSymlinks)) {
+            subDirectories << directory.filePath(name);
+        }
+        if (m_nameFilter.isEmpty() || m_nameFilter.matches(name)) {
+            directory.entries << makeEntry(directory, std::move(name), isDir, info.isFile());
+        }
+    }
+    return true;
+}
+
+#endif
+
+DirectoryScanner::Entry
+DirectoryScanner::makeEntry(const Directory& directory, QString name, bool isDir, bool isFile) const
+{
+    Entry entry;
+    entry.name = std::move(name);
+    entry.isDir = isDir;
+    entry.isFile = isFile;
+    if (m_options.fileDetails && isFile) {
+        const QFileInfo info(directory.filePath(entry.name));
+        entry.size = info.size();
+        entry.lastModified = info.lastModified();
+    }
+    return entry;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "file/NameMatcher.h"
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Walks directory trees with several threads and streams their entries.
+///
+/// Searchers used to walk their directories with a single QDirIterator. On network
+/// mounts, such a walk is bound by the latency of each directory listing. The scanner
+/// lists subdirectories concurrently instead: each directory is a task in a thread pool
+/// and every listed subdirectory is queued as a new task, which any idle thread takes.
+/// There is one pool per volume so that the number of concurrent listings per volume
+/// is limited.
+///
+/// On Unix, entry types are taken from readdir() so that no stat() call is needed per
+/// entry. Only symlinks, entries of unknown type and, if requested, matching files are
+/// stat'ed. Same as QDirIterator without QDir::Hidden and QDir::System, hidden entries
+/// and special files are skipped.
+///
+/// Entries are passed to the consumer directory by directory as soon as a directory is
+/// listed. The consumer is called from the scanner's threads, but never concurrently,
+/// so it doesn't need to lock its own data. The order of directories is undefined.
+///
+/// \par Example
+/// \code{cpp}
+///   DirectoryScanner::Options options;
+///   options.nameFilters = QStringList{"*.mkv", "*.avi"};
+///   DirectoryScanner scanner(options);
+///   scanner.scan({"/media/movies"}, [&](const DirectoryScanner::Directory& directory) {
+///       for (const auto& entry : directory.entries) {
+///           files << directory.filePath(entry);
+///       }
+///   });
+/// \endcode
+class DirectoryScanner
+{
+public:
+    struct Entry
+    {
+        QString name;
+        bool isDir = false;
+        bool isFile = false;
+        /// Only set for files if Options::fileDetails is true.
+        qint64 size = -1;
+        /// Only set for files if Options::fileDetails is true.
+        QDateTime lastModified;
+    };
+
+    struct Directory
+    {
+        /// Cleaned path of the directory, see QDir::cleanPath().
+        QString path;
+        /// Name of the directory, see QDir::dirName().
+        QString name;
+        /// Entries that match the name filters.
+        QVector<Entry> entries;
+
+        QString filePath(const QString& fileName) const
+        {
+            return path.endsWith('/') ? path + fileName : path + '/' + fileName;
+        }
+        QString filePath(const Entry& entry) const { return filePath(entry.name); }
+    };
+
+    struct Options
+    {
+        /// Wildcards such as "*.mkv", compared case-insensitively. Applied to files and
+        /// directories, but all subdirectories are scanned. Empty means all entries.
+        QStringList nameFilters;
+        bool recursive = true;
+        bool followSymlinks = true;
+        /// Read the size and last modification time of matching files.
+        bool fileDetails = false;
+        /// Maximum number of directories that are listed at the same time per volume.
+        int maxConcurrencyPerVolume = 8;
+    };
+
+    using Consumer = std::function<void(const Directory& directory)>;
+
+public:
+    explicit DirectoryScanner(Options options);
+
+    /// \brief Scans the given directories and blocks until all are scanned or aborted.
+    void scan(const QStringList& roots, const Consumer& consumer);
+
+    /// \brief Stops the scan as soon as possible. Thread-safe; may be called by the consumer.
+    void abort() { m_aborted.store(true); }
+    bool isAborted() const { return m_aborted.load(); }
+
+private:
+    struct State;
+
+    void enqueue(State& state, int volume, const QString& path);
+    void listDirectory(State& state, int volume, const QString& path);
+    bool readDirectory(State& state, Directory& directory, QStringList& subDirectories) const;
+    Entry makeEntry(const Directory& directory, QString name, bool isDir, bool isFile) const;
+
+private:
+    Options m_options;
+    NameMatcher m_nameFilter;
+    std::atomic_bool m_aborted{false};
+};
+
+} // namespace mediaelch
@@ -0,0 +1,456 @@
+#include "file/FileTransferQueue.h"
+
+#include "log/Log.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QRunnable>
+#include <QStorageInfo>
+#include <QThreadPool>
+
+#include <cerrno>
+#include <cstdio>
+
+#ifdef Q_OS_UNIX
+#    include <unistd.h>
+#endif
+#ifdef Q_OS_WIN
+#    include <windows.h>
+#endif
+#ifdef Q_OS_LINUX
+#    include <fcntl.h>
+#    include <sys/sendfile.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#endif
+
+namespace {
+
+/// Bytes per copy_file_range() or sendfile() call and size of the buffer for buffered
+/// copies. Large enough for full throughput, small enough for smooth progress and fast aborts.
+constexpr qint64 chunkSize = 8 * 1024 * 1024;
+/// The end of a part file may not have reached the disk if the system crashed while
+/// it was written. That much is copied again when resuming.
+constexpr qint64 resumeOverlap = chunkSize;
+constexpr int progressIntervalMs = 250;
+
+class Task : public QRunnable
+{
+public:
+    explicit Task(std::function<void()> run) : m_run{std::move(run)} {}
+    void run() override { m_run(); }
+
+private:
+    std::function<void()> m_run;
+};
+
+/// \brief Root path of the volume that the file will be on. The file's directory
+/// doesn't have to exist, yet.
+QString volumeOf(const QString& filePath)
+{
+    QString path = QFileInfo(filePath).absolutePath();
+    while (!QFileInfo::exists(path)) {
+        const QString parent = QFileInfo(path).path();
+        if (parent == path) {
+            break;
+        }
+        path = parent;
+    }
+    const QStorageInfo storage(path);
+    return storage.isValid() ? storage.rootPath() : QString();
+}
+
+enum class RenameResult
+{
+    Renamed,
+    OtherVolume,
+    Failed
+};
+
+/// \brief Renames the file if it stays on the same volume. Never copies it.
+RenameResult renameFile(const QString& source, const QString& destination)
+{
+#ifdef Q_OS_WIN
+    // Without MOVEFILE_COPY_ALLOWED, files are not copied to other volumes.
+    const QString nativeSource = QDir::toNativeSeparators(source);
+    const QString nativeDestination = QDir::toNativeSeparators(destination);
+    if (::MoveFileExW(reinterpret_cast<const wchar_t*>(nativeSource.utf16()),
+            reinterpret_cast<const wchar_t*>(nativeDestination.utf16()),
+            0)
+        != 0) {
+        return RenameResult::Renamed;
+    }
+    return ::GetLastError() == ERROR_NOT_SAME_DEVICE ? RenameResult::OtherVolume : RenameResult::Failed;
+#else
+    if (std::rename(QFile::encodeName(source).constData(), QFile::encodeName(destination).constData()) == 0) {
+        return RenameResult::Renamed;
+    }
+    return errno == EXDEV ? RenameResult::OtherVolume : RenameResult::Failed;
+#endif
+}
+
+#ifdef Q_OS_LINUX
+
+/// \brief Errors of copy_file_range() and sendfile() if the file systems don't support them.
+bool isUnsupported(int error)
+{
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP;
+}
+
+ssize_t bufferedCopy(int in, int out, qint64 offset, qint64 length, QByteArray& buffer)
+{
+    if (buffer.isEmpty()) {
+        buffer.resize(static_cast<int>(chunkSize));
+    }
+    const ssize_t read = ::pread(in, buffer.data(), static_cast<size_t>(length), offset);
+    if (read <= 0) {
+        return read;
+    }
+    ssize_t written = 0;
+    while (written < read) {
+        const ssize_t count = ::pwrite(out,
+            buffer.constData() + written,
+            static_cast<size_t>(read - written),
+            static_cast<off_t>(offset + written));
+        if (count < 0 && errno != EINTR) {
+            return -1;
+        }
+        written += qMax<ssize_t>(0, count);
+    }
+    return read;
+}
+
+#endif
+
+} // namespace
+
+namespace mediaelch {
+
+bool FileTransfer::transfer(const QString& source,
+    const QString& destination,
+    const Options& options,
+    const std::atomic_bool& aborted,
+    const ProgressFunction& onProgress)
+{
+    const QFileInfo sourceInfo(source);
+    if (!sourceInfo.isFile()) {
+        qCWarning(generic) << "[FileTransfer] Source file does not exist:" << source;
+        return false;
+    }
+    if (QFileInfo::exists(destination)) {
+        qCWarning(generic) << "[FileTransfer] Destination file already exists:" << destination;
+        return false;
+    }
+    QDir().mkpath(QFileInfo(destination).absolutePath());
+
+    if (options.mode == Mode::Move && options.renameOnSameVolume) {
+        // Not QFile::rename() or QDir::rename(): they may copy files to other volumes
+        // without progress, part file and checksum.
+        switch (renameFile(source, destination)) {
+        case RenameResult::Renamed:
+            onProgress(sourceInfo.size());
+            return true;
+        case RenameResult::OtherVolume:
+            qCDebug(generic) << "[FileTransfer] Destination is on another volume, copying:" << source;
+            break;
+        case RenameResult::Failed:
+            qCWarning(generic) << "[FileTransfer] Could not move" << source << "to" << destination;
+            return false;
+        }
+    }
+
+    if (!copy(source, destination, options, aborted, onProgress)) {
+        return false;
+    }
+
+    if (options.mode == Mode::Move && !QFile::remove(source)) {
+        qCWarning(generic) << "[FileTransfer] Could not remove the moved file:" << source;
+    }
+    return true;
+}
+
+bool FileTransfer::copy(const QString& source,
+    const QString& destination,
+    const Options& options,
+    const std::atomic_bool& aborted,
+    const ProgressFunction& onProgress)
+{
+    const QString part = partFileName(destination);
+    const qint64 size = QFileInfo(source).size();
+
+    qint64 offset = 0;
+    const QFileInfo partInfo(part);
+    if (partInfo.exists() && partInfo.size() <= size) {
+        offset = qMax<qint64>(0, partInfo.size() - resumeOverlap);
+        qCInfo(generic) << "[FileTransfer] Resuming" << destination << "at byte" << offset;
+        onProgress(offset);
+    }
+
+    if (!copyData(source, part, offset, aborted, onProgress)) {
+        if (!aborted.load()) {
+            qCWarning(generic) << "[FileTransfer] Could not copy" << source << "to" << part;
+        }
+        return false;
+    }
+
+    if (options.verifyChecksum && !sameChecksum(source, part)) {
+        qCWarning(generic) << "[FileTransfer] Checksums differ, removing the copy:" << part;
+        QFile::remove(part);
+        return false;
+    }
+
+    QFile::setPermissions(part, QFile::permissions(source));
+    if (!QDir().rename(part, destination)) {
+        qCWarning(generic) << "[FileTransfer] Could not rename" << part << "to" << destination;
+        return false;
+    }
+    return true;
+}
+
+#ifdef Q_OS_LINUX
+
+bool FileTransfer::copyData(const QString& source,
+    const QString& target,
+    qint64 offset,
+    const std::atomic_bool& aborted,
+    const ProgressFunction& onProgress)
+{
+    const int in = ::open(QFile::encodeName(source).constData(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+    const int out = ::open(QFile::encodeName(target).constData(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+
+    struct stat sourceStat = {};
+    bool ok = ::fstat(in, &sourceStat) == 0 && ::ftruncate(out, static_cast<off_t>(offset)) == 0;
+    const qint64 size = sourceStat.st_size;
+
+    // copy_file_range() copies in the kernel and lets file systems clone data or copy it
+    // on the server side. sendfile() copies in the kernel, too. Both are tried once.
+    bool useCopyFileRange = true;
+    bool useSendfile = true;
+    QByteArray buffer;
+
+    while (ok && offset < size) {
+        if (aborted.load()) {
+            ok = false;
+            break;
+        }
+        const qint64 length = qMin(chunkSize, size - offset);
+        ssize_t copied = -1;
+
+        if (useCopyFileRange) {
+#    ifdef SYS_copy_file_range
+            loff_t inOffset = offset;
+            loff_t outOffset = offset;
+            copied = static_cast<ssize_t>(
+                ::syscall(SYS_copy_file_range, in, &inOffset, out, &outOffset, static_cast<size_t>(length), 0U));
+            if (copied < 0 && isUnsupported(errno)) {
+                useCopyFileRange = false;
+                continue;
+            }
+#    else
+            useCopyFileRange = false;
+            continue;
+#    endif
+        } else if (useSendfile) {
+            // sendfile() writes at the output's file offset.
+            if (::lseek(out, static_cast<off_t>(offset), SEEK_SET) < 0) {
+                ok = false;
+                break;
+            }
+            off_t inOffset = static_cast<off_t>(offset);
+            copied = ::sendfile(out, in, &inOffset, static_cast<size_t>(length));
+            if (copied < 0 && isUnsupported(errno)) {
+                useSendfile = false;
+                continue;
+            }
+        } else {
+            copied = bufferedCopy(in, out, offset, length, buffer);
+        }
+
+        if (copied < 0 && errno == EINTR) {
+            continue;
+        }
+        if (copied <= 0) {
+            // Zero if the source was truncated in the meantime.
+            ok = false;
+            break;
+        }
+        offset += copied;
+        onProgress(copied);
+    }
+
+    // The part file is renamed afterwards; its data must be on disk before that.
+    ok = ok && ::fsync(out) == 0;
+    ::close(out);
+    ::close(in);
+    return ok;
+}
+
+#else
+
+bool FileTransfer::copyData(const QString& source,
+    const QString& target,
+    qint64 offset,
+    const std::atomic_bool& aborted,
+    const ProgressFunction& onProgress)
+{
+    QFile in(source);
+    QFile out(target);
+    // ReadWrite doesn't truncate the part file.
+    if (!in.open(QIODevice::ReadOnly) || !out.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    if (!out.resize(offset) || !in.seek(offset) || !out.seek(offset)) {
+        return false;
+    }
+
+    QByteArray buffer(static_cast<int>(chunkSize), Qt::Uninitialized);
+    while (!in.atEnd()) {
+        if (aborted.load()) {
+            return false;
+        }
+        const qint64 read = in.read(buffer.data(), chunkSize);
+        if (read <= 0 || out.write(buffer.constData(), read) != read) {
+            return false;
+        }
+        onProgress(read);
+    }
+
+    if (!out.flush()) {
+        return false;
+    }
+#    ifdef Q_OS_UNIX
+    return ::fsync(out.handle()) == 0;
+#    else
+    return true;
+#    endif
+}
+
+#endif
+
+bool FileTransfer::sameChecksum(const QString& file1, const QString& file2)
+{
+    const auto checksum = [](const QString& fileName) {
+        QFile file(fileName);
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file)) {
+            return QByteArray();
+        }
+        return hash.result();
+    };
+    const QByteArray checksum1 = checksum(file1);
+    return !checksum1.isEmpty() && checksum1 == checksum(file2);
+}
+
+FileTransferQueue::FileTransferQueue(Options options, QObject* parent) :
+    QObject(parent), m_options{std::move(options)}
+{
+    m_progressTimer.setInterval(progressIntervalMs);
+    connect(&m_progressTimer, &QTimer::timeout, this, &FileTransferQueue::reportProgress);
+}
+
+FileTransferQueue::~FileTransferQueue()
+{
+    m_aborted.store(true);
+    for (const auto& pool : m_pools) {
+        pool->waitForDone();
+    }
+}
+
+void FileTransferQueue::add(const QString& source, const QString& destination)
+{
+    Q_ASSERT(!m_running);
+    Item item;
+    item.source = source;
+    item.destination = destination;
+    m_items << item;
+    m_bytesTotal += QFileInfo(source).size();
+}
+
+void FileTransferQueue::start()
+{
+    Q_ASSERT(!m_running);
+    m_running = true;
+    qCInfo(generic) << "[FileTransferQueue] Transferring" << m_items.size() << "files," << m_bytesTotal << "bytes";
+
+    QHash<QString, int> volumes;
+    for (int i = 0; i < m_items.size(); ++i) {
+        const Item item = m_items.at(i);
+        const QString volume = volumeOf(item.destination);
+        if (!volumes.contains(volume)) {
+            auto pool = std::make_unique<QThreadPool>();
+            pool->setMaxThreadCount(qMax(1, m_options.maxTransfersPerVolume));
+            volumes.insert(volume, static_cast<int>(m_pools.size()));
+            m_pools.push_back(std::move(pool));
+        }
+
+        m_pools[static_cast<size_t>(volumes.value(volume))]->start(new Task([this, i, item]() {
+            const bool success = !m_aborted.load()
+                                 && FileTransfer::transfer(item.source,
+                                     item.destination,
+                                     m_options.transfer,
+                                     m_aborted,
+                                     [this](qint64 bytes) { m_bytesDone += bytes; });
+            QMetaObject::invokeMethod(
+                this, "onTransferFinished", Qt::QueuedConnection, Q_ARG(int, i), Q_ARG(bool, success));
+        }));
+    }
+
+    m_throughputTimer.start();
+    m_progressTimer.start();
+    finishIfDone();
+}
+
+void FileTransferQueue::abort()
+{
+    m_aborted.store(true);
+}
+
+void FileTransferQueue::onTransferFinished(int index, bool success)
+{
+    ++m_completed;
+    if (!success) {
+        ++m_failed;
+    }
+    const Item& item = m_items.at(index);
+    emit fileFinished(item.source, item.destination, success);
+    finishIfDone();
+}
+
+void FileTransferQueue::reportProgress()
+{
+    const qint64 done = qMin(m_bytesDone.load(), m_bytesTotal);
+    const qint64 elapsedMs = m_throughputTimer.restart();
+    if (elapsedMs > 0) {
+        const double current = static_cast<double>(done - m_lastBytesDone) * 1000.0 / elapsedMs;
+        // Moving average, so that the throughput doesn't jump around.
+        m_bytesPerSecond = (m_bytesPerSecond <= 0.0) ? current : 0.8 * m_bytesPerSecond + 0.2 * current;
+    }
+    m_lastBytesDone = done;
+    emit progress(done, m_bytesTotal, qRound64(m_bytesPerSecond));
+}
+
+void FileTransferQueue::finishIfDone()
+{
+    if (!m_running || m_completed < m_items.size()) {
+        return;
+    }
+    m_running = false;
+    m_progressTimer.stop();
+    reportProgress();
+    qCInfo(generic) << "[FileTransferQueue] Transferred" << (m_items.size() - m_failed) << "of" << m_items.size()
+                    << "files";
+    emit finished(m_failed);
+}
+
+} // namespace mediaelch
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QThreadPool;
+
+namespace mediaelch {
+
+/// \brief Copies or moves a single file. Blocks until the file is transferred.
+///
+/// Data is copied in large chunks, on Linux in the kernel with copy_file_range() or
+/// sendfile(), so that it isn't copied to user space. Other systems and file systems
+/// that support neither use buffered reads and writes.
+///
+/// Data is written to "<destination>.part" first, which is renamed once all data is
+/// on disk. If a transfer is interrupted, the next transfer of the same file resumes
+/// the part file. Existing destination files are never overwritten.
+///
+/// Moves are renames if source and destination are on the same volume. Otherwise the
+/// file is copied, optionally verified and the source is removed afterwards. Renames
+/// never fall back to copies of the operating system, which would bypass the part file.
+class FileTransfer
+{
+public:
+    enum class Mode
+    {
+        Copy,
+        Move
+    };
+
+    struct Options
+    {
+        Mode mode = Mode::Copy;
+        /// Compare the checksums of source and copy before the copy is renamed and, for
+        /// moves, the source is removed. Renamed files are not verified.
+        bool verifyChecksum = false;
+        /// Moves on the same volume are renames. If false, moved files are always copied
+        /// and the source is removed afterwards, so that they can be verified as well.
+        bool renameOnSameVolume = true;
+    };
+
+    /// \brief Called with the number of bytes that were transferred since the last call.
+    using ProgressFunction = std::function<void(qint64 bytes)>;
+
+    /// \brief Transfers the file. Returns false on errors and if aborted.
+    /// \param aborted Checked after each chunk. The part file is kept for resuming.
+    static bool transfer(const QString& source,
+        const QString& destination,
+        const Options& options,
+        const std::atomic_bool& aborted,
+        const ProgressFunction& onProgress);
+
+    static QString partFileName(const QString& destination) { return destination + QStringLiteral(".part"); }
+
+private:
+    static bool copy(const QString& source,
+        const QString& destination,
+        const Options& options,
+        const std::atomic_bool& aborted,
+        const ProgressFunction& onProgress);
+    static bool copyData(const QString& source,
+        const QString& target,
+        qint64 offset,
+        const std::atomic_bool& aborted,
+        const ProgressFunction& onProgress);
+    static bool sameChecksum(const QString& file1, const QString& file2);
+};
+
+/// \brief Transfers many files with several threads, e.g. for imports.
+///
+/// Every destination volume has its own thread pool, so that the number of concurrent
+/// transfers per volume is limited: several transfers saturate a network link better
+/// than one, but too many would only compete for the disk. Transfers to different
+/// volumes don't block each other.
+///
+/// The number of transferred bytes and the throughput are reported periodically on
+/// the thread that the queue lives in.
+///
+/// \par Example
+/// \code{cpp}
+///   FileTransferQueue::Options options;
+///   options.transfer.mode = FileTransfer::Mode::Move;
+///   auto* queue = new FileTransferQueue(options, this);
+///   queue->add("/downloads/Movie.mkv", "/nas/Movies/Movie (2020)/Movie.mkv");
+///   connect(queue, &FileTransferQueue::progress, this, &MyDialog::onProgress);
+///   connect(queue, &FileTransferQueue::finished, queue, &QObject::deleteLater);
+///   queue->start();
+/// \endcode
+class FileTransferQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        FileTransfer::Options transfer;
+        /// Maximum number of files that are transferred at the same time per destination volume.
+        int maxTransfersPerVolume = 2;
+    };
+
+public:
+    explicit FileTransferQueue(Options options, QObject* parent = nullptr);
+    /// \brief Aborts running transfers and waits for them.
+    ~FileTransferQueue() override;
+
+    /// \brief Adds a file. No files may be added after start().
+    void add(const QString& source, const QString& destination);
+    void start();
+    /// \brief Stops all transfers after their current chunk. finished() is emitted
+    ///        once the running transfers have stopped.
+    void abort();
+
+    int count() const { return m_items.size(); }
+    bool isRunning() const { return m_running; }
+    qint64 bytesTotal() const { return m_bytesTotal; }
+    qint64 bytesDone() const { return m_bytesDone.load(); }
+
+signals:
+    /// \brief Emitted periodically while files are transferred.
+    /// \param bytesPerSecond Throughput of the last seconds.
+    void progress(qint64 bytesDone, qint64 bytesTotal, qint64 bytesPerSecond);
+    void fileFinished(QString source, QString destination, bool success);
+    /// \param failed Number of files that weren't transferred.
+    void finished(int failed);
+
+private slots:
+    void onTransferFinished(int index, bool success);
+    void reportProgress();
+
+private:
+    struct Item
+    {
+        QString source;
+        QString destination;
+    };
+
+    void finishIfDone();
+
+private:
+    Options m_options;
+    QVector<Item> m_items;
+    std::vector<std::unique_ptr<QThreadPool>> m_pools;
+    std::atomic_bool m_aborted{false};
+    std::atomic<qint64> m_bytesDone{0};
+    qint64 m_bytesTotal = 0;
+    bool m_running = false;
+    int m_completed = 0;
+    int m_failed = 0;
+
+    QTimer m_progressTimer;
+    QElapsedTimer m_throughputTimer;
+    qint64 m_lastBytesDone = 0;
+    double m_bytesPerSecond = 0.0;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,185 @@
+#include "file/FileWriter.h"
+
+#include "log/Log.h"
+#include "log/Perf.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace {
+
+/// Upper bound of remembered files. The cache is cleared if it grows larger.
+constexpr int MAX_KNOWN_FILES = 100000;
+
+QByteArray contentHash(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+} // namespace
+
+namespace mediaelch {
+
+FileWriter& FileWriter::global()
+{
+    static FileWriter writer;
+    return writer;
+}
+
+FileWriter::Result FileWriter::write(const QString& filePath, const QByteArray& data, QIODevice::OpenMode mode)
+{
+    const QByteArray hash = contentHash(data);
+    Result result = Result::Written;
+
+    if (hasContent(filePath, data, hash, mode)) {
+        result = Result::Skipped;
+    } else if (writeFile(filePath, data, mode)) {
+        remember(filePath, hash);
+    } else {
+        qCWarning(generic) << "[FileWriter] Could not write file:" << filePath;
+        result = Result::Failed;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    switch (result) {
+    case Result::Written:
+        ++m_statistics.written;
+        m_statistics.bytesWritten += data.size();
+        perf::count("files.written");
+        break;
+    case Result::Skipped:
+        ++m_statistics.skipped;
+        m_statistics.bytesSkipped += data.size();
+        perf::count("files.skipped");
+        break;
+    case Result::Failed: ++m_statistics.failed; break;
+    }
+    return result;
+}
+
+bool FileWriter::remove(const QString& filePath)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_knownFiles.remove(filePath);
+    }
+    if (!QFileInfo::exists(filePath) || QFile::remove(filePath)) {
+        return true;
+    }
+    qCWarning(generic) << "[FileWriter] Could not remove file:" << filePath;
+    return false;
+}
+
+void FileWriter::setAtomicWrites(bool atomicWrites)
+{
+    m_atomicWrites.store(atomicWrites);
+}
+
+bool FileWriter::atomicWrites() const
+{
+    return m_atomicWrites.load();
+}
+
+FileWriter::Statistics FileWriter::statistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_statistics;
+}
+
+void FileWriter::resetStatistics()
+{
+    QMutexLocker locker(&m_mutex);
+    m_statistics = Statistics{};
+}
+
+bool FileWriter::hasContent(const QString& filePath,
+    const QByteArray& data,
+    const QByteArray& hash,
+    QIODevice::OpenMode mode)
+{
+    perf::ScopedTimer timer("files.compare");
+    const QFileInfo info(filePath);
+    if (!info.isFile()) {
+        return false;
+    }
+    const bool textMode = mode.testFlag(QIODevice::Text);
+#ifdef Q_OS_WIN
+    // Line endings are converted in text mode, so the file size differs from the data's size.
+    const bool sizeIsComparable = !textMode;
+#else
+    const bool sizeIsComparable = true;
+#endif
+    if (sizeIsComparable && info.size() != data.size()) {
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto known = m_knownFiles.constFind(filePath);
+        if (known != m_knownFiles.constEnd() && known->size == info.size()
+            && known->lastModified == info.lastModified()) {
+            return known->hash == hash;
+        }
+    }
+
+    QFile file(filePath);
+    if (!file.open(textMode ? QIODevice::ReadOnly | QIODevice::Text : QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray onDisk = file.readAll();
+    file.close();
+
+    const bool isEqual = (onDisk == data);
+    remember(filePath, isEqual ? hash : contentHash(onDisk));
+    return isEqual;
+}
+
+bool FileWriter::writeFile(const QString& filePath, const QByteArray& data, QIODevice::OpenMode mode)
+{
+    perf::ScopedTimer timer("files.write");
+    QDir saveFileDir = QFileInfo(filePath).dir();
+    if (!saveFileDir.exists()) {
+        saveFileDir.mkpath(".");
+    }
+
+    if (!m_atomicWrites.load()) {
+        QFile file(filePath);
+        if (!file.open(mode)) {
+            return false;
+        }
+        return file.write(data) == data.size();
+    }
+
+    // QSaveFile writes into a temporary file, syncs it to disk and renames it on commit().
+    QSaveFile file(filePath);
+    if (!file.open(mode)) {
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        file.commit();
+        return false;
+    }
+    return file.commit();
+}
+
+void FileWriter::remember(const QString& filePath, const QByteArray& hash)
+{
+    const QFileInfo info(filePath);
+    KnownFile knownFile;
+    knownFile.size = info.size();
+    knownFile.lastModified = info.lastModified();
+    knownFile.hash = hash;
+
+    QMutexLocker locker(&m_mutex);
+    if (m_knownFiles.size() >= MAX_KNOWN_FILES) {
+        m_knownFiles.clear();
+    }
+    m_knownFiles.insert(filePath, knownFile);
+}
+
+} // namespace mediaelch
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QIODevice>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+namespace mediaelch {
+
+/// \brief Thread-safe writer for NFO and image files.
+///
+/// Files whose content is already on disk are not written again, so that their
+/// modification time doesn't change.  Kodi and other media centers would rescan
+/// such files otherwise.  To avoid reading files over and over again, the size,
+/// modification time and hash of files that were compared or written are
+/// remembered.
+///
+/// By default, files are written atomically: content is written to a temporary
+/// file that is synced to disk and renamed afterwards, so that a crash never
+/// leaves half-written files behind.
+///
+/// \par Example
+/// \code{cpp}
+///   FileWriter::Result result = FileWriter::global().write(nfoFilePath, xmlContent);
+/// \endcode
+class FileWriter
+{
+public:
+    enum class Result
+    {
+        Written,
+        /// The file already has the given content.
+        Skipped,
+        Failed
+    };
+
+    struct Statistics
+    {
+        qint64 written = 0;
+        qint64 skipped = 0;
+        qint64 failed = 0;
+        /// Bytes of written and skipped files.
+        qint64 bytesWritten = 0;
+        qint64 bytesSkipped = 0;
+    };
+
+public:
+    FileWriter() = default;
+
+    /// \brief Writer that is used for all media files.
+    static FileWriter& global();
+
+    /// \brief Writes data to the given file and creates its directory if necessary.
+    /// \param mode Open mode for writing. If QIODevice::Text is set, existing files
+    ///             are read in text mode as well for comparing their content.
+    Result write(const QString& filePath, const QByteArray& data, QIODevice::OpenMode mode = QIODevice::WriteOnly);
+    /// \brief Removes the given file. Returns true if the file does not exist afterwards.
+    bool remove(const QString& filePath);
+
+    /// \brief If false, files are overwritten in-place and are not synced to disk.
+    ///        Faster on some network shares but not crash-safe. Default: true
+    void setAtomicWrites(bool atomicWrites);
+    bool atomicWrites() const;
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    struct KnownFile
+    {
+        qint64 size = 0;
+        QDateTime lastModified;
+        QByteArray hash;
+    };
+
+    bool hasContent(const QString& filePath, const QByteArray& data, const QByteArray& hash, QIODevice::OpenMode mode);
+    bool writeFile(const QString& filePath, const QByteArray& data, QIODevice::OpenMode mode);
+    void remember(const QString& filePath, const QByteArray& hash);
+
+private:
+    std::atomic<bool> m_atomicWrites{true};
+    mutable QMutex m_mutex;
+    QHash<QString, KnownFile> m_knownFiles;
+    Statistics m_statistics;
+};
+
+} // namespace mediaelch
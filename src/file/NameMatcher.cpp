@@ -0,0 +1,161 @@
+#include "file/NameMatcher.h"
+
+#include "log/Log.h"
+
+namespace {
+
+/// Options that can be expressed as inline flags, e.g. "(?i:...)".
+constexpr QRegularExpression::PatternOptions inlineOptions = QRegularExpression::CaseInsensitiveOption
+                                                             | QRegularExpression::DotMatchesEverythingOption
+                                                             | QRegularExpression::MultilineOption
+                                                             | QRegularExpression::ExtendedPatternSyntaxOption
+                                                             | QRegularExpression::InvertedGreedinessOption
+                                                             | QRegularExpression::DontCaptureOption;
+
+QString inlineFlags(QRegularExpression::PatternOptions options)
+{
+    QString flags;
+    if (options.testFlag(QRegularExpression::CaseInsensitiveOption)) {
+        flags += 'i';
+    }
+    if (options.testFlag(QRegularExpression::DotMatchesEverythingOption)) {
+        flags += 's';
+    }
+    if (options.testFlag(QRegularExpression::MultilineOption)) {
+        flags += 'm';
+    }
+    if (options.testFlag(QRegularExpression::ExtendedPatternSyntaxOption)) {
+        flags += 'x';
+    }
+    if (options.testFlag(QRegularExpression::InvertedGreedinessOption)) {
+        flags += 'U';
+    }
+    return flags;
+}
+
+/// Group numbers change in a combined pattern, so backreferences and subroutine
+/// calls would refer to other groups.
+bool refersToGroups(const QString& pattern)
+{
+    static const QRegularExpression references(R"(\\[1-9gk]|\(\?P[=>]|\(\?[-+]?[0-9R&])");
+    return pattern.contains(references);
+}
+
+QString wildcardToPattern(const QString& wildcard)
+{
+    QString pattern;
+    for (int i = 0; i < wildcard.size(); ++i) {
+        const QChar c = wildcard.at(i);
+        if (c == '*') {
+            pattern += QStringLiteral(".*");
+        } else if (c == '?') {
+            pattern += '.';
+        } else if (c == '[' && wildcard.indexOf(']', i + 2) > 0) {
+            // Character classes such as "[0-9]" or "[!a]" are kept.
+            const int end = wildcard.indexOf(']', i + 2);
+            QString characterClass = wildcard.mid(i + 1, end - i - 1);
+            characterClass.replace('\\', QStringLiteral("\\\\"));
+            if (characterClass.startsWith('!')) {
+                characterClass[0] = '^';
+            }
+            pattern += '[' + characterClass + ']';
+            i = end;
+        } else {
+            pattern += QRegularExpression::escape(QString(c));
+        }
+    }
+    return QStringLiteral("\\A(?:%1)\\z").arg(pattern);
+}
+
+QRegularExpression compiled(const QString& pattern)
+{
+    QRegularExpression regex(pattern);
+    regex.optimize();
+    return regex;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+NameMatcher::NameMatcher(const QVector<QRegularExpression>& patterns,
+    const QStringList& parts,
+    const QStringList& names)
+{
+    QStringList alternatives;
+    // Used if the alternatives can't be combined.
+    QVector<QRegularExpression> fallback;
+    for (const QRegularExpression& regex : patterns) {
+        if (!regex.isValid()) {
+            qCWarning(generic) << "[NameMatcher] Ignoring invalid pattern:" << regex.pattern();
+            continue;
+        }
+        if ((regex.patternOptions() & ~inlineOptions) != 0 || refersToGroups(regex.pattern())) {
+            QRegularExpression separate(regex);
+            separate.optimize();
+            m_separate << separate;
+            continue;
+        }
+        alternatives << QStringLiteral("(?%1:%2)").arg(inlineFlags(regex.patternOptions()), regex.pattern());
+        fallback << regex;
+    }
+
+    QStringList escapedParts;
+    for (const QString& part : parts) {
+        escapedParts << QRegularExpression::escape(part);
+    }
+    if (!escapedParts.isEmpty()) {
+        alternatives << QStringLiteral("(?i:%1)").arg(escapedParts.join('|'));
+        fallback << QRegularExpression(alternatives.last());
+    }
+
+    QStringList escapedNames;
+    for (const QString& name : names) {
+        escapedNames << QRegularExpression::escape(name);
+    }
+    if (!escapedNames.isEmpty()) {
+        alternatives << QStringLiteral("(?i:\\A(?:%1)\\z)").arg(escapedNames.join('|'));
+        fallback << QRegularExpression(alternatives.last());
+    }
+
+    if (alternatives.isEmpty()) {
+        return;
+    }
+
+    m_combined = compiled(alternatives.join('|'));
+    m_hasCombined = m_combined.isValid();
+    if (!m_hasCombined) {
+        // Some patterns are only valid on their own, e.g. ones with an unterminated "\Q".
+        qCDebug(generic) << "[NameMatcher] Patterns can't be combined, matching them separately";
+        for (QRegularExpression& regex : fallback) {
+            regex.optimize();
+            m_separate << regex;
+        }
+    }
+}
+
+NameMatcher NameMatcher::fromWildcards(const QStringList& wildcards, Qt::CaseSensitivity cs)
+{
+    const auto options =
+        cs == Qt::CaseInsensitive ? QRegularExpression::CaseInsensitiveOption : QRegularExpression::NoPatternOption;
+    QVector<QRegularExpression> patterns;
+    for (const QString& wildcard : wildcards) {
+        patterns << QRegularExpression(wildcardToPattern(wildcard), options);
+    }
+    return NameMatcher(patterns, {}, {});
+}
+
+bool NameMatcher::matches(const QString& name) const
+{
+    if (m_hasCombined && m_combined.match(name).hasMatch()) {
+        return true;
+    }
+    for (const QRegularExpression& regex : m_separate) {
+        if (regex.match(name).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace mediaelch {
+
+/// \brief Matches file or folder names against many rules with a single regular expression.
+///
+/// Directory scanners check every directory entry against the user's exclude patterns,
+/// extras suffixes such as "-trailer" and special folder names such as "extrafanart".
+/// Instead of running each rule one after another, all rules are compiled into one
+/// alternation that is matched once per name.
+///
+/// Patterns keep their own pattern options. Patterns with backreferences can't be combined
+/// because their group numbers would change; they are matched separately.
+///
+/// Build a matcher once per scan, not per entry. Matching is thread-safe.
+///
+/// \par Example
+/// \code{cpp}
+///   NameMatcher matcher({}, {"-trailer", "-sample"}, {"extras"});
+///   matcher.matches("Movie-Trailer.mkv"); // true
+///   matcher.matches("Extras");            // true
+/// \endcode
+class NameMatcher
+{
+public:
+    /// \brief Matcher that matches no name at all.
+    NameMatcher() = default;
+    /// \param patterns Regular expressions that match (parts of) a name.
+    /// \param parts Literal texts that a name contains, compared case-insensitively.
+    /// \param names Literal names, compared case-insensitively.
+    NameMatcher(const QVector<QRegularExpression>& patterns, const QStringList& parts, const QStringList& names);
+
+    /// \brief Matcher for wildcard filters such as "*.mkv" that must match the whole name.
+    static NameMatcher fromWildcards(const QStringList& wildcards, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    bool matches(const QString& name) const;
+    bool isEmpty() const { return !m_hasCombined && m_separate.isEmpty(); }
+
+    /// \brief Pattern of the combined regular expression, e.g. for debugging.
+    QString pattern() const { return m_combined.pattern(); }
+
+private:
+    QRegularExpression m_combined;
+    bool m_hasCombined = false;
+    QVector<QRegularExpression> m_separate;
+};
+
+/// \brief Compiled rules for directory entries that scanners skip.
+struct ScanExcludes
+{
+    /// Files excluded by exclude patterns or because they are extras, e.g. trailers.
+    NameMatcher files;
+    /// Folders excluded by exclude patterns.
+    NameMatcher folders;
+    /// Folders excluded by exclude patterns or because they contain extras, e.g. "extrafanart".
+    NameMatcher foldersWithExtras;
+};
+
+} // namespace mediaelch
@@ -172,7 +172,7 @@ bool Filter::accepts(Movie* movie)
         return (m_hasInfo && movie->images().hasExtraFanarts()) || (!m_hasInfo && !movie->images().hasExtraFanarts());
     }
     if (isInfo(MovieFilters::Actors)) {
-        return (m_hasInfo && movie->actors().hasActors()) || (!m_hasInfo && !movie->actors().hasActors());
+        return (m_hasInfo && movie->hasActors()) || (!m_hasInfo && !movie->hasActors());
     }
     if (isInfo(MovieFilters::Logo)) {
         return (m_hasInfo && movie->hasImage(ImageType::MovieLogo))
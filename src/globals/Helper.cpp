@@ -251,63 +251,45 @@ QString appendArticle(const QString& text)
 
 QString mapGenre(const QString& text)
 {
-    if (Settings::instance()->advanced()->genreMappings().isEmpty()) {
-        return text;
-    }
-
-    if (Settings::instance()->advanced()->genreMappings().contains(text)) {
-        return Settings::instance()->advanced()->genreMappings().value(text);
-    }
-    return text;
+    return Settings::instance()->advanced()->genreMappings().value(text, text);
 }
 
 QStringList mapGenre(const QStringList& genres)
 {
-    if (Settings::instance()->advanced()->genreMappings().isEmpty()) {
+    const QHash<QString, QString>& mappings = Settings::instance()->advanced()->genreMappings();
+    if (mappings.isEmpty()) {
         return genres;
     }
 
     QStringList mappedGenres;
+    mappedGenres.reserve(genres.size());
     for (const QString& genre : genres) {
-        mappedGenres << mapGenre(genre);
+        mappedGenres << mappings.value(genre, genre);
     }
     return mappedGenres;
 }
 
 Certification mapCertification(const Certification& certification)
 {
-    if (Settings::instance()->advanced()->certificationMappings().isEmpty()) {
+    const QHash<QString, QString>& mappings = Settings::instance()->advanced()->certificationMappings();
+    if (mappings.isEmpty()) {
         return certification;
     }
-    const QString certStr = certification.toString();
-    if (Settings::instance()->advanced()->certificationMappings().contains(certStr)) {
-        return Certification(Settings::instance()->advanced()->certificationMappings().value(certStr));
+    const auto mapped = mappings.constFind(certification.toString());
+    if (mapped != mappings.constEnd()) {
+        return Certification(*mapped);
     }
     return certification;
 }
 
 QString mapStudio(const QString& text)
 {
-    if (Settings::instance()->advanced()->studioMappings().isEmpty()) {
-        return text;
-    }
-
-    if (Settings::instance()->advanced()->studioMappings().contains(text)) {
-        return Settings::instance()->advanced()->studioMappings().value(text);
-    }
-    return text;
+    return Settings::instance()->advanced()->studioMappings().value(text, text);
 }
 
 QString mapCountry(const QString& text)
 {
-    if (Settings::instance()->advanced()->countryMappings().isEmpty()) {
-        return text;
-    }
-
-    if (Settings::instance()->advanced()->countryMappings().contains(text)) {
-        return Settings::instance()->advanced()->countryMappings().value(text);
-    }
-    return text;
+    return Settings::instance()->advanced()->countryMappings().value(text, text);
 }
 
 QString formatFileSizeBinary(double size, const QLocale& locale)
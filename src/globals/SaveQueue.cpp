@@ -0,0 +1,245 @@
+#include "globals/SaveQueue.h"
+
+#include "data/DatabaseService.h"
+#include "file/FileWriter.h"
+#include "log/Log.h"
+#include "log/Perf.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QStorageInfo>
+#include <QtConcurrent>
+
+namespace {
+
+/// Maximum time that items are saved on the GUI thread before other events are handled.
+constexpr int TIME_SLICE_MS = 15;
+/// Concurrent writes per volume. More writes only make spinning disks seek.
+constexpr int MAX_WRITES_PER_VOLUME = 2;
+/// Saving is paused if this many writes are queued, because each one holds its file's content.
+constexpr int MAX_QUEUED_WRITES = 64;
+
+/// Queue whose item is currently saved in this thread.
+thread_local mediaelch::SaveQueue* currentQueue = nullptr;
+
+} // namespace
+
+namespace mediaelch {
+
+SaveQueue::SaveQueue(DatabaseService* database, QObject* parent) : QObject(parent), m_database{database}
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(0);
+    connect(&m_timer, &QTimer::timeout, this, &SaveQueue::saveNextItems);
+    m_writePool.setMaxThreadCount(8);
+}
+
+SaveQueue::~SaveQueue()
+{
+    m_writePool.waitForDone();
+    if (m_holdsDatabase) {
+        m_database->releaseWrites();
+    }
+}
+
+void SaveQueue::add(QObject* object, SaveFunction save, CompletedFunction completed)
+{
+    Q_ASSERT(!m_running);
+    Item item;
+    item.object = object;
+    item.save = std::move(save);
+    item.completed = std::move(completed);
+    m_items.push_back(std::move(item));
+}
+
+void SaveQueue::start()
+{
+    Q_ASSERT(!m_running);
+    qCDebug(generic) << "[SaveQueue] Saving" << m_items.count() << "items";
+    m_running = true;
+    if (m_database != nullptr) {
+        m_database->holdWrites();
+        m_holdsDatabase = true;
+    }
+    m_filesAtStart = FileWriter::global().statistics();
+    emit progress(0, m_items.count());
+    m_timer.start();
+}
+
+bool SaveQueue::writeFile(const QString& filePath, const QByteArray& data, QIODevice::OpenMode mode)
+{
+    if (currentQueue != nullptr && currentQueue->m_currentItem >= 0) {
+        currentQueue->enqueueWrite({currentQueue->m_currentItem, filePath, data, mode});
+        return true;
+    }
+    return writeFileNow(filePath, data, mode);
+}
+
+bool SaveQueue::removeFile(const QString& filePath)
+{
+    if (currentQueue != nullptr && currentQueue->m_currentItem >= 0) {
+        currentQueue->enqueueWrite({currentQueue->m_currentItem, filePath, {}, QIODevice::NotOpen, true});
+        return true;
+    }
+    return FileWriter::global().remove(filePath);
+}
+
+void SaveQueue::saveNextItems()
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (m_nextItem < m_items.count() && m_queuedWrites < MAX_QUEUED_WRITES && timer.elapsed() < TIME_SLICE_MS) {
+        m_currentItem = m_nextItem++;
+        Item& item = m_items[m_currentItem];
+        if (!item.object.isNull()) {
+            perf::ScopedTimer saveTimer("save.item");
+            currentQueue = this;
+            item.failed = !item.save();
+            currentQueue = nullptr;
+        }
+        item.saved = true;
+        if (item.pendingWrites == 0) {
+            completeItem(item);
+        }
+    }
+    m_currentItem = -1;
+
+    if (m_nextItem < m_items.count()) {
+        // If too many writes are queued, saving is resumed by onWriteFinished().
+        if (m_queuedWrites < MAX_QUEUED_WRITES) {
+            m_timer.start();
+        }
+        return;
+    }
+    finishIfDone();
+}
+
+void SaveQueue::enqueueWrite(Write write)
+{
+    ++m_items[write.item].pendingWrites;
+    ++m_queuedWrites;
+    const QString volume = volumeOf(write.filePath);
+    m_writesByVolume[volume].enqueue(std::move(write));
+    startWrites(volume);
+}
+
+void SaveQueue::startWrites(const QString& volume)
+{
+    QQueue<Write>& writes = m_writesByVolume[volume];
+    int& runningWrites = m_runningWritesByVolume[volume];
+    // Writes to a file that is currently written are skipped, so that they can't overtake
+    // or race with the earlier write.  Both are in the same volume's queue, so they're
+    // started once the earlier write finished.
+    auto next = writes.begin();
+    while (runningWrites < MAX_WRITES_PER_VOLUME && next != writes.end()) {
+        if (m_filesBeingWritten.contains(next->filePath)) {
+            ++next;
+            continue;
+        }
+        const Write write = *next;
+        next = writes.erase(next);
+        ++runningWrites;
+        m_filesBeingWritten.insert(write.filePath);
+
+        auto* watcher = new QFutureWatcher<bool>(this);
+        const int item = write.item;
+        const QString filePath = write.filePath;
+        connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, volume, filePath, item]() {
+            watcher->deleteLater();
+            onWriteFinished(volume, filePath, item, watcher->result());
+        });
+        watcher->setFuture(QtConcurrent::run(&m_writePool, &SaveQueue::executeWrite, write));
+    }
+}
+
+void SaveQueue::onWriteFinished(const QString& volume, const QString& filePath, int item, bool success)
+{
+    --m_runningWritesByVolume[volume];
+    --m_queuedWrites;
+    m_filesBeingWritten.remove(filePath);
+
+    Item& savedItem = m_items[item];
+    if (!success) {
+        savedItem.failed = true;
+    }
+    if (--savedItem.pendingWrites == 0 && savedItem.saved) {
+        completeItem(savedItem);
+    }
+
+    startWrites(volume);
+    if (m_nextItem < m_items.count()) {
+        if (!m_timer.isActive()) {
+            m_timer.start();
+        }
+        return;
+    }
+    finishIfDone();
+}
+
+void SaveQueue::completeItem(Item& item)
+{
+    ++m_completedItems;
+    if (item.failed) {
+        ++m_failedItems;
+    }
+    if (item.completed && !item.object.isNull()) {
+        item.completed(!item.failed);
+    }
+    emit progress(m_completedItems, m_items.count());
+}
+
+void SaveQueue::finishIfDone()
+{
+    if (!m_running || m_nextItem < m_items.count() || m_queuedWrites > 0) {
+        return;
+    }
+    m_running = false;
+    if (m_holdsDatabase) {
+        m_database->releaseWrites();
+        m_holdsDatabase = false;
+    }
+    const FileWriter::Statistics files = FileWriter::global().statistics();
+    qCInfo(generic) << "[SaveQueue] Saved" << m_items.count() << "items," << m_failedItems << "failed; files written:"
+                    << (files.written - m_filesAtStart.written)
+                    << "unchanged:" << (files.skipped - m_filesAtStart.skipped);
+    emit finished(m_failedItems);
+}
+
+QString SaveQueue::volumeOf(const QString& filePath)
+{
+    const QString directory = QFileInfo(filePath).absolutePath();
+    auto cached = m_volumeByDirectory.constFind(directory);
+    if (cached != m_volumeByDirectory.constEnd()) {
+        return cached.value();
+    }
+
+    // The directory may not exist yet, e.g. ".actors", so use its nearest existing parent.
+    QString existingDirectory = directory;
+    while (!QFileInfo::exists(existingDirectory)) {
+        const QString parent = QFileInfo(existingDirectory).absolutePath();
+        if (parent == existingDirectory) {
+            break;
+        }
+        existingDirectory = parent;
+    }
+    const QStorageInfo storage(existingDirectory);
+    const QString volume = storage.isValid() ? storage.rootPath() : QString();
+    m_volumeByDirectory.insert(directory, volume);
+    return volume;
+}
+
+bool SaveQueue::writeFileNow(const QString& filePath, const QByteArray& data, QIODevice::OpenMode mode)
+{
+    return FileWriter::global().write(filePath, data, mode) != FileWriter::Result::Failed;
+}
+
+bool SaveQueue::executeWrite(const Write& write)
+{
+    if (write.remove) {
+        return FileWriter::global().remove(write.filePath);
+    }
+    return writeFileNow(write.filePath, write.data, write.mode);
+}
+
+} // namespace mediaelch
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "file/FileWriter.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QIODevice>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+namespace mediaelch {
+
+class DatabaseService;
+
+/// \brief Saves many movies, TV shows, episodes or concerts without freezing the UI.
+///
+/// Items are saved one after another on the GUI thread in short time slices, because
+/// the items themselves are not thread-safe.  Files that are written while an item is
+/// saved, see writeFile(), are written by a thread pool instead, with a limited number
+/// of concurrent writes per volume.  Writes and removals of the same file, see
+/// removeFile(), are executed in the order in which they were queued.  Database updates are held back until the whole
+/// queue is saved so that they are committed in a single transaction.
+///
+/// The queue never calls QApplication::processEvents(); use the progress() signal to
+/// update the UI.
+///
+/// \par Example
+/// \code{cpp}
+///   auto* queue = new SaveQueue(Manager::instance()->database()->service(), this);
+///   for (Movie* movie : changedMovies) {
+///       queue->add(movie,
+///           [movie]() { return movie->controller()->saveData(interface); },
+///           [movie](bool success) { movie->setChanged(!success); });
+///   }
+///   connect(queue, &SaveQueue::progress, this, &MovieWidget::onSaveProgress);
+///   connect(queue, &SaveQueue::finished, queue, &QObject::deleteLater);
+///   queue->start();
+/// \endcode
+class SaveQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    using SaveFunction = std::function<bool()>;
+    /// \brief Called once the item's save function returned and all of its files are written.
+    using CompletedFunction = std::function<void(bool success)>;
+
+    /// \param database Service whose writes are batched. May be null.
+    explicit SaveQueue(DatabaseService* database, QObject* parent = nullptr);
+    ~SaveQueue() override;
+
+    /// \brief Adds an item to the queue. Neither function is called if object was
+    ///        destroyed in the meantime.
+    /// \param completed Optional; receives whether the save function and all background
+    ///        writes of the item succeeded.  The save function only knows about the former.
+    void add(QObject* object, SaveFunction save, CompletedFunction completed = {});
+    /// \brief Starts saving all added items. No items may be added afterwards.
+    void start();
+
+    int count() const { return m_items.count(); }
+    bool isRunning() const { return m_running; }
+
+    /// \brief Writes data to the given file and creates its directory if necessary.
+    ///
+    /// If called while an item of a SaveQueue is saved, the file is written in the
+    /// background and true is returned.  A failed background write marks the item
+    /// as failed.  Otherwise the file is written immediately.
+    static bool writeFile(const QString& filePath,
+        const QByteArray& data,
+        QIODevice::OpenMode mode = QIODevice::WriteOnly);
+    /// \brief Removes the given file, e.g. an image that the user deleted.
+    ///
+    /// Like writeFile(), the file is removed in the background if called while an item of
+    /// a SaveQueue is saved, after all earlier writes to the same file.  Otherwise it is
+    /// removed immediately.
+    static bool removeFile(const QString& filePath);
+
+signals:
+    /// \brief Number of items that are completely saved, including their files.
+    void progress(int done, int total);
+    /// \brief Emitted once all items are saved and all files are written.
+    /// \param failed Number of items whose save function or file writes failed.
+    void finished(int failed);
+
+private:
+    struct Item
+    {
+        QPointer<QObject> object;
+        SaveFunction save;
+        CompletedFunction completed;
+        int pendingWrites = 0;
+        bool saved = false;
+        bool failed = false;
+    };
+
+    struct Write
+    {
+        int item;
+        QString filePath;
+        QByteArray data;
+        QIODevice::OpenMode mode;
+        /// If true, the file is removed instead of written.
+        bool remove = false;
+    };
+
+    void saveNextItems();
+    void enqueueWrite(Write write);
+    void startWrites(const QString& volume);
+    void onWriteFinished(const QString& volume, const QString& filePath, int item, bool success);
+    void completeItem(Item& item);
+    void finishIfDone();
+    QString volumeOf(const QString& filePath);
+    static bool writeFileNow(const QString& filePath, const QByteArray& data, QIODevice::OpenMode mode);
+    static bool executeWrite(const Write& write);
+
+private:
+    DatabaseService* m_database;
+    QVector<Item> m_items;
+    QTimer m_timer;
+    QThreadPool m_writePool;
+    bool m_running = false;
+    bool m_holdsDatabase = false;
+    int m_nextItem = 0;
+    int m_currentItem = -1;
+    int m_completedItems = 0;
+    int m_failedItems = 0;
+    int m_queuedWrites = 0;
+    QHash<QString, QQueue<Write>> m_writesByVolume;
+    QHash<QString, int> m_runningWritesByVolume;
+    /// Files that are currently written or removed. Further writes to them wait in their volume's queue.
+    QSet<QString> m_filesBeingWritten;
+    QHash<QString, QString> m_volumeByDirectory;
+    /// Used to report how many files were written or skipped because they were unchanged.
+    FileWriter::Statistics m_filesAtStart;
+};
+
+} // namespace mediaelch
@@ -29,14 +29,6 @@ bool ImageCapture::captureImage(FilePath file,
         return false;
     }
 
-#ifdef Q_OS_OSX
-    QString ffmpegbin = QCoreApplication::applicationDirPath() + "/ffmpeg";
-#elif defined(Q_OS_WIN)
-    QString ffmpegbin = QCoreApplication::applicationDirPath() + "/vendor/ffmpeg.exe";
-#else
-    QString ffmpegbin = "ffmpeg";
-#endif
-
     QProcess ffmpeg;
 
     unsigned duration =
@@ -57,7 +49,7 @@ bool ImageCapture::captureImage(FilePath file,
     }
     tmpFile.close();
 
-    ffmpeg.start(ffmpegbin,
+    ffmpeg.start(ffmpegPath(),
         QStringList() << "-y"
                       << "-ss" << timeCode << "-i" << file.toNativePathString() << "-vframes"
                       << "1"
@@ -84,32 +76,44 @@ bool ImageCapture::captureImage(FilePath file,
         return false;
     }
 
-    img = QImage::fromData(tmpFile.readAll());
+    img = scaled(QImage::fromData(tmpFile.readAll()), dim, cropFromCenter);
     tmpFile.close();
+    return true;
+}
 
+QString ImageCapture::ffmpegPath()
+{
+#ifdef Q_OS_OSX
+    return QCoreApplication::applicationDirPath() + "/ffmpeg";
+#elif defined(Q_OS_WIN)
+    return QCoreApplication::applicationDirPath() + "/vendor/ffmpeg.exe";
+#else
+    return "ffmpeg";
+#endif
+}
+
+QImage ImageCapture::scaled(const QImage& img, ThumbnailDimensions dim, bool cropFromCenter)
+{
     // 0 => no scaling
     if (dim.width == 0 || dim.height == 0) {
-        return true;
+        return img;
     }
 
     if (cropFromCenter) {
-        img = img.scaled(dim.width, dim.height, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        QImage result = img.scaled(dim.width, dim.height, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
 
-        int offsetLeft = (img.width() - dim.width) / 2;
+        int offsetLeft = (result.width() - dim.width) / 2;
         offsetLeft = (offsetLeft < 0) ? 0 : offsetLeft;
 
-        int offsetTop = (img.height() - dim.height) / 2;
+        int offsetTop = (result.height() - dim.height) / 2;
         offsetTop = (offsetTop < 0) ? 0 : offsetTop;
 
         // Crop the image
-        img = img.copy(QRect(offsetLeft, offsetTop, dim.width, dim.height));
-
-    } else {
-        // Only resize the image to the wanted dimensions and keep the aspect ratio.
-        img = img.scaled(dim.width, dim.height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        return result.copy(QRect(offsetLeft, offsetTop, dim.width, dim.height));
     }
 
-    return true;
+    // Only resize the image to the wanted dimensions and keep the aspect ratio.
+    return img.scaled(dim.width, dim.height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 }
 
 } // namespace mediaelch
@@ -4,7 +4,9 @@
 #include "file/Path.h"
 #include "image/ThumbnailDimensions.h"
 
+#include <QImage>
 #include <QObject>
+#include <QString>
 
 namespace mediaelch {
 
@@ -27,6 +29,11 @@ public:
         ThumbnailDimensions dim,
         QImage& img,
         bool cropFromCenter = false);
+
+    /// \brief Path to the ffmpeg binary: the bundled one on Windows and macOS.
+    static QString ffmpegPath();
+    /// \brief Scales the image as described in captureImage().
+    static QImage scaled(const QImage& img, ThumbnailDimensions dim, bool cropFromCenter);
 };
 
 } // namespace mediaelch
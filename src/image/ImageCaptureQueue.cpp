@@ -0,0 +1,314 @@
+#include "image/ImageCaptureQueue.h"
+
+#include "globals/Time.h"
+#include "image/ImageCapture.h"
+#include "log/Log.h"
+
+#include <QFile>
+#include <QFutureWatcher>
+#include <QThread>
+#include <QTimer>
+#include <QtConcurrent>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+/// ffmpeg has to seek to all candidate frames, which may take a while on network shares.
+constexpr int processTimeoutMs = 60 * 1000;
+/// Width of the copy that a frame's quality is measured on.
+constexpr int measureWidth = 160;
+
+/// \brief Times of the candidate frames, spread evenly over the video.
+/// The first and last 10% are skipped because they are often intros, credits or black.
+QVector<quint32> candidateTimes(quint32 duration, int count)
+{
+    QVector<quint32> times;
+    for (int i = 0; i < count; ++i) {
+        const double position = 0.1 + 0.8 * (i + 0.5) / count;
+        times << static_cast<quint32>(duration * position);
+    }
+    return times;
+}
+
+/// \brief Loads and removes the candidate files and returns the best frame, scaled.
+QImage selectFrame(const QStringList& files, mediaelch::ThumbnailDimensions dim, bool cropFromCenter)
+{
+    QVector<QImage> images;
+    for (const QString& file : files) {
+        // Null if ffmpeg couldn't extract the frame, e.g. because of a broken file.
+        images << QImage(file, "JPG");
+        QFile::remove(file);
+    }
+    const int best = mediaelch::FrameQuality::bestFrame(images);
+    return (best < 0) ? QImage() : mediaelch::ImageCapture::scaled(images.at(best), dim, cropFromCenter);
+}
+
+} // namespace
+
+namespace mediaelch {
+
+bool FrameQuality::isUsable() const
+{
+    return brightness >= 20.0 && brightness <= 235.0 && contrast >= 10.0;
+}
+
+bool FrameQuality::isBetterThan(const FrameQuality& other) const
+{
+    if (isUsable() != other.isUsable()) {
+        return isUsable();
+    }
+    return sharpness > other.sharpness;
+}
+
+FrameQuality FrameQuality::measure(const QImage& image)
+{
+    FrameQuality quality;
+    if (image.isNull()) {
+        return quality;
+    }
+
+    const QImage gray = image.scaledToWidth(qMin(measureWidth, image.width()), Qt::FastTransformation)
+                            .convertToFormat(QImage::Format_Grayscale8);
+    const int width = gray.width();
+    const int height = gray.height();
+
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    for (int y = 0; y < height; ++y) {
+        const uchar* line = gray.constScanLine(y);
+        for (int x = 0; x < width; ++x) {
+            sum += line[x];
+            sumOfSquares += line[x] * line[x];
+        }
+    }
+    const double pixels = static_cast<double>(width) * height;
+    quality.brightness = sum / pixels;
+    quality.contrast = std::sqrt(qMax(0.0, sumOfSquares / pixels - quality.brightness * quality.brightness));
+
+    if (width < 3 || height < 3) {
+        return quality;
+    }
+    double laplacian = 0.0;
+    for (int y = 1; y < height - 1; ++y) {
+        const uchar* above = gray.constScanLine(y - 1);
+        const uchar* line = gray.constScanLine(y);
+        const uchar* below = gray.constScanLine(y + 1);
+        for (int x = 1; x < width - 1; ++x) {
+            laplacian += std::abs(4 * line[x] - line[x - 1] - line[x + 1] - above[x] - below[x]);
+        }
+    }
+    quality.sharpness = laplacian / (static_cast<double>(width - 2) * (height - 2));
+    return quality;
+}
+
+int FrameQuality::bestFrame(const QVector<QImage>& images)
+{
+    int best = -1;
+    FrameQuality bestQuality;
+    for (int i = 0; i < images.size(); ++i) {
+        if (images.at(i).isNull()) {
+            continue;
+        }
+        const FrameQuality quality = measure(images.at(i));
+        if (best < 0 || quality.isBetterThan(bestQuality)) {
+            best = i;
+            bestQuality = quality;
+        }
+    }
+    return best;
+}
+
+ImageCaptureQueue::ImageCaptureQueue(QObject* parent) :
+    QObject(parent), m_maxProcesses{qMax(1, QThread::idealThreadCount() / 2)}
+{
+}
+
+ImageCaptureQueue::~ImageCaptureQueue()
+{
+    const auto processes = findChildren<QProcess*>();
+    for (QProcess* process : processes) {
+        QObject::disconnect(process, nullptr, this, nullptr);
+        process->kill();
+        process->waitForFinished(1000);
+    }
+}
+
+void ImageCaptureQueue::add(QObject* object,
+    FilePath file,
+    StreamDetails* streamDetails,
+    ThumbnailDimensions dim,
+    bool cropFromCenter,
+    CaptureFunction onCaptured)
+{
+    Q_ASSERT(!m_running);
+    Item item;
+    item.object = object;
+    item.file = std::move(file);
+    item.streamDetails = streamDetails;
+    item.dimensions = dim;
+    item.cropFromCenter = cropFromCenter;
+    item.onCaptured = std::move(onCaptured);
+    m_items << item;
+}
+
+void ImageCaptureQueue::start()
+{
+    Q_ASSERT(!m_running);
+    m_running = true;
+    qCInfo(generic) << "[ImageCaptureQueue] Capturing" << m_items.size() << "files with up to" << m_maxProcesses
+                    << "ffmpeg processes";
+    if (!m_tempDir.isValid()) {
+        qCWarning(generic) << "[ImageCaptureQueue] Could not create a temporary directory";
+        m_aborted = true;
+    }
+    startNextItems();
+    finishIfDone();
+}
+
+void ImageCaptureQueue::abort()
+{
+    m_aborted = true;
+    finishIfDone();
+}
+
+void ImageCaptureQueue::startNextItems()
+{
+    while (!m_aborted && m_runningProcesses < m_maxProcesses && m_nextItem < m_items.size()) {
+        const int index = m_nextItem++;
+        if (m_items[index].object.isNull()) {
+            completeItem(true);
+        } else if (!startItem(index)) {
+            completeItem(false);
+        }
+    }
+}
+
+bool ImageCaptureQueue::startItem(int index)
+{
+    const Item& item = m_items[index];
+    StreamDetails* streamDetails = item.streamDetails.data();
+    if (streamDetails == nullptr) {
+        return false;
+    }
+    if (streamDetails->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).isEmpty()) {
+        streamDetails->loadStreamDetails();
+    }
+    const quint32 duration =
+        streamDetails->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toUInt();
+    if (duration == 0) {
+        qCInfo(generic) << "[ImageCaptureQueue] Unknown duration, skipping:" << item.file.toNativePathString();
+        return false;
+    }
+
+    QStringList arguments{"-nostdin", "-y", "-v", "error"};
+    // One input per candidate: seeking before "-i" is fast, because ffmpeg only decodes
+    // from the nearest keyframe on.
+    const QVector<quint32> times = candidateTimes(duration, m_candidatesPerFile);
+    for (const quint32 time : times) {
+        arguments << "-ss" << secondsToTimeCode(time) << "-i" << item.file.toNativePathString();
+    }
+    const QStringList outputs = candidateFiles(index);
+    for (int i = 0; i < outputs.size(); ++i) {
+        arguments << "-map" << QStringLiteral("%1:v:0").arg(i) << "-frames:v"
+                  << "1"
+                  << "-q:v"
+                  << "2"
+                  << "-f"
+                  << "mjpeg" << outputs.at(i);
+    }
+
+    auto* process = new QProcess(this);
+    connect(process,
+        static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+        this,
+        [this, index, process]() { onProcessFinished(index, process); });
+    connect(process, &QProcess::errorOccurred, this, [this, index, process](QProcess::ProcessError error) {
+        // Other errors are followed by finished().
+        if (error == QProcess::FailedToStart) {
+            qCWarning(generic) << "[ImageCaptureQueue] Could not start ffmpeg:" << process->program();
+            abort();
+            onProcessFinished(index, process);
+        }
+    });
+    QTimer::singleShot(processTimeoutMs, process, [process]() {
+        qCWarning(generic) << "[ImageCaptureQueue] ffmpeg did not finish in time, killing it";
+        process->kill();
+    });
+
+    ++m_activeItems;
+    ++m_runningProcesses;
+    process->start(ImageCapture::ffmpegPath(), arguments);
+    return true;
+}
+
+void ImageCaptureQueue::onProcessFinished(int index, QProcess* process)
+{
+    --m_runningProcesses;
+    process->deleteLater();
+
+    const Item& item = m_items[index];
+    const QStringList files = candidateFiles(index);
+    const ThumbnailDimensions dim = item.dimensions;
+    const bool cropFromCenter = item.cropFromCenter;
+    std::function<QImage()> select = [files, dim, cropFromCenter]() {
+        return selectFrame(files, dim, cropFromCenter);
+    };
+
+    // Decoding and ranking full-size frames takes too long for the GUI thread.
+    auto* watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, index]() {
+        watcher->deleteLater();
+        onFrameSelected(index, watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run(std::move(select)));
+
+    startNextItems();
+}
+
+void ImageCaptureQueue::onFrameSelected(int index, const QImage& image)
+{
+    --m_activeItems;
+    const Item& item = m_items[index];
+    const bool captured = !image.isNull();
+    if (!captured) {
+        qCInfo(generic) << "[ImageCaptureQueue] Could not capture a frame of:" << item.file.toNativePathString();
+    } else if (!item.object.isNull() && item.onCaptured) {
+        item.onCaptured(image);
+    }
+    completeItem(captured);
+}
+
+void ImageCaptureQueue::completeItem(bool success)
+{
+    ++m_completedItems;
+    if (!success) {
+        ++m_failedItems;
+    }
+    emit progress(m_completedItems, m_items.size());
+    finishIfDone();
+}
+
+void ImageCaptureQueue::finishIfDone()
+{
+    if (!m_running || m_activeItems > 0 || (!m_aborted && m_nextItem < m_items.size())) {
+        return;
+    }
+    m_running = false;
+    // Files that weren't captured because the queue was aborted.
+    m_failedItems += m_items.size() - m_nextItem;
+    qCInfo(generic) << "[ImageCaptureQueue] Captured" << (m_items.size() - m_failedItems) << "of" << m_items.size()
+                    << "files";
+    emit finished(m_failedItems);
+}
+
+QStringList ImageCaptureQueue::candidateFiles(int index) const
+{
+    QStringList files;
+    for (int i = 0; i < m_candidatesPerFile; ++i) {
+        files << QStringLiteral("%1/%2-%3.jpg").arg(m_tempDir.path()).arg(index).arg(i);
+    }
+    return files;
+}
+
+} // namespace mediaelch
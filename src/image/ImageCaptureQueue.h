@@ -0,0 +1,134 @@
+#pragma once
+
+#include "data/StreamDetails.h"
+#include "file/Path.h"
+#include "image/ThumbnailDimensions.h"
+
+#include <QImage>
+#include <QObject>
+#include <QPointer>
+#include <QProcess>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVector>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Measures how well a video frame is suited as a thumbnail.
+struct FrameQuality
+{
+    /// Mean luma, 0 (black) to 255 (white).
+    double brightness = 0.0;
+    /// Standard deviation of the luma; low for fades and single-colored frames.
+    double contrast = 0.0;
+    /// Mean absolute Laplacian of the luma; low for blurry frames.
+    double sharpness = 0.0;
+
+    /// \brief False for (nearly) black, white or single-colored frames.
+    bool isUsable() const;
+    /// \brief Usable frames are better than unusable ones, then sharper ones are better.
+    bool isBetterThan(const FrameQuality& other) const;
+
+    /// \brief Measures the quality on a downscaled grayscale copy of the image.
+    static FrameQuality measure(const QImage& image);
+    /// \brief Returns the index of the best image or -1 if there is no valid image.
+    static int bestFrame(const QVector<QImage>& images);
+};
+
+/// \brief Captures thumbnails of many video files without blocking the UI.
+///
+/// ImageCapture::captureImage() runs one ffmpeg process per frame and waits for it.
+/// The queue instead runs a limited number of ffmpeg processes asynchronously.  Each
+/// process extracts several candidate frames of one file, spread over its duration
+/// (see StreamDetails).  The candidates are ranked on a worker thread so that black
+/// or blurry frames are not used; the best one is scaled and passed to the item's
+/// capture function on the GUI thread.
+///
+/// \par Example
+/// \code{cpp}
+///   auto* queue = new ImageCaptureQueue(this);
+///   for (TvShowEpisode* episode : episodesWithoutThumbnail) {
+///       queue->add(episode, episode->files().first(), episode->streamDetails(), dimensions, false,
+///           [episode](const QImage& image) { ... });
+///   }
+///   connect(queue, &ImageCaptureQueue::progress, this, &MyWidget::onCaptureProgress);
+///   connect(queue, &ImageCaptureQueue::finished, queue, &QObject::deleteLater);
+///   queue->start();
+/// \endcode
+class ImageCaptureQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    using CaptureFunction = std::function<void(const QImage& image)>;
+
+    explicit ImageCaptureQueue(QObject* parent = nullptr);
+    ~ImageCaptureQueue() override;
+
+    /// \brief Adds a video file to the queue.  The capture function isn't called if
+    ///        object was destroyed in the meantime.
+    /// \param streamDetails Used for the file's duration.  Stream details are loaded
+    ///                      right before the file is captured if they aren't, yet.
+    void add(QObject* object,
+        FilePath file,
+        StreamDetails* streamDetails,
+        ThumbnailDimensions dim,
+        bool cropFromCenter,
+        CaptureFunction onCaptured);
+    /// \brief Starts capturing all added files. No files may be added afterwards.
+    void start();
+    /// \brief Doesn't start any more ffmpeg processes. finished() is emitted once
+    ///        the running ones are done.
+    void abort();
+
+    /// \brief Maximum number of concurrent ffmpeg processes. Defaults to half the number of cores.
+    void setMaxProcesses(int count) { m_maxProcesses = qMax(1, count); }
+    /// \brief Number of candidate frames per file.
+    void setCandidatesPerFile(int count) { m_candidatesPerFile = qMax(1, count); }
+
+    int count() const { return m_items.count(); }
+    bool isRunning() const { return m_running; }
+
+signals:
+    /// \brief Number of files that are captured or failed.
+    void progress(int done, int total);
+    /// \brief Emitted once all files are captured or the queue was aborted.
+    /// \param failed Number of files for which no image could be captured.
+    void finished(int failed);
+
+private:
+    struct Item
+    {
+        QPointer<QObject> object;
+        FilePath file;
+        QPointer<StreamDetails> streamDetails;
+        ThumbnailDimensions dimensions;
+        bool cropFromCenter = false;
+        CaptureFunction onCaptured;
+    };
+
+    void startNextItems();
+    bool startItem(int index);
+    void onProcessFinished(int index, QProcess* process);
+    void onFrameSelected(int index, const QImage& image);
+    void completeItem(bool success);
+    void finishIfDone();
+    QStringList candidateFiles(int index) const;
+
+private:
+    QVector<Item> m_items;
+    QTemporaryDir m_tempDir;
+    int m_maxProcesses;
+    int m_candidatesPerFile = 5;
+    bool m_running = false;
+    bool m_aborted = false;
+    int m_nextItem = 0;
+    /// Items whose ffmpeg process runs or whose frames are being ranked.
+    int m_activeItems = 0;
+    int m_runningProcesses = 0;
+    int m_completedItems = 0;
+    int m_failedItems = 0;
+};
+
+} // namespace mediaelch
@@ -1,59 +1,38 @@
 #include "imports/DownloadFileSearcher.h"
 
-#include <QRegularExpression>
+#include "file/DirectoryScanner.h"
 
-// Still required for wildcards at the moment.
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-#    include <QRegExp>
-#endif
+#include <QRegularExpression>
 
 namespace mediaelch {
 
 void DownloadFileSearcher::scan()
 {
+    QStringList importFilters;
+    importFilters << Settings::instance()->advanced()->movieFilters().filters();
+    importFilters << Settings::instance()->advanced()->tvShowFilters().filters();
+    importFilters << Settings::instance()->advanced()->concertFilters().filters();
+    importFilters.removeDuplicates();
+    m_importableFiles = NameMatcher::fromWildcards(importFilters);
+    m_subtitleFiles = NameMatcher::fromWildcards(Settings::instance()->advanced()->subtitleFilters().filters());
+
+    QStringList roots;
     for (const SettingsDir& settingsDir : Settings::instance()->directorySettings().downloadDirectories()) {
-        QString dir = settingsDir.path.path();
-        QDirIterator it(dir,
-            QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
-            QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
-        while (it.hasNext()) {
-            it.next();
-            if (m_scanDownloads && isPackage(it.fileInfo())) {
-                QString base = baseName(it.fileInfo());
-                if (m_packages.contains(base)) {
-                    m_packages[base].files.append(it.filePath());
-                    m_packages[base].size += static_cast<double>(it.fileInfo().size());
-                } else {
-                    Package p;
-                    p.baseName = base;
-                    p.size = static_cast<double>(it.fileInfo().size());
-                    p.files << it.filePath();
-                    m_packages.insert(base, p);
-                }
-
-            } else if (m_scanImports && (isImportable(it.fileInfo()) || isSubtitle(it.fileInfo()))) {
-                QString base = it.fileInfo().completeBaseName();
-                if (m_imports.contains(base)) {
-                    if (isSubtitle(it.fileInfo())) {
-                        m_imports[base].extraFiles.append(it.filePath());
-                    } else {
-                        m_imports[base].files.append(it.filePath());
-                    }
-                    m_imports[base].size += static_cast<double>(it.fileInfo().size());
-                } else {
-                    Import i;
-                    i.baseName = base;
-                    if (isSubtitle(it.fileInfo())) {
-                        i.extraFiles << it.filePath();
-                    } else {
-                        i.files << it.filePath();
-                    }
-                    i.size = static_cast<double>(it.fileInfo().size());
-                    m_imports.insert(base, i);
-                }
+        roots << settingsDir.path.path();
+    }
+
+    DirectoryScanner::Options options;
+    options.fileDetails = true;
+    DirectoryScanner scanner(options);
+
+    // Called for one directory after another, see DirectoryScanner.
+    scanner.scan(roots, [this](const DirectoryScanner::Directory& directory) {
+        for (const DirectoryScanner::Entry& entry : directory.entries) {
+            if (entry.isFile) {
+                addFile(directory.filePath(entry), static_cast<double>(entry.size));
             }
         }
-    }
+    });
 
     QMapIterator<QString, Import> it(m_imports);
     QStringList onlyExtraFiles;
@@ -71,19 +50,59 @@ void DownloadFileSearcher::scan()
     emit sigScanFinished(this);
 }
 
+void DownloadFileSearcher::addFile(const QString& filePath, double size)
+{
+    const QFileInfo fileInfo(filePath);
+    if (m_scanDownloads && isPackage(fileInfo)) {
+        QString base = baseName(fileInfo);
+        if (m_packages.contains(base)) {
+            m_packages[base].files.append(filePath);
+            m_packages[base].size += size;
+        } else {
+            Package p;
+            p.baseName = base;
+            p.size = size;
+            p.files << filePath;
+            m_packages.insert(base, p);
+        }
+
+    } else if (m_scanImports && (isImportable(fileInfo) || isSubtitle(fileInfo))) {
+        QString base = fileInfo.completeBaseName();
+        if (m_imports.contains(base)) {
+            if (isSubtitle(fileInfo)) {
+                m_imports[base].extraFiles.append(filePath);
+            } else {
+                m_imports[base].files.append(filePath);
+            }
+            m_imports[base].size += size;
+        } else {
+            Import i;
+            i.baseName = base;
+            if (isSubtitle(fileInfo)) {
+                i.extraFiles << filePath;
+            } else {
+                i.files << filePath;
+            }
+            i.size = size;
+            m_imports.insert(base, i);
+        }
+    }
+}
+
 QString DownloadFileSearcher::baseName(const QFileInfo& fileInfo) const
 {
     const QString fileName = fileInfo.fileName();
 
-    QRegularExpression rx("^(.*)(part[0-9]*)\\.rar$");
-    QRegularExpressionMatch match = rx.match(fileName);
+    static const QRegularExpression partRx("^(.*)(part[0-9]*)\\.rar$");
+    static const QRegularExpression rarRx("^(.*)\\.r(?:ar|[0-9]*)$");
+
+    QRegularExpressionMatch match = partRx.match(fileName);
     if (match.hasMatch()) {
         return match.captured(1).endsWith(".") ? match.captured(1).mid(0, match.captured(1).length() - 1)
                                                : match.captured(1);
     }
 
-    rx.setPattern("^(.*)\\.r(?:ar|[0-9]*)$");
-    match = rx.match(fileName);
+    match = rarRx.match(fileName);
     if (match.hasMatch()) {
         return match.captured(1);
     }
@@ -97,54 +116,18 @@ bool DownloadFileSearcher::isPackage(const QFileInfo& file) const
         return true;
     }
 
-    QRegularExpression rx("r[0-9]*");
+    static const QRegularExpression rx("r[0-9]*");
     return rx.match(file.suffix()).hasMatch();
 }
 
 bool DownloadFileSearcher::isImportable(const QFileInfo& file) const
 {
-    QStringList filters;
-    filters << Settings::instance()->advanced()->movieFilters().filters();
-    filters << Settings::instance()->advanced()->tvShowFilters().filters();
-    filters << Settings::instance()->advanced()->concertFilters().filters();
-    filters.removeDuplicates();
-
-    for (const QString& filter : asConst(filters)) {
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-        QRegExp rx(filter);
-        rx.setPatternSyntax(QRegExp::Wildcard);
-        if (rx.exactMatch(file.fileName())) {
-            return true;
-        }
-#else
-        QRegularExpression rx(QRegularExpression::wildcardToRegularExpression(filter));
-        if (rx.match(file.fileName()).hasMatch()) {
-            return true;
-        }
-#endif
-    }
-    return false;
+    return m_importableFiles.matches(file.fileName());
 }
 
 bool DownloadFileSearcher::isSubtitle(const QFileInfo& file) const
 {
-    const QStringList filters = Settings::instance()->advanced()->subtitleFilters().filters();
-    for (const QString& filter : filters) {
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-        QRegExp rx(filter);
-        rx.setPatternSyntax(QRegExp::Wildcard);
-        if (rx.exactMatch(file.fileName())) {
-            return true;
-        }
-#else
-        QRegularExpression rx(QRegularExpression::wildcardToRegularExpression(filter));
-        if (rx.match(file.fileName()).hasMatch()) {
-            return true;
-        }
-#endif
-    }
-
-    return false;
+    return m_subtitleFiles.matches(file.fileName());
 }
 
 } // namespace mediaelch
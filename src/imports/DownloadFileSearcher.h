@@ -1,5 +1,6 @@
 #pragma once
 
+#include "file/NameMatcher.h"
 #include "settings/Settings.h"
 
 #include <QDirIterator>
@@ -56,6 +57,9 @@ public:
     QMap<QString, Import> imports() { return m_imports; }
 
 private:
+    /// \brief Adds the file to the packages or imports if it is one.
+    void addFile(const QString& filePath, double size);
+
     /// \brief Extract the base file name of the given file, i.e. remove all part
     ///        data (e.g. "part1", ".r2") from the file name.
     QString baseName(const QFileInfo& fileInfo) const;
@@ -75,6 +79,10 @@ private:
     QMap<QString, Package> m_packages;
     QMap<QString, Import> m_imports;
 
+    /// Compiled file filters, built once per scan.
+    NameMatcher m_importableFiles;
+    NameMatcher m_subtitleFiles;
+
     bool m_scanDownloads = false;
     bool m_scanImports = false;
 };
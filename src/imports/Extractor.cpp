@@ -3,6 +3,7 @@
 #include "log/Log.h"
 #include "settings/Settings.h"
 
+#include <QDir>
 #include <QFileInfo>
 #include <QProcess>
 #include <QRegularExpression>
@@ -76,6 +77,39 @@ void Extractor::onReadyRead()
     if (match.hasMatch()) {
         emit sigProgress(process->property("baseName").toString(), match.captured(1).toInt());
     }
+    process->setProperty("output", process->property("output").toString() + msg);
+    parseOutputLines(process, false);
+}
+
+void Extractor::parseOutputLines(QProcess* process, bool flush)
+{
+    // Output may end in the middle of a line. The rest is kept until the next read.
+    QString output = process->property("output").toString();
+    const int end = flush ? output.size() : output.lastIndexOf('\n') + 1;
+    if (end <= 0) {
+        return;
+    }
+    const QStringList lines = output.left(end).split('\n', ElchSplitBehavior::SkipEmptyParts);
+    process->setProperty("output", output.mid(end));
+
+    const QString baseName = process->property("baseName").toString();
+    const QDir workingDir(process->workingDirectory());
+    for (const QString& line : lines) {
+        const QString file = extractedFileFromOutput(line);
+        if (!file.isEmpty()) {
+            emit sigFileExtracted(baseName, QDir::cleanPath(workingDir.absoluteFilePath(file)));
+        }
+    }
+}
+
+QString Extractor::extractedFileFromOutput(QString line)
+{
+    // unrar updates the percentage in place using backspaces. Long file names are
+    // continued in lines starting with "...".
+    static const QRegularExpression rx(R"(^(?:Extracting|\.\.\.)\s+(.+?)\s+(?:\d+%\s*)*OK$)");
+    line.remove('\b');
+    const QRegularExpressionMatch match = rx.match(line.trimmed());
+    return match.hasMatch() ? match.captured(1) : QString();
 }
 
 void Extractor::onReadyReadError()
@@ -93,6 +127,9 @@ void Extractor::onFinished(int exitCode, QProcess::ExitStatus status)
     Q_UNUSED(exitCode);
     Q_UNUSED(status);
     auto* process = dynamic_cast<QProcess*>(QObject::sender());
+    if (!process->property("hasError").toBool()) {
+        parseOutputLines(process, true);
+    }
     m_processes.removeAll(process);
     process->deleteLater();
     emit sigFinished(process->property("baseName").toString(), !process->property("hasError").toBool());
@@ -14,19 +14,32 @@ public:
     ~Extractor() override;
 
 public slots:
-    void extract(QString baseName, QStringList files, QString password);
-    void stopExtraction(QString baseName);
+    /// \brief Extracts the package's RAR archives into their directory.
+    virtual void extract(QString baseName, QStringList files, QString password);
+    virtual void stopExtraction(QString baseName);
+
+public:
+    /// \brief Returns the file that unrar reports as completely extracted in the given
+    ///        output line, e.g. "Extracting  Movie/Movie.mkv  12% 58%  OK", or an empty string.
+    static QString extractedFileFromOutput(QString line);
 
 signals:
     void sigProgress(QString, int);
     void sigFinished(QString, bool);
     void sigError(QString, QString);
+    /// \brief Emitted as soon as unrar has written and closed a file, i.e. before the
+    ///        package is completely extracted.
+    /// \param filePath Absolute path of the extracted file.
+    void sigFileExtracted(QString baseName, QString filePath);
 
 private slots:
     void onReadyRead();
     void onReadyReadError();
     void onFinished(int exitCode, QProcess::ExitStatus status);
 
+private:
+    void parseOutputLines(QProcess* process, bool flush);
+
 private:
     QVector<QProcess*> m_processes;
 };
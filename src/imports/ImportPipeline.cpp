@@ -0,0 +1,236 @@
+#include "imports/ImportPipeline.h"
+
+#include "globals/Globals.h"
+#include "globals/Meta.h"
+#include "imports/Extractor.h"
+#include "log/Log.h"
+#include "settings/Settings.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStorageInfo>
+#include <algorithm>
+
+namespace mediaelch {
+
+ImportPipeline::ImportPipeline(Options options, QObject* parent) :
+    ImportPipeline(std::move(options), new Extractor, parent)
+{
+}
+
+ImportPipeline::ImportPipeline(Options options, Extractor* extractor, QObject* parent) :
+    QObject(parent), m_options{std::move(options)}, m_extractor{extractor}
+{
+    m_extractor->setParent(this);
+    m_options.maxExtractions = qMax(1, m_options.maxExtractions);
+    m_options.maxExtractionsPerVolume = qMax(1, m_options.maxExtractionsPerVolume);
+
+    QStringList importFilters = m_options.importFilters;
+    if (importFilters.isEmpty()) {
+        importFilters << Settings::instance()->advanced()->movieFilters().filters();
+        importFilters << Settings::instance()->advanced()->tvShowFilters().filters();
+        importFilters << Settings::instance()->advanced()->concertFilters().filters();
+        importFilters << Settings::instance()->advanced()->subtitleFilters().filters();
+    }
+    importFilters.removeDuplicates();
+    m_importableFiles = NameMatcher::fromWildcards(importFilters);
+
+    connect(m_extractor, &Extractor::sigFileExtracted, this, &ImportPipeline::onFileExtracted);
+    connect(m_extractor, &Extractor::sigFinished, this, &ImportPipeline::onExtractionFinished);
+    connect(m_extractor, &Extractor::sigProgress, this, &ImportPipeline::packageProgress);
+    connect(m_extractor, &Extractor::sigError, this, &ImportPipeline::packageError);
+}
+
+void ImportPipeline::add(const DownloadFileSearcher::Package& package, const QString& password)
+{
+    if (package.files.isEmpty()) {
+        return;
+    }
+    Package item;
+    item.baseName = package.baseName;
+    item.files = package.files;
+    item.password = password;
+    item.directory = QFileInfo(package.files.first()).absolutePath();
+    item.volume = QStorageInfo(item.directory).rootPath();
+    m_waiting.append(item);
+    ++m_total;
+    startNextPackages();
+}
+
+void ImportPipeline::start()
+{
+    qCInfo(generic) << "[ImportPipeline] Importing" << m_total << "packages with up to" << m_options.maxExtractions
+                    << "extractions at the same time";
+    m_running = true;
+    m_aborted = false;
+    startNextPackages();
+    finishIfDone();
+}
+
+void ImportPipeline::abort()
+{
+    if (!m_running) {
+        return;
+    }
+    qCInfo(generic) << "[ImportPipeline] Aborting";
+    m_aborted = true;
+    m_failedPackages += m_waiting.size();
+    m_waiting.clear();
+    m_pendingTransfers.clear();
+    // Extractions report back via onExtractionFinished().
+    const QStringList extracting = m_extracting.keys();
+    for (const QString& baseName : extracting) {
+        m_extractor->stopExtraction(baseName);
+    }
+    if (!m_transferQueue.isNull()) {
+        m_transferQueue->abort();
+    }
+    finishIfDone();
+}
+
+void ImportPipeline::startNextPackages()
+{
+    // Extractor::extract() may report failures immediately, which calls this method again.
+    if (m_startingPackages) {
+        return;
+    }
+    m_startingPackages = true;
+    int index = nextStartablePackage();
+    while (m_running && !m_aborted && index >= 0) {
+        const Package package = m_waiting.takeAt(index);
+        m_extracting.insert(package.baseName, package);
+        ++m_extractionsPerVolume[package.volume];
+        qCDebug(generic) << "[ImportPipeline] Extracting" << package.baseName;
+        emit packageStarted(package.baseName);
+        m_extractor->extract(package.baseName, package.files, package.password);
+        index = nextStartablePackage();
+    }
+    m_startingPackages = false;
+}
+
+int ImportPipeline::nextStartablePackage() const
+{
+    if (m_extracting.size() >= m_options.maxExtractions) {
+        return -1;
+    }
+    for (int i = 0; i < m_waiting.size(); ++i) {
+        if (m_extractionsPerVolume.value(m_waiting.at(i).volume) < m_options.maxExtractionsPerVolume) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void ImportPipeline::onFileExtracted(QString baseName, QString filePath)
+{
+    emit fileExtracted(baseName, filePath);
+
+    const QFileInfo fileInfo(filePath);
+    if (m_aborted || m_options.targetDirectory.isEmpty() || !m_importableFiles.matches(fileInfo.fileName())) {
+        return;
+    }
+    QString relativePath = fileInfo.fileName();
+    auto package = m_extracting.constFind(baseName);
+    if (package != m_extracting.constEnd()) {
+        const QString pathInPackage = QDir(package->directory).relativeFilePath(filePath);
+        if (!pathInPackage.startsWith("../")) {
+            relativePath = pathInPackage;
+        }
+    }
+    if (isSample(relativePath)) {
+        qCDebug(generic) << "[ImportPipeline] Skipping sample" << filePath;
+        return;
+    }
+    Transfer transfer;
+    transfer.source = filePath;
+    transfer.destination = QDir(m_options.targetDirectory).filePath(baseName + "/" + relativePath);
+    m_pendingTransfers.append(transfer);
+    startTransfers();
+}
+
+bool ImportPipeline::isSample(const QString& relativePath)
+{
+    static const NameMatcher samples({}, {"-sample", ".sample", "_sample"}, {"sample", "samples"});
+    QStringList parts = relativePath.split('/', ElchSplitBehavior::SkipEmptyParts);
+    if (parts.isEmpty()) {
+        return false;
+    }
+    parts.last() = QFileInfo(parts.last()).completeBaseName();
+    return std::any_of(parts.cbegin(), parts.cend(), [](const QString& part) { return samples.matches(part); });
+}
+
+void ImportPipeline::onExtractionFinished(QString baseName, bool success)
+{
+    if (!m_extracting.contains(baseName)) {
+        return;
+    }
+    const Package package = m_extracting.take(baseName);
+    --m_extractionsPerVolume[package.volume];
+
+    if (success) {
+        qCInfo(generic) << "[ImportPipeline] Extracted" << baseName;
+        if (m_options.deleteArchives) {
+            for (const QString& file : package.files) {
+                QFile::remove(file);
+            }
+        }
+    } else {
+        qCWarning(generic) << "[ImportPipeline] Extraction failed:" << baseName;
+        ++m_failedPackages;
+    }
+    emit packageFinished(baseName, success);
+
+    startNextPackages();
+    finishIfDone();
+}
+
+void ImportPipeline::startTransfers()
+{
+    if (!m_transferQueue.isNull() || m_pendingTransfers.isEmpty()) {
+        return;
+    }
+    // Files extracted while this batch is transferred form the next batch.
+    FileTransferQueue::Options options;
+    options.transfer.mode = FileTransfer::Mode::Move;
+    options.transfer.verifyChecksum = m_options.verifyChecksums;
+    options.maxTransfersPerVolume = m_options.maxTransfersPerVolume;
+    m_transferQueue = new FileTransferQueue(options, this);
+    for (const Transfer& transfer : asConst(m_pendingTransfers)) {
+        m_transferQueue->add(transfer.source, transfer.destination);
+    }
+    m_pendingTransfers.clear();
+    connect(m_transferQueue.data(), &FileTransferQueue::fileFinished, this, &ImportPipeline::onTransferFinished);
+    connect(m_transferQueue.data(), &FileTransferQueue::finished, this, &ImportPipeline::onTransfersFinished);
+    m_transferQueue->start();
+}
+
+void ImportPipeline::onTransferFinished(QString source, QString destination, bool success)
+{
+    if (!success) {
+        qCWarning(generic) << "[ImportPipeline] Could not import" << source;
+        ++m_failedFiles;
+    }
+    emit fileImported(source, destination, success);
+}
+
+void ImportPipeline::onTransfersFinished()
+{
+    m_transferQueue->deleteLater();
+    m_transferQueue.clear();
+    startTransfers();
+    finishIfDone();
+}
+
+void ImportPipeline::finishIfDone()
+{
+    if (m_running && m_waiting.isEmpty() && m_extracting.isEmpty() && m_pendingTransfers.isEmpty()
+        && m_transferQueue.isNull()) {
+        m_running = false;
+        qCInfo(generic) << "[ImportPipeline] Finished," << m_failedPackages << "packages and" << m_failedFiles
+                        << "files failed";
+        emit finished(m_failedPackages, m_failedFiles);
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "file/FileTransferQueue.h"
+#include "file/NameMatcher.h"
+#include "imports/DownloadFileSearcher.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+
+class Extractor;
+
+namespace mediaelch {
+
+/// \brief Extracts downloaded packages and imports their files, with all steps overlapping.
+///
+/// Several packages are extracted at the same time. Their number is limited overall,
+/// because unrar is CPU bound for compressed archives, and per volume of the archives,
+/// because more extractions would only compete for the disk. The next package is
+/// extracted as soon as one is done, i.e. while the files of the previous one are
+/// still being imported.
+///
+/// Extracted files are identified as soon as unrar closes them. Files that match the
+/// movie, TV show, concert or subtitle filters are moved to a directory named after
+/// the package in targetDirectory, while the rest of the package is still extracted.
+/// Files keep their path inside the package, so that e.g. "CD1/movie.mkv" and
+/// "CD2/movie.mkv" don't collide. Samples such as "Sample/movie-sample.mkv" are not
+/// imported.
+///
+/// \par Example
+/// \code{cpp}
+///   ImportPipeline::Options options;
+///   options.targetDirectory = "/nas/Imports";
+///   auto* pipeline = new ImportPipeline(options, this);
+///   for (const DownloadFileSearcher::Package& package : packages) {
+///       pipeline->add(package);
+///   }
+///   connect(pipeline, &ImportPipeline::finished, pipeline, &QObject::deleteLater);
+///   pipeline->start();
+/// \endcode
+class ImportPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        /// Maximum number of packages that are extracted at the same time.
+        int maxExtractions = qBound(1, QThread::idealThreadCount() / 2, 4);
+        /// Maximum number of packages that are extracted at the same time per volume.
+        int maxExtractionsPerVolume = 2;
+        /// Importable files are moved to "<targetDirectory>/<package>/<path in package>".
+        /// If empty, extracted files are left where unrar extracted them.
+        QString targetDirectory;
+        /// Wildcards of importable files. If empty, the movie, TV show, concert and
+        /// subtitle filters of the advanced settings are used.
+        QStringList importFilters;
+        /// Maximum number of files that are moved at the same time per target volume.
+        int maxTransfersPerVolume = 2;
+        bool verifyChecksums = false;
+        /// Remove the archives of successfully extracted packages.
+        bool deleteArchives = false;
+    };
+
+public:
+    explicit ImportPipeline(Options options, QObject* parent = nullptr);
+    /// \brief Uses the given extractor instead of unrar, e.g. for tests. Takes ownership of it.
+    ImportPipeline(Options options, Extractor* extractor, QObject* parent = nullptr);
+
+    void add(const DownloadFileSearcher::Package& package, const QString& password = {});
+    /// \brief Starts extracting. Packages may still be added afterwards.
+    void start();
+    /// \brief Stops all extractions and transfers. finished() is emitted once the
+    ///        running transfers have stopped.
+    void abort();
+
+    int count() const { return m_total; }
+    bool isRunning() const { return m_running; }
+
+signals:
+    void packageStarted(QString baseName);
+    void packageProgress(QString baseName, int percent);
+    void packageFinished(QString baseName, bool success);
+    void packageError(QString baseName, QString message);
+    void fileExtracted(QString baseName, QString filePath);
+    void fileImported(QString source, QString destination, bool success);
+    void finished(int failedPackages, int failedFiles);
+
+private slots:
+    void onFileExtracted(QString baseName, QString filePath);
+    void onExtractionFinished(QString baseName, bool success);
+    void onTransferFinished(QString source, QString destination, bool success);
+    void onTransfersFinished();
+
+private:
+    struct Package
+    {
+        QString baseName;
+        QStringList files;
+        QString password;
+        /// Directory of the archives, which is where unrar extracts them to.
+        QString directory;
+        QString volume;
+    };
+
+    struct Transfer
+    {
+        QString source;
+        QString destination;
+    };
+
+    /// \brief Whether the extracted file is a sample, e.g. "Sample/movie.mkv" or "movie-sample.mkv".
+    static bool isSample(const QString& relativePath);
+    void startNextPackages();
+    int nextStartablePackage() const;
+    void startTransfers();
+    void finishIfDone();
+
+private:
+    Options m_options;
+    Extractor* m_extractor = nullptr;
+    NameMatcher m_importableFiles;
+
+    QVector<Package> m_waiting;
+    QHash<QString, Package> m_extracting;
+    QHash<QString, int> m_extractionsPerVolume;
+    bool m_startingPackages = false;
+
+    QVector<Transfer> m_pendingTransfers;
+    QPointer<FileTransferQueue> m_transferQueue;
+
+    bool m_running = false;
+    bool m_aborted = false;
+    int m_total = 0;
+    int m_failedPackages = 0;
+    int m_failedFiles = 0;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,155 @@
+#include "log/Perf.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+
+namespace mediaelch {
+namespace perf {
+
+namespace {
+
+/// Upper bound of stored trace events so that tracing a huge library can't exhaust memory.
+constexpr int MAX_TRACE_EVENTS = 1000000;
+
+struct TraceEvent
+{
+    const char* name;
+    quintptr threadId;
+    qint64 startUs;
+    qint64 durationUs;
+};
+
+struct Measurements
+{
+    QMutex mutex;
+    QHash<QString, Entry> entries;
+    QVector<TraceEvent> traceEvents;
+    bool recordTrace = false;
+};
+
+Measurements& measurements()
+{
+    static Measurements m;
+    return m;
+}
+
+QElapsedTimer& clock()
+{
+    static QElapsedTimer timer = []() {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+} // namespace
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+qint64 nowUs()
+{
+    return clock().nsecsElapsed() / 1000;
+}
+
+void addTiming(const char* name, qint64 startUs, qint64 durationUs)
+{
+    Measurements& m = measurements();
+    QMutexLocker locker(&m.mutex);
+    Entry& entry = m.entries[QString::fromLatin1(name)];
+    ++entry.count;
+    entry.totalUs += durationUs;
+    entry.maxUs = std::max(entry.maxUs, durationUs);
+
+    if (m.recordTrace && m.traceEvents.size() < MAX_TRACE_EVENTS) {
+        const auto threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+        m.traceEvents.push_back({name, threadId, startUs, durationUs});
+    }
+}
+
+void addCounter(const QString& name, qint64 value)
+{
+    Measurements& m = measurements();
+    QMutexLocker locker(&m.mutex);
+    m.entries[name].count += value;
+}
+
+} // namespace detail
+
+void setEnabled(bool enabled, bool recordTrace)
+{
+    {
+        Measurements& m = measurements();
+        QMutexLocker locker(&m.mutex);
+        m.recordTrace = enabled && recordTrace;
+    }
+    clock(); // start the clock before the first measurement
+    detail::enabled.store(enabled);
+}
+
+void reset()
+{
+    Measurements& m = measurements();
+    QMutexLocker locker(&m.mutex);
+    m.entries.clear();
+    m.traceEvents.clear();
+}
+
+QVector<Entry> entries()
+{
+    QVector<Entry> result;
+    {
+        Measurements& m = measurements();
+        QMutexLocker locker(&m.mutex);
+        for (auto it = m.entries.constBegin(); it != m.entries.constEnd(); ++it) {
+            Entry entry = it.value();
+            entry.name = it.key();
+            result.push_back(entry);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+    return result;
+}
+
+bool writeChromeTrace(const QString& filePath)
+{
+    QJsonArray events;
+    {
+        Measurements& m = measurements();
+        QMutexLocker locker(&m.mutex);
+        if (m.traceEvents.isEmpty()) {
+            return false;
+        }
+        const qint64 pid = QCoreApplication::applicationPid();
+        for (const TraceEvent& event : m.traceEvents) {
+            // "X" are complete events, see the Trace Event Format specification.
+            events.append(QJsonObject{{"name", QString::fromLatin1(event.name)},
+                {"ph", "X"},
+                {"pid", pid},
+                {"tid", static_cast<qint64>(event.threadId)},
+                {"ts", event.startUs},
+                {"dur", event.durationUs}});
+        }
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray json = QJsonDocument(QJsonObject{{"traceEvents", events}}).toJson(QJsonDocument::Compact);
+    return file.write(json) == json.size();
+}
+
+} // namespace perf
+} // namespace mediaelch
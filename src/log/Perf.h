@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+namespace mediaelch {
+namespace perf {
+
+/// \brief Aggregated measurements of a single timer or counter.
+struct Entry
+{
+    QString name;
+    /// Number of timed scopes or sum of counter increments.
+    qint64 count = 0;
+    /// Total and maximum duration of timed scopes in microseconds. Zero for counters.
+    qint64 totalUs = 0;
+    qint64 maxUs = 0;
+};
+
+namespace detail {
+extern std::atomic<bool> enabled;
+void addTiming(const char* name, qint64 startUs, qint64 durationUs);
+void addCounter(const QString& name, qint64 value);
+qint64 nowUs();
+} // namespace detail
+
+/// \brief Whether measurements are recorded. Disabled by default.
+inline bool isEnabled()
+{
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/// \brief Enables or disables recording of measurements.
+/// \param recordTrace If true, each timed scope is stored as well, see writeChromeTrace().
+void setEnabled(bool enabled, bool recordTrace = false);
+
+/// \brief Removes all measurements, e.g. at the start of a library reload.
+void reset();
+
+/// \brief All measurements since the last reset(), sorted by name.
+QVector<Entry> entries();
+
+/// \brief Writes all timed scopes since the last reset() as a Chrome trace, which can be
+///        opened with chrome://tracing or https://ui.perfetto.dev
+/// \returns False if the file couldn't be written or no trace was recorded.
+bool writeChromeTrace(const QString& filePath);
+
+/// \brief Increments the counter with the given name. Does nothing if disabled.
+/// \param name Only converted to a QString if measurements are enabled.
+inline void count(const char* name, qint64 value = 1)
+{
+    if (isEnabled()) {
+        detail::addCounter(QString::fromLatin1(name), value);
+    }
+}
+
+/// \brief Overload for counters with a dynamic name.  Check isEnabled() before building
+///        the name so that disabled measurements don't cost an allocation.
+inline void count(const QString& name, qint64 value = 1)
+{
+    if (isEnabled()) {
+        detail::addCounter(name, value);
+    }
+}
+
+/// \brief Measures the time until the end of the current scope.
+///
+/// If measurements are disabled, only a single atomic flag is read.
+///
+/// \par Example
+/// \code{cpp}
+///   void KodiXml::loadMovie(...) {
+///       perf::ScopedTimer timer("nfo.parse.movie");
+///       ...
+///   }
+/// \endcode
+class ScopedTimer
+{
+public:
+    /// \param name Must be a string literal or otherwise outlive the timer.
+    explicit ScopedTimer(const char* name) : m_name{isEnabled() ? name : nullptr}
+    {
+        if (m_name != nullptr) {
+            m_startUs = detail::nowUs();
+        }
+    }
+    ~ScopedTimer()
+    {
+        if (m_name != nullptr) {
+            detail::addTiming(m_name, m_startUs, detail::nowUs() - m_startUs);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* m_name;
+    qint64 m_startUs = 0;
+};
+
+} // namespace perf
+} // namespace mediaelch
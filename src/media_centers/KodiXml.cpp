@@ -3,8 +3,10 @@
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "globals/SaveQueue.h"
 #include "image/Image.h"
 #include "log/Log.h"
+#include "log/Perf.h"
 #include "media_centers/kodi/AlbumXmlReader.h"
 #include "media_centers/kodi/AlbumXmlWriter.h"
 #include "media_centers/kodi/ArtistXmlReader.h"
@@ -75,17 +77,10 @@ bool KodiXml::saveMovie(Movie* movie)
     for (auto dataFile : Settings::instance()->dataFiles(DataFileType::MovieNfo)) {
         QString saveFileName = dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, movie->files().count() > 1);
         QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qCDebug(generic) << "Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCDebug(generic) << "Saving to" << saveFilePath;
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
             qCWarning(generic) << "File could not be openend";
         } else {
-            file.write(xmlContent);
-            file.close();
             saved = true;
         }
     }
@@ -123,25 +118,26 @@ bool KodiXml::saveMovie(Movie* movie)
                     && (movie->discType() == DiscType::BluRay || movie->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                QFile(getPath(movie).filePath(saveFileName)).remove();
+                removeFile(getPath(movie).filePath(saveFileName));
             }
         }
     }
 
     if (movie->inSeparateFolder() && !movie->files().isEmpty()) {
         for (const QString& file : movie->images().extraFanartsToRemove()) {
-            QFile::remove(file);
+            removeFile(file);
         }
         QDir dir(movie->files().first().dir().toString() + "/extrafanart");
         if (!dir.exists() && !movie->images().extraFanartToAdd().isEmpty()) {
             QDir(movie->files().first().dir().toString()).mkdir("extrafanart");
         }
+        // Files may still be written in the background, so count the added fanarts as well.
+        int num = 1;
         for (const QByteArray& img : movie->images().extraFanartToAdd()) {
-            int num = 1;
             while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
                 ++num;
             }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num++), img);
         }
     }
 
@@ -298,6 +294,7 @@ QString KodiXml::nfoFilePath(Concert* concert)
  */
 bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
 {
+    mediaelch::perf::ScopedTimer timer("nfo.parse.movie");
     movie->clear();
     movie->setChanged(false);
 
@@ -557,17 +554,10 @@ bool KodiXml::saveConcert(Concert* concert)
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, concert->files().size() > 1);
         QString saveFilePath = mediaelch::DirectoryPath(fi.absolutePath()).filePath(saveFileName);
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qCDebug(generic) << "[KodiXml] Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCDebug(generic) << "[KodiXml] Saving to" << saveFilePath;
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
             qCWarning(generic) << "[KodiXml] File could not be openend";
         } else {
-            file.write(xmlContent);
-            file.close();
             saved = true;
         }
     }
@@ -604,25 +594,25 @@ bool KodiXml::saveConcert(Concert* concert)
                     && (concert->discType() == DiscType::BluRay || concert->discType() == DiscType::Dvd)) {
                     saveFileName = "fanart.jpg";
                 }
-                QFile(getPath(concert).filePath(saveFileName)).remove();
+                removeFile(getPath(concert).filePath(saveFileName));
             }
         }
     }
 
     if (concert->inSeparateFolder() && !concert->files().isEmpty()) {
         for (const QString& file : concert->extraFanartsToRemove()) {
-            QFile::remove(file);
+            removeFile(file);
         }
         QDir dir(QFileInfo(concert->files().first().toString()).absolutePath() + "/extrafanart");
         if (!dir.exists() && !concert->extraFanartImagesToAdd().isEmpty()) {
             QDir(QFileInfo(concert->files().first().toString()).absolutePath()).mkdir("extrafanart");
         }
+        int num = 1;
         for (const QByteArray& img : concert->extraFanartImagesToAdd()) {
-            int num = 1;
             while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
                 ++num;
             }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num++), img);
         }
     }
 
@@ -636,6 +626,7 @@ bool KodiXml::saveConcert(Concert* concert)
  */
 bool KodiXml::loadConcert(Concert* concert, QString initialNfoContent)
 {
+    mediaelch::perf::ScopedTimer timer("nfo.parse.concert");
     concert->clear();
     concert->setChanged(false);
 
@@ -720,6 +711,7 @@ QString KodiXml::actorImageName(TvShowEpisode* episode, Actor actor)
  */
 bool KodiXml::loadTvShow(TvShow* show, QString initialNfoContent)
 {
+    mediaelch::perf::ScopedTimer timer("nfo.parse.tvshow");
     show->clear();
     show->setChanged(false);
 
@@ -770,6 +762,7 @@ bool KodiXml::loadTvShow(TvShow* show, QString initialNfoContent)
  */
 bool KodiXml::loadTvShowEpisode(TvShowEpisode* episode, QString initialNfoContent)
 {
+    mediaelch::perf::ScopedTimer timer("nfo.parse.episode");
     if (episode == nullptr) {
         qCWarning(generic) << "[KodiXml] Passed an empty (null) episode to loadTvShowEpisode";
         return false;
@@ -860,17 +853,10 @@ bool KodiXml::saveTvShow(TvShow* show)
 
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowNfo)) {
         QString saveFilePath = show->dir().filePath(dataFile.saveFileName(""));
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] NFO file could not be openend for writing" << file.fileName();
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
+            qCWarning(generic) << "[KodiXml] NFO file could not be openend for writing" << saveFilePath;
             return false;
         }
-        file.write(xmlContent);
-        file.close();
     }
 
     for (const auto imageType : TvShow::imageTypes()) {
@@ -884,7 +870,7 @@ bool KodiXml::saveTvShow(TvShow* show)
         if (show->imagesToRemove().contains(imageType)) {
             for (auto dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName("");
-                QFile(show->dir().filePath(saveFileName)).remove();
+                removeFile(show->dir().filePath(saveFileName));
             }
         }
     }
@@ -902,7 +888,7 @@ bool KodiXml::saveTvShow(TvShow* show)
                 && show->imagesToRemove().value(imageType).contains(season)) {
                 for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                     QString saveFileName = dataFile.saveFileName("", season);
-                    QFile(show->dir().filePath(saveFileName)).remove();
+                    removeFile(show->dir().filePath(saveFileName));
                 }
             }
         }
@@ -910,18 +896,18 @@ bool KodiXml::saveTvShow(TvShow* show)
 
     if (show->dir().isValid()) {
         for (const QString& file : show->extraFanartsToRemove()) {
-            QFile::remove(file);
+            removeFile(file);
         }
         QDir dir(show->dir().toString() + "/extrafanart");
         if (!dir.exists() && !show->extraFanartImagesToAdd().isEmpty()) {
             QDir(show->dir().toString()).mkdir("extrafanart");
         }
+        int num = 1;
         for (const QByteArray& img : show->extraFanartImagesToAdd()) {
-            int num = 1;
             while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
                 ++num;
             }
-            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+            saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num++), img);
         }
     }
 
@@ -947,11 +933,8 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
 {
     // Multi-Episode handling
     QVector<TvShowEpisode*> episodes;
-    for (TvShowEpisode* subEpisode : episode->tvShow()->episodes()) {
-        if (subEpisode->isDummy()) {
-            continue;
-        }
-        if (episode->files() == subEpisode->files()) {
+    for (TvShowEpisode* subEpisode : episode->tvShow()->episodes(episode->files())) {
+        if (!subEpisode->isDummy()) {
             episodes.append(subEpisode);
         }
     }
@@ -974,17 +957,10 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
         QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        if (!saveFile(saveFilePath, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
             qCWarning(generic) << "[KodiXml] NFO file could not be opened for writing" << saveFileName;
             return false;
         }
-        file.write(xmlContent);
-        file.close();
     }
 
     fi.setFile(episode->files().first().toString());
@@ -1009,14 +985,14 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
         if (helper::isBluRay(episode->files().first()) || helper::isDvd(episode->files().at(0))) {
             QDir dir = fi.dir();
             dir.cdUp();
-            QFile(dir.absolutePath() + "/thumb.jpg").remove();
+            removeFile(dir.absolutePath() + "/thumb.jpg");
         } else if (helper::isDvd(episode->files().first(), true)) {
-            QFile(fi.dir().absolutePath() + "/thumb.jpg").remove();
+            removeFile(fi.dir().absolutePath() + "/thumb.jpg");
         } else {
             for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowEpisodeThumb)) {
                 QString saveFileName =
                     dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
-                QFile(fi.absolutePath() + "/" + saveFileName).remove();
+                removeFile(fi.absolutePath() + "/" + saveFileName);
             }
         }
     }
@@ -1162,20 +1138,19 @@ void KodiXml::saveMovieSetBackdrop(QString setName, QImage backdrop)
     }
 }
 
-bool KodiXml::saveFile(QString filename, QByteArray data)
+/// \brief Writes data to the given file. Inside of a SaveQueue, the file is written in the background.
+/// \see mediaelch::SaveQueue::writeFile
+bool KodiXml::saveFile(QString filename, QByteArray data, QIODevice::OpenMode mode)
 {
-    QDir saveFileDir = QFileInfo(filename).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    QFile file(filename);
+    return mediaelch::SaveQueue::writeFile(filename, data, mode);
+}
 
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(data);
-        file.close();
-        return true;
-    }
-    return false;
+/// \brief Removes the given file. Inside of a SaveQueue, it is removed in the background
+///        after all earlier writes to it.
+/// \see mediaelch::SaveQueue::removeFile
+bool KodiXml::removeFile(const QString& filename)
+{
+    return mediaelch::SaveQueue::removeFile(filename);
 }
 
 mediaelch::DirectoryPath KodiXml::getPath(const Movie* movie)
@@ -1584,18 +1559,9 @@ bool KodiXml::saveArtist(Artist* artist)
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(fileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    {
-        QFile file(fileName);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] File could not be openend";
-            return false;
-        }
-        file.write(xmlContent);
-        file.close();
+    if (!saveFile(fileName, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
+        qCWarning(generic) << "[KodiXml] File could not be openend";
+        return false;
     }
     for (const auto imageType : Artist::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
@@ -1604,7 +1570,7 @@ bool KodiXml::saveArtist(Artist* artist)
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
                 if (!saveFileName.isEmpty()) {
-                    QFile(artist->path().filePath(saveFileName)).remove();
+                    removeFile(artist->path().filePath(saveFileName));
                 }
             }
         }
@@ -1618,18 +1584,18 @@ bool KodiXml::saveArtist(Artist* artist)
     }
 
     for (const QString& file : artist->extraFanartsToRemove()) {
-        QFile::remove(file);
+        removeFile(file);
     }
     QDir dir(artist->path().subDir("extrafanart").toString());
     if (!dir.exists() && !artist->extraFanartImagesToAdd().isEmpty()) {
         QDir(artist->path().toString()).mkdir("extrafanart");
     }
+    int num = 1;
     for (const QByteArray& img : artist->extraFanartImagesToAdd()) {
-        int num = 1;
         while (QFileInfo(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num)).exists()) {
             ++num;
         }
-        saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num), img);
+        saveFile(dir.absolutePath() + "/" + QString("fanart%1.jpg").arg(num++), img);
     }
 
     return true;
@@ -1651,17 +1617,10 @@ bool KodiXml::saveAlbum(Album* album)
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(nfoFileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    QFile nfo(nfoFileName);
-    if (!nfo.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!saveFile(nfoFileName, xmlContent, QIODevice::WriteOnly | QIODevice::Text)) {
         qCWarning(generic) << "[KodiXml] File could not be openend";
         return false;
     }
-    nfo.write(xmlContent);
-    nfo.close();
 
     for (const auto imageType : Album::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
@@ -1670,7 +1629,7 @@ bool KodiXml::saveAlbum(Album* album)
             for (DataFile dataFile : Settings::instance()->dataFiles(dataFileType)) {
                 QString saveFileName = dataFile.saveFileName(QString());
                 if (!saveFileName.isEmpty()) {
-                    QFile(album->path().filePath(saveFileName)).remove();
+                    removeFile(album->path().filePath(saveFileName));
                 }
             }
         }
@@ -1692,7 +1651,7 @@ bool KodiXml::saveAlbum(Album* album)
         // \todo: get filename from settings
         for (Image* image : album->bookletModel()->images()) {
             if (image->deletion() && !image->fileName().isEmpty()) {
-                QFile::remove(image->fileName());
+                removeFile(image->fileName());
             } else if (!image->deletion()) {
                 image->load();
             }
@@ -1702,11 +1661,7 @@ bool KodiXml::saveAlbum(Album* album)
             if (!image->deletion()) {
                 QString imageFileName = "booklet" + QString("%1").arg(bookletNum, 2, 10, QChar('0')) + ".jpg";
                 QString imageFilePath = album->path().subDir("booklet").filePath(imageFileName);
-                QFile file(imageFilePath);
-                if (file.open(QIODevice::WriteOnly)) {
-                    file.write(image->rawData());
-                    file.close();
-                }
+                saveFile(imageFilePath, image->rawData());
                 bookletNum++;
             }
         }
@@ -8,6 +8,7 @@
 
 #include <QByteArray>
 #include <QDomDocument>
+#include <QIODevice>
 #include <QObject>
 #include <QString>
 #include <QVector>
@@ -115,7 +116,8 @@ private:
     QByteArray getAlbumXml(Album* album);
     bool loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc);
     void loadStreamDetails(StreamDetails* streamDetails, QDomElement elem);
-    bool saveFile(QString filename, QByteArray data);
+    bool saveFile(QString filename, QByteArray data, QIODevice::OpenMode mode = QIODevice::WriteOnly);
+    bool removeFile(const QString& filename);
     mediaelch::DirectoryPath getPath(const Movie* movie);
     mediaelch::DirectoryPath getPath(const Concert* concert);
     QString movieSetFileName(QString setName, DataFile* dataFile);
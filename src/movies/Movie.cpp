@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "data/ImageCache.h"
+#include "data/StringPool.h"
 #include "globals/Helper.h"
 #include "log/Log.h"
 #include "media_centers/MediaCenterInterface.h"
@@ -97,6 +98,7 @@ void Movie::clear(QSet<MovieScraperInfo> infos)
 {
     if (infos.contains(MovieScraperInfo::Actors)) {
         m_crew.setActors({});
+        m_hasUnloadedActors = false;
     }
     m_movieImages.clear(infos);
     if (infos.contains(MovieScraperInfo::Countries)) {
@@ -344,6 +346,11 @@ Actors& Movie::actors()
     return m_crew.actors();
 }
 
+bool Movie::hasActors() const
+{
+    return m_hasUnloadedActors || m_crew.actors().hasActors();
+}
+
 /**
  * \brief Holds the files of the movie
  * \return List of files
@@ -491,10 +498,28 @@ QDateTime Movie::fileLastModified() const
 }
 
 QString Movie::nfoContent() const
+{
+    return QString::fromUtf8(nfoContentUtf8());
+}
+
+QByteArray Movie::nfoContentUtf8() const
+{
+    if (m_nfoContent.isEmpty()) {
+        return QByteArray();
+    }
+    return qUncompress(m_nfoContent);
+}
+
+const QByteArray& Movie::compressedNfoContent() const
 {
     return m_nfoContent;
 }
 
+int Movie::storedNfoContentSize() const
+{
+    return m_nfoContent.size();
+}
+
 int Movie::databaseId() const
 {
     return m_databaseId;
@@ -742,6 +767,11 @@ void Movie::setStreamDetailsLoaded(bool loaded)
     m_streamDetailsLoaded = loaded;
 }
 
+void Movie::setHasUnloadedActors(bool hasActors)
+{
+    m_hasUnloadedActors = hasActors;
+}
+
 /**
  * \brief Sets if the movies files are stored in a separate folder
  * \param inSepFolder Files of the movie are in one separate folder
@@ -770,6 +800,13 @@ void Movie::setFileLastModified(QDateTime modified)
 }
 
 void Movie::setNfoContent(QString content)
+{
+    // The NFO content is only needed to (re-)load details and to write the database,
+    // so we keep it compressed instead of storing several KB of UTF-16 per item.
+    m_nfoContent = content.isEmpty() ? QByteArray() : qCompress(content.toUtf8());
+}
+
+void Movie::setCompressedNfoContent(QByteArray content)
 {
     m_nfoContent = std::move(content);
 }
@@ -807,7 +844,7 @@ void Movie::addCountry(QString country) // NOLINT // we require pass-by-value
     if (country.isEmpty()) {
         return;
     }
-    m_countries.append(country);
+    m_countries.append(mediaelch::StringPool::global().intern(country));
     setChanged(true);
 }
 
@@ -821,7 +858,7 @@ void Movie::addGenre(QString genre) // NOLINT // we require pass-by-value
     if (genre.isEmpty()) {
         return;
     }
-    m_genres.append(genre);
+    m_genres.append(mediaelch::StringPool::global().intern(genre));
     setChanged(true);
 }
 
@@ -835,7 +872,7 @@ void Movie::addStudio(QString studio) // NOLINT // we require pass-by-value
     if (studio.isEmpty()) {
         return;
     }
-    m_studios.append(studio);
+    m_studios.append(mediaelch::StringPool::global().intern(studio));
     setChanged(true);
 }
 
@@ -844,7 +881,7 @@ void Movie::addTag(QString tag) // NOLINT // we require pass-by-value
     if (m_tags.contains(tag)) {
         return;
     }
-    m_tags.append(tag);
+    m_tags.append(mediaelch::StringPool::global().intern(tag));
     setChanged(true);
 }
 
@@ -70,6 +70,9 @@ public:
 
     const Actors& actors() const;
     Actors& actors();
+    /// \brief Returns true if the movie has actors, even if they are not loaded yet.
+    /// \see setHasUnloadedActors()
+    bool hasActors() const;
 
     const mediaelch::FileList& files() const;
     QString folderName() const;
@@ -85,7 +88,14 @@ public:
     StreamDetails* streamDetails();
     bool streamDetailsLoaded() const;
     QDateTime fileLastModified() const;
+    /// \brief Decompresses the NFO content. Store the result instead of calling this repeatedly.
     QString nfoContent() const;
+    /// \brief Decompressed NFO content without converting it from UTF-8, e.g. for the database.
+    QByteArray nfoContentUtf8() const;
+    /// \brief The qCompress()ed NFO content that is kept in memory, see setCompressedNfoContent().
+    const QByteArray& compressedNfoContent() const;
+    /// \brief Size of the compressed NFO content that is kept in memory.
+    int storedNfoContentSize() const;
     int databaseId() const;
     bool syncNeeded() const;
     bool hasLocalTrailer() const;
@@ -129,8 +139,13 @@ public:
     void setInSeparateFolder(bool inSepFolder);
     void setMediaCenterId(int mediaCenterId);
     void setStreamDetailsLoaded(bool loaded);
+    /// \brief Marks that the movie has actors that are not loaded, e.g. because only
+    ///        the details shown in movie lists were read from the database.
+    void setHasUnloadedActors(bool hasActors);
     void setFileLastModified(QDateTime modified);
     void setNfoContent(QString content);
+    /// \brief Sets NFO content that was compressed before, e.g. read from a movie snapshot.
+    void setCompressedNfoContent(QByteArray content);
     void setDatabaseId(int id);
     void setSyncNeeded(bool syncNeeded);
     void setDateAdded(QDateTime date);
@@ -207,9 +222,11 @@ private:
     bool m_syncNeeded = false;
     bool m_streamDetailsLoaded = false;
     bool m_hasDuplicates = false;
+    bool m_hasUnloadedActors = false;
     StreamDetails* m_streamDetails;
     QDateTime m_fileLastModified;
-    QString m_nfoContent;
+    /// qCompress()ed UTF-8 NFO content.
+    QByteArray m_nfoContent;
     QDateTime m_dateAdded;
     DiscType m_discType;
     ColorLabel m_label;
@@ -3,9 +3,12 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QRegularExpression>
+#include <QThread>
+#include <QtConcurrent>
 #include <QtCore/qmath.h>
 #include <chrono>
 
+#include "data/Database.h"
 #include "data/ImageCache.h"
 #include "file/NameFormatter.h"
 #include "globals/DownloadManager.h"
@@ -19,7 +22,6 @@
 #include "scrapers/movie/tmdb/TmdbMovie.h"
 #include "settings/Settings.h"
 // TODO: Remove UI dependency
-#include "ui/notifications/NotificationBox.h"
 
 MovieController::MovieController(Movie* parent) :
     QObject(parent),
@@ -47,6 +49,12 @@ MovieController::MovieController(Movie* parent) :
 
 bool MovieController::saveData(MediaCenterInterface* mediaCenterInterface)
 {
+    if (!m_hydrated) {
+        // Saving a movie with only its list details would remove all other details from the NFO file.
+        // Reloading the NFO here would discard the changes, so callers must hydrate it before editing it.
+        qCCritical(generic) << "[MovieController] Refusing to save a movie that is not hydrated:" << m_movie->name();
+        return false;
+    }
     if (!m_movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         loadStreamDetailsFromFile();
     }
@@ -74,6 +82,11 @@ bool MovieController::loadData(MediaCenterInterface* mediaCenterInterface, bool
     }
 
     NameFormatter nameFormatter(Settings::instance()->excludeWords());
+    // Unsaved changes are discarded, e.g. when reverting them. Models (and their facet
+    // index) have to be notified about that.  Otherwise, the list columns are the ones that
+    // they already know and notifying them for each loaded movie is only overhead; only the
+    // facet index is updated, as it also contains details that are not in the list columns.
+    const bool discardsChanges = m_movie->hasChanged();
     m_movie->blockSignals(true);
 
     bool infoLoaded = false;
@@ -131,8 +144,18 @@ bool MovieController::loadData(MediaCenterInterface* mediaCenterInterface, bool
     }
     m_infoLoaded = infoLoaded;
     m_infoFromNfoLoaded = infoLoaded && reloadFromNfo;
-    m_movie->setChanged(false);
-    m_movie->blockSignals(false);
+    m_hydrated = true;
+    if (discardsChanges) {
+        m_movie->blockSignals(false);
+        m_movie->setChanged(false);
+    } else {
+        m_movie->setChanged(false);
+        m_movie->blockSignals(false);
+        // Movies loaded in worker threads are indexed by the caller, e.g. hydrate().
+        if (QThread::currentThread() == Manager::instance()->movieModel()->thread()) {
+            Manager::instance()->movieModel()->updateFacetIndex({m_movie});
+        }
+    }
     return infoLoaded;
 }
 
@@ -140,8 +163,13 @@ void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, mediaelc
     mediaelch::scraper::MovieScraper* scraperInterface,
     QSet<MovieScraperInfo> infos)
 {
+    hydrate();
     emit sigLoadStarted(m_movie);
     m_infosToLoad = infos;
+    m_loadError = {};
+    m_fanartRequested = false;
+    m_fanartPrefetch = FanartPrefetch::None;
+    m_prefetchedFanart.clear();
     if (scraperInterface->meta().identifier == mediaelch::scraper::TmdbMovie::ID
         && !ids.values().first().str().startsWith("tt")) {
         m_movie->setTmdbId(TmdbId(ids.values().first().str()));
@@ -180,12 +208,11 @@ void MovieController::setInfosToLoad(QSet<MovieScraperInfo> infos)
 
 void MovieController::scraperLoadDone(mediaelch::scraper::MovieScraper* scraper, mediaelch::ScraperError error)
 {
-    using namespace std::chrono_literals;
-
-    if (error.hasError() && !error.is404()) {
-        // TODO: 404 not necessary but avoids false positives at the moment.
-        // TODO: Remove UI dependency
-        NotificationBox::instance()->showError(error.message, 6s);
+    if (error.hasError()) {
+        if (!m_loadError.hasError()) {
+            m_loadError = error;
+        }
+        emit sigLoadError(m_movie, error);
     }
 
     m_customScraperMutex.lock();
@@ -206,52 +233,79 @@ void MovieController::scraperLoadDone(mediaelch::scraper::MovieScraper* scraper,
         return;
     }
 
-    QVector<ImageType> images;
-    mediaelch::scraper::MovieScraper* sigScraper = scraper;
+    const QVector<ImageType> images = fanartImageTypes(scraper);
+    // Scraped images of these types are replaced by the ones from fanart.tv.
+    const QMap<ImageType, MovieScraperInfo> replacedInfos{{ImageType::MovieBackdrop, MovieScraperInfo::Backdrop},
+        {ImageType::MoviePoster, MovieScraperInfo::Poster},
+        {ImageType::MovieClearArt, MovieScraperInfo::ClearArt},
+        {ImageType::MovieCdArt, MovieScraperInfo::CdArt},
+        {ImageType::MovieLogo, MovieScraperInfo::Logo}};
+    for (ImageType type : images) {
+        if (replacedInfos.contains(type)) {
+            m_movie->clear({replacedInfos.value(type)});
+        }
+    }
 
-    scraper = (property("isCustomScraper").toBool())
-                  ? mediaelch::scraper::CustomMovieScraper::instance()->scraperForInfo(MovieScraperInfo::Backdrop)
-                  : sigScraper;
-    if (infosToLoad().contains(MovieScraperInfo::Backdrop)
-        && (m_forceFanartBackdrop || !scraper->scraperNativelySupports().contains(MovieScraperInfo::Backdrop))) {
-        images << ImageType::MovieBackdrop;
-        m_movie->clear({MovieScraperInfo::Backdrop});
+    if (m_fanartPrefetch == FanartPrefetch::Loaded) {
+        m_fanartPrefetch = FanartPrefetch::None;
+        onFanartLoadDone(m_movie, m_prefetchedFanart);
+        m_prefetchedFanart.clear();
+        return;
+    }
+    if (m_fanartPrefetch == FanartPrefetch::Loading) {
+        // Continued by onFanartImagesLoaded()
+        m_fanartPrefetch = FanartPrefetch::WaitingForImages;
+        return;
     }
 
-    scraper = (property("isCustomScraper").toBool())
-                  ? mediaelch::scraper::CustomMovieScraper::instance()->scraperForInfo(MovieScraperInfo::Poster)
-                  : sigScraper;
-    if (infosToLoad().contains(MovieScraperInfo::Poster)
-        && (m_forceFanartPoster || !scraper->scraperNativelySupports().contains(MovieScraperInfo::Poster))) {
-        images << ImageType::MoviePoster;
-        m_movie->clear({MovieScraperInfo::Poster});
+    if (!images.isEmpty() && (m_movie->tmdbId().isValid() || m_movie->imdbId().isValid())) {
+        requestFanartImages(images);
+    } else {
+        onFanartLoadDone(m_movie, QMap<ImageType, QVector<Poster>>());
     }
+}
 
-    scraper = (property("isCustomScraper").toBool())
-                  ? mediaelch::scraper::CustomMovieScraper::instance()->scraperForInfo(MovieScraperInfo::ClearArt)
-                  : sigScraper;
-    if (infosToLoad().contains(MovieScraperInfo::ClearArt)
-        && (m_forceFanartClearArt || !scraper->scraperNativelySupports().contains(MovieScraperInfo::ClearArt))) {
-        images << ImageType::MovieClearArt;
-        m_movie->clear({MovieScraperInfo::ClearArt});
+void MovieController::prefetchFanartImages(mediaelch::scraper::MovieScraper* scraper)
+{
+    const QVector<ImageType> images = fanartImageTypes(scraper);
+    if (images.isEmpty() || (!m_movie->tmdbId().isValid() && !m_movie->imdbId().isValid())) {
+        return;
     }
+    m_fanartPrefetch = FanartPrefetch::Loading;
+    m_prefetchedFanart.clear();
+    requestFanartImages(images);
+}
+
+QVector<ImageType> MovieController::fanartImageTypes(mediaelch::scraper::MovieScraper* scraper)
+{
+    const bool isCustomScraper = property("isCustomScraper").toBool();
+    const auto loadFromFanart = [&](MovieScraperInfo info, bool force) {
+        if (!infosToLoad().contains(info)) {
+            return false;
+        }
+        if (force) {
+            return true;
+        }
+        auto* infoScraper =
+            isCustomScraper ? mediaelch::scraper::CustomMovieScraper::instance()->scraperForInfo(info) : scraper;
+        return !infoScraper->scraperNativelySupports().contains(info);
+    };
 
-    scraper = (property("isCustomScraper").toBool())
-                  ? mediaelch::scraper::CustomMovieScraper::instance()->scraperForInfo(MovieScraperInfo::CdArt)
-                  : sigScraper;
-    if (infosToLoad().contains(MovieScraperInfo::CdArt)
-        && (m_forceFanartCdArt || !scraper->scraperNativelySupports().contains(MovieScraperInfo::CdArt))) {
+    QVector<ImageType> images;
+    if (loadFromFanart(MovieScraperInfo::Backdrop, m_forceFanartBackdrop)) {
+        images << ImageType::MovieBackdrop;
+    }
+    if (loadFromFanart(MovieScraperInfo::Poster, m_forceFanartPoster)) {
+        images << ImageType::MoviePoster;
+    }
+    if (loadFromFanart(MovieScraperInfo::ClearArt, m_forceFanartClearArt)) {
+        images << ImageType::MovieClearArt;
+    }
+    if (loadFromFanart(MovieScraperInfo::CdArt, m_forceFanartCdArt)) {
         images << ImageType::MovieCdArt;
-        m_movie->clear({MovieScraperInfo::CdArt});
     }
-
-    scraper = (property("isCustomScraper").toBool())
-                  ? mediaelch::scraper::CustomMovieScraper::instance()->scraperForInfo(MovieScraperInfo::Logo)
-                  : sigScraper;
-    if (infosToLoad().contains(MovieScraperInfo::Logo)
-        && (m_forceFanartLogo || !scraper->scraperNativelySupports().contains(MovieScraperInfo::Logo))) {
+    if (loadFromFanart(MovieScraperInfo::Logo, m_forceFanartLogo)) {
         images << ImageType::MovieLogo;
-        m_movie->clear({MovieScraperInfo::Logo});
     }
     if (infosToLoad().contains(MovieScraperInfo::Banner)) {
         images << ImageType::MovieBanner;
@@ -259,18 +313,35 @@ void MovieController::scraperLoadDone(mediaelch::scraper::MovieScraper* scraper,
     if (infosToLoad().contains(MovieScraperInfo::Thumb)) {
         images << ImageType::MovieThumb;
     }
+    return images;
+}
 
-    if (!images.isEmpty() && (m_movie->tmdbId().isValid() || m_movie->imdbId().isValid())) {
-        connect(Manager::instance()->fanartTv(),
-            &mediaelch::scraper::ImageProvider::sigMovieImagesLoaded,
-            this,
-            &MovieController::onFanartLoadDone,
-            Qt::UniqueConnection);
-        Manager::instance()->fanartTv()->movieImages(
-            m_movie, (m_movie->tmdbId().isValid()) ? m_movie->tmdbId() : TmdbId(m_movie->imdbId().toString()), images);
-    } else {
-        onFanartLoadDone(m_movie, QMap<ImageType, QVector<Poster>>());
+void MovieController::requestFanartImages(const QVector<ImageType>& images)
+{
+    connect(Manager::instance()->fanartTv(),
+        &mediaelch::scraper::ImageProvider::sigMovieImagesLoaded,
+        this,
+        &MovieController::onFanartImagesLoaded,
+        Qt::UniqueConnection);
+    m_fanartRequested = true;
+    Manager::instance()->fanartTv()->movieImages(
+        m_movie, (m_movie->tmdbId().isValid()) ? m_movie->tmdbId() : TmdbId(m_movie->imdbId().toString()), images);
+}
+
+void MovieController::onFanartImagesLoaded(Movie* movie, QMap<ImageType, QVector<Poster>> posters)
+{
+    if (movie != m_movie || !m_fanartRequested) {
+        return;
     }
+    m_fanartRequested = false;
+    if (m_fanartPrefetch == FanartPrefetch::Loading) {
+        // Details are still loading, scraperLoadDone() continues with these images.
+        m_prefetchedFanart = posters;
+        m_fanartPrefetch = FanartPrefetch::Loaded;
+        return;
+    }
+    m_fanartPrefetch = FanartPrefetch::None;
+    onFanartLoadDone(movie, posters);
 }
 
 void MovieController::onFanartLoadDone(Movie* movie, QMap<ImageType, QVector<Poster>> posters)
@@ -407,6 +478,62 @@ bool MovieController::infoLoaded() const
     return m_infoLoaded;
 }
 
+void MovieController::setInfoLoaded(bool infoLoaded)
+{
+    m_infoLoaded = infoLoaded;
+}
+
+bool MovieController::isHydrated() const
+{
+    return m_hydrated;
+}
+
+void MovieController::setHydrated(bool hydrated)
+{
+    m_hydrated = hydrated;
+}
+
+void MovieController::hydrate()
+{
+    if (!m_hydrated) {
+        hydrate({m_movie});
+    }
+}
+
+void MovieController::hydrate(const QVector<Movie*>& movies)
+{
+    QVector<Movie*> moviesToHydrate;
+    QVector<int> databaseIds;
+    for (Movie* movie : movies) {
+        if (!movie->controller()->isHydrated()) {
+            if (movie->hasChanged()) {
+                // Hydrating reloads the NFO content; see saveData().
+                qCWarning(generic) << "[MovieController] Hydrating a changed movie discards its changes:"
+                                   << movie->name();
+            }
+            moviesToHydrate << movie;
+            databaseIds << movie->databaseId();
+        }
+    }
+    if (moviesToHydrate.isEmpty()) {
+        return;
+    }
+
+    // Light movies don't keep their NFO content in memory. It is read from the database
+    // in one go because the database connection must only be used in the main thread.
+    const QHash<int, QString> nfoContents = Manager::instance()->database()->movieNfoContents(databaseIds);
+    for (Movie* movie : asConst(moviesToHydrate)) {
+        movie->setNfoContent(nfoContents.value(movie->databaseId()));
+    }
+
+    // If there is no NFO content in the database, the movie is loaded from disk.
+    QtConcurrent::blockingMap(moviesToHydrate, [](Movie* movie) {
+        movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true, false);
+    });
+    Manager::instance()->movieModel()->updateFacetIndex(moviesToHydrate);
+    qCDebug(generic) << "[MovieController] Hydrated" << moviesToHydrate.size() << "movies";
+}
+
 bool MovieController::downloadsInProgress() const
 {
     return m_downloadsInProgress;
@@ -423,13 +550,17 @@ void MovieController::setLoadsLeft(QVector<ScraperData> loadsLeft)
     m_loadsLeft = loadsLeft;
 }
 
-void MovieController::removeFromLoadsLeft(ScraperData load)
+void MovieController::removeFromLoadsLeft(ScraperData load, mediaelch::ScraperError error)
 {
     m_loadsLeft.removeOne(load);
     m_loadMutex.lock();
+    if (error.hasError() && !m_loadError.hasError()) {
+        m_loadError = error;
+    }
     if (m_loadsLeft.isEmpty() && !m_loadDoneFired) {
         m_loadDoneFired = true;
-        scraperLoadDone(Manager::instance()->scrapers().movieScraper(mediaelch::scraper::TmdbMovie::ID), {});
+        scraperLoadDone(
+            Manager::instance()->scrapers().movieScraper(mediaelch::scraper::TmdbMovie::ID), m_loadError);
     }
     m_loadMutex.unlock();
 }
@@ -51,12 +51,33 @@ public:
     /// \brief Called when a ScraperInterface has finished loading
     ///        Emits the loaded signal
     void scraperLoadDone(mediaelch::scraper::MovieScraper* scraper, mediaelch::ScraperError error);
+    /// \brief First error of the last load started by loadData(), if any.  The movie's
+    ///        details may have been cleared without loading new ones, so it must not be saved.
+    const mediaelch::ScraperError& loadError() const { return m_loadError; }
 
     QSet<MovieScraperInfo> infosToLoad();
 
     /// \brief Holds wether movie infos were loaded from a MediaCenterInterface or ScraperInterface
     /// \return Infos were loaded
     bool infoLoaded() const;
+    /// \brief Marks the movie's infos as loaded, e.g. if they were restored from a snapshot.
+    void setInfoLoaded(bool infoLoaded);
+
+    /// \brief Whether all of the movie's details are loaded.
+    ///
+    /// Movies loaded from the database only contain the details shown in movie
+    /// lists and used by filters.  Their NFO content is parsed by hydrate() once
+    /// the movie is opened, edited, exported or scraped.
+    bool isHydrated() const;
+    void setHydrated(bool hydrated);
+    /// \brief Loads all details of a movie that only has its list details loaded.
+    ///        Does nothing if the movie is already hydrated.
+    ///
+    /// The NFO content is reloaded, so movies must be hydrated before they are
+    /// edited. saveData() refuses to save movies that are not hydrated.
+    void hydrate();
+    /// \brief Hydrates all given movies. NFO contents are parsed in parallel.
+    static void hydrate(const QVector<Movie*>& movies);
 
     /// \brief Returns true if a download is in progress
     /// \return Download is in progress
@@ -66,7 +87,8 @@ public:
     void loadImages(ImageType type, QVector<QUrl> urls);
     void abortDownloads();
     void setLoadsLeft(QVector<ScraperData> loadsLeft);
-    void removeFromLoadsLeft(ScraperData load);
+    /// \brief Marks the load as done. Its error, if any, is reported once all loads are done.
+    void removeFromLoadsLeft(ScraperData load, mediaelch::ScraperError error = {});
     void setInfosToLoad(QSet<MovieScraperInfo> infos);
     void setForceFanartBackdrop(const bool& force);
     void setForceFanartPoster(const bool& force);
@@ -74,25 +96,50 @@ public:
     void setForceFanartClearArt(const bool& force);
     void setForceFanartLogo(const bool& force);
 
+    /// \brief Starts loading fanart.tv's image lists while the movie's details are still loaded.
+    ///
+    /// Requires the movie's TMDb or IMDb ID as well as the infos to load and fanart.tv settings
+    /// to be known. scraperLoadDone() then continues with the prefetched images instead of
+    /// requesting them after all details are loaded.
+    void prefetchFanartImages(mediaelch::scraper::MovieScraper* scraper);
+
 signals:
     void sigLoadStarted(Movie*);
     void sigInfoLoadDone(Movie*);
     void sigLoadDone(Movie*);
+    /// \brief A scraper reported an error. sigLoadDone() is still emitted, see loadError().
+    void sigLoadError(Movie*, mediaelch::ScraperError);
     void sigLoadImagesStarted(Movie*);
     void sigDownloadProgress(Movie*, int, int);
     void sigLoadingImages(Movie*, QVector<ImageType>);
     void sigImage(Movie*, ImageType, QByteArray);
 
 private slots:
+    void onFanartImagesLoaded(Movie* movie, QMap<ImageType, QVector<Poster>> posters);
     void onFanartLoadDone(Movie* movie, QMap<ImageType, QVector<Poster>> posters);
     void onAllDownloadsFinished();
     void onDownloadFinished(DownloadManagerElement elem);
 
+private:
+    enum class FanartPrefetch
+    {
+        None,
+        Loading,
+        Loaded,
+        WaitingForImages
+    };
+
+    /// \brief Image types that are loaded from fanart.tv after scraping with the given scraper.
+    QVector<ImageType> fanartImageTypes(mediaelch::scraper::MovieScraper* scraper);
+    void requestFanartImages(const QVector<ImageType>& images);
+
 private:
     Movie* m_movie;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
+    bool m_hydrated = true;
     QSet<MovieScraperInfo> m_infosToLoad;
+    mediaelch::ScraperError m_loadError;
     DownloadManager* m_downloadManager;
     bool m_downloadsInProgress = false;
     int m_downloadsSize = 0;
@@ -106,4 +153,7 @@ private:
     bool m_forceFanartClearArt;
     bool m_forceFanartCdArt;
     bool m_forceFanartLogo;
+    bool m_fanartRequested = false;
+    FanartPrefetch m_fanartPrefetch = FanartPrefetch::None;
+    QMap<ImageType, QVector<Poster>> m_prefetchedFanart;
 };
@@ -0,0 +1,158 @@
+#include "movies/MovieFacetIndex.h"
+
+#include "globals/LocaleStringCompare.h"
+#include "movies/Movie.h"
+
+#include <algorithm>
+
+namespace mediaelch {
+
+constexpr int MovieFacetIndex::FACET_COUNT;
+
+void MovieFacetIndex::addMovie(Movie* movie)
+{
+    const int movieId = movie->movieId();
+    const MovieValues oldValues = m_valuesByMovie.value(movieId);
+
+    MovieValues newValues;
+    bool changed = false;
+    for (int facet = 0; facet < FACET_COUNT; ++facet) {
+        newValues[facet] = facetValues(movie, static_cast<MovieFacet>(facet));
+        if (newValues[facet] == oldValues[facet]) {
+            continue;
+        }
+        changed = true;
+        removeValues(movieId, facet, oldValues[facet]);
+        for (const QString& value : newValues[facet]) {
+            QSet<int>& postings = m_postings[facet][value];
+            if (postings.isEmpty()) {
+                m_sortedValuesValid[facet] = false;
+            }
+            postings.insert(movieId);
+        }
+    }
+
+    if (changed || !m_valuesByMovie.contains(movieId)) {
+        m_valuesByMovie.insert(movieId, newValues);
+        ++m_revision;
+    }
+}
+
+void MovieFacetIndex::removeMovie(int movieId)
+{
+    auto movieValues = m_valuesByMovie.find(movieId);
+    if (movieValues == m_valuesByMovie.end()) {
+        return;
+    }
+    for (int facet = 0; facet < FACET_COUNT; ++facet) {
+        removeValues(movieId, facet, movieValues.value()[facet]);
+    }
+    m_valuesByMovie.erase(movieValues);
+    ++m_revision;
+}
+
+void MovieFacetIndex::clear()
+{
+    for (int facet = 0; facet < FACET_COUNT; ++facet) {
+        m_postings[facet].clear();
+        m_sortedValues[facet].clear();
+        m_sortedValuesValid[facet] = false;
+    }
+    m_valuesByMovie.clear();
+    ++m_revision;
+}
+
+QVector<MovieFacetIndex::ValueCount> MovieFacetIndex::values(MovieFacet facet) const
+{
+    const int f = static_cast<int>(facet);
+    if (!m_sortedValuesValid[f]) {
+        m_sortedValues[f] = m_postings[f].keys();
+        std::sort(m_sortedValues[f].begin(), m_sortedValues[f].end(), LocaleStringCompare());
+        m_sortedValuesValid[f] = true;
+    }
+
+    QVector<ValueCount> result;
+    result.reserve(m_sortedValues[f].size());
+    for (const QString& value : m_sortedValues[f]) {
+        ValueCount valueCount;
+        valueCount.value = value;
+        valueCount.count = m_postings[f].value(value).size();
+        result.push_back(valueCount);
+    }
+    return result;
+}
+
+QSet<int> MovieFacetIndex::movies(MovieFacet facet, const QString& value) const
+{
+    return m_postings[static_cast<int>(facet)].value(value);
+}
+
+int MovieFacetIndex::count(MovieFacet facet, const QString& value) const
+{
+    const auto& postings = m_postings[static_cast<int>(facet)];
+    auto it = postings.constFind(value);
+    return it == postings.constEnd() ? 0 : it->size();
+}
+
+MovieFilters MovieFacetIndex::filterInfo(MovieFacet facet)
+{
+    switch (facet) {
+    case MovieFacet::Genre: return MovieFilters::Genres;
+    case MovieFacet::Studio: return MovieFilters::Studio;
+    case MovieFacet::Country: return MovieFilters::Country;
+    case MovieFacet::Tag: return MovieFilters::Tags;
+    case MovieFacet::Director: return MovieFilters::Director;
+    case MovieFacet::VideoCodec: return MovieFilters::VideoCodec;
+    case MovieFacet::Year: return MovieFilters::Released;
+    case MovieFacet::Certification: return MovieFilters::Certification;
+    case MovieFacet::Set: return MovieFilters::Set;
+    }
+    return MovieFilters::Title;
+}
+
+QStringList MovieFacetIndex::facetValues(Movie* movie, MovieFacet facet)
+{
+    const auto notEmpty = [](const QString& value) { return value.isEmpty() ? QStringList{} : QStringList{value}; };
+    const auto notEmptyUnique = [](const QStringList& values) {
+        QStringList result;
+        for (const QString& value : values) {
+            if (!value.isEmpty() && !result.contains(value)) {
+                result.append(value);
+            }
+        }
+        return result;
+    };
+
+    switch (facet) {
+    case MovieFacet::Genre: return notEmptyUnique(movie->genres());
+    case MovieFacet::Studio: return notEmptyUnique(movie->studios());
+    case MovieFacet::Country: return notEmptyUnique(movie->countries());
+    case MovieFacet::Tag: return notEmptyUnique(movie->tags());
+    case MovieFacet::Director: return notEmpty(movie->director());
+    case MovieFacet::VideoCodec:
+        return notEmpty(movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Codec));
+    case MovieFacet::Year:
+        return movie->released().isValid() ? QStringList{QString::number(movie->released().year())} : QStringList{};
+    case MovieFacet::Certification:
+        return movie->certification().isValid() ? QStringList{movie->certification().toString()} : QStringList{};
+    case MovieFacet::Set: return notEmpty(movie->set().name);
+    }
+    return {};
+}
+
+void MovieFacetIndex::removeValues(int movieId, int facet, const QStringList& values)
+{
+    for (const QString& value : values) {
+        auto postings = m_postings[facet].find(value);
+        if (postings == m_postings[facet].end()) {
+            continue;
+        }
+        postings->remove(movieId);
+        if (postings->isEmpty()) {
+            m_postings[facet].erase(postings);
+            m_sortedValuesValid[facet] = false;
+        }
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "globals/Globals.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <array>
+
+class Movie;
+
+namespace mediaelch {
+
+/// \brief Movie details that movies can be filtered by, e.g. "Genre: Action".
+enum class MovieFacet
+{
+    Genre,
+    Studio,
+    Country,
+    Tag,
+    Director,
+    VideoCodec,
+    Year,
+    Certification,
+    Set,
+
+    First = Genre,
+    Last = Set
+};
+
+/// \brief Index of all values of each MovieFacet and the movies that have them.
+///
+/// The index is updated by MovieModel whenever a movie is added or changed, so that
+/// the available filters and their counts are known without walking all movies.
+/// Each value maps to a posting list of movie IDs (Movie::movieId()) which can be
+/// intersected to filter movies.
+///
+/// \par Example
+/// \code{cpp}
+///   const MovieFacetIndex& index = Manager::instance()->movieModel()->facetIndex();
+///   for (const MovieFacetIndex::ValueCount& genre : index.values(MovieFacet::Genre)) {
+///       qCDebug(generic) << genre.value << genre.count;
+///   }
+///   QSet<int> actionMovies = index.movies(MovieFacet::Genre, "Action");
+/// \endcode
+class MovieFacetIndex
+{
+public:
+    struct ValueCount
+    {
+        QString value;
+        int count = 0;
+    };
+
+public:
+    MovieFacetIndex() = default;
+
+    /// \brief Adds the movie or updates its values if it was already added.
+    void addMovie(Movie* movie);
+    void removeMovie(int movieId);
+    bool contains(int movieId) const { return m_valuesByMovie.contains(movieId); }
+    void clear();
+
+    /// \brief All values of the given facet, sorted locale-aware, with their number of movies.
+    QVector<ValueCount> values(MovieFacet facet) const;
+    /// \brief IDs of all movies that have the given value.
+    QSet<int> movies(MovieFacet facet, const QString& value) const;
+    int count(MovieFacet facet, const QString& value) const;
+
+    /// \brief Incremented on every change of the index. Can be used to invalidate caches.
+    quint64 revision() const { return m_revision; }
+
+    /// \brief Filter type that filters by the given facet.
+    static MovieFilters filterInfo(MovieFacet facet);
+    /// \brief Non-empty values of the given movie for the given facet.
+    static QStringList facetValues(Movie* movie, MovieFacet facet);
+
+private:
+    static constexpr int FACET_COUNT = static_cast<int>(MovieFacet::Last) + 1;
+    using MovieValues = std::array<QStringList, FACET_COUNT>;
+
+    void removeValues(int movieId, int facet, const QStringList& values);
+
+private:
+    std::array<QHash<QString, QSet<int>>, FACET_COUNT> m_postings;
+    QHash<int, MovieValues> m_valuesByMovie;
+    quint64 m_revision = 0;
+
+    /// Sorted values are cached until values of the facet are added or removed.
+    mutable std::array<QStringList, FACET_COUNT> m_sortedValues;
+    mutable std::array<bool, FACET_COUNT> m_sortedValuesValid{};
+};
+
+} // namespace mediaelch
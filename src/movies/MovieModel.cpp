@@ -28,6 +28,7 @@ void MovieModel::addMovie(Movie* movie)
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_movies.append(movie);
     endInsertRows();
+    m_facetIndex.addMovie(movie);
     connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
 }
 
@@ -36,18 +37,29 @@ void MovieModel::addMovies(const QVector<Movie*>& movies)
     beginInsertRows(QModelIndex(), rowCount(), rowCount() + movies.size() - 1);
     m_movies.append(movies);
     for (Movie* movie : movies) {
+        m_facetIndex.addMovie(movie);
         connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
     }
     endInsertRows();
 }
 
+void MovieModel::updateFacetIndex(const QVector<Movie*>& movies)
+{
+    for (Movie* movie : movies) {
+        if (m_facetIndex.contains(movie->movieId())) {
+            m_facetIndex.addMovie(movie);
+        }
+    }
+}
+
 /**
  * \brief Called when a movies data has changed
- * Emits dataChanged
+ * Updates the facet index and emits dataChanged
  * \param movie Movie which has changed
  */
 void MovieModel::onMovieChanged(Movie* movie)
 {
+    m_facetIndex.addMovie(movie);
     const QModelIndex index = createIndex(m_movies.indexOf(movie), 0);
     emit dataChanged(index, index);
 }
@@ -168,7 +180,7 @@ QVariant MovieModel::data(const QModelIndex& index, int role) const
 
         switch (MovieModel::columnToMediaStatus(index.column())) {
         case MediaStatusColumn::Actors:
-            color = (!movie->actors().hasActors()) ? MediaStatusState::RED : MediaStatusState::GREEN;
+            color = (!movie->hasActors()) ? MediaStatusState::RED : MediaStatusState::GREEN;
             icon = "edit-image-face-show";
             break;
         case MediaStatusColumn::Trailer:
@@ -275,6 +287,7 @@ void MovieModel::clear()
         movie->deleteLater();
     }
     m_movies.clear();
+    m_facetIndex.clear();
     endRemoveRows();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "movies/Movie.h"
+#include "movies/MovieFacetIndex.h"
 
 #include <QAbstractItemModel>
 #include <QIcon>
@@ -58,9 +59,15 @@ public:
     Movie* movie(int row);
     void addMovie(Movie* movie);
     void addMovies(const QVector<Movie*>& movies);
+    /// \brief Updates the facet index for movies of this model whose details were loaded
+    ///        while their signals were blocked, see MovieController::loadData().
+    ///        Views are not notified.  Movies that are not part of the model are ignored.
+    void updateFacetIndex(const QVector<Movie*>& movies);
     void update();
     void clear();
     int countNewMovies();
+    /// \brief Index of genres, studios, etc. of all movies. Updated when movies change.
+    const mediaelch::MovieFacetIndex& facetIndex() const { return m_facetIndex; }
 
     static int mediaStatusToColumn(MediaStatusColumn column);
     static QString mediaStatusToText(MediaStatusColumn column);
@@ -71,6 +78,7 @@ private slots:
 
 private:
     QVector<Movie*> m_movies;
+    mediaelch::MovieFacetIndex m_facetIndex;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
@@ -6,6 +6,29 @@
 #include "globals/Globals.h"
 #include "globals/Manager.h"
 
+#include <algorithm>
+
+namespace {
+
+using mediaelch::MovieFacet;
+
+/// Checks whether the filter can be answered by the facet index, i.e. if it filters by a facet's value.
+bool isFacetFilter(const Filter* filter, MovieFacet& facet)
+{
+    if (!filter->hasInfo()) {
+        return false;
+    }
+    for (int i = static_cast<int>(MovieFacet::First); i <= static_cast<int>(MovieFacet::Last); ++i) {
+        if (filter->isInfo(mediaelch::MovieFacetIndex::filterInfo(static_cast<MovieFacet>(i)))) {
+            facet = static_cast<MovieFacet>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
 MovieProxyModel::MovieProxyModel(QObject* parent) :
     QSortFilterProxyModel(parent), m_sortBy{SortBy::New}, m_filterDuplicates{false}
 {
@@ -25,6 +48,12 @@ bool MovieProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceP
     }
 
     Movie* movie = movies.at(sourceRow);
+    if (!m_facetFilters.isEmpty()) {
+        updateFacetMatches();
+        if (!m_facetMatches.contains(movie->movieId())) {
+            return false;
+        }
+    }
     for (Filter* filter : m_filters) {
         if (!filter->accepts(movie)) {
             return false;
@@ -97,11 +126,45 @@ void MovieProxyModel::setFilterDuplicates(bool filterDuplicates)
 
 void MovieProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
-    m_filters = std::move(filters);
+    m_filters.clear();
+    m_facetFilters.clear();
+    for (Filter* filter : filters) {
+        mediaelch::MovieFacet facet = mediaelch::MovieFacet::First;
+        if (isFacetFilter(filter, facet)) {
+            m_facetFilters.append(qMakePair(facet, filter));
+        } else {
+            m_filters.append(filter);
+        }
+    }
+    m_facetMatchesValid = false;
     m_filterText = std::move(text);
     invalidate();
 }
 
+void MovieProxyModel::updateFacetMatches() const
+{
+    const mediaelch::MovieFacetIndex& index = Manager::instance()->movieModel()->facetIndex();
+    if (m_facetMatchesValid && m_facetMatchesRevision == index.revision()) {
+        return;
+    }
+
+    QVector<QSet<int>> postings;
+    for (const auto& facetFilter : m_facetFilters) {
+        postings.append(index.movies(facetFilter.first, facetFilter.second->shortText()));
+    }
+    // Start with the smallest posting list so that each intersection is as cheap as possible.
+    std::sort(postings.begin(), postings.end(), [](const QSet<int>& a, const QSet<int>& b) {
+        return a.size() < b.size();
+    });
+
+    m_facetMatches = postings.isEmpty() ? QSet<int>{} : postings.first();
+    for (int i = 1; i < postings.size() && !m_facetMatches.isEmpty(); ++i) {
+        m_facetMatches.intersect(postings.at(i));
+    }
+    m_facetMatchesRevision = index.revision();
+    m_facetMatchesValid = true;
+}
+
 void MovieProxyModel::setSortBy(SortBy sortBy)
 {
     m_sortBy = sortBy;
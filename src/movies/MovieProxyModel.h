@@ -1,7 +1,10 @@
 #pragma once
 
 #include "globals/Filter.h"
+#include "movies/MovieFacetIndex.h"
 
+#include <QPair>
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 class MovieProxyModel : public QSortFilterProxyModel
@@ -20,8 +23,18 @@ protected:
     /// \brief Sort function for the movie model. Sorts movies by name and new files to top per default.
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
+private:
+    /// \brief Intersects the movies of all facet filters if the facet index has changed.
+    void updateFacetMatches() const;
+
 private:
     QVector<Filter*> m_filters;
+    /// Filters by genre, studio, etc. that are answered by the movie model's facet index.
+    QVector<QPair<mediaelch::MovieFacet, Filter*>> m_facetFilters;
+    /// Movie IDs that match all facet filters.
+    mutable QSet<int> m_facetMatches;
+    mutable quint64 m_facetMatchesRevision = 0;
+    mutable bool m_facetMatchesValid = false;
     QString m_filterText;
     SortBy m_sortBy;
     bool m_filterDuplicates;
@@ -0,0 +1,230 @@
+#include "movies/MovieScrapeScheduler.h"
+
+#include "globals/Meta.h"
+#include "log/Log.h"
+#include "movies/Movie.h"
+#include "movies/MovieController.h"
+#include "scrapers/movie/MovieScraper.h"
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "settings/Settings.h"
+
+namespace mediaelch {
+
+using scraper::CustomMovieScraper;
+using scraper::ImdbMovie;
+using scraper::MovieIdentifier;
+using scraper::MovieScraper;
+using scraper::MovieSearchJob;
+using scraper::TmdbMovie;
+
+MovieScrapeScheduler::MovieScrapeScheduler(MovieScraper* scraper, QObject* parent) : QObject(parent), m_scraper{scraper}
+{
+}
+
+MovieScrapeScheduler::~MovieScrapeScheduler()
+{
+    abort();
+}
+
+void MovieScrapeScheduler::add(Movie* movie)
+{
+    m_queue.enqueue(QPointer<Movie>(movie));
+    ++m_total;
+    startNextItems();
+}
+
+void MovieScrapeScheduler::start()
+{
+    if (m_scraper.isNull()) {
+        qCWarning(generic) << "[MovieScrapeScheduler] No scraper set, nothing is scraped";
+        m_queue.clear();
+    }
+    qCInfo(generic) << "[MovieScrapeScheduler] Scraping" << m_total << "movies with up to" << m_maxConcurrentItems
+                    << "at the same time";
+    m_running = true;
+    startNextItems();
+    // Nothing to do or only deleted movies.
+    if (m_running && m_active.isEmpty() && m_queue.isEmpty()) {
+        m_running = false;
+        emit finished();
+    }
+}
+
+void MovieScrapeScheduler::abort()
+{
+    m_running = false;
+    m_queue.clear();
+    const QList<Movie*> movies = m_active.keys();
+    for (Movie* movie : movies) {
+        disconnect(movie, nullptr, this, nullptr);
+        disconnect(movie->controller(), nullptr, this, nullptr);
+        movie->controller()->abortDownloads();
+    }
+    m_active.clear();
+}
+
+void MovieScrapeScheduler::startNextItems()
+{
+    while (m_running && !m_queue.isEmpty() && m_active.size() < m_maxConcurrentItems) {
+        const QPointer<Movie> movie = m_queue.dequeue();
+        if (!movie.isNull()) {
+            startMovie(movie.data());
+        } else {
+            // Deleted in the meantime.
+            completeItem();
+        }
+    }
+}
+
+void MovieScrapeScheduler::startMovie(Movie* movie)
+{
+    if (m_onlyWithId && !hasUsableId(movie)) {
+        emit movieSkipped(movie, tr("No ID"));
+        completeItem();
+        return;
+    }
+
+    m_active.insert(movie, {});
+    connect(movie, &QObject::destroyed, this, [this, movie]() {
+        if (m_active.remove(movie) > 0) {
+            completeItem();
+        }
+    });
+    connect(movie->controller(), &MovieController::sigLoadDone, this, &MovieScrapeScheduler::onLoadDone);
+    emit movieStarted(movie);
+
+    const QString& scraperId = m_scraper->meta().identifier;
+    if (scraperId == ImdbMovie::ID && movie->imdbId().isValid()) {
+        loadMovie(movie, MovieIdentifier(movie->imdbId()));
+    } else if (scraperId == TmdbMovie::ID && movie->tmdbId().isValid()) {
+        loadMovie(movie, MovieIdentifier(movie->tmdbId()));
+    } else if (scraperId == TmdbMovie::ID && movie->imdbId().isValid()) {
+        loadMovie(movie, MovieIdentifier(movie->imdbId()));
+    } else if (scraperId == CustomMovieScraper::ID) {
+        searchMovie(movie, CustomMovieScraper::instance()->titleScraper());
+    } else {
+        searchMovie(movie, m_scraper);
+    }
+}
+
+bool MovieScrapeScheduler::hasUsableId(Movie* movie) const
+{
+    const QString& scraperId = m_scraper->meta().identifier;
+    if (scraperId == ImdbMovie::ID) {
+        return movie->imdbId().isValid();
+    }
+    if (scraperId == TmdbMovie::ID || scraperId == CustomMovieScraper::ID) {
+        return movie->imdbId().isValid() || movie->tmdbId().isValid();
+    }
+    // Other scrapers only search by name.
+    return true;
+}
+
+void MovieScrapeScheduler::searchMovie(Movie* movie, MovieScraper* searchScraper)
+{
+    MovieSearchJob::Config config;
+    config.includeAdult = Settings::instance()->showAdultScrapers();
+    config.locale = searchScraper->meta().defaultLocale;
+    config.query = movie->name().replace(".", " ");
+
+    // The custom movie scraper's scrapers may find the movie by the IDs of other scrapers.
+    const QString& scraperId = searchScraper->meta().identifier;
+    if ((scraperId == ImdbMovie::ID || scraperId == TmdbMovie::ID) && movie->imdbId().isValid()) {
+        config.query = movie->imdbId().toString();
+    } else if (scraperId == TmdbMovie::ID && movie->tmdbId().isValid()) {
+        config.query = movie->tmdbId().withPrefix();
+    }
+
+    auto* searchJob = searchScraper->search(config);
+    connect(searchJob, &MovieSearchJob::sigFinished, this, [this, movie, searchScraper](MovieSearchJob* job) {
+        onSearchFinished(movie, searchScraper, job);
+    });
+    searchJob->execute();
+}
+
+void MovieScrapeScheduler::onSearchFinished(Movie* movie, MovieScraper* searchScraper, MovieSearchJob* searchJob)
+{
+    auto dls = makeDeleteLaterScope(searchJob);
+
+    if (!m_active.contains(movie)) {
+        return;
+    }
+    if (searchJob->hasError()) {
+        skipMovie(movie, searchJob->error().message);
+        return;
+    }
+    if (searchJob->results().isEmpty()) {
+        skipMovie(movie, tr("No search results"));
+        return;
+    }
+
+    QHash<MovieScraper*, MovieIdentifier>& ids = m_active[movie];
+    if (m_scraper->meta().identifier == CustomMovieScraper::ID) {
+        ids.insert(searchScraper, searchJob->results().first().identifier);
+        const QVector<MovieScraper*> searchScrapers =
+            CustomMovieScraper::instance()->scrapersNeedSearch(m_infos, ids);
+        if (!searchScrapers.isEmpty()) {
+            searchMovie(movie, searchScrapers.first());
+            return;
+        }
+    } else {
+        ids.insert(m_scraper, searchJob->results().first().identifier);
+    }
+    movie->controller()->loadData(ids, m_scraper, m_infos);
+}
+
+void MovieScrapeScheduler::loadMovie(Movie* movie, MovieIdentifier id)
+{
+    QHash<MovieScraper*, MovieIdentifier> ids;
+    ids.insert(nullptr, id);
+    movie->controller()->loadData(ids, m_scraper, m_infos);
+}
+
+void MovieScrapeScheduler::onLoadDone(Movie* movie)
+{
+    if (!m_active.contains(movie)) {
+        return;
+    }
+    const ScraperError& error = movie->controller()->loadError();
+    if (error.hasError()) {
+        qCWarning(generic) << "[MovieScrapeScheduler] Loading movie" << movie->name() << "failed:" << error.message;
+        emit movieFailed(movie, error.message);
+    } else {
+        emit movieFinished(movie);
+    }
+    completeMovie(movie);
+}
+
+void MovieScrapeScheduler::skipMovie(Movie* movie, const QString& reason)
+{
+    qCInfo(generic) << "[MovieScrapeScheduler] Skipping movie" << movie->name() << "-" << reason;
+    emit movieSkipped(movie, reason);
+    completeMovie(movie);
+}
+
+void MovieScrapeScheduler::completeMovie(Movie* movie)
+{
+    disconnect(movie, nullptr, this, nullptr);
+    disconnect(movie->controller(), nullptr, this, nullptr);
+    m_active.remove(movie);
+    completeItem();
+}
+
+void MovieScrapeScheduler::completeItem()
+{
+    if (!m_running) {
+        return;
+    }
+    ++m_done;
+    emit progress(m_done, m_total);
+    startNextItems();
+    if (m_running && m_active.isEmpty() && m_queue.isEmpty()) {
+        m_running = false;
+        qCInfo(generic) << "[MovieScrapeScheduler] Scraped" << m_done << "movies";
+        emit finished();
+    }
+}
+
+} // namespace mediaelch
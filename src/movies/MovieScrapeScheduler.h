@@ -0,0 +1,108 @@
+#pragma once
+
+#include "globals/ScraperInfos.h"
+#include "scrapers/movie/MovieIdentifier.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QSet>
+
+class Movie;
+
+namespace mediaelch {
+
+namespace scraper {
+class MovieScraper;
+class MovieSearchJob;
+} // namespace scraper
+
+/// \brief Scrapes many movies without user interaction, with several movies in flight.
+///
+/// Movies with an IMDb or TMDb ID are loaded directly if the scraper supports the ID.
+/// All others are searched for by their name and the first result is used. For the
+/// custom movie scraper, each scraper that needs an ID of its own is searched for.
+///
+/// Loading a movie includes downloading its images. Up to maxConcurrentItems() movies
+/// are scraped at the same time, so that the requests and downloads of several movies
+/// overlap instead of waiting for each other's round trips.
+///
+/// \par Example
+/// \code{cpp}
+///   auto* scheduler = new MovieScrapeScheduler(scraper, this);
+///   scheduler->setInfos(infos);
+///   for (Movie* movie : movies) {
+///       scheduler->add(movie);
+///   }
+///   connect(scheduler, &MovieScrapeScheduler::movieFinished, this, &MyClass::saveMovie);
+///   connect(scheduler, &MovieScrapeScheduler::movieFailed, this, &MyClass::reportError);
+///   connect(scheduler, &MovieScrapeScheduler::finished, scheduler, &QObject::deleteLater);
+///   scheduler->start();
+/// \endcode
+class MovieScrapeScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MovieScrapeScheduler(scraper::MovieScraper* scraper, QObject* parent = nullptr);
+    ~MovieScrapeScheduler() override;
+
+    void setInfos(QSet<MovieScraperInfo> infos) { m_infos = std::move(infos); }
+    /// \brief Skip movies that have no ID usable by the scraper instead of searching for them.
+    void setOnlyWithId(bool onlyWithId) { m_onlyWithId = onlyWithId; }
+    /// \brief Maximum number of movies that are scraped at the same time.
+    void setMaxConcurrentItems(int count) { m_maxConcurrentItems = qMax(1, count); }
+    int maxConcurrentItems() const { return m_maxConcurrentItems; }
+
+    void add(Movie* movie);
+    /// \brief Starts scraping the added movies. Movies may still be added afterwards.
+    void start();
+    /// \brief Aborts all running movies and clears the queue. finished() is not emitted.
+    void abort();
+
+    int count() const { return m_total; }
+    bool isRunning() const { return m_running; }
+
+signals:
+    void movieStarted(Movie* movie);
+    /// \brief The movie was scraped, including its images.
+    void movieFinished(Movie* movie);
+    /// \brief The movie was not scraped, e.g. because nothing was found.
+    void movieSkipped(Movie* movie, QString reason);
+    /// \brief Loading the movie failed, e.g. because of a network error.  Some of its
+    ///        details may have been cleared already, so it must not be saved.
+    void movieFailed(Movie* movie, QString error);
+    /// \brief Number of movies that are scraped, skipped or failed.
+    void progress(int done, int total);
+    void finished();
+
+private slots:
+    void onLoadDone(Movie* movie);
+
+private:
+    void startNextItems();
+    void startMovie(Movie* movie);
+    void searchMovie(Movie* movie, scraper::MovieScraper* searchScraper);
+    void onSearchFinished(Movie* movie, scraper::MovieScraper* searchScraper, scraper::MovieSearchJob* searchJob);
+    void loadMovie(Movie* movie, scraper::MovieIdentifier id);
+    bool hasUsableId(Movie* movie) const;
+    void skipMovie(Movie* movie, const QString& reason);
+    void completeMovie(Movie* movie);
+    void completeItem();
+
+private:
+    QPointer<scraper::MovieScraper> m_scraper;
+    QSet<MovieScraperInfo> m_infos;
+    bool m_onlyWithId = false;
+    int m_maxConcurrentItems = 4;
+
+    QQueue<QPointer<Movie>> m_queue;
+    /// Running movies and the IDs found so far, per scraper.
+    QHash<Movie*, QHash<scraper::MovieScraper*, scraper::MovieIdentifier>> m_active;
+    bool m_running = false;
+    int m_total = 0;
+    int m_done = 0;
+};
+
+} // namespace mediaelch
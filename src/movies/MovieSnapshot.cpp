@@ -0,0 +1,463 @@
+#include "movies/MovieSnapshot.h"
+
+#include "data/Subtitle.h"
+#include "log/Log.h"
+#include "movies/Movie.h"
+#include "settings/Settings.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <limits>
+
+namespace {
+
+// "MESN" - MediaElch SNapshot
+constexpr quint32 SNAPSHOT_MAGIC = 0x4D45534E;
+// Increase this version whenever the layout of a movie in the snapshot changes.
+// Older snapshots are discarded and rebuilt from the database.
+constexpr quint32 SNAPSHOT_VERSION = 3;
+
+template<typename Enum>
+void writeEnumMap(QDataStream& out, const QMap<Enum, QString>& map)
+{
+    out << static_cast<qint32>(map.size());
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        out << static_cast<qint32>(it.key()) << it.value();
+    }
+}
+
+template<typename Enum>
+QMap<Enum, QString> readEnumMap(QDataStream& in)
+{
+    QMap<Enum, QString> map;
+    qint32 size = 0;
+    in >> size;
+    for (qint32 i = 0; i < size && in.status() == QDataStream::Ok; ++i) {
+        qint32 key = 0;
+        QString value;
+        in >> key >> value;
+        map.insert(static_cast<Enum>(key), value);
+    }
+    return map;
+}
+
+void writePosters(QDataStream& out, const QVector<Poster>& posters)
+{
+    out << static_cast<qint32>(posters.size());
+    for (const Poster& poster : posters) {
+        out << poster.originalUrl << poster.thumbUrl << poster.aspect;
+    }
+}
+
+QVector<Poster> readPosters(QDataStream& in)
+{
+    QVector<Poster> posters;
+    qint32 size = 0;
+    in >> size;
+    for (qint32 i = 0; i < size && in.status() == QDataStream::Ok; ++i) {
+        Poster poster;
+        in >> poster.originalUrl >> poster.thumbUrl >> poster.aspect;
+        posters.push_back(poster);
+    }
+    return posters;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+MovieSnapshot::MovieSnapshot(DirectoryPath movieDirectory) : m_movieDirectory{std::move(movieDirectory)}
+{
+}
+
+DirectoryPath MovieSnapshot::snapshotDir()
+{
+    return Settings::instance()->databaseDir().subDir("snapshots");
+}
+
+QString MovieSnapshot::snapshotFilePath() const
+{
+    return snapshotFilePath(snapshotDir(), m_movieDirectory);
+}
+
+QString MovieSnapshot::snapshotFilePath(const DirectoryPath& snapshotDir, const DirectoryPath& movieDirectory)
+{
+    const QByteArray hash =
+        QCryptographicHash::hash(movieDirectory.toString().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return snapshotDir.filePath(QStringLiteral("movies-%1.snapshot").arg(QString::fromLatin1(hash.left(16))));
+}
+
+QByteArray MovieSnapshot::fingerprint(const DirectoryPath& dir)
+{
+    // Only direct entries are considered: Adding or removing a movie changes the modification
+    // time of its parent folder, which is either the movie directory itself or one of its
+    // direct sub-folders (if movies are stored in separate folders).
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const QFileInfoList entries = dir.dir().entryInfoList(
+        QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden, QDir::Name | QDir::DirsFirst);
+    hash.addData(QByteArray::number(entries.size()));
+    for (const QFileInfo& entry : entries) {
+        hash.addData(entry.fileName().toUtf8());
+        hash.addData(QByteArray::number(entry.lastModified().toMSecsSinceEpoch()));
+    }
+    return hash.result();
+}
+
+QVector<Movie*> MovieSnapshot::load(QObject* parent)
+{
+    m_fingerprint.clear();
+
+    QFile file(snapshotFilePath());
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    // QByteArray can't hold more than INT_MAX bytes; such a snapshot is unusable.
+    if (file.size() > std::numeric_limits<int>::max()) {
+        qCWarning(generic) << "[MovieSnapshot] Snapshot is too large, falling back to database:" << file.fileName();
+        file.close();
+        remove();
+        return {};
+    }
+
+    // Map the file into memory; falls back to reading it if mapping is not supported.
+    QByteArray content;
+    uchar* mapped = file.map(0, file.size());
+    if (mapped != nullptr) {
+        content = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<int>(file.size()));
+    } else {
+        content = file.readAll();
+    }
+
+    QDataStream in(content);
+    in.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString directory;
+    QByteArray fingerprint;
+    qint32 count = 0;
+    in >> magic >> version;
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) {
+        qCInfo(generic) << "[MovieSnapshot] Discarding snapshot with unknown version:" << file.fileName();
+        if (mapped != nullptr) {
+            file.unmap(mapped);
+        }
+        file.close();
+        remove();
+        return {};
+    }
+
+    in >> directory >> fingerprint >> count;
+    if (directory != m_movieDirectory.toString()) {
+        // Hash collision of the file name; extremely unlikely but not impossible.
+        if (mapped != nullptr) {
+            file.unmap(mapped);
+        }
+        return {};
+    }
+
+    QVector<Movie*> movies;
+    movies.reserve(count);
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        movies.push_back(readMovie(in, parent));
+    }
+
+    if (mapped != nullptr) {
+        file.unmap(mapped);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(generic) << "[MovieSnapshot] Snapshot is corrupt, falling back to database:" << file.fileName();
+        qDeleteAll(movies);
+        file.close();
+        remove();
+        return {};
+    }
+
+    m_fingerprint = fingerprint;
+    qCDebug(generic) << "[MovieSnapshot] Loaded" << movies.size() << "movies from snapshot for"
+                     << m_movieDirectory.toNativePathString();
+    return movies;
+}
+
+bool MovieSnapshot::save(const QVector<Movie*>& movies)
+{
+    QDir().mkpath(snapshotDir().toString());
+
+    QSaveFile file(snapshotFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(generic) << "[MovieSnapshot] Could not write snapshot:" << file.fileName();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << SNAPSHOT_MAGIC << SNAPSHOT_VERSION;
+    out << m_movieDirectory.toString() << fingerprint(m_movieDirectory) << static_cast<qint32>(movies.size());
+    for (Movie* movie : movies) {
+        writeMovie(out, *movie);
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(generic) << "[MovieSnapshot] Writing snapshot failed:" << file.fileName();
+        return false;
+    }
+    return true;
+}
+
+void MovieSnapshot::remove()
+{
+    QFile::remove(snapshotFilePath());
+    m_fingerprint.clear();
+}
+
+void MovieSnapshot::removeAll()
+{
+    QDir dir(snapshotDir().toString());
+    const QStringList snapshots = dir.entryList({"movies-*.snapshot"}, QDir::Files);
+    for (const QString& snapshot : snapshots) {
+        dir.remove(snapshot);
+    }
+}
+
+void MovieSnapshot::writeMovie(QDataStream& out, Movie& movie)
+{
+    // Database / file state
+    out << static_cast<qint32>(movie.databaseId()) << movie.files().toStringList() << movie.inSeparateFolder()
+        << movie.fileLastModified() << static_cast<qint32>(movie.discType()) << static_cast<qint32>(movie.label())
+        << movie.controller()->infoLoaded() << movie.controller()->isHydrated() << movie.compressedNfoContent();
+
+    // Details
+    out << movie.name() << movie.sortTitle() << movie.originalName() << movie.overview() << movie.tagline()
+        << movie.outline() << movie.userRating() << static_cast<qint32>(movie.top250()) << movie.released()
+        << static_cast<qint32>(movie.runtime().count()) << movie.certification().toString() << movie.writer()
+        << movie.director() << movie.genres() << movie.countries() << movie.studios() << movie.tags()
+        << movie.trailer() << static_cast<qint32>(movie.playcount()) << movie.lastPlayed()
+        << movie.imdbId().toString() << movie.tmdbId().toString() << movie.dateAdded()
+        << movie.resumeTime().position << movie.resumeTime().total;
+
+    const MovieSet set = movie.set();
+    out << set.tmdbId.toString() << set.name << set.overview;
+
+    out << static_cast<qint32>(movie.ratings().size());
+    for (const Rating& rating : movie.ratings()) {
+        out << rating.source << rating.rating << static_cast<qint32>(rating.voteCount) << rating.minRating
+            << rating.maxRating;
+    }
+
+    out << movie.hasActors() << static_cast<qint32>(movie.actors().size());
+    for (const Actor* actor : movie.actors()) {
+        out << actor->name << actor->role << actor->thumb << actor->id << static_cast<qint32>(actor->order);
+    }
+
+    // Images
+    writePosters(out, movie.images().posters());
+    writePosters(out, movie.images().backdrops());
+    for (const ImageType imageType : Movie::imageTypes()) {
+        out << movie.hasImage(imageType);
+    }
+    out << movie.images().hasExtraFanarts();
+
+    // Stream details
+    StreamDetails* streamDetails = movie.streamDetails();
+    out << movie.streamDetailsLoaded();
+    writeEnumMap(out, streamDetails->videoDetails());
+    const auto audioDetails = streamDetails->audioDetails();
+    out << static_cast<qint32>(audioDetails.size());
+    for (const auto& audio : audioDetails) {
+        writeEnumMap(out, audio);
+    }
+    const auto subtitleDetails = streamDetails->subtitleDetails();
+    out << static_cast<qint32>(subtitleDetails.size());
+    for (const auto& subtitle : subtitleDetails) {
+        writeEnumMap(out, subtitle);
+    }
+
+    // External subtitles
+    const QVector<Subtitle*> subtitles = movie.subtitles();
+    out << static_cast<qint32>(subtitles.size());
+    for (const Subtitle* subtitle : subtitles) {
+        out << subtitle->files() << subtitle->language() << subtitle->forced();
+    }
+}
+
+Movie* MovieSnapshot::readMovie(QDataStream& in, QObject* parent)
+{
+    qint32 databaseId = -1;
+    QStringList files;
+    bool inSeparateFolder = false;
+    QDateTime fileLastModified;
+    qint32 discType = 0;
+    qint32 label = 0;
+    bool infoLoaded = false;
+    bool hydrated = true;
+    QByteArray nfoContent;
+    in >> databaseId >> files >> inSeparateFolder >> fileLastModified >> discType >> label >> infoLoaded >> hydrated
+        >> nfoContent;
+
+    auto* movie = new Movie(files, parent);
+    movie->blockSignals(true);
+    movie->setDatabaseId(databaseId);
+    movie->setInSeparateFolder(inSeparateFolder);
+    movie->setFileLastModified(fileLastModified);
+    movie->setDiscType(static_cast<DiscType>(discType));
+    movie->setLabel(static_cast<ColorLabel>(label));
+    movie->setCompressedNfoContent(nfoContent);
+
+    QString name;
+    QString sortTitle;
+    QString originalName;
+    QString overview;
+    QString tagline;
+    QString outline;
+    double userRating = 0.0;
+    qint32 top250 = 0;
+    QDate released;
+    qint32 runtime = 0;
+    QString certification;
+    QString writer;
+    QString director;
+    QStringList genres;
+    QStringList countries;
+    QStringList studios;
+    QStringList tags;
+    QUrl trailer;
+    qint32 playcount = 0;
+    QDateTime lastPlayed;
+    QString imdbId;
+    QString tmdbId;
+    QDateTime dateAdded;
+    mediaelch::ResumeTime resumeTime;
+    in >> name >> sortTitle >> originalName >> overview >> tagline >> outline >> userRating >> top250 >> released
+        >> runtime >> certification >> writer >> director >> genres >> countries >> studios >> tags >> trailer
+        >> playcount >> lastPlayed >> imdbId >> tmdbId >> dateAdded >> resumeTime.position >> resumeTime.total;
+
+    movie->setName(name);
+    movie->setSortTitle(sortTitle);
+    movie->setOriginalName(originalName);
+    movie->setOverview(overview);
+    movie->setTagline(tagline);
+    movie->setOutline(outline);
+    movie->setUserRating(userRating);
+    movie->setTop250(top250);
+    movie->setReleased(released);
+    movie->setRuntime(std::chrono::minutes(runtime));
+    movie->setCertification(Certification(certification));
+    movie->setWriter(writer);
+    movie->setDirector(director);
+    for (const QString& genre : asConst(genres)) {
+        movie->addGenre(genre);
+    }
+    for (const QString& country : asConst(countries)) {
+        movie->addCountry(country);
+    }
+    for (const QString& studio : asConst(studios)) {
+        movie->addStudio(studio);
+    }
+    for (const QString& tag : asConst(tags)) {
+        movie->addTag(tag);
+    }
+    movie->setTrailer(trailer);
+    movie->setPlayCount(playcount);
+    movie->setLastPlayed(lastPlayed);
+    movie->setImdbId(ImdbId(imdbId));
+    movie->setTmdbId(TmdbId(tmdbId));
+    movie->setDateAdded(dateAdded);
+    movie->setResumeTime(resumeTime);
+
+    MovieSet set;
+    QString setTmdbId;
+    in >> setTmdbId >> set.name >> set.overview;
+    set.tmdbId = TmdbId(setTmdbId);
+    movie->setSet(set);
+
+    qint32 ratingCount = 0;
+    in >> ratingCount;
+    for (qint32 i = 0; i < ratingCount && in.status() == QDataStream::Ok; ++i) {
+        Rating rating;
+        qint32 voteCount = 0;
+        in >> rating.source >> rating.rating >> voteCount >> rating.minRating >> rating.maxRating;
+        rating.voteCount = voteCount;
+        movie->ratings().addRating(rating);
+    }
+
+    bool hasActors = false;
+    qint32 actorCount = 0;
+    in >> hasActors >> actorCount;
+    movie->setHasUnloadedActors(hasActors && actorCount == 0);
+    for (qint32 i = 0; i < actorCount && in.status() == QDataStream::Ok; ++i) {
+        Actor actor;
+        qint32 order = 0;
+        in >> actor.name >> actor.role >> actor.thumb >> actor.id >> order;
+        actor.order = order;
+        movie->addActor(actor);
+    }
+
+    for (const Poster& poster : readPosters(in)) {
+        movie->images().addPoster(poster);
+    }
+    for (const Poster& backdrop : readPosters(in)) {
+        movie->images().addBackdrop(backdrop);
+    }
+    for (const ImageType imageType : Movie::imageTypes()) {
+        bool hasImage = false;
+        in >> hasImage;
+        movie->images().setHasImage(imageType, hasImage);
+    }
+    bool hasExtraFanarts = false;
+    in >> hasExtraFanarts;
+    movie->images().setHasExtraFanarts(hasExtraFanarts);
+
+    bool streamDetailsLoaded = false;
+    in >> streamDetailsLoaded;
+    StreamDetails* streamDetails = movie->streamDetails();
+    const auto videoDetails = readEnumMap<StreamDetails::VideoDetails>(in);
+    for (auto it = videoDetails.cbegin(); it != videoDetails.cend(); ++it) {
+        streamDetails->setVideoDetail(it.key(), it.value());
+    }
+    qint32 audioCount = 0;
+    in >> audioCount;
+    for (qint32 i = 0; i < audioCount && in.status() == QDataStream::Ok; ++i) {
+        const auto audioDetails = readEnumMap<StreamDetails::AudioDetails>(in);
+        for (auto it = audioDetails.cbegin(); it != audioDetails.cend(); ++it) {
+            streamDetails->setAudioDetail(i, it.key(), it.value());
+        }
+    }
+    qint32 subtitleDetailCount = 0;
+    in >> subtitleDetailCount;
+    for (qint32 i = 0; i < subtitleDetailCount && in.status() == QDataStream::Ok; ++i) {
+        const auto subtitleDetails = readEnumMap<StreamDetails::SubtitleDetails>(in);
+        for (auto it = subtitleDetails.cbegin(); it != subtitleDetails.cend(); ++it) {
+            streamDetails->setSubtitleDetail(i, it.key(), it.value());
+        }
+    }
+    movie->setStreamDetailsLoaded(streamDetailsLoaded);
+
+    qint32 subtitleCount = 0;
+    in >> subtitleCount;
+    for (qint32 i = 0; i < subtitleCount && in.status() == QDataStream::Ok; ++i) {
+        QStringList subtitleFiles;
+        QString language;
+        bool forced = false;
+        in >> subtitleFiles >> language >> forced;
+        auto* subtitle = new Subtitle(movie);
+        subtitle->setFiles(subtitleFiles, false);
+        subtitle->setLanguage(language);
+        subtitle->setForced(forced);
+        subtitle->setChanged(false);
+        movie->addSubtitle(subtitle, true);
+    }
+
+    movie->controller()->setInfoLoaded(infoLoaded);
+    movie->controller()->setHydrated(hydrated);
+    movie->setChanged(false);
+    movie->blockSignals(false);
+    return movie;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "file/Path.h"
+#include "globals/Meta.h"
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class Movie;
+class QDataStream;
+
+namespace mediaelch {
+
+/// \brief Binary snapshot of the loaded movies of a single movie directory.
+///
+/// Loading movies from the database requires many queries and re-parsing
+/// the NFO content of movies that are not "light", which is slow for large
+/// libraries.  A snapshot stores already loaded movies, light or hydrated,
+/// in a versioned QDataStream format that is memory-mapped on startup.
+/// Snapshots are written after a directory was loaded from the database and
+/// are removed as soon as the database content of that directory changes.
+/// The directory's fingerprint is stored as well so that callers can check
+/// in the background whether the snapshot is still up-to-date.
+///
+/// \par Example
+/// \code{cpp}
+///   MovieSnapshot snapshot(mediaelch::DirectoryPath(movieDir.path));
+///   QVector<Movie*> movies = snapshot.load(this);
+///   if (movies.isEmpty()) {
+///       movies = loadFromDatabase();
+///       snapshot.save(movies);
+///   }
+/// \endcode
+class MovieSnapshot
+{
+public:
+    explicit MovieSnapshot(DirectoryPath movieDirectory);
+
+    /// \brief Loads all movies of the snapshot. Returns an empty list if there
+    ///        is no snapshot or if it was written by an incompatible version.
+    /// \param parent Parent of the created movies.
+    ELCH_NODISCARD QVector<Movie*> load(QObject* parent);
+    /// \brief Writes the given movies atomically into the snapshot file.
+    bool save(const QVector<Movie*>& movies);
+    /// \brief Removes the snapshot file. Next load() will return no movies.
+    void remove();
+
+    /// \brief Fingerprint that was stored with the last loaded snapshot.
+    ELCH_NODISCARD const QByteArray& storedFingerprint() const { return m_fingerprint; }
+    ELCH_NODISCARD QString snapshotFilePath() const;
+
+    /// \brief Directory that contains all snapshots. Reads the settings, so only
+    ///        call it on the main thread.
+    ELCH_NODISCARD static DirectoryPath snapshotDir();
+    /// \brief Path of the snapshot of the given movie directory inside snapshotDir.
+    ///        Doesn't access the settings and can be used in database jobs.
+    ELCH_NODISCARD static QString snapshotFilePath(const DirectoryPath& snapshotDir,
+        const DirectoryPath& movieDirectory);
+
+    /// \brief Calculates a fingerprint of the directory's direct entries and
+    ///        their modification times.  May be slow on network shares.
+    ELCH_NODISCARD static QByteArray fingerprint(const DirectoryPath& dir);
+
+    /// \brief Removes the snapshots of all movie directories.
+    static void removeAll();
+
+private:
+    static void writeMovie(QDataStream& out, Movie& movie);
+    static Movie* readMovie(QDataStream& in, QObject* parent);
+
+private:
+    DirectoryPath m_movieDirectory;
+    QByteArray m_fingerprint;
+};
+
+} // namespace mediaelch
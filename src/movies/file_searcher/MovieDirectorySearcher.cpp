@@ -1,8 +1,10 @@
 #include "MovieDirectorySearcher.h"
 
+#include "file/DirectoryScanner.h"
 #include "file/FilenameUtils.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
+#include "log/Perf.h"
 
 #include "file/FilenameUtils.h"
 
@@ -49,112 +51,84 @@ void MovieDirectorySearcher::abort()
 
 void MovieDirectorySearcher::loadMovieContents()
 {
-    QDirIterator it(m_dir.path.path(),
-        Settings::instance()->advanced()->movieFilters().filters(),
-        QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
-        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+    perf::ScopedTimer timer("movies.directoryWalk");
 
-    QString lastDir;
+    DirectoryScanner::Options options;
+    options.nameFilters = Settings::instance()->advanced()->movieFilters().filters();
+    options.fileDetails = true;
+    DirectoryScanner scanner(options);
 
-    while (it.hasNext()) {
+    const ScanExcludes excludes = Settings::instance()->advanced()->movieScanExcludes();
+
+    // Called for one directory after another, see DirectoryScanner.
+    scanner.scan({m_dir.path.path()}, [&](const DirectoryScanner::Directory& directory) {
         if (m_aborted.load()) {
-            // 0, because "contents" isn't stored, yet
-            emit loaded(this);
+            scanner.abort();
             return;
         }
-        it.next();
-
-        QString dirName = it.fileInfo().dir().dirName();
-        QString fileName = it.fileName(); // may actually be a directory name
-
-        const bool isFile = it.fileInfo().isFile();
-        const bool isDir = it.fileInfo().isDir();
-        bool isSpecialDir = false; // set to true for DVD or BluRay Structure
-
-        if (isFile && Settings::instance()->advanced()->isFileExcluded(fileName)) {
-            continue;
-        }
-
-        // TODO: If there is a BluRay structure then the directory filter may not work
-        // because BDMV's parent directory is not listed.
-        if ((isDir && Settings::instance()->advanced()->isFolderExcluded(fileName))
-            || Settings::instance()->advanced()->isFolderExcluded(dirName)) {
-            continue;
-        }
 
-        // Skips Extras files
-        if (isFile
-            && (fileName.contains("-trailer", Qt::CaseInsensitive)            //
-                || fileName.contains("-sample", Qt::CaseInsensitive)          //
-                || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
-                || fileName.contains("-deleted", Qt::CaseInsensitive)         //
-                || fileName.contains("-featurette", Qt::CaseInsensitive)      //
-                || fileName.contains("-interview", Qt::CaseInsensitive)       //
-                || fileName.contains("-scene", Qt::CaseInsensitive)           //
-                || fileName.contains("-short", Qt::CaseInsensitive))) {
-            continue;
-        }
+        const QString& dirName = directory.name;
+        const QString& dirPath = directory.path;
 
-        // Skip actors folder and all files inside it
-        if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
+        // Skips excluded folders and extras folders such as ".actors" and all files inside them.
+        if (excludes.foldersWithExtras.matches(dirName)) {
+            return;
         }
 
-        // Skip extras folder and all files inside it
-        if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+        for (const DirectoryScanner::Entry& entry : directory.entries) {
+            const QString& fileName = entry.name; // may actually be a directory name
+            bool isSpecialDir = false;            // set to true for DVD or BluRay Structure
 
-        // Skip extra fanarts folder and all files inside it
-        if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            // Skips excluded and extras files, e.g. trailers
+            if (entry.isFile && excludes.files.matches(fileName)) {
+                continue;
+            }
 
-        // Skip extra thumbs folder and all files inside it
-        if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            // TODO: If there is a BluRay structure then the directory filter may not work
+            // because BDMV's parent directory is not listed.
+            if (entry.isDir && excludes.folders.matches(fileName)) {
+                continue;
+            }
 
-        // Skip BluRay backup folder
-        if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
-            && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+            // Skip BluRay backup folder
+            if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0
+                && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+                continue;
+            }
 
-        if (dirName != lastDir) {
-            lastDir = dirName;
-            if (m_contents.count() % 20 == 0) {
-                // TODO  emit currentDir(dirName);
+            if (entry.isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+                qCDebug(generic) << "[MovieDirectorySearcher] Found BluRay structure";
+                QDir bluRayDir(dirPath);
+                if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
+                    bluRayDir.cdUp();
+                }
+                m_bluRayDirectories << bluRayDir.path();
+                isSpecialDir = true;
+            }
+            if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
+                qCDebug(generic) << "[MovieDirectorySearcher] Found DVD structure";
+                QDir videoDir(dirPath);
+                if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
+                    videoDir.cdUp();
+                }
+                m_dvdDirectories << videoDir.path();
+                isSpecialDir = true;
             }
-        }
 
-        if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            qCDebug(generic) << "[MovieDirectorySearcher] Found BluRay structure";
-            QDir bluRayDir(it.fileInfo().dir());
-            if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
-                bluRayDir.cdUp();
+            if (!m_contents.contains(dirPath)) {
+                m_contents.insert(dirPath, {});
             }
-            m_bluRayDirectories << bluRayDir.path();
-            isSpecialDir = true;
-        }
-        if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
-            qCDebug(generic) << "[MovieDirectorySearcher] Found DVD structure";
-            QDir videoDir(it.fileInfo().dir());
-            if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
-                videoDir.cdUp();
+            if (entry.isFile || isSpecialDir) {
+                const QString filePath = directory.filePath(entry);
+                m_contents[dirPath].append(filePath);
+                m_lastModifications.insert(filePath, entry.lastModified);
             }
-            m_dvdDirectories << videoDir.path();
-            isSpecialDir = true;
         }
+    });
 
-        const QString dirPath = it.fileInfo().path();
-        if (!m_contents.contains(dirPath)) {
-            m_contents.insert(dirPath, {});
-        }
-        if (isFile || isSpecialDir) {
-            m_contents[dirPath].append(it.filePath());
-            m_lastModifications.insert(it.filePath(), it.fileInfo().lastModified());
-        }
+    if (m_aborted.load()) {
+        // 0, because "contents" isn't stored, yet
+        emit loaded(this);
     }
 }
 
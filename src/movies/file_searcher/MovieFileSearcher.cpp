@@ -6,9 +6,12 @@
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
 #include "log/Log.h"
+#include "log/Perf.h"
+#include "movies/MovieSnapshot.h"
 
 #include <QApplication>
 #include <QDirIterator>
+#include <QFutureWatcher>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QtConcurrent>
@@ -17,10 +20,20 @@ namespace mediaelch {
 
 MovieFileSearcher::MovieFileSearcher(QObject* parent) : QObject(parent), m_aborted{false}
 {
-    connect(this, &MovieFileSearcher::searchStarted, this, [this]() { m_reloadTimer.start(); });
+    connect(this, &MovieFileSearcher::searchStarted, this, [this]() {
+        m_reloadTimer.start();
+        // Measurements are aggregated per reload.
+        perf::reset();
+    });
     connect(this, &MovieFileSearcher::moviesLoaded, this, [this]() {
         qCDebug(generic) << "[MovieFileSearcher] Reloading took" << m_reloadTimer.elapsed() << "ms";
         m_reloadTimer.invalidate();
+        if (perf::isEnabled()) {
+            for (const perf::Entry& entry : perf::entries()) {
+                qCDebug(generic) << "[MovieFileSearcher] Perf:" << entry.name << "count:" << entry.count
+                                 << "total:" << entry.totalUs / 1000 << "ms";
+            }
+        }
     });
 }
 
@@ -69,6 +82,7 @@ void MovieFileSearcher::reload(bool force)
 
     if (force) {
         Manager::instance()->database()->clearAllMovies();
+        m_outdatedDirectories.clear();
     }
     QApplication::processEvents();
     Manager::instance()->movieModel()->clear();
@@ -83,7 +97,7 @@ void MovieFileSearcher::reload(bool force)
             continue;
         }
 
-        if (movieDir.autoReload || force) {
+        if (movieDir.autoReload || force || m_outdatedDirectories.remove(DirectoryPath(movieDir.path))) {
             // We need to reload from disk...
             auto* searcher = new MovieDirectorySearcher(movieDir, movieDir.separateFolders, this);
             m_searchers.push_back(searcher);
@@ -93,14 +107,38 @@ void MovieFileSearcher::reload(bool force)
                 searcher, &MovieDirectorySearcher::startLoading, this, &MovieFileSearcher::onDirectoryStartsLoading);
 
         } else {
+            // ...or from the snapshot of already parsed movies...
+            const mediaelch::DirectoryPath directory(movieDir.path);
+            MovieSnapshot snapshot(directory);
+            const QVector<Movie*> moviesFromSnapshot = snapshot.load(this);
+            if (!moviesFromSnapshot.isEmpty()) {
+                Manager::instance()->movieModel()->addMovies(moviesFromSnapshot);
+                validateSnapshotInBackground(directory, snapshot.storedFingerprint());
+                continue;
+            }
+
             // ...or from the cached database.
             // Note: We do this in a blocking way for now.
             // TODO: Move into worker.
-            const QVector<Movie*> moviesFromDb =
-                Manager::instance()->database()->moviesInDirectory(mediaelch::DirectoryPath(movieDir.path));
+            const QVector<Movie*> moviesFromDb = Manager::instance()->database()->moviesInDirectory(directory);
             if (moviesFromDb.count() > 0) {
-                QtConcurrent::blockingMap(moviesFromDb, MovieFileSearcher::loadMovieData);
+                // Movies are light and only parsed once they are needed, except for those cached by
+                // older versions or without NFO content. Store their list details for next time.
+                QVector<Movie*> moviesToParse;
+                for (Movie* movie : moviesFromDb) {
+                    if (!movie->controller()->infoLoaded()) {
+                        moviesToParse << movie;
+                    }
+                }
+                QtConcurrent::blockingMap(moviesToParse, MovieFileSearcher::loadMovieData);
+                Manager::instance()->database()->transaction();
+                for (Movie* movie : asConst(moviesToParse)) {
+                    Manager::instance()->database()->updateListColumns(movie);
+                }
+                Manager::instance()->database()->commit();
+
                 Manager::instance()->movieModel()->addMovies(moviesFromDb);
+                snapshot.save(moviesFromDb);
             }
         }
     }
@@ -136,6 +174,10 @@ void MovieFileSearcher::onDirectoryLoaded(MovieDirectorySearcher* searcher)
     // This avoid adding thousands of movies at once.
     // TODO: Do in another thread.
     QVector<Movie*> movies = searcher->movies();
+    // Note: We can't do it in MovieDirectorySearcher, because we have to use the database connection's thread.
+    for (Movie* movie : asConst(movies)) {
+        movie->setLabel(Manager::instance()->database()->getLabel(movie->files()));
+    }
     Manager::instance()->database()->transaction();
     for (int i = 0; i < movies.size(); ++i) {
         if (i % 40 == 0 && i > 0) {
@@ -145,8 +187,6 @@ void MovieFileSearcher::onDirectoryLoaded(MovieDirectorySearcher* searcher)
         }
 
         Movie* movie = movies.at(i);
-        // Note: We can't do it in MovieDirectorySearcher, because we have to use the database connection's thread.
-        movie->setLabel(Manager::instance()->database()->getLabel(movie->files()));
         Manager::instance()->database()->add(movie, mediaelch::DirectoryPath(searcher->directory().path));
 
         if (i % 40 == 0 && i > 0) {
@@ -186,6 +226,26 @@ void MovieFileSearcher::onMovieProcessed(Movie* movie)
     }
 }
 
+void MovieFileSearcher::validateSnapshotInBackground(const mediaelch::DirectoryPath& directory, QByteArray fingerprint)
+{
+    auto* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, directory]() {
+        if (!watcher->result()) {
+            // The snapshot only mirrors the database, which isn't updated either when
+            // automatic reloading is disabled.  Both are outdated, so the directory has
+            // to be scanned from disk.
+            qCInfo(generic) << "[MovieFileSearcher] Movie directory changed since its snapshot was written:"
+                            << directory;
+            MovieSnapshot(directory).remove();
+            m_outdatedDirectories.insert(directory);
+            emit directoryOutdated(directory);
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(
+        [directory, fingerprint]() { return MovieSnapshot::fingerprint(directory) == fingerprint; }));
+}
+
 void MovieFileSearcher::resetInternalState()
 {
     m_reloadTimer.invalidate();
@@ -207,6 +267,9 @@ void MovieFileSearcher::scanDir(QString startPath,
 {
     resetInternalState();
     m_aborted = false;
+    if (firstScan) {
+        m_scanExcludes = Settings::instance()->advanced()->movieOrganizerScanExcludes();
+    }
     emit currentDir(path.mid(startPath.length()));
 
     QDir dir(path);
@@ -215,15 +278,8 @@ void MovieFileSearcher::scanDir(QString startPath,
             return;
         }
 
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
-        }
-
-        // Skip "Extras" folder
-        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, ".AppleDouble", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
+        // Skip excluded and "Extras" folders
+        if (m_scanExcludes.foldersWithExtras.matches(cDir)) {
             continue;
         }
 
@@ -252,19 +308,8 @@ void MovieFileSearcher::scanDir(QString startPath,
             return;
         }
 
-        if (Settings::instance()->advanced()->isFileExcluded(file)) {
-            continue;
-        }
-
-        // Skip Extras files
-        if (file.contains("-trailer", Qt::CaseInsensitive)            //
-            || file.contains("-sample", Qt::CaseInsensitive)          //
-            || file.contains("-behindthescenes", Qt::CaseInsensitive) //
-            || file.contains("-deleted", Qt::CaseInsensitive)         //
-            || file.contains("-featurette", Qt::CaseInsensitive)      //
-            || file.contains("-interview", Qt::CaseInsensitive)       //
-            || file.contains("-scene", Qt::CaseInsensitive)           //
-            || file.contains("-short", Qt::CaseInsensitive)) {
+        // Skip excluded and Extras files
+        if (m_scanExcludes.files.matches(file)) {
             continue;
         }
         files.append(file);
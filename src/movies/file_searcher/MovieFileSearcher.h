@@ -1,5 +1,7 @@
 #pragma once
 
+#include "file/NameMatcher.h"
+#include "file/Path.h"
 #include "globals/Meta.h"
 #include "movies/Movie.h"
 
@@ -7,6 +9,7 @@
 #include <QElapsedTimer>
 #include <QHash>
 #include <QObject>
+#include <QSet>
 #include <QTime>
 #include <QVector>
 #include <memory>
@@ -31,6 +34,9 @@ public:
 
     /// \brief Sets the directories to scan for movies. Not readable directories are skipped.
     void setMovieDirectories(const QVector<SettingsDir>& directories);
+    /// \brief Whether there are directories whose snapshot turned out to be outdated.
+    ///        They are scanned from disk on the next reload.
+    ELCH_NODISCARD bool hasOutdatedDirectories() const { return !m_outdatedDirectories.isEmpty(); }
 
     /// \brief Scans the given path for movie files.
     ///
@@ -58,6 +64,9 @@ signals:
     void progress(int current, int max, int messageBarId);
     void moviesLoaded();
     void currentDir(QString);
+    /// \brief Emitted if a directory changed on disk since its snapshot was written.
+    ///        Its snapshot is removed and the directory is scanned from disk on the next reload.
+    void directoryOutdated(mediaelch::DirectoryPath directory);
 
 public:
     static void loadMovieData(Movie* movie);
@@ -71,6 +80,11 @@ private:
     /// \brief Resets all counters, internal variables and so on.
     void resetInternalState();
 
+    /// \brief Compares the directory's current fingerprint with the one stored in its
+    ///        snapshot in a worker thread. If they differ, the snapshot is removed and the
+    ///        directory is marked as outdated, see directoryOutdated().
+    void validateSnapshotInBackground(const mediaelch::DirectoryPath& directory, QByteArray fingerprint);
+
     /// Get a list of files in a directory
     /// \deprecated Remove with scanDir
     ELCH_DEPRECATED QStringList getFiles(QString path);
@@ -79,9 +93,13 @@ private:
     QVector<SettingsDir> m_directories;
     QVector<MovieDirectorySearcher*> m_searchers;
     QElapsedTimer m_reloadTimer;
+    /// Directories that are scanned from disk on next reload, see directoryOutdated().
+    QSet<mediaelch::DirectoryPath> m_outdatedDirectories;
 
     /// \deprecated Remove with scanDir
     ELCH_DEPRECATED QHash<QString, QDateTime> m_lastModifications;
+    /// \deprecated Remove with scanDir
+    ScanExcludes m_scanExcludes;
 
     int m_approxMovieSum = 0;
     int m_moviesProcessed = 0;
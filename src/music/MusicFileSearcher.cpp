@@ -67,6 +67,7 @@ void MusicFileSearcher::reload(bool force)
         }
 
         if (dir.autoReload || force) {
+            const mediaelch::ScanExcludes excludes = Settings::instance()->advanced()->musicScanExcludes();
             QDirIterator it(dir.path.path(), QDir::NoDotAndDotDot | QDir::Dirs, QDirIterator::FollowSymlinks);
             while (it.hasNext()) {
                 if (m_aborted) {
@@ -75,7 +76,7 @@ void MusicFileSearcher::reload(bool force)
 
                 it.next();
 
-                if (Settings::instance()->advanced()->isFolderExcluded(it.fileInfo().dir().dirName())) {
+                if (excludes.folders.matches(it.fileInfo().dir().dirName())) {
                     continue;
                 }
 
@@ -89,7 +90,7 @@ void MusicFileSearcher::reload(bool force)
                 while (itAlbums.hasNext()) {
                     itAlbums.next();
 
-                    if (Settings::instance()->advanced()->isFolderExcluded(itAlbums.fileInfo().dir().dirName())) {
+                    if (excludes.folders.matches(itAlbums.fileInfo().dir().dirName())) {
                         continue;
                     }
 
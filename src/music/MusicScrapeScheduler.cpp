@@ -0,0 +1,215 @@
+#include "music/MusicScrapeScheduler.h"
+
+#include "globals/Meta.h"
+#include "log/Log.h"
+#include "music/Album.h"
+#include "music/AlbumController.h"
+#include "music/Artist.h"
+#include "music/ArtistController.h"
+
+namespace mediaelch {
+
+MusicScrapeScheduler::MusicScrapeScheduler(scraper::MusicScraper* scraper, QObject* parent) :
+    QObject(parent), m_scraper{scraper}
+{
+}
+
+MusicScrapeScheduler::~MusicScrapeScheduler()
+{
+    abort();
+}
+
+void MusicScrapeScheduler::add(Artist* artist)
+{
+    Item item;
+    item.artist = artist;
+    m_queue.enqueue(item);
+    ++m_total;
+    startNextItems();
+}
+
+void MusicScrapeScheduler::add(Album* album)
+{
+    Item item;
+    item.album = album;
+    m_queue.enqueue(item);
+    ++m_total;
+    startNextItems();
+}
+
+void MusicScrapeScheduler::start()
+{
+    if (m_scraper.isNull()) {
+        qCWarning(generic) << "[MusicScrapeScheduler] No scraper set, nothing is scraped";
+        m_queue.clear();
+    }
+    qCInfo(generic) << "[MusicScrapeScheduler] Scraping" << m_total << "items with up to" << m_maxConcurrentItems
+                    << "at the same time";
+    m_running = true;
+    startNextItems();
+    // Nothing to do or only deleted items.
+    if (m_running && m_activeArtists.isEmpty() && m_activeAlbums.isEmpty() && m_queue.isEmpty()) {
+        m_running = false;
+        emit finished();
+    }
+}
+
+void MusicScrapeScheduler::abort()
+{
+    m_running = false;
+    m_queue.clear();
+    for (Artist* artist : asConst(m_activeArtists)) {
+        disconnect(artist, nullptr, this, nullptr);
+        disconnect(artist->controller(), nullptr, this, nullptr);
+        artist->controller()->abortDownloads();
+    }
+    for (Album* album : asConst(m_activeAlbums)) {
+        disconnect(album, nullptr, this, nullptr);
+        disconnect(album->controller(), nullptr, this, nullptr);
+        album->controller()->abortDownloads();
+    }
+    m_activeArtists.clear();
+    m_activeAlbums.clear();
+}
+
+void MusicScrapeScheduler::startNextItems()
+{
+    while (m_running && !m_queue.isEmpty()
+           && m_activeArtists.size() + m_activeAlbums.size() < m_maxConcurrentItems) {
+        const Item item = m_queue.dequeue();
+        if (!item.artist.isNull()) {
+            startArtist(item.artist.data());
+        } else if (!item.album.isNull()) {
+            startAlbum(item.album.data());
+        } else {
+            // Deleted in the meantime.
+            completeItem();
+        }
+    }
+}
+
+void MusicScrapeScheduler::startArtist(Artist* artist)
+{
+    m_activeArtists.insert(artist);
+    connect(artist, &QObject::destroyed, this, [this, artist]() {
+        if (m_activeArtists.remove(artist)) {
+            completeItem();
+        }
+    });
+    connect(artist->controller(),
+        &ArtistController::sigLoadDone,
+        this,
+        &MusicScrapeScheduler::onArtistLoadDone,
+        Qt::UniqueConnection);
+    emit artistStarted(artist);
+
+    if (artist->mbId().isValid()) {
+        artist->controller()->loadData(artist->mbId(), m_scraper, m_artistInfos);
+        return;
+    }
+
+    // The callback isn't bound to this object, so it must check whether the artist is still scraped.
+    QPointer<MusicScrapeScheduler> self(this);
+    m_scraper->searchArtist(artist->name().trimmed(), [self, artist](QVector<ScraperSearchResult> results) {
+        if (self.isNull() || !self->m_activeArtists.contains(artist)) {
+            return;
+        }
+        if (results.isEmpty()) {
+            qCInfo(generic) << "[MusicScrapeScheduler] No results for artist:" << artist->name();
+            self->completeArtist(artist);
+            return;
+        }
+        artist->controller()->loadData(MusicBrainzId(results.first().id), self->m_scraper, self->m_artistInfos);
+    });
+}
+
+void MusicScrapeScheduler::startAlbum(Album* album)
+{
+    m_activeAlbums.insert(album);
+    connect(album, &QObject::destroyed, this, [this, album]() {
+        if (m_activeAlbums.remove(album)) {
+            completeItem();
+        }
+    });
+    connect(album->controller(),
+        &AlbumController::sigLoadDone,
+        this,
+        &MusicScrapeScheduler::onAlbumLoadDone,
+        Qt::UniqueConnection);
+    emit albumStarted(album);
+
+    if (album->mbAlbumId().isValid()) {
+        album->controller()->loadData(album->mbAlbumId(), album->mbReleaseGroupId(), m_scraper, m_albumInfos);
+        return;
+    }
+
+    const QString artistName = (album->artist().isEmpty() && (album->artistObj() != nullptr))
+                                   ? album->artistObj()->name().trimmed()
+                                   : album->artist().trimmed();
+    QPointer<MusicScrapeScheduler> self(this);
+    m_scraper->searchAlbum(artistName, album->title(), [self, album](QVector<ScraperSearchResult> results) {
+        if (self.isNull() || !self->m_activeAlbums.contains(album)) {
+            return;
+        }
+        if (results.isEmpty()) {
+            qCInfo(generic) << "[MusicScrapeScheduler] No results for album:" << album->title();
+            self->completeAlbum(album);
+            return;
+        }
+        album->controller()->loadData(MusicBrainzId(results.first().id),
+            MusicBrainzId(results.first().id2),
+            self->m_scraper,
+            self->m_albumInfos);
+    });
+}
+
+void MusicScrapeScheduler::onArtistLoadDone(Artist* artist)
+{
+    if (!m_activeArtists.contains(artist)) {
+        return;
+    }
+    emit artistFinished(artist);
+    completeArtist(artist);
+}
+
+void MusicScrapeScheduler::onAlbumLoadDone(Album* album)
+{
+    if (!m_activeAlbums.contains(album)) {
+        return;
+    }
+    emit albumFinished(album);
+    completeAlbum(album);
+}
+
+void MusicScrapeScheduler::completeArtist(Artist* artist)
+{
+    disconnect(artist, nullptr, this, nullptr);
+    disconnect(artist->controller(), nullptr, this, nullptr);
+    m_activeArtists.remove(artist);
+    completeItem();
+}
+
+void MusicScrapeScheduler::completeAlbum(Album* album)
+{
+    disconnect(album, nullptr, this, nullptr);
+    disconnect(album->controller(), nullptr, this, nullptr);
+    m_activeAlbums.remove(album);
+    completeItem();
+}
+
+void MusicScrapeScheduler::completeItem()
+{
+    if (!m_running) {
+        return;
+    }
+    ++m_done;
+    emit progress(m_done, m_total);
+    startNextItems();
+    if (m_running && m_activeArtists.isEmpty() && m_activeAlbums.isEmpty() && m_queue.isEmpty()) {
+        m_running = false;
+        qCInfo(generic) << "[MusicScrapeScheduler] Scraped" << m_done << "items";
+        emit finished();
+    }
+}
+
+} // namespace mediaelch
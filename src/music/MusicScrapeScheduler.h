@@ -0,0 +1,107 @@
+#pragma once
+
+#include "globals/ScraperInfos.h"
+#include "scrapers/music/MusicScraper.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QSet>
+#include <QVector>
+
+class Album;
+class Artist;
+
+namespace mediaelch {
+
+/// \brief Scrapes many artists and albums with several items in flight.
+///
+/// Each item needs a few requests to MusicBrainz (search, lookup) and then to other
+/// sites such as TheAudioDb, AllMusic and Discogs. The requests are limited per site
+/// by network::RateLimiter, MusicBrainz e.g. to one request per second. If only one
+/// item is scraped at a time, most of the time is spent waiting for round trips. The
+/// scheduler instead keeps up to maxConcurrentItems() items in flight, so that other
+/// items' requests to other sites are sent while MusicBrainz's rate limit is reached.
+/// The overall duration is then bound by the sites' rate limits.
+///
+/// Items without a MusicBrainz ID are searched for and the first result is used.
+///
+/// \par Example
+/// \code{cpp}
+///   auto* scheduler = new MusicScrapeScheduler(scraper, this);
+///   scheduler->setArtistInfos(artistInfos);
+///   for (Artist* artist : artists) {
+///       scheduler->add(artist);
+///   }
+///   connect(scheduler, &MusicScrapeScheduler::artistFinished, this, &MyDialog::saveArtist);
+///   connect(scheduler, &MusicScrapeScheduler::finished, scheduler, &QObject::deleteLater);
+///   scheduler->start();
+/// \endcode
+class MusicScrapeScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MusicScrapeScheduler(scraper::MusicScraper* scraper, QObject* parent = nullptr);
+    ~MusicScrapeScheduler() override;
+
+    void setArtistInfos(QSet<MusicScraperInfo> infos) { m_artistInfos = std::move(infos); }
+    void setAlbumInfos(QSet<MusicScraperInfo> infos) { m_albumInfos = std::move(infos); }
+    /// \brief Maximum number of items that are scraped at the same time.
+    void setMaxConcurrentItems(int count) { m_maxConcurrentItems = qMax(1, count); }
+    int maxConcurrentItems() const { return m_maxConcurrentItems; }
+
+    void add(Artist* artist);
+    void add(Album* album);
+    /// \brief Starts scraping the added items. Items may still be added afterwards.
+    void start();
+    /// \brief Aborts all running items and clears the queue. finished() is not emitted.
+    void abort();
+
+    int count() const { return m_total; }
+    bool isRunning() const { return m_running; }
+
+signals:
+    void artistStarted(Artist* artist);
+    void albumStarted(Album* album);
+    /// \brief The artist was scraped, including its images. Not emitted if nothing was found.
+    void artistFinished(Artist* artist);
+    /// \brief The album was scraped, including its images. Not emitted if nothing was found.
+    void albumFinished(Album* album);
+    /// \brief Number of items that are scraped or skipped.
+    void progress(int done, int total);
+    void finished();
+
+private slots:
+    void onArtistLoadDone(Artist* artist);
+    void onAlbumLoadDone(Album* album);
+
+private:
+    struct Item
+    {
+        QPointer<Artist> artist;
+        QPointer<Album> album;
+    };
+
+    void startNextItems();
+    void startArtist(Artist* artist);
+    void startAlbum(Album* album);
+    void completeArtist(Artist* artist);
+    void completeAlbum(Album* album);
+    void completeItem();
+
+private:
+    QPointer<scraper::MusicScraper> m_scraper;
+    QSet<MusicScraperInfo> m_artistInfos;
+    QSet<MusicScraperInfo> m_albumInfos;
+    int m_maxConcurrentItems = 8;
+
+    QQueue<Item> m_queue;
+    QSet<Artist*> m_activeArtists;
+    QSet<Album*> m_activeAlbums;
+    bool m_running = false;
+    int m_total = 0;
+    int m_done = 0;
+};
+
+} // namespace mediaelch
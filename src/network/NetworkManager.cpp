@@ -1,42 +1,137 @@
 #include "network/NetworkManager.h"
 
+#include "log/Perf.h"
 #include "network/NetworkReplyWatcher.h"
+#include "network/RateLimiter.h"
+#include "network/ReplayTransport.h"
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QThread>
+#include <memory>
 
 namespace mediaelch {
 namespace network {
 
-NetworkManager::NetworkManager(QObject* parent) : QObject(parent)
+namespace {
+
+/// Dynamic property of replies that stores the NetworkManager which sent them.
+constexpr char OWNER_PROP[] = "mediaelch_network_manager";
+
+/// \brief Access manager shared by all network managers of the GUI thread.
+///
+/// QNetworkAccessManager keeps a pool of connections per host; sharing it lets all
+/// scrapers reuse the same connections. Returns nullptr for other threads because
+/// access managers can only be used in the thread they were created in.
+QNetworkAccessManager* sharedAccessManager()
 {
-    // Mapping of important signals
-    // clang-format off
-    connect(&m_qnam, &QNetworkAccessManager::authenticationRequired, this, &NetworkManager::authenticationRequired, Qt::UniqueConnection);
-    connect(&m_qnam, &QNetworkAccessManager::finished,               this, &NetworkManager::finished,               Qt::UniqueConnection);
-    // clang-format on
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app == nullptr || QThread::currentThread() != app->thread()) {
+        return nullptr;
+    }
+    static QPointer<QNetworkAccessManager> s_qnam;
+    if (s_qnam.isNull()) {
+        s_qnam = new QNetworkAccessManager(app);
+    }
+    return s_qnam.data();
+}
+
+} // namespace
+
+NetworkManager::NetworkManager(QObject* parent) : QObject(parent), m_qnam{sharedAccessManager()}
+{
+    if (m_qnam == nullptr) {
+        m_qnam = new QNetworkAccessManager(this);
+    }
+    // The access manager may be shared, so only requests of this manager are forwarded.
+    connect(m_qnam,
+        &QNetworkAccessManager::authenticationRequired,
+        this,
+        [this](QNetworkReply* reply, QAuthenticator* authenticator) {
+            if (reply->property(OWNER_PROP).value<QObject*>() == this) {
+                emit authenticationRequired(reply, authenticator);
+            }
+        });
 }
 
 QNetworkReply* NetworkManager::get(const QNetworkRequest& request)
 {
-    return m_qnam.get(request);
+    return send(QNetworkAccessManager::GetOperation, request);
 }
 
 QNetworkReply* NetworkManager::getWithWatcher(const QNetworkRequest& request)
 {
-    QNetworkReply* reply = m_qnam.get(request);
+    QNetworkReply* reply = send(QNetworkAccessManager::GetOperation, request);
     new NetworkReplyWatcher(this, reply);
     return reply;
 }
 
+void NetworkManager::getWithWatcherRateLimited(const QNetworkRequest& request,
+    std::function<void(QNetworkReply*)> onSent)
+{
+    const QString host = request.url().host();
+    QPointer<NetworkManager> self(this);
+    RateLimiter::instance()->acquire(host, [self, request, host, onSent = std::move(onSent)]() {
+        if (self.isNull()) {
+            RateLimiter::instance()->finished(host);
+            return;
+        }
+        QNetworkReply* reply = self->getWithWatcher(request);
+        // Replies may be deleted without emitting finished(), e.g. if the network manager is destroyed.
+        auto released = std::make_shared<bool>(false);
+        const auto release = [host, released]() {
+            if (!*released) {
+                *released = true;
+                RateLimiter::instance()->finished(host);
+            }
+        };
+        connect(reply, &QNetworkReply::finished, RateLimiter::instance(), release);
+        connect(reply, &QObject::destroyed, RateLimiter::instance(), release);
+        onSent(reply);
+    });
+}
+
 QNetworkReply* NetworkManager::post(const QNetworkRequest& request, const QByteArray& data)
 {
-    return m_qnam.post(request, data);
+    return send(QNetworkAccessManager::PostOperation, request, data);
 }
 
 QNetworkReply* NetworkManager::postWithWatcher(const QNetworkRequest& request, const QByteArray& data)
 {
-    QNetworkReply* reply = m_qnam.post(request, data);
+    QNetworkReply* reply = send(QNetworkAccessManager::PostOperation, request, data);
     new NetworkReplyWatcher(this, reply);
     return reply;
 }
 
+QNetworkReply* NetworkManager::send(QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const QByteArray& data)
+{
+    countRequest(request);
+    QNetworkReply* reply = nullptr;
+    ReplayTransport& transport = ReplayTransport::instance();
+    if (transport.isEnabled()) {
+        reply = transport.send(*m_qnam, operation, request, data);
+    } else if (operation == QNetworkAccessManager::PostOperation) {
+        reply = m_qnam->post(request, data);
+    } else {
+        reply = m_qnam->get(request);
+    }
+    // Replies are children of the shared access manager, which lives as long as the application.
+    // Replies that nobody deletes would leak, together with everything that their connections
+    // capture. They are deleted with this manager instead.
+    reply->setParent(this);
+    reply->setProperty(OWNER_PROP, QVariant::fromValue<QObject*>(this));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { emit finished(reply); });
+    return reply;
+}
+
+void NetworkManager::countRequest(const QNetworkRequest& request)
+{
+    if (perf::isEnabled()) {
+        perf::count(QStringLiteral("http.requests.%1").arg(request.url().host()));
+    }
+}
+
 } // namespace network
 } // namespace mediaelch
@@ -6,11 +6,15 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QObject>
+#include <functional>
 
 namespace mediaelch {
 namespace network {
 
 /// \brief Wrapper around QNetworkAccessManager that adds timeout mechanisms and logging.
+///
+/// All network managers of the GUI thread share one QNetworkAccessManager and
+/// therefore its connections.
 class NetworkManager : public QObject
 {
     Q_OBJECT
@@ -21,6 +25,9 @@ public:
 public:
     QNetworkReply* get(const QNetworkRequest& request);
     QNetworkReply* getWithWatcher(const QNetworkRequest& request);
+    /// \brief Sends the GET request as soon as the RateLimiter allows another request to its host.
+    /// \param onSent Called with the reply once the request was sent. The reply has a watcher.
+    void getWithWatcherRateLimited(const QNetworkRequest& request, std::function<void(QNetworkReply*)> onSent);
 
     QNetworkReply* post(const QNetworkRequest& request, const QByteArray& data);
     QNetworkReply* postWithWatcher(const QNetworkRequest& request, const QByteArray& data);
@@ -30,7 +37,15 @@ signals:
     void finished(QNetworkReply* reply);
 
 private:
-    QNetworkAccessManager m_qnam;
+    /// \brief Sends the request through the ReplayTransport if it is enabled, otherwise through m_qnam.
+    QNetworkReply* send(QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        const QByteArray& data = QByteArray());
+    /// \brief Counts requests per host if performance measurements are enabled.
+    static void countRequest(const QNetworkRequest& request);
+
+    /// Either shared or owned by this manager.
+    QNetworkAccessManager* m_qnam = nullptr;
 };
 
 } // namespace network
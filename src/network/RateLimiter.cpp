@@ -0,0 +1,114 @@
+#include "network/RateLimiter.h"
+
+#include <QTimer>
+#include <QtMath>
+
+namespace mediaelch {
+namespace network {
+
+RateLimiter::RateLimiter(QObject* parent) : QObject(parent)
+{
+}
+
+RateLimiter* RateLimiter::instance()
+{
+    static auto* s_instance = new RateLimiter();
+    return s_instance;
+}
+
+void RateLimiter::setLimits(const QString& host, Limits limits)
+{
+    Host& entry = m_hosts[host];
+    if (entry.lastRefill.isValid()) {
+        // Keep the tokens that were collected with the previous limits.
+        refill(entry);
+        entry.limits = limits;
+        entry.tokens = qMin(entry.tokens, static_cast<double>(qMax(1, limits.burst)));
+    } else {
+        entry.limits = limits;
+        refill(entry);
+    }
+    startWaiting(host);
+}
+
+RateLimiter::Limits RateLimiter::limits(const QString& host) const
+{
+    return m_hosts.value(host).limits;
+}
+
+void RateLimiter::acquire(const QString& host, StartFunction start)
+{
+    m_hosts[host].waiting.enqueue(std::move(start));
+    startWaiting(host);
+}
+
+void RateLimiter::finished(const QString& host)
+{
+    auto entry = m_hosts.find(host);
+    if (entry == m_hosts.end() || entry->running == 0) {
+        return;
+    }
+    --entry->running;
+    startWaiting(host);
+}
+
+int RateLimiter::waiting(const QString& host) const
+{
+    return m_hosts.value(host).waiting.size();
+}
+
+int RateLimiter::running(const QString& host) const
+{
+    return m_hosts.value(host).running;
+}
+
+void RateLimiter::startWaiting(const QString& hostName)
+{
+    // The host is looked up in each iteration because start() may add requests.
+    while (true) {
+        Host& host = m_hosts[hostName];
+        refill(host);
+        if (host.waiting.isEmpty()) {
+            return;
+        }
+        if (host.limits.maxConcurrent > 0 && host.running >= host.limits.maxConcurrent) {
+            // Continued by finished()
+            return;
+        }
+        const bool hasRateLimit = host.limits.requestsPerSecond > 0.0;
+        if (hasRateLimit && host.tokens < 1.0) {
+            if (!host.timerScheduled) {
+                host.timerScheduled = true;
+                const int waitMs = qMax(1, qCeil((1.0 - host.tokens) * 1000.0 / host.limits.requestsPerSecond));
+                QTimer::singleShot(waitMs, this, [this, hostName]() {
+                    m_hosts[hostName].timerScheduled = false;
+                    startWaiting(hostName);
+                });
+            }
+            return;
+        }
+
+        if (hasRateLimit) {
+            host.tokens -= 1.0;
+        }
+        ++host.running;
+        StartFunction start = host.waiting.dequeue();
+        start();
+    }
+}
+
+void RateLimiter::refill(Host& host)
+{
+    if (!host.lastRefill.isValid()) {
+        host.tokens = qMax(1, host.limits.burst);
+        host.lastRefill.start();
+        return;
+    }
+    const double elapsedSeconds = static_cast<double>(host.lastRefill.nsecsElapsed()) / 1e9;
+    host.lastRefill.restart();
+    host.tokens = qMin(static_cast<double>(qMax(1, host.limits.burst)),
+        host.tokens + elapsedSeconds * host.limits.requestsPerSecond);
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <functional>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Limits the requests per host with a token bucket and a maximum of concurrent requests.
+///
+/// The limiter is shared by all NetworkManager instances (see instance()), so that
+/// e.g. all IMDb scrapers together stay below IMDb's limits. Hosts without limits
+/// are not throttled. The limiter is not thread safe and must be used from the
+/// GUI thread.
+///
+/// \par Example
+/// \code{cpp}
+///   RateLimiter::instance()->acquire("www.imdb.com", [](){
+///       // send request, call RateLimiter::instance()->finished("www.imdb.com") afterwards
+///   });
+/// \endcode
+class RateLimiter : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Limits
+    {
+        /// Average number of requests that may be started per second. Zero means unlimited.
+        double requestsPerSecond = 0.0;
+        /// Number of requests that may be started at once after the host was idle.
+        int burst = 1;
+        /// Number of requests that may run at the same time. Zero means unlimited.
+        int maxConcurrent = 0;
+    };
+
+    using StartFunction = std::function<void()>;
+
+public:
+    explicit RateLimiter(QObject* parent = nullptr);
+    ~RateLimiter() override = default;
+
+    static RateLimiter* instance();
+
+    void setLimits(const QString& host, Limits limits);
+    Limits limits(const QString& host) const;
+
+    /// \brief Calls start() as soon as the host's limits allow another request.
+    /// May call start() immediately. Each call of start() must be followed by finished().
+    void acquire(const QString& host, StartFunction start);
+    /// \brief Marks a request to the given host as finished.
+    void finished(const QString& host);
+
+    /// \brief Number of requests to the host that wait for their start.
+    int waiting(const QString& host) const;
+    /// \brief Number of requests to the host that were started but are not finished.
+    int running(const QString& host) const;
+
+private:
+    struct Host
+    {
+        Limits limits;
+        double tokens = 0.0;
+        QElapsedTimer lastRefill;
+        int running = 0;
+        bool timerScheduled = false;
+        QQueue<StartFunction> waiting;
+    };
+
+    void startWaiting(const QString& host);
+    static void refill(Host& host);
+
+private:
+    QHash<QString, Host> m_hosts;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,382 @@
+#include "network/ReplayTransport.h"
+
+#include "log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTimer>
+#include <QUrlQuery>
+#include <QtGlobal>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+/// \brief Stored response to a request.
+struct Response
+{
+    int statusCode = 0;
+    QByteArray reasonPhrase;
+    QUrl redirectTarget;
+    QNetworkReply::NetworkError error = QNetworkReply::NoError;
+    QString errorString;
+    QList<QNetworkReply::RawHeaderPair> headers;
+    QByteArray body;
+};
+
+/// \brief Network reply whose response is set by ReplayTransport.
+///
+/// Finishes once finish() is called; the whole body is available at once.
+class BufferedReply : public QNetworkReply
+{
+public:
+    BufferedReply(QNetworkAccessManager::Operation operation, const QNetworkRequest& request, QObject* parent) :
+        QNetworkReply(parent)
+    {
+        setOperation(operation);
+        setRequest(request);
+        setUrl(request.url());
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+
+    void finish(const Response& response)
+    {
+        if (isFinished()) {
+            return;
+        }
+        m_body = response.body;
+        m_offset = 0;
+
+        if (response.statusCode > 0) {
+            setAttribute(QNetworkRequest::HttpStatusCodeAttribute, response.statusCode);
+            setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, response.reasonPhrase);
+        }
+        if (response.redirectTarget.isValid()) {
+            setAttribute(QNetworkRequest::RedirectionTargetAttribute, response.redirectTarget);
+        }
+        for (const auto& header : response.headers) {
+            setRawHeader(header.first, header.second);
+        }
+        if (response.error != QNetworkReply::NoError) {
+            setError(response.error, response.errorString);
+        }
+
+        emit metaDataChanged();
+        emit downloadProgress(m_body.size(), m_body.size());
+        if (!m_body.isEmpty()) {
+            emit readyRead();
+        }
+        setFinished(true);
+        emit finished();
+    }
+
+    void abort() override
+    {
+        if (isFinished()) {
+            return;
+        }
+        setError(QNetworkReply::OperationCanceledError, QStringLiteral("Operation canceled"));
+        setFinished(true);
+        emit finished();
+    }
+
+    bool isSequential() const override { return true; }
+
+    qint64 bytesAvailable() const override { return (m_body.size() - m_offset) + QIODevice::bytesAvailable(); }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+        if (m_offset >= m_body.size()) {
+            return isFinished() ? -1 : 0;
+        }
+        const qint64 count = qMin(maxSize, static_cast<qint64>(m_body.size() - m_offset));
+        std::memcpy(data, m_body.constData() + m_offset, static_cast<size_t>(count));
+        m_offset += count;
+        return count;
+    }
+
+private:
+    QByteArray m_body;
+    qint64 m_offset = 0;
+};
+
+/// Names of query parameters and JSON fields that contain API keys or tokens.
+bool isCredential(const QString& key)
+{
+    static const QStringList credentials{"api_key", "apikey", "client_key", "access_token", "token"};
+    return credentials.contains(key, Qt::CaseInsensitive);
+}
+
+QByteArray bodyWithoutCredentials(const QByteArray& body)
+{
+    QJsonParseError error{};
+    const QJsonDocument json = QJsonDocument::fromJson(body, &error);
+    if (error.error != QJsonParseError::NoError || !json.isObject()) {
+        return body;
+    }
+    QJsonObject object = json.object();
+    bool removed = false;
+    for (const QString& key : object.keys()) {
+        if (isCredential(key)) {
+            object.remove(key);
+            removed = true;
+        }
+    }
+    return removed ? QJsonDocument(object).toJson(QJsonDocument::Compact) : body;
+}
+
+QString operationName(QNetworkAccessManager::Operation operation)
+{
+    switch (operation) {
+    case QNetworkAccessManager::HeadOperation: return QStringLiteral("HEAD");
+    case QNetworkAccessManager::GetOperation: return QStringLiteral("GET");
+    case QNetworkAccessManager::PutOperation: return QStringLiteral("PUT");
+    case QNetworkAccessManager::PostOperation: return QStringLiteral("POST");
+    case QNetworkAccessManager::DeleteOperation: return QStringLiteral("DELETE");
+    case QNetworkAccessManager::CustomOperation:
+    case QNetworkAccessManager::UnknownOperation: break;
+    }
+    return QStringLiteral("CUSTOM");
+}
+
+QNetworkReply* sendToNetwork(QNetworkAccessManager& qnam,
+    QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const QByteArray& body)
+{
+    switch (operation) {
+    case QNetworkAccessManager::HeadOperation: return qnam.head(request);
+    case QNetworkAccessManager::PutOperation: return qnam.put(request, body);
+    case QNetworkAccessManager::PostOperation: return qnam.post(request, body);
+    case QNetworkAccessManager::DeleteOperation: return qnam.deleteResource(request);
+    case QNetworkAccessManager::GetOperation:
+    case QNetworkAccessManager::CustomOperation:
+    case QNetworkAccessManager::UnknownOperation: break;
+    }
+    return qnam.get(request);
+}
+
+Response responseOf(QNetworkReply* reply)
+{
+    Response response;
+    response.statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    response.reasonPhrase = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toByteArray();
+    response.redirectTarget = reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
+    response.error = reply->error();
+    response.errorString = response.error != QNetworkReply::NoError ? reply->errorString() : QString();
+    response.headers = reply->rawHeaderPairs();
+    response.body = reply->readAll();
+    return response;
+}
+
+bool writeResponse(const QString& basePath, const QString& method, const QUrl& url, const Response& response)
+{
+    QJsonArray headers;
+    for (const auto& header : response.headers) {
+        headers.append(QJsonArray{QString::fromLatin1(header.first), QString::fromLatin1(header.second)});
+    }
+    QJsonObject meta;
+    meta.insert("method", method);
+    meta.insert("url", url.toString());
+    meta.insert("status", response.statusCode);
+    meta.insert("reason", QString::fromLatin1(response.reasonPhrase));
+    meta.insert("redirect", response.redirectTarget.toString());
+    meta.insert("error", static_cast<int>(response.error));
+    meta.insert("errorString", response.errorString);
+    meta.insert("headers", headers);
+
+    QFile metaFile(basePath + ".json");
+    QFile bodyFile(basePath + ".body");
+    if (!metaFile.open(QIODevice::WriteOnly) || !bodyFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return metaFile.write(QJsonDocument(meta).toJson()) >= 0 && bodyFile.write(response.body) == response.body.size();
+}
+
+bool readResponse(const QString& basePath, Response& response)
+{
+    QFile metaFile(basePath + ".json");
+    QFile bodyFile(basePath + ".body");
+    if (!metaFile.open(QIODevice::ReadOnly) || !bodyFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QJsonObject meta = QJsonDocument::fromJson(metaFile.readAll()).object();
+    if (meta.isEmpty()) {
+        return false;
+    }
+    response.statusCode = meta.value("status").toInt();
+    response.reasonPhrase = meta.value("reason").toString().toLatin1();
+    response.redirectTarget = QUrl(meta.value("redirect").toString());
+    response.error = static_cast<QNetworkReply::NetworkError>(meta.value("error").toInt());
+    response.errorString = meta.value("errorString").toString();
+    for (const QJsonValue& header : meta.value("headers").toArray()) {
+        const QJsonArray pair = header.toArray();
+        response.headers.append(qMakePair(pair.at(0).toString().toLatin1(), pair.at(1).toString().toLatin1()));
+    }
+    response.body = bodyFile.readAll();
+    return true;
+}
+
+} // namespace
+
+namespace mediaelch {
+namespace network {
+
+ReplayTransport& ReplayTransport::instance()
+{
+    static ReplayTransport s_instance;
+    return s_instance;
+}
+
+void ReplayTransport::configureFromEnvironment()
+{
+    const QByteArray mode = qgetenv("MEDIAELCH_HTTP_REPLAY").toLower();
+    if (mode.isEmpty()) {
+        return;
+    }
+    if (mode != "record" && mode != "replay") {
+        qCWarning(generic) << "[ReplayTransport] Unknown mode in MEDIAELCH_HTTP_REPLAY:" << mode;
+        return;
+    }
+
+    Config config;
+    config.mode = (mode == "record") ? Mode::Record : Mode::Replay;
+    config.directory = QString::fromLocal8Bit(qgetenv("MEDIAELCH_HTTP_REPLAY_DIR"));
+    if (config.directory.isEmpty()) {
+        config.directory = QStringLiteral("http-replay");
+    }
+    config.latency = std::chrono::milliseconds(qgetenv("MEDIAELCH_HTTP_LATENCY_MS").toInt());
+    config.bytesPerSecond = qgetenv("MEDIAELCH_HTTP_BYTES_PER_SECOND").toLongLong();
+    setConfig(config);
+}
+
+void ReplayTransport::setConfig(Config config)
+{
+    m_config = std::move(config);
+    if (m_config.mode == Mode::Record && !QDir().mkpath(m_config.directory)) {
+        qCWarning(generic) << "[ReplayTransport] Could not create directory:" << m_config.directory;
+    }
+    if (isEnabled()) {
+        qCInfo(generic) << "[ReplayTransport]" << (m_config.mode == Mode::Record ? "Recording to" : "Replaying from")
+                        << m_config.directory;
+    }
+}
+
+QNetworkReply* ReplayTransport::send(QNetworkAccessManager& qnam,
+    QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const QByteArray& body)
+{
+    ++m_statistics.requests;
+    if (m_config.mode == Mode::Record) {
+        return record(qnam, operation, request, body);
+    }
+    return replay(qnam, operation, request, body);
+}
+
+QString ReplayTransport::fileKey(QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const QByteArray& body)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(operationName(operation).toUtf8());
+    hash.addData(" ");
+    hash.addData(withoutCredentials(request.url()).toEncoded());
+    hash.addData("\n");
+    hash.addData(bodyWithoutCredentials(body));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QUrl ReplayTransport::withoutCredentials(QUrl url)
+{
+    if (!url.hasQuery()) {
+        return url;
+    }
+    QUrlQuery query(url);
+    bool removed = false;
+    for (const auto& item : query.queryItems()) {
+        if (isCredential(item.first)) {
+            query.removeAllQueryItems(item.first);
+            removed = true;
+        }
+    }
+    if (removed) {
+        url.setQuery(query);
+    }
+    return url;
+}
+
+QNetworkReply* ReplayTransport::record(QNetworkAccessManager& qnam,
+    QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const QByteArray& body)
+{
+    auto* reply = new BufferedReply(operation, request, &qnam);
+    QNetworkReply* networkReply = sendToNetwork(qnam, operation, request, body);
+    const QString basePath = QDir(m_config.directory).filePath(fileKey(operation, request, body));
+    const QString method = operationName(operation);
+
+    QObject::connect(networkReply, &QNetworkReply::finished, reply, [this, reply, networkReply, basePath, method]() {
+        networkReply->deleteLater();
+        if (reply->isFinished()) {
+            // Aborted, e.g. by a timeout. Don't store incomplete responses.
+            return;
+        }
+        const Response response = responseOf(networkReply);
+        m_statistics.bytes += response.body.size();
+        const QUrl url = withoutCredentials(networkReply->request().url());
+        if (!writeResponse(basePath, method, url, response)) {
+            qCWarning(generic) << "[ReplayTransport] Could not store response to:" << url;
+        }
+        reply->finish(response);
+    });
+    // Stop the request if the reply was aborted or deleted before the response arrived.
+    const auto abortNetworkReply = [networkReply]() {
+        if (networkReply->isRunning()) {
+            networkReply->abort();
+        }
+    };
+    QObject::connect(reply, &QNetworkReply::finished, networkReply, abortNetworkReply);
+    QObject::connect(reply, &QObject::destroyed, networkReply, abortNetworkReply);
+    return reply;
+}
+
+QNetworkReply* ReplayTransport::replay(QNetworkAccessManager& qnam,
+    QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const QByteArray& body)
+{
+    auto* reply = new BufferedReply(operation, request, &qnam);
+    const QString basePath = QDir(m_config.directory).filePath(fileKey(operation, request, body));
+
+    Response response;
+    if (readResponse(basePath, response)) {
+        m_statistics.bytes += response.body.size();
+    } else {
+        ++m_statistics.missing;
+        qCWarning(generic) << "[ReplayTransport] No recorded response for:" << operationName(operation)
+                           << withoutCredentials(request.url());
+        response = Response{};
+        response.error = QNetworkReply::ContentNotFoundError;
+        response.errorString = QStringLiteral("No recorded response");
+    }
+
+    qint64 delayMs = m_config.latency.count();
+    if (m_config.bytesPerSecond > 0) {
+        delayMs += response.body.size() * 1000 / m_config.bytesPerSecond;
+    }
+
+    // Replies must never finish before the caller could connect to their signals.
+    const int delay = static_cast<int>(qMin<qint64>(delayMs, std::numeric_limits<int>::max()));
+    QTimer::singleShot(delay, reply, [reply, response]() { reply->finish(response); });
+    return reply;
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <QByteArray>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QUrl>
+#include <chrono>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Records HTTP responses to disk and serves them instead of the network.
+///
+/// The transport sits underneath NetworkManager and is disabled by default. In record
+/// mode, requests are sent as usual and each response is stored in the configured
+/// directory. In replay mode, no request reaches the network. Stored responses are
+/// served after a synthetic delay, i.e. the latency plus the time needed to transfer
+/// the response with the configured bandwidth. Requests without a stored response
+/// fail with QNetworkReply::ContentNotFoundError.
+///
+/// Responses are keyed by the request's method, URL and body. API keys and tokens in
+/// query parameters and JSON bodies are ignored, see withoutCredentials(), so that
+/// recordings don't depend on them and can be committed. Response bodies are stored
+/// as they are; don't commit recordings of login responses.
+///
+/// The transport is meant for tests and benchmarks, e.g. to measure scrapers offline.
+/// It is not thread safe and must be used from the GUI thread.
+///
+/// \par Example
+/// \code{cpp}
+///   ReplayTransport::Config config;
+///   config.mode = ReplayTransport::Mode::Replay;
+///   config.directory = "test/resources/scrapers/http";
+///   config.latency = std::chrono::milliseconds(80);
+///   ReplayTransport::instance().setConfig(config);
+/// \endcode
+class ReplayTransport
+{
+public:
+    enum class Mode
+    {
+        Off,
+        Record,
+        Replay
+    };
+
+    struct Config
+    {
+        Mode mode = Mode::Off;
+        /// Directory in which responses are stored.
+        QString directory;
+        /// Synthetic latency of each replayed response.
+        std::chrono::milliseconds latency{0};
+        /// Synthetic bandwidth of replayed responses. Zero means unlimited.
+        qint64 bytesPerSecond = 0;
+    };
+
+    struct Statistics
+    {
+        int requests = 0;
+        /// Replayed requests without a stored response.
+        int missing = 0;
+        /// Size of all response bodies.
+        qint64 bytes = 0;
+    };
+
+public:
+    static ReplayTransport& instance();
+
+    /// \brief Configures the transport using environment variables.
+    ///
+    /// MEDIAELCH_HTTP_REPLAY is either "record" or "replay". The other variables
+    /// are optional: MEDIAELCH_HTTP_REPLAY_DIR (default: "http-replay"),
+    /// MEDIAELCH_HTTP_LATENCY_MS and MEDIAELCH_HTTP_BYTES_PER_SECOND.
+    void configureFromEnvironment();
+
+    void setConfig(Config config);
+    const Config& config() const { return m_config; }
+    bool isEnabled() const { return m_config.mode != Mode::Off; }
+
+    Statistics statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics{}; }
+
+    /// \brief Sends the request through the transport. Must only be called if isEnabled().
+    /// The returned reply is a child of \p qnam, same as replies created by \p qnam itself.
+    QNetworkReply* send(QNetworkAccessManager& qnam,
+        QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        const QByteArray& body);
+
+    /// \brief File name (without extension) under which the response to the request is stored.
+    static QString fileKey(QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        const QByteArray& body);
+    /// \brief The URL without query parameters that contain credentials, e.g. "api_key".
+    static QUrl withoutCredentials(QUrl url);
+
+private:
+    ReplayTransport() = default;
+
+    QNetworkReply* record(QNetworkAccessManager& qnam,
+        QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        const QByteArray& body);
+    QNetworkReply* replay(QNetworkAccessManager& qnam,
+        QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        const QByteArray& body);
+
+private:
+    Config m_config;
+    Statistics m_statistics;
+};
+
+} // namespace network
+} // namespace mediaelch
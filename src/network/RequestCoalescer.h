@@ -0,0 +1,165 @@
+#pragma once
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Coalesces equal requests that run at the same time ("single-flight").
+///
+/// The first caller for a key sends the request, later callers wait for its
+/// response instead of sending the same request again. The coalescer is shared
+/// by all API clients with the same callback type (see shared()), so requests of
+/// e.g. the movie search dialog and a background job are coalesced as well.
+/// Keys should contain everything that influences the response, e.g. use
+/// WebsiteCache::key() for URL and locale.
+///
+/// The caller that sends the request gets a Flight from join() and finishes it with
+/// the response, also if the request failed. If the request ends without that, e.g.
+/// because its reply or its sender was destroyed, waiting callers get the fallback
+/// response that was passed to join() once the last reference to the flight is gone.
+/// Capture the flight in the reply's connections, so that it lives as long as the reply.
+///
+/// The coalescer is thread safe. Callbacks are called in the thread that finishes the
+/// flight. Fallback responses are delivered through the application's event loop,
+/// because flights are often destroyed while their sender is destroyed.
+///
+/// \par Example
+/// \code{cpp}
+///   auto flight = RequestCoalescer<QString, ScraperError>::shared().join(
+///       key, std::move(callback), QString(), makeCanceledRequestError());
+///   if (flight == nullptr) {
+///       return; // an equal request is running
+///   }
+///   QNetworkReply* reply = m_network.getWithWatcher(request);
+///   connect(reply, &QNetworkReply::finished, this, [reply, flight]() {
+///       flight->finish(data, error);
+///   });
+/// \endcode
+template<class... Args>
+class RequestCoalescer
+{
+public:
+    using Callback = std::function<void(Args...)>;
+
+    /// \brief A request that is being sent, see join().
+    class Flight
+    {
+    public:
+        Flight(RequestCoalescer& coalescer, QString key, quint64 id, std::function<void(const Callback&)> fallback) :
+            m_coalescer{coalescer}, m_key{std::move(key)}, m_id{id}, m_fallback{std::move(fallback)}
+        {
+        }
+        Flight(const Flight&) = delete;
+        Flight& operator=(const Flight&) = delete;
+
+        ~Flight()
+        {
+            if (m_finished.exchange(true)) {
+                return;
+            }
+            const QVector<Callback> callbacks = m_coalescer.take(m_key, m_id);
+            QCoreApplication* app = QCoreApplication::instance();
+            if (callbacks.isEmpty() || app == nullptr) {
+                return;
+            }
+            const auto fallback = m_fallback;
+            QMetaObject::invokeMethod(
+                app,
+                [callbacks, fallback]() {
+                    for (const Callback& callback : callbacks) {
+                        fallback(callback);
+                    }
+                },
+                Qt::QueuedConnection);
+        }
+
+        /// \brief Calls all callbacks that wait for the request with the given response.
+        ///        Later calls are ignored.
+        void finish(Args... args)
+        {
+            if (m_finished.exchange(true)) {
+                return;
+            }
+            // Callbacks may send requests themselves, so the coalescer's mutex must not be locked.
+            for (const Callback& callback : m_coalescer.take(m_key, m_id)) {
+                callback(args...);
+            }
+        }
+
+    private:
+        RequestCoalescer& m_coalescer;
+        const QString m_key;
+        const quint64 m_id;
+        const std::function<void(const Callback&)> m_fallback;
+        std::atomic_bool m_finished{false};
+    };
+
+    static RequestCoalescer& shared()
+    {
+        static RequestCoalescer s_coalescer;
+        return s_coalescer;
+    }
+
+    /// \brief Adds the callback to the callbacks that wait for the response to the key's request.
+    /// \param fallback Response for waiting callbacks if the request ends without a response.
+    /// \return The flight if no request for the key is running, i.e. the caller must send
+    ///         the request and finish the flight.  Otherwise nullptr.
+    std::shared_ptr<Flight> join(const QString& key, Callback callback, Args... fallback)
+    {
+        QMutexLocker lock(&m_mutex);
+        auto waiting = m_waiting.find(key);
+        if (waiting != m_waiting.end()) {
+            waiting->callbacks.append(std::move(callback));
+            return nullptr;
+        }
+        const quint64 id = ++m_lastFlight;
+        m_waiting.insert(key, {id, {std::move(callback)}});
+        return std::make_shared<Flight>(
+            *this, key, id, [fallback...](const Callback& waitingCallback) { waitingCallback(fallback...); });
+    }
+
+    /// \brief Number of callbacks that wait for the key's request.
+    int waiting(const QString& key) const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_waiting.value(key).callbacks.size();
+    }
+
+private:
+    struct Waiting
+    {
+        quint64 flight = 0;
+        QVector<Callback> callbacks;
+    };
+
+    /// \brief Removes the callbacks that wait for the given flight of the key.
+    QVector<Callback> take(const QString& key, quint64 flight)
+    {
+        QMutexLocker lock(&m_mutex);
+        auto waiting = m_waiting.find(key);
+        if (waiting == m_waiting.end() || waiting->flight != flight) {
+            return {};
+        }
+        QVector<Callback> callbacks = std::move(waiting->callbacks);
+        m_waiting.erase(waiting);
+        return callbacks;
+    }
+
+private:
+    mutable QMutex m_mutex;
+    quint64 m_lastFlight = 0;
+    QHash<QString, Waiting> m_waiting;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -1,24 +1,29 @@
 #include "network/WebsiteCache.h"
 
 #include <QDateTime>
+#include <QMutexLocker>
 #include <QString>
 #include <QUrl>
 
 namespace mediaelch {
 namespace scraper {
 
-WebsiteCache::WebsiteCache()
+WebsiteCache::Storage& WebsiteCache::storage()
 {
-    QObject::connect(&m_timer, &QTimer::timeout, [this]() { clearOldCacheEntries(); });
+    static Storage s_storage;
+    return s_storage;
 }
 
 bool WebsiteCache::hasValidElement(const QUrl& url, const Locale& locale)
 {
-    const QString h = hash(url, locale);
-    return m_cache.contains(h) && m_cache[h].date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds);
+    Storage& cache = storage();
+    QMutexLocker lock(&cache.mutex);
+    auto element = cache.elements.constFind(key(url, locale));
+    return element != cache.elements.constEnd()
+           && element->date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds);
 }
 
-QString WebsiteCache::hash(const QUrl& url, const Locale& locale)
+QString WebsiteCache::key(const QUrl& url, const Locale& locale)
 {
     return QStringLiteral("%1_##_%2").arg(locale.toString(), url.toString());
 }
@@ -31,34 +36,36 @@ void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QString dat
     CacheElement c;
     c.data = std::move(data);
     c.date = QDateTime::currentDateTime();
-    m_cache.insert(hash(url, locale), c);
 
-    if (!m_timer.isActive()) {
-        // set timer for clearing the cache
-        m_timer.start(timeoutSeconds * 1000);
-    }
+    Storage& cache = storage();
+    QMutexLocker lock(&cache.mutex);
+    clearOldCacheEntries(cache, c.date);
+    cache.elements.insert(key(url, locale), c);
 }
 
 QString WebsiteCache::getElement(const QUrl& url, const Locale& locale)
 {
-    const QString h = hash(url, locale);
-    return m_cache[h].data;
+    Storage& cache = storage();
+    QMutexLocker lock(&cache.mutex);
+    return cache.elements.value(key(url, locale)).data;
 }
 
-void WebsiteCache::clearOldCacheEntries()
+void WebsiteCache::clearOldCacheEntries(Storage& cache, const QDateTime& now)
 {
-    auto it = m_cache.begin();
-    while (it != m_cache.end()) {
-        if (it.value().date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds)) {
-            it = m_cache.erase(it);
+    if (cache.lastCleanup.isValid() && cache.lastCleanup >= now.addSecs(-timeoutSeconds)) {
+        return;
+    }
+    cache.lastCleanup = now;
+
+    const QDateTime oldest = now.addSecs(-timeoutSeconds);
+    auto it = cache.elements.begin();
+    while (it != cache.elements.end()) {
+        if (it.value().date < oldest) {
+            it = cache.elements.erase(it);
         } else {
             ++it;
         }
     }
-
-    if (!m_cache.isEmpty()) {
-        m_timer.start(timeoutSeconds * 1000);
-    }
 }
 
 } // namespace scraper
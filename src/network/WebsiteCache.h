@@ -3,29 +3,33 @@
 #include "data/Locale.h"
 
 #include <QDateTime>
-#include <QMap>
+#include <QHash>
+#include <QMutex>
 #include <QString>
-#include <QTimer>
 #include <QUrl>
 
 namespace mediaelch {
 namespace scraper {
 
-/// \brief TheTvDb API cache stores the result for a API request as a string.
+/// \brief Cache for API responses, stored as strings.
 ///
-/// Clears cache elements every timeoutSeconds. The cache is *not*
-/// thread safe.
+/// All instances share one storage, so that e.g. all TMDb API clients use the
+/// same cached responses. Entries are keyed by URL and locale and expire after
+/// timeoutSeconds. The cache is thread safe.
 class WebsiteCache
 {
 public:
     constexpr static int timeoutSeconds = 240;
 
-    WebsiteCache();
+    WebsiteCache() = default;
 
     void addElement(const QUrl& url, const Locale& locale, QString data);
     QString getElement(const QUrl& url, const Locale& locale);
     bool hasValidElement(const QUrl& url, const Locale& locale);
 
+    /// \brief Key of the cache entry for the given URL and locale.
+    static QString key(const QUrl& url, const Locale& locale);
+
 private:
     struct CacheElement
     {
@@ -33,16 +37,19 @@ private:
         QString data;
     };
 
-    QString hash(const QUrl& url, const Locale& locale);
+    struct Storage
+    {
+        QMutex mutex;
+        QHash<QString, CacheElement> elements;
+        QDateTime lastCleanup;
+    };
 
-    /// \brief Clears old cache entries that are older than timeoutSeconds.
-    ///
-    /// Restarts the timer if the cache is not empty to ensure that all elements
-    /// are eventually deleted.
-    void clearOldCacheEntries();
+    static Storage& storage();
 
-    QMap<QUrl, CacheElement> m_cache;
-    QTimer m_timer;
+    /// \brief Removes cache entries that are older than timeoutSeconds.
+    /// Does nothing if the last cleanup is more recent than timeoutSeconds.
+    /// Storage::mutex must be locked.
+    static void clearOldCacheEntries(Storage& storage, const QDateTime& now);
 };
 
 } // namespace scraper
@@ -3,6 +3,7 @@
 
 #include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "movies/Movie.h"
 #include "renamer/ConcertRenamer.h"
 #include "renamer/EpisodeRenamer.h"
 #include "renamer/MovieRenamer.h"
@@ -226,6 +227,9 @@ void RenamerDialog::renameMovies(QVector<Movie*> movies, const RenamerConfig& co
         return;
     }
 
+    // Renaming patterns may use any detail, e.g. the video codec or the studio.
+    MovieController::hydrate(movies);
+
     MovieRenamer renamer(config, this);
     for (Movie* movie : movies) {
         if (movie->files().isEmpty() || (movie->files().count() > 1 && config.filePatternMulti.isEmpty())) {
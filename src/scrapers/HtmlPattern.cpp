@@ -0,0 +1,152 @@
+#include "scrapers/HtmlPattern.h"
+
+#include "log/Log.h"
+
+#include <QFutureWatcher>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrent>
+#include <atomic>
+
+namespace {
+
+std::atomic_bool verifyAnchors{false};
+
+QMutex& anchorMismatchesMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+QStringList& anchorMismatchesList()
+{
+    static QStringList mismatches;
+    return mismatches;
+}
+
+/// Start and captured texts of the match, so that matches can be compared.
+QString describe(const QRegularExpressionMatch& match)
+{
+    if (!match.hasMatch()) {
+        return {};
+    }
+    return QString::number(match.capturedStart(0)) + ": " + match.capturedTexts().join(" | ");
+}
+
+QStringList describeAll(QRegularExpressionMatchIterator matches)
+{
+    QStringList descriptions;
+    while (matches.hasNext()) {
+        descriptions << describe(matches.next());
+    }
+    return descriptions;
+}
+
+} // namespace
+
+namespace mediaelch {
+namespace scraper {
+
+constexpr QRegularExpression::PatternOptions HtmlPattern::Lazy;
+
+HtmlPattern::HtmlPattern(const QString& pattern, QRegularExpression::PatternOptions options, QString anchor) :
+    m_regex(pattern, options),
+    m_anchor{std::move(anchor)},
+    m_anchorCase{options.testFlag(QRegularExpression::CaseInsensitiveOption) ? Qt::CaseInsensitive : Qt::CaseSensitive}
+{
+    if (!m_regex.isValid()) {
+        qCWarning(generic) << "[HtmlPattern] Invalid pattern:" << pattern << m_regex.errorString();
+    }
+    // Compiles the pattern now instead of on first use.
+    m_regex.optimize();
+}
+
+QRegularExpressionMatch HtmlPattern::match(const QString& html) const
+{
+    const int start = startOf(html);
+    const QRegularExpressionMatch match = start < 0 ? QRegularExpressionMatch() : m_regex.match(html, start);
+    if (verifyAnchors.load(std::memory_order_relaxed)) {
+        verifyAnchor({describe(match)}, {describe(m_regex.match(html))});
+    }
+    return match;
+}
+
+QRegularExpressionMatchIterator HtmlPattern::globalMatch(const QString& html) const
+{
+    const int start = startOf(html);
+    if (verifyAnchors.load(std::memory_order_relaxed)) {
+        // Iterators share their state when copied, so compare separate ones.
+        const QStringList anchored = start < 0 ? QStringList() : describeAll(m_regex.globalMatch(html, start));
+        verifyAnchor(anchored, describeAll(m_regex.globalMatch(html)));
+    }
+    if (start < 0) {
+        return {};
+    }
+    return m_regex.globalMatch(html, start);
+}
+
+QString HtmlPattern::captured(const QString& html, int group) const
+{
+    const QRegularExpressionMatch result = match(html);
+    return result.hasMatch() ? result.captured(group) : QString();
+}
+
+QStringList HtmlPattern::capturedAll(const QString& html, int group) const
+{
+    QStringList results;
+    QRegularExpressionMatchIterator matches = globalMatch(html);
+    while (matches.hasNext()) {
+        results << matches.next().captured(group);
+    }
+    return results;
+}
+
+QString HtmlPattern::removeHtmlTags(QString html)
+{
+    static const HtmlPattern tags("<[^>]*>", QRegularExpression::NoPatternOption, "<");
+    if (!html.contains('<')) {
+        return html;
+    }
+    return html.remove(tags.regex());
+}
+
+int HtmlPattern::startOf(const QString& html) const
+{
+    return m_anchor.isEmpty() ? 0 : html.indexOf(m_anchor, 0, m_anchorCase);
+}
+
+void HtmlPattern::setVerifyAnchors(bool verify)
+{
+    QMutexLocker locker(&anchorMismatchesMutex());
+    anchorMismatchesList().clear();
+    verifyAnchors = verify;
+}
+
+QStringList HtmlPattern::anchorMismatches()
+{
+    QMutexLocker locker(&anchorMismatchesMutex());
+    return anchorMismatchesList();
+}
+
+void HtmlPattern::verifyAnchor(const QStringList& anchored, const QStringList& unanchored) const
+{
+    if (anchored == unanchored) {
+        return;
+    }
+    qCWarning(generic) << "[HtmlPattern] Anchor" << m_anchor << "changes the matches of" << m_regex.pattern();
+    QMutexLocker locker(&anchorMismatchesMutex());
+    anchorMismatchesList() << m_regex.pattern();
+}
+
+void parseInBackground(QObject* context, std::function<void()> parse, std::function<void()> done)
+{
+    auto* watcher = new QFutureWatcher<void>(context);
+    QObject::connect(watcher, &QFutureWatcher<void>::finished, context, [watcher, done]() {
+        watcher->deleteLater();
+        done();
+    });
+    watcher->setFuture(QtConcurrent::run(std::move(parse)));
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QObject>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief Regular expression for extracting details from HTML pages.
+///
+/// Patterns are meant to be function-local statics so that they are compiled (and JIT
+/// compiled if supported) only once. An optional anchor, i.e. a literal text that every
+/// match starts with, is searched with QString::indexOf() first. The regular expression
+/// is only run from the anchor's first occurrence on, or not at all if the anchor is
+/// missing. This avoids running patterns like "<div>(.*)</div>" over whole pages.
+///
+/// Matching is thread-safe, so patterns can be used in parseInBackground().
+///
+/// \par Example
+/// \code{cpp}
+///   static const HtmlPattern rx(R"(<h1 class="[^"]*">([^<]*)</h1>)", HtmlPattern::Lazy, R"(<h1 class=")");
+///   const QString title = rx.captured(html);
+/// \endcode
+class HtmlPattern
+{
+public:
+    /// Options used by most scrapers: "." matches newlines and quantifiers are lazy.
+    static constexpr QRegularExpression::PatternOptions Lazy =
+        QRegularExpression::DotMatchesEverythingOption | QRegularExpression::InvertedGreedinessOption;
+
+public:
+    explicit HtmlPattern(const QString& pattern,
+        QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption,
+        QString anchor = {});
+
+    QRegularExpressionMatch match(const QString& html) const;
+    QRegularExpressionMatchIterator globalMatch(const QString& html) const;
+
+    /// \brief Captured text of the first match or an empty string if there is none.
+    QString captured(const QString& html, int group = 1) const;
+    /// \brief Captured texts of all matches.
+    QStringList capturedAll(const QString& html, int group = 1) const;
+
+    const QRegularExpression& regex() const { return m_regex; }
+
+    /// \brief Removes all HTML tags, e.g. "<b>bold</b> text" becomes "bold text".
+    static QString removeHtmlTags(QString html);
+
+    /// \brief If enabled, every pattern is additionally run over the whole page and matches
+    ///        that differ from the anchored ones are recorded, see anchorMismatches().
+    ///        Used by tests to check that anchors don't change parse results.
+    static void setVerifyAnchors(bool verify);
+    /// \brief Patterns whose anchored matches differed from unanchored ones since
+    ///        setVerifyAnchors(true) was called.
+    static QStringList anchorMismatches();
+
+private:
+    /// \brief Position from which the pattern is run or -1 if the anchor is missing.
+    int startOf(const QString& html) const;
+    void verifyAnchor(const QStringList& anchored, const QStringList& unanchored) const;
+
+private:
+    QRegularExpression m_regex;
+    QString m_anchor;
+    Qt::CaseSensitivity m_anchorCase = Qt::CaseSensitive;
+};
+
+/// \brief Runs parse() on the global thread pool and then done() on the context's thread.
+///
+/// parse() must not access QObjects such as Movie; return its results through
+/// captured shared state instead. done() is not called if the context is destroyed.
+void parseInBackground(QObject* context, std::function<void()> parse, std::function<void()> done);
+
+} // namespace scraper
+} // namespace mediaelch
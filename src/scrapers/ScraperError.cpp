@@ -40,6 +40,16 @@ ScraperError replyToScraperError(const QNetworkReply& reply)
     return error;
 }
 
+ScraperError makeCanceledRequestError()
+{
+    ScraperError error;
+    error.error = ScraperError::Type::NetworkError;
+    error.message = QObject::tr("Network Error: %1")
+                        .arg(mediaelch::translateNetworkError(QNetworkReply::OperationCanceledError));
+    error.technical = QStringLiteral("The request ended without a response");
+    return error;
+}
+
 ScraperError makeScraperError(const QString& data, const QNetworkReply& reply, const QJsonParseError& parseError)
 {
     ScraperError error;
@@ -47,4 +47,7 @@ ScraperError makeScraperError(const QString& data, const QNetworkReply& reply, c
 /// \brief A utility function to create a scraper error object based on a network reply.
 ScraperError replyToScraperError(const QNetworkReply& reply);
 
+/// \brief Error for requests that ended without a response, e.g. because their sender was destroyed.
+ScraperError makeCanceledRequestError();
+
 } // namespace mediaelch
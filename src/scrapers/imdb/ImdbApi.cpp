@@ -4,6 +4,8 @@
 #include "globals/Meta.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "network/RateLimiter.h"
+#include "network/RequestCoalescer.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -16,6 +18,13 @@ namespace scraper {
 
 ImdbApi::ImdbApi(QObject* parent) : QObject(parent)
 {
+    // The limits are shared by all IMDb scrapers, so that batch scrapes are not throttled by IMDb.
+    // QNetworkAccessManager keeps up to six connections per host alive and reuses them.
+    network::RateLimiter::Limits limits;
+    limits.requestsPerSecond = 8.0;
+    limits.burst = 8;
+    limits.maxConcurrent = 6;
+    network::RateLimiter::instance()->setLimits(makeFullUrl("/").host(), limits);
 }
 
 void ImdbApi::initialize()
@@ -39,26 +48,35 @@ void ImdbApi::sendGetRequest(const Locale& locale, const QUrl& url, ImdbApi::Api
         return;
     }
 
+    const QString key = WebsiteCache::key(url, locale);
+    auto flight = network::RequestCoalescer<QString, ScraperError>::shared().join(
+        key, std::move(callback), QString(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
+
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     addHeadersToRequest(locale, request);
 
-    QNetworkReply* reply = m_network.getWithWatcher(request);
-
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
-        auto dls = makeDeleteLaterScope(reply);
-        QString html;
-        if (reply->error() == QNetworkReply::NoError) {
-            html = QString::fromUtf8(reply->readAll());
-
-            if (!html.isEmpty()) {
-                m_cache.addElement(reply->url(), locale, html);
+    m_network.getWithWatcherRateLimited(request, [flight, locale, this](QNetworkReply* reply) {
+        connect(reply, &QNetworkReply::finished, this, [reply, flight, locale, this]() {
+            auto dls = makeDeleteLaterScope(reply);
+            QString html;
+            if (reply->error() == QNetworkReply::NoError) {
+                html = QString::fromUtf8(reply->readAll());
+
+                if (!html.isEmpty()) {
+                    m_cache.addElement(reply->url(), locale, html);
+                }
+            } else {
+                qCWarning(generic) << "[ImdbTv][Api] Network Error:" << reply->errorString() << "for URL"
+                                   << reply->url();
             }
-        } else {
-            qCWarning(generic) << "[ImdbTv][Api] Network Error:" << reply->errorString() << "for URL" << reply->url();
-        }
 
-        ScraperError error = makeScraperError(html, *reply, {});
-        cb(html, error);
+            ScraperError error = makeScraperError(html, *reply, {});
+            flight->finish(html, error);
+        });
     });
 }
 
@@ -3,6 +3,9 @@
 #include "globals/Meta.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "network/RequestCoalescer.h"
+
+#include <QTimer>
 
 namespace mediaelch {
 namespace scraper {
@@ -22,6 +25,14 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
         return;
     }
 
+    const QString key = WebsiteCache::key(url, Locale::English);
+    auto flight = network::RequestCoalescer<QString, ScraperError>::shared().join(
+        key, std::move(callback), QString(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
+
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     // Some server-side detection if the browser supports hovering or certain JavaScript features.
     // If we use the MediaElch user agent, then no actor images are sent in the response (i.e. HTML).
@@ -29,7 +40,7 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
     mediaelch::network::useFirefoxUserAgent(request);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, flight, this]() {
         auto dls = makeDeleteLaterScope(reply);
 
         QString data;
@@ -46,7 +57,7 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
-        cb(data, error);
+        flight->finish(data, error);
     });
 }
 
@@ -8,6 +8,7 @@
 
 #include <QGridLayout>
 #include <QRegularExpression>
+#include <QTimer>
 
 namespace mediaelch {
 namespace scraper {
@@ -158,110 +158,84 @@ void CustomMovieScraper::loadData(QHash<MovieScraper*, mediaelch::scraper::Movie
         }
     }
 
-    bool needImdbId = false;
-    for (const auto info : asConst(infos)) {
-        MovieScraper* scraper = scraperForInfo(info);
-        if (scraper == nullptr) {
-            continue;
-        }
-        if (scraper->meta().identifier == ImdbMovie::ID) {
-            needImdbId = true;
-            break;
+    QHash<MovieScraperInfo, MovieScraper*> scraperByInfo;
+    for (const auto info : infos) {
+        auto* scraper = scraperForInfo(info);
+        if (scraper != nullptr) {
+            scraperByInfo.insert(info, scraper);
         }
     }
 
-    if (needImdbId && !imdbId.isValid()) {
-        if (!tmdbId.isValid()) {
-            qCWarning(generic) << "[CustomMovieScraper] Invalid id: can't scrape movie with TMDb id:" << tmdbId;
-            ScraperError error;
-            error.error = ScraperError::Type::ConfigError;
-            error.message = tr("TMDb ID is invalid. Cannot scrape movie.");
-            error.technical = QStringLiteral("Invalid id: can't scrape movie with TMDb id: %1").arg(tmdbId.toString());
-            movie->controller()->scraperLoadDone(this, error);
-            return;
-        }
-        QNetworkRequest request;
-        request.setRawHeader("Accept", "application/json");
-        QUrl url(QStringLiteral("https://api.themoviedb.org/3/movie/%1?api_key=%2")
-                     .arg(tmdbId.toString())
-                     .arg(TmdbApi::apiKey()));
-        request.setUrl(url);
-        QNetworkReply* reply = network()->getWithWatcher(request);
-        reply->setProperty("movie", QVariant::fromValue(movie));
-        reply->setProperty("infosToLoad", QVariant::fromValue(infos));
-        reply->setProperty("ids", QVariant::fromValue(ids));
-        reply->setProperty("tmdbId", tmdbId.toString());
-        connect(reply, &QNetworkReply::finished, this, &CustomMovieScraper::onLoadTmdbFinished);
+    const FetchPlan plan = planFetches(m_scrapers, scraperByInfo, ids, tmdbId, imdbId);
+    if (!plan.waitingForImdbId.isEmpty() && !tmdbId.isValid()) {
+        qCWarning(generic) << "[CustomMovieScraper] Invalid id: can't scrape movie with TMDb id:" << tmdbId;
+        ScraperError error;
+        error.error = ScraperError::Type::ConfigError;
+        error.message = tr("TMDb ID is invalid. Cannot scrape movie.");
+        error.technical = QStringLiteral("Invalid id: can't scrape movie with TMDb id: %1").arg(tmdbId.toString());
+        movie->controller()->scraperLoadDone(this, error);
         return;
     }
-    loadAllData(ids, movie, infos, tmdbId, imdbId);
-}
-
-void CustomMovieScraper::onLoadTmdbFinished()
-{
-    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    Movie* movie = reply->property("movie").value<Movie*>();
-    QSet<MovieScraperInfo> infos = reply->property("infosToLoad").value<QSet<MovieScraperInfo>>();
-    QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> ids =
-        reply->property("ids").value<QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier>>();
-    TmdbId tmdbId(reply->property("tmdbId").toString());
-
-    if (reply->error() == QNetworkReply::NoError) {
-        ImdbId imdbId;
-        QJsonParseError parseError{};
-        const auto parsedJson = QJsonDocument::fromJson(reply->readAll(), &parseError).object();
-        reply->deleteLater();
-        if (parseError.error != QJsonParseError::NoError) {
-            qCWarning(generic) << "Error parsing TMDb json " << parseError.errorString();
-            return;
-        }
-        if (!parsedJson.value("imdb_id").toString().isEmpty()) {
-            imdbId = ImdbId(parsedJson.value("imdb_id").toString());
-
-        } else {
-            qCWarning(generic) << "No IMDB id available";
-            movie->controller()->scraperLoadDone(this, {}); // silent error
-            return;
-        }
-        loadAllData(ids, movie, infos, tmdbId, imdbId);
 
-    } else {
-        movie->controller()->scraperLoadDone(this, mediaelch::replyToScraperError(*reply));
-        reply->deleteLater();
+    const int loads = plan.ready.size() + plan.waitingForImdbId.size();
+    movie->controller()->setProperty("customMovieScraperLoads", loads);
+    movie->controller()->setProperty("isCustomScraper", true);
+    setForceFanartImages(movie, infos);
+
+    // Start everything whose inputs are known: fanart.tv's image lists only need the TMDb or
+    // IMDb ID and are loaded in parallel to the details. Only scrapers that need the IMDb ID
+    // wait for TMDb. Each scraper only loads the details it is configured for, so the order
+    // in which they finish does not change the result.
+    movie->controller()->prefetchFanartImages(this);
+    if (!plan.waitingForImdbId.isEmpty()) {
+        loadImdbIdFromTmdb(movie, tmdbId, plan.waitingForImdbId);
+    }
+    for (const Fetch& fetch : plan.ready) {
+        startFetch(movie, fetch);
+    }
+    if (loads == 0) {
+        movie->controller()->scraperLoadDone(this, {});
     }
 }
 
-void CustomMovieScraper::loadAllData(QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> ids,
-    Movie* movie,
-    const QSet<MovieScraperInfo>& infos,
-    TmdbId tmdbId,
-    ImdbId imdbId)
+CustomMovieScraper::FetchPlan CustomMovieScraper::planFetches(const QVector<MovieScraper*>& scrapers,
+    const QHash<MovieScraperInfo, MovieScraper*>& scraperByInfo,
+    const QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier>& ids,
+    const TmdbId& tmdbId,
+    const ImdbId& imdbId)
 {
-    QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> scrapersWithIds;
-    for (const auto info : infos) {
-        auto* scraper = scraperForInfo(info);
-        if (scraper == nullptr) {
-            continue;
-        }
+    QHash<MovieScraper*, QSet<MovieScraperInfo>> infosByScraper;
+    for (auto it = scraperByInfo.constBegin(); it != scraperByInfo.constEnd(); ++it) {
+        infosByScraper[it.value()].insert(it.key());
+    }
 
-        if (scrapersWithIds.contains(scraper)) {
+    FetchPlan plan;
+    for (MovieScraper* scraper : scrapers) {
+        if (!infosByScraper.contains(scraper)) {
             continue;
         }
-        QString id;
+        Fetch fetch;
+        fetch.scraper = scraper;
+        fetch.infos = infosByScraper.value(scraper);
+
         if (scraper->meta().identifier == TmdbMovie::ID) {
-            id = !tmdbId.isValid() ? imdbId.toString() : tmdbId.toString();
+            fetch.id = MovieIdentifier(!tmdbId.isValid() ? imdbId.toString() : tmdbId.toString());
         } else if (scraper->meta().identifier == ImdbMovie::ID) {
-            id = imdbId.toString();
+            if (!imdbId.isValid()) {
+                plan.waitingForImdbId.append(fetch);
+                continue;
+            }
+            fetch.id = MovieIdentifier(imdbId);
         } else {
-            id = ids.value(scraper).str();
+            fetch.id = ids.value(scraper);
         }
-        scrapersWithIds.insert(scraper, MovieIdentifier(id));
+        plan.ready.append(fetch);
     }
+    return plan;
+}
 
-    int loads = scrapersWithIds.count();
-    movie->controller()->setProperty("customMovieScraperLoads", loads);
-    movie->controller()->setProperty("isCustomScraper", true);
-
+void CustomMovieScraper::setForceFanartImages(Movie* movie, const QSet<MovieScraperInfo>& infos)
+{
     if (infos.contains(MovieScraperInfo::Backdrop)
         && Settings::instance()->customMovieScraper().value(MovieScraperInfo::Backdrop) == "images.fanarttv") {
         movie->controller()->setForceFanartBackdrop(true);
@@ -282,18 +256,60 @@ void CustomMovieScraper::loadAllData(QHash<MovieScraper*, mediaelch::scraper::Mo
         && Settings::instance()->customMovieScraper().value(MovieScraperInfo::Logo) == "images.fanarttv") {
         movie->controller()->setForceFanartLogo(true);
     }
+}
 
-    QHashIterator<MovieScraper*, MovieIdentifier> itS(scrapersWithIds);
-    while (itS.hasNext()) {
-        itS.next();
-        QSet<MovieScraperInfo> infosToLoad = infosForScraper(itS.key(), infos);
-        if (infosToLoad.isEmpty()) {
-            continue;
+void CustomMovieScraper::loadImdbIdFromTmdb(Movie* movie, const TmdbId& tmdbId, QVector<Fetch> fetches)
+{
+    QNetworkRequest request;
+    request.setRawHeader("Accept", "application/json");
+    QUrl url(QStringLiteral("https://api.themoviedb.org/3/movie/%1?api_key=%2")
+                 .arg(tmdbId.toString())
+                 .arg(TmdbApi::apiKey()));
+    request.setUrl(url);
+    QNetworkReply* reply = network()->getWithWatcher(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, movie, fetches]() {
+        onLoadTmdbFinished(reply, movie, fetches);
+    });
+}
+
+void CustomMovieScraper::onLoadTmdbFinished(QNetworkReply* reply, Movie* movie, QVector<Fetch> fetches)
+{
+    reply->deleteLater();
+    if (reply->error() != QNetworkReply::NoError) {
+        // Counts as done for all loads that waited for the IMDb ID, but the error is only
+        // reported once.  The controller remembers it until the last load is done.
+        const mediaelch::ScraperError error = mediaelch::replyToScraperError(*reply);
+        for (int i = 0; i < fetches.size(); ++i) {
+            movie->controller()->scraperLoadDone(this, i == 0 ? error : mediaelch::ScraperError{});
+        }
+        return;
+    }
+
+    QJsonParseError parseError{};
+    const auto parsedJson = QJsonDocument::fromJson(reply->readAll(), &parseError).object();
+    if (parseError.error != QJsonParseError::NoError) {
+        qCWarning(generic) << "Error parsing TMDb json " << parseError.errorString();
+    }
+    const ImdbId imdbId(parsedJson.value("imdb_id").toString());
+    if (!imdbId.isValid()) {
+        qCWarning(generic) << "No IMDB id available";
+        for (int i = 0; i < fetches.size(); ++i) {
+            movie->controller()->scraperLoadDone(this, {}); // silent error
         }
-        QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> subIds;
-        subIds.insert(nullptr, itS.value());
-        itS.key()->loadData(subIds, movie, infosToLoad);
+        return;
     }
+
+    for (Fetch& fetch : fetches) {
+        fetch.id = MovieIdentifier(imdbId);
+        startFetch(movie, fetch);
+    }
+}
+
+void CustomMovieScraper::startFetch(Movie* movie, const Fetch& fetch)
+{
+    QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> subIds;
+    subIds.insert(nullptr, fetch.id);
+    fetch.scraper->loadData(subIds, movie, fetch.infos);
 }
 
 MovieScraper* CustomMovieScraper::scraperForInfo(MovieScraperInfo info)
@@ -334,17 +350,6 @@ QVector<MovieScraper*> CustomMovieScraper::scrapersForInfos(QSet<MovieScraperInf
     return scrapers;
 }
 
-QSet<MovieScraperInfo> CustomMovieScraper::infosForScraper(MovieScraper* scraper, QSet<MovieScraperInfo> selectedInfos)
-{
-    QSet<MovieScraperInfo> infosForScraper;
-    for (const auto info : selectedInfos) {
-        if (scraper == scraperForInfo(info)) {
-            infosForScraper.insert(info);
-        }
-    }
-    return infosForScraper;
-}
-
 MovieScraper* CustomMovieScraper::titleScraper()
 {
     return scraperForInfo(MovieScraperInfo::Title);
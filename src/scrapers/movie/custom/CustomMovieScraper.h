@@ -42,8 +42,33 @@ public:
     QWidget* settingsWidget() override;
     MovieScraper* scraperForInfo(MovieScraperInfo info);
 
-private slots:
-    void onLoadTmdbFinished();
+public:
+    /// \brief Load of one sub-scraper with the details it is responsible for.
+    struct Fetch
+    {
+        MovieScraper* scraper = nullptr;
+        MovieIdentifier id;
+        QSet<MovieScraperInfo> infos;
+    };
+
+    /// \brief All loads of sub-scrapers for one movie, in the order of the sub-scrapers.
+    struct FetchPlan
+    {
+        /// Loads whose movie ID is known and that can be started right away.
+        QVector<Fetch> ready;
+        /// Loads that need the movie's IMDb ID, which is looked up on TMDb first.
+        QVector<Fetch> waitingForImdbId;
+    };
+
+    /// \brief Groups the given details by the sub-scraper that is configured for them.
+    /// \param scrapers All sub-scrapers; defines the order of the loads.
+    /// \param scraperByInfo Sub-scraper that is configured for each selected detail.
+    /// \param ids IDs of sub-scrapers other than TMDb and IMDb.
+    static FetchPlan planFetches(const QVector<MovieScraper*>& scrapers,
+        const QHash<MovieScraperInfo, MovieScraper*>& scraperByInfo,
+        const QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier>& ids,
+        const TmdbId& tmdbId,
+        const ImdbId& imdbId);
 
 private:
     ScraperMeta m_meta;
@@ -54,12 +79,10 @@ private:
     ImageProvider* imageProviderForInfo(int info);
     QVector<ImageProvider*> imageProvidersForInfos(QSet<MovieScraperInfo> infos);
 
-    QSet<MovieScraperInfo> infosForScraper(MovieScraper* scraper, QSet<MovieScraperInfo> selectedInfos);
-    void loadAllData(QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> ids,
-        Movie* movie,
-        const QSet<MovieScraperInfo>& infos,
-        TmdbId tmdbId,
-        ImdbId imdbId);
+    void setForceFanartImages(Movie* movie, const QSet<MovieScraperInfo>& infos);
+    void loadImdbIdFromTmdb(Movie* movie, const TmdbId& tmdbId, QVector<Fetch> fetches);
+    void onLoadTmdbFinished(QNetworkReply* reply, Movie* movie, QVector<Fetch> fetches);
+    void startFetch(Movie* movie, const Fetch& fetch);
     mediaelch::network::NetworkManager* network();
 };
 
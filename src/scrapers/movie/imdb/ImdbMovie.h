@@ -5,7 +5,12 @@
 #include "scrapers/imdb/ImdbApi.h"
 #include "scrapers/movie/MovieScraper.h"
 
+#include <QHash>
 #include <QNetworkReply>
+#include <QPointer>
+#include <QUrl>
+#include <QVector>
+#include <functional>
 
 class QCheckBox;
 
@@ -44,7 +49,11 @@ public:
     QSet<MovieScraperInfo> scraperNativelySupports() override;
     void changeLanguage(mediaelch::Locale locale) override;
     QWidget* settingsWidget() override;
-    void parseAndAssignInfos(const QString& html, Movie* movie, QSet<MovieScraperInfo> infos) const;
+    /// \brief Loads the image URL of the given IMDb actor page and passes it to the callback.
+    ///
+    /// Actors appear in many movies, so image URLs are cached and each page is only requested
+    /// once at a time.  The callback is not called if receiver was destroyed in the meantime.
+    void loadActorImageUrl(const QUrl& actorUrl, QObject* receiver, std::function<void(QString)> callback);
 
 private slots:
     void onLoadDone(Movie& movie, ImdbMovieLoader* loader);
@@ -59,6 +68,16 @@ private:
     mediaelch::network::NetworkManager m_network;
 
     ScraperSearchResult parseIdFromMovieHtml(const QString& html);
+    static QString parseActorImageUrl(const QString& html);
+
+    struct ActorPageCallback
+    {
+        QPointer<QObject> receiver;
+        std::function<void(QString)> callback;
+    };
+    /// Callbacks of loaders that wait for an actor page which is being loaded.
+    QHash<QUrl, QVector<ActorPageCallback>> m_pendingActorPages;
+    QHash<QUrl, QString> m_actorImageUrls;
 };
 
 } // namespace scraper
@@ -0,0 +1,339 @@
+#include "scrapers/movie/imdb/ImdbMovieParser.h"
+
+#include "globals/Helper.h"
+#include "log/Perf.h"
+#include "movies/Movie.h"
+#include "scrapers/HtmlPattern.h"
+
+#include <chrono>
+
+namespace mediaelch {
+namespace scraper {
+
+void ImdbMovieParser::parseInfos(Movie& movie,
+    const QString& html,
+    const QSet<MovieScraperInfo>& infos,
+    bool loadAllTags)
+{
+    using namespace std::chrono;
+    perf::ScopedTimer timer("scraper.imdb.parse");
+
+    // Matches the links inside of director, writer, genre and country blocks.
+    static const HtmlPattern linkRx(R"(<a href="[^"]*"[^>]*>([^<]*)</a>)", HtmlPattern::Lazy, R"(<a href=")");
+
+    if (infos.contains(MovieScraperInfo::Title)) {
+        static const HtmlPattern titleRx(R"(<h1 class="[^"]*">([^<]*)&nbsp;)", HtmlPattern::Lazy, R"(<h1 class=")");
+        static const HtmlPattern titleWithYearRx(R"(<h1 itemprop="name" class="">(.*)&nbsp;<span id="titleYear">)",
+            HtmlPattern::Lazy,
+            R"(<h1 itemprop="name" class="">)");
+        static const HtmlPattern originalTitleRx(
+            R"(<div class="originalTitle">([^<]*)<span)", HtmlPattern::Lazy, R"(<div class="originalTitle">)");
+
+        QRegularExpressionMatch match = titleRx.match(html);
+        if (match.hasMatch()) {
+            movie.setName(match.captured(1));
+        }
+        match = titleWithYearRx.match(html);
+        if (match.hasMatch()) {
+            movie.setName(match.captured(1));
+        }
+        match = originalTitleRx.match(html);
+        if (match.hasMatch()) {
+            movie.setOriginalName(match.captured(1));
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Director)) {
+        static const HtmlPattern directorsRx(
+            R"(<div class="txt-block" itemprop="director" itemscope itemtype="http://schema.org/Person">(.*)</div>)",
+            HtmlPattern::Lazy,
+            R"(<div class="txt-block" itemprop="director")");
+        // the ghost span may only exist if there are more than 2 directors
+        static const HtmlPattern directorsSummaryRx(
+            R"(<div class="credit_summary_item">\n +<h4 class="inline">Directors?:</h4>(.*)(?:<span class="ghost">|</div>))",
+            HtmlPattern::Lazy,
+            R"(<div class="credit_summary_item">)");
+
+        const QRegularExpressionMatch match = directorsRx.match(html);
+        const QString directorsBlock = match.hasMatch() ? match.captured(1) : directorsSummaryRx.captured(html);
+        if (!directorsBlock.isEmpty()) {
+            movie.setDirector(linkRx.capturedAll(directorsBlock).join(", "));
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Writer)) {
+        static const HtmlPattern writersRx(
+            R"(<div class="txt-block" itemprop="creator" itemscope itemtype="http://schema.org/Person">(.*)</div>)",
+            HtmlPattern::Lazy,
+            R"(<div class="txt-block" itemprop="creator")");
+        // the ghost span may only exist if there are more than 2 writers
+        static const HtmlPattern writersSummaryRx(
+            R"(<div class="credit_summary_item">\n +<h4 class="inline">Writers?:</h4>(.*)(?:<span class="ghost">|</div>))",
+            HtmlPattern::Lazy,
+            R"(<div class="credit_summary_item">)");
+
+        const QRegularExpressionMatch match = writersRx.match(html);
+        const QString writersBlock = match.hasMatch() ? match.captured(1) : writersSummaryRx.captured(html);
+        if (!writersBlock.isEmpty()) {
+            movie.setWriter(linkRx.capturedAll(writersBlock).join(", "));
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Genres)) {
+        static const HtmlPattern genresRx(
+            R"(<div class="see-more inline canwrap">\n *<h4 class="inline">Genres:</h4>(.*)</div>)",
+            HtmlPattern::Lazy,
+            R"(<div class="see-more inline canwrap">)");
+        const QRegularExpressionMatch match = genresRx.match(html);
+        if (match.hasMatch()) {
+            for (const QString& genre : linkRx.capturedAll(match.captured(1))) {
+                movie.addGenre(helper::mapGenre(genre.trimmed()));
+            }
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Tagline)) {
+        static const HtmlPattern taglineRx(R"(<div class="txt-block">[^<]*<h4 class="inline">Taglines:</h4>(.*)</div>)",
+            HtmlPattern::Lazy,
+            R"(<div class="txt-block">)");
+        static const HtmlPattern seeMoreRx("<span class=\"see-more inline\">.*</span>", HtmlPattern::Lazy);
+        const QRegularExpressionMatch match = taglineRx.match(html);
+        if (match.hasMatch()) {
+            const QString tagline = match.captured(1).remove(seeMoreRx.regex()).trimmed();
+            movie.setTagline(tagline);
+        }
+    }
+
+    if (!loadAllTags && infos.contains(MovieScraperInfo::Tags)) {
+        static const HtmlPattern tagsRx(
+            R"(<div class="see-more inline canwrap">\n *<h4 class="inline">Plot Keywords:</h4>(.*)<nobr>)",
+            HtmlPattern::Lazy,
+            R"(<div class="see-more inline canwrap">)");
+        static const HtmlPattern tagRx(
+            R"(<span class="itemprop">([^<]*)</span>)", HtmlPattern::Lazy, R"(<span class="itemprop">)");
+        const QRegularExpressionMatch match = tagsRx.match(html);
+        if (match.hasMatch()) {
+            for (const QString& tag : tagRx.capturedAll(match.captured(1))) {
+                movie.addTag(tag.trimmed());
+            }
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Released)) {
+        static const HtmlPattern releasedRx("<a href=\"[^\"]*\"(.*)title=\"See all release dates\" >[^<]*<meta "
+                                            "itemprop=\"datePublished\" content=\"([^\"]*)\" />",
+            HtmlPattern::Lazy,
+            "<a href=\"");
+        static const HtmlPattern releaseDateRx(R"(<h4 class="inline">Release Date:</h4> ([0-9]+) ([A-z]*) ([0-9]{4}))",
+            HtmlPattern::Lazy,
+            R"(<h4 class="inline">Release Date:</h4>)");
+        static const HtmlPattern titleYearRx(
+            R"(<title>[^<]+(?:\(| )(\d{4})\) - IMDb</title>)", HtmlPattern::Lazy, "<title>");
+
+        QRegularExpressionMatch match = releasedRx.match(html);
+        if (match.hasMatch()) {
+            movie.setReleased(QDate::fromString(match.captured(2), "yyyy-MM-dd"));
+
+        } else {
+            match = releaseDateRx.match(html);
+            if (match.hasMatch()) {
+                int day = match.captured(1).trimmed().toInt();
+                int month = -1;
+                QString monthName = match.captured(2).trimmed();
+                int year = match.captured(3).trimmed().toInt();
+                if (monthName.contains("January", Qt::CaseInsensitive)) {
+                    month = 1;
+                } else if (monthName.contains("February", Qt::CaseInsensitive)) {
+                    month = 2;
+                } else if (monthName.contains("March", Qt::CaseInsensitive)) {
+                    month = 3;
+                } else if (monthName.contains("April", Qt::CaseInsensitive)) {
+                    month = 4;
+                } else if (monthName.contains("May", Qt::CaseInsensitive)) {
+                    month = 5;
+                } else if (monthName.contains("June", Qt::CaseInsensitive)) {
+                    month = 6;
+                } else if (monthName.contains("July", Qt::CaseInsensitive)) {
+                    month = 7;
+                } else if (monthName.contains("August", Qt::CaseInsensitive)) {
+                    month = 8;
+                } else if (monthName.contains("September", Qt::CaseInsensitive)) {
+                    month = 9;
+                } else if (monthName.contains("October", Qt::CaseInsensitive)) {
+                    month = 10;
+                } else if (monthName.contains("November", Qt::CaseInsensitive)) {
+                    month = 11;
+                } else if (monthName.contains("December", Qt::CaseInsensitive)) {
+                    month = 12;
+                }
+
+                if (day != 0 && month != -1 && year != 0) {
+                    movie.setReleased(QDate(year, month, day));
+                }
+
+            } else {
+                match = titleYearRx.match(html);
+                if (match.hasMatch()) {
+                    const int day = 1;
+                    const int month = 1;
+                    const int year = match.captured(1).trimmed().toInt();
+                    movie.setReleased(QDate(year, month, day));
+                }
+            }
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Certification)) {
+        static const HtmlPattern certificationRx(
+            R"rx("contentRating": "([^"]*)",)rx", HtmlPattern::Lazy, R"("contentRating": ")");
+        const QRegularExpressionMatch match = certificationRx.match(html);
+        if (match.hasMatch()) {
+            movie.setCertification(helper::mapCertification(Certification(match.captured(1))));
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Runtime)) {
+        static const HtmlPattern durationRx(
+            R"("duration": "PT([0-9]+)H?([0-9]+)M")", HtmlPattern::Lazy, R"("duration": ")");
+        static const HtmlPattern runtimeRx(R"(<h4 class="inline">Runtime:</h4>[^<]*<time datetime="PT([0-9]+)M">)",
+            HtmlPattern::Lazy,
+            R"(<h4 class="inline">Runtime:</h4>)");
+
+        QRegularExpressionMatch match = durationRx.match(html);
+        if (match.hasMatch()) {
+            if (durationRx.regex().captureCount() > 1) {
+                minutes runtime = hours(match.captured(1).toInt()) + minutes(match.captured(2).toInt());
+                movie.setRuntime(runtime);
+            } else {
+                minutes runtime = minutes(match.captured(1).toInt());
+                movie.setRuntime(runtime);
+            }
+        }
+        match = runtimeRx.match(html);
+        if (match.hasMatch()) {
+            movie.setRuntime(minutes(match.captured(1).toInt()));
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Overview)) {
+        static const HtmlPattern descriptionRx(
+            "<p itemprop=\"description\">(.*)</p>", HtmlPattern::Lazy, "<p itemprop=\"description\">");
+        static const HtmlPattern summaryRx(
+            R"(<div class="summary_text">(.*)</div>)", HtmlPattern::Lazy, R"(<div class="summary_text">)");
+        static const HtmlPattern storylineRx(
+            R"(<h2>Storyline</h2>\n +\n +<div class="inline canwrap">\n +<p>\n +<span>(.*)</span>)",
+            HtmlPattern::Lazy,
+            "<h2>Storyline</h2>");
+
+        QRegularExpressionMatch match = descriptionRx.match(html);
+        if (match.hasMatch()) {
+            QString outline = HtmlPattern::removeHtmlTags(match.captured(1));
+            outline = outline.remove("See full summary&nbsp;&raquo;").trimmed();
+            movie.setOutline(outline);
+        }
+        match = summaryRx.match(html);
+        if (match.hasMatch()) {
+            QString outline = HtmlPattern::removeHtmlTags(match.captured(1));
+            outline = outline.remove("See full summary&nbsp;&raquo;").trimmed();
+            movie.setOutline(outline);
+        }
+        match = storylineRx.match(html);
+        if (match.hasMatch()) {
+            const QString overview = HtmlPattern::removeHtmlTags(match.captured(1).trimmed());
+            movie.setOverview(overview.trimmed());
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Rating)) {
+        static const HtmlPattern starBoxRx("<div class=\"star-box-details\" "
+                                           "itemtype=\"http://schema.org/AggregateRating\" "
+                                           "itemscope itemprop=\"aggregateRating\">(.*)</div>",
+            HtmlPattern::Lazy,
+            "<div class=\"star-box-details\"");
+        static const HtmlPattern ratingValueRx(
+            "<span itemprop=\"ratingValue\">(.*)</span>", HtmlPattern::Lazy, "<span itemprop=\"ratingValue\">");
+        static const HtmlPattern ratingCountRx(
+            "<span itemprop=\"ratingCount\">(.*)</span>", HtmlPattern::Lazy, "<span itemprop=\"ratingCount\">");
+        static const HtmlPattern imdbRatingRx(R"(<div class="imdbRating"[^>]*>\n +<div class="ratingValue">(.*)</div>)",
+            HtmlPattern::Lazy,
+            R"(<div class="imdbRating")");
+        static const HtmlPattern ratingDotRx("([0-9]\\.[0-9]) based on ([0-9\\,]*) ", HtmlPattern::Lazy);
+        static const HtmlPattern ratingCommaRx("([0-9]\\,[0-9]) based on ([0-9\\.]*) ", HtmlPattern::Lazy);
+        // Top250 for movies
+        static const HtmlPattern top250MoviesRx(
+            "Top Rated Movies #([0-9]+)\\n</a>", HtmlPattern::Lazy, "Top Rated Movies #");
+        // Top250 for TV shows (used by TheTvDb)
+        static const HtmlPattern top250TvRx("Top Rated TV #([0-9]+)\\n</a>", HtmlPattern::Lazy, "Top Rated TV #");
+
+        Rating rating;
+        rating.source = "imdb";
+        rating.maxRating = 10;
+        QRegularExpressionMatch match = starBoxRx.match(html);
+        if (match.hasMatch()) {
+            const QString content = match.captured(1);
+            match = ratingValueRx.match(content);
+            if (match.hasMatch()) {
+                rating.rating = match.captured(1).trimmed().replace(",", ".").toDouble();
+            }
+            match = ratingCountRx.match(content);
+            if (match.hasMatch()) {
+                rating.voteCount = match.captured(1).replace(",", "").replace(".", "").toInt();
+            }
+        } else {
+            match = imdbRatingRx.match(html);
+            if (match.hasMatch()) {
+                const QString content = match.captured(1);
+                match = ratingDotRx.match(content);
+                if (match.hasMatch()) {
+                    rating.rating = match.captured(1).trimmed().replace(",", ".").toDouble();
+                    rating.voteCount = match.captured(2).replace(",", "").replace(".", "").toInt();
+                }
+                match = ratingCommaRx.match(content);
+                if (match.hasMatch()) {
+                    rating.rating = match.captured(1).trimmed().replace(",", ".").toDouble();
+                    rating.voteCount = match.captured(2).replace(",", "").replace(".", "").toInt();
+                }
+            }
+        }
+
+        movie.ratings().setOrAddRating(rating);
+
+        match = top250MoviesRx.match(html);
+        if (match.hasMatch()) {
+            movie.setTop250(match.captured(1).toInt());
+        }
+        match = top250TvRx.match(html);
+        if (match.hasMatch()) {
+            movie.setTop250(match.captured(1).toInt());
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Studios)) {
+        static const HtmlPattern studiosRx(
+            R"(<h4 class="inline">Production Co:</h4>(.*)<span class="see-more inline">)",
+            HtmlPattern::Lazy,
+            R"(<h4 class="inline">Production Co:</h4>)");
+        static const HtmlPattern studioRx(
+            R"(<a href="/company/[^"]*"[^>]*>([^<]+)</a>)", HtmlPattern::Lazy, R"(<a href="/company/)");
+        const QRegularExpressionMatch match = studiosRx.match(html);
+        if (match.hasMatch()) {
+            for (const QString& studio : studioRx.capturedAll(match.captured(1))) {
+                movie.addStudio(helper::mapStudio(studio.trimmed()));
+            }
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Countries)) {
+        static const HtmlPattern countriesRx(
+            R"(<h4 class="inline">Country:</h4>(.*)</div>)", HtmlPattern::Lazy, R"(<h4 class="inline">Country:</h4>)");
+        const QRegularExpressionMatch match = countriesRx.match(html);
+        if (match.hasMatch()) {
+            for (const QString& country : linkRx.capturedAll(match.captured(1))) {
+                movie.addCountry(helper::mapCountry(country.trimmed()));
+            }
+        }
+    }
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "globals/ScraperInfos.h"
+
+#include <QSet>
+#include <QString>
+
+class Movie;
+
+namespace mediaelch {
+namespace scraper {
+
+class ImdbMovieParser
+{
+public:
+    /// \brief Parse the given HTML string and assign the requested details to the given movie.
+    /// \param movie Where to store the movie details into.
+    /// \param html HTML string of a movie page from imdb.com
+    /// \param infos Details to assign. Others are not touched.
+    /// \param loadAllTags If true, tags are not taken from the movie page because they are
+    ///        loaded from the keywords page instead.
+    static void parseInfos(Movie& movie, const QString& html, const QSet<MovieScraperInfo>& infos, bool loadAllTags);
+};
+
+} // namespace scraper
+} // namespace mediaelch
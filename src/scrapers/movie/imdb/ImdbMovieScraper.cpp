@@ -3,10 +3,13 @@
 #include "globals/Helper.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "scrapers/HtmlPattern.h"
 #include "scrapers/imdb/ImdbApi.h"
 #include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/imdb/ImdbMovieParser.h"
 
 #include <QRegularExpression>
+#include <memory>
 
 namespace mediaelch {
 namespace scraper {
@@ -24,40 +27,59 @@ void ImdbMovieLoader::load()
             return;
         }
 
-        QUrl posterViewerUrl = parsePosterViewerUrl(html);
-        parseAndAssignInfos(html);
-        parseAndStoreActors(html);
-
-        const bool shouldLoadPoster = m_infos.contains(MovieScraperInfo::Poster) && posterViewerUrl.isValid();
-        const bool shouldLoadTags = m_infos.contains(MovieScraperInfo::Tags) && m_loadAllTags;
-        const bool shouldLoadActors = m_infos.contains(MovieScraperInfo::Actors) && !m_actorUrls.isEmpty();
+        // The actor list and poster URL are extracted in the background. Details are
+        // assigned afterwards because Movie must only be accessed from the GUI thread.
+        struct PageDetails
+        {
+            QUrl posterViewerUrl;
+            QVector<QPair<Actor, QUrl>> actors;
+        };
+        auto details = std::make_shared<PageDetails>();
+        parseInBackground(
+            this,
+            [html, details]() {
+                details->posterViewerUrl = parsePosterViewerUrl(html);
+                details->actors = parseActors(html);
+            },
+            [this, html, details]() {
+                parseAndAssignInfos(html);
+                storeActors(details->actors);
+                loadAdditionalPages(details->posterViewerUrl);
+            });
+    });
+}
 
-        { // How many pages do we have to download? Count them.
-            m_itemsLeftToDownloads = 1;
-            if (shouldLoadPoster) {
-                ++m_itemsLeftToDownloads;
-            }
-            // IMDb has an extra page listing all tags (popular movies can have more than 100 tags).
-            if (shouldLoadTags) {
-                ++m_itemsLeftToDownloads;
-            }
-            if (shouldLoadActors) {
-                m_itemsLeftToDownloads += m_actorUrls.size();
-            }
-        }
+void ImdbMovieLoader::loadAdditionalPages(const QUrl& posterViewerUrl)
+{
+    const bool shouldLoadPoster = m_infos.contains(MovieScraperInfo::Poster) && posterViewerUrl.isValid();
+    const bool shouldLoadTags = m_infos.contains(MovieScraperInfo::Tags) && m_loadAllTags;
+    const bool shouldLoadActors = m_infos.contains(MovieScraperInfo::Actors) && !m_actorUrls.isEmpty();
 
+    { // How many pages do we have to download? Count them.
+        m_itemsLeftToDownloads = 1;
         if (shouldLoadPoster) {
-            loadPoster(posterViewerUrl);
+            ++m_itemsLeftToDownloads;
         }
+        // IMDb has an extra page listing all tags (popular movies can have more than 100 tags).
         if (shouldLoadTags) {
-            loadTags();
+            ++m_itemsLeftToDownloads;
         }
         if (shouldLoadActors) {
-            loadActorImageUrls();
+            m_itemsLeftToDownloads += m_actorUrls.size();
         }
-        // It's possible that none of the above items should be loaded.
-        decreaseDownloadCount();
-    });
+    }
+
+    if (shouldLoadPoster) {
+        loadPoster(posterViewerUrl);
+    }
+    if (shouldLoadTags) {
+        loadTags();
+    }
+    if (shouldLoadActors) {
+        loadActorImageUrls();
+    }
+    // It's possible that none of the above items should be loaded.
+    decreaseDownloadCount();
 }
 
 
@@ -94,73 +116,75 @@ void ImdbMovieLoader::loadTags()
 void ImdbMovieLoader::loadActorImageUrls()
 {
     for (int index = 0; index < m_actorUrls.size(); ++index) {
-        m_api.sendGetRequest(
-            Locale("en"), m_actorUrls[index].second, [actorIndex = index, this](QString html, ScraperError error) {
-                if (error.hasError()) {
-                    // TODO
-                    m_scraper.showNetworkError(error);
-                    decreaseDownloadCount();
-                    return;
-                }
-
-                QString url = parseActorImageUrl(html);
-                if (!url.isEmpty()) {
-                    m_actorUrls[actorIndex].first.thumb = url;
-                }
-                decreaseDownloadCount();
-            });
+        m_scraper.loadActorImageUrl(m_actorUrls[index].second, this, [actorIndex = index, this](QString url) {
+            if (!url.isEmpty()) {
+                m_actorUrls[actorIndex].first.thumb = url;
+            }
+            decreaseDownloadCount();
+        });
     }
 }
 
 void ImdbMovieLoader::parseAndAssignInfos(const QString& html)
 {
-    m_scraper.parseAndAssignInfos(html, &m_movie, m_infos);
+    ImdbMovieParser::parseInfos(m_movie, html, m_infos, m_loadAllTags);
 }
 
-void ImdbMovieLoader::parseAndStoreActors(const QString& html)
+void ImdbMovieLoader::storeActors(const QVector<QPair<Actor, QUrl>>& actors)
 {
-    QRegularExpression rx("<table class=\"cast_list\">(.*)</table>",
-        QRegularExpression::DotMatchesEverythingOption | QRegularExpression::InvertedGreedinessOption);
-    QRegularExpressionMatch match = rx.match(html);
-    if (!match.hasMatch()) {
-        return;
+    for (const auto& actorUrl : actors) {
+        m_movie.addActor(actorUrl.first);
+        m_actorUrls.push_back(actorUrl);
     }
+}
 
-    QString content = match.captured(1);
-    rx.setPattern(R"(<tr class="[^"]*">(.*)</tr>)");
+QVector<QPair<Actor, QUrl>> ImdbMovieLoader::parseActors(const QString& html)
+{
+    static const HtmlPattern castListRx(
+        "<table class=\"cast_list\">(.*)</table>", HtmlPattern::Lazy, "<table class=\"cast_list\">");
+    static const HtmlPattern actorRowRx(R"(<tr class="[^"]*">(.*)</tr>)", HtmlPattern::Lazy, R"(<tr class=")");
+    static const HtmlPattern nameRx(
+        R"re(<a href="(/name/[^"]+)"\n\s*>([^<]*)</a>)re", HtmlPattern::Lazy, R"(<a href="/name/)");
+    static const HtmlPattern characterRx(
+        R"(<td class="character">\n\s*(.*)</td>)", HtmlPattern::Lazy, R"(<td class="character">)");
+    static const HtmlPattern roleLinkRx(R"(<a href="[^"]*" >([^<]*)</a>)", HtmlPattern::Lazy, R"(<a href=")");
+    static const HtmlPattern whitespaceRx("[\\s\\n]+");
+    static const HtmlPattern imageRx("<img [^<]*loadlate=\"([^\"]*)\"[^<]* />", HtmlPattern::Lazy, "<img ");
+    static const HtmlPattern thumbRx("https://ia.media-imdb.com/images/(.*)/(.*)._V(.*).jpg", HtmlPattern::Lazy);
+
+    QVector<QPair<Actor, QUrl>> actors;
+    QRegularExpressionMatch match = castListRx.match(html);
+    if (!match.hasMatch()) {
+        return actors;
+    }
 
-    QRegularExpressionMatchIterator actorRowsMatch = rx.globalMatch(content);
+    QRegularExpressionMatchIterator actorRowsMatch = actorRowRx.globalMatch(match.captured(1));
 
     while (actorRowsMatch.hasNext()) {
         QString actorHtml = actorRowsMatch.next().captured(1);
 
         QPair<Actor, QUrl> actorUrl;
 
-        rx.setPattern(R"re(<a href="(/name/[^"]+)"\n\s*>([^<]*)</a>)re");
-        match = rx.match(actorHtml);
+        match = nameRx.match(actorHtml);
         if (match.hasMatch()) {
             actorUrl.second = QUrl("https://www.imdb.com" + match.captured(1));
             actorUrl.first.name = match.captured(2).trimmed();
         }
 
-        rx.setPattern(R"(<td class="character">\n\s*(.*)</td>)");
-        match = rx.match(actorHtml);
+        match = characterRx.match(actorHtml);
         if (match.hasMatch()) {
             QString role = match.captured(1);
-            rx.setPattern(R"(<a href="[^"]*" >([^<]*)</a>)");
-            match = rx.match(role);
+            match = roleLinkRx.match(role);
             if (match.hasMatch()) {
                 role = match.captured(1);
             }
-            actorUrl.first.role = role.trimmed().replace(QRegularExpression("[\\s\\n]+"), " ");
+            actorUrl.first.role = role.trimmed().replace(whitespaceRx.regex(), " ");
         }
 
-        rx.setPattern("<img [^<]*loadlate=\"([^\"]*)\"[^<]* />");
-        match = rx.match(actorHtml);
+        match = imageRx.match(actorHtml);
         if (match.hasMatch()) {
             QString img = match.captured(1);
-            rx.setPattern("https://ia.media-imdb.com/images/(.*)/(.*)._V(.*).jpg");
-            match = rx.match(img);
+            match = thumbRx.match(img);
             if (match.hasMatch()) {
                 actorUrl.first.thumb =
                     "https://ia.media-imdb.com/images/" + match.captured(1) + "/" + match.captured(2) + ".jpg";
@@ -169,23 +193,23 @@ void ImdbMovieLoader::parseAndStoreActors(const QString& html)
             }
         }
 
-        m_movie.addActor(actorUrl.first);
-        m_actorUrls.push_back(actorUrl);
+        actors.push_back(actorUrl);
     }
+    return actors;
 }
 
 QUrl ImdbMovieLoader::parsePosterViewerUrl(const QString& html)
 {
-    QRegularExpression rx("<div class=\"poster\">(.*)</div>",
-        QRegularExpression::DotMatchesEverythingOption | QRegularExpression::InvertedGreedinessOption);
-    QRegularExpressionMatch match = rx.match(html);
-    if (!match.hasMatch()) {
+    static const HtmlPattern posterRx(
+        "<div class=\"poster\">(.*)</div>", HtmlPattern::Lazy, "<div class=\"poster\">");
+    static const HtmlPattern titleLinkRx("<a href=\"/title/(tt[^\"]*)\"", HtmlPattern::Lazy, "<a href=\"/title/");
+
+    const QRegularExpressionMatch posterMatch = posterRx.match(html);
+    if (!posterMatch.hasMatch()) {
         return QUrl();
     }
 
-    const QString content = match.captured(1);
-    rx.setPattern("<a href=\"/title/(tt[^\"]*)\"");
-    match = rx.match(content);
+    const QRegularExpressionMatch match = titleLinkRx.match(posterMatch.captured(1));
     if (!match.hasMatch()) {
         return QUrl();
     }
@@ -195,32 +219,15 @@ QUrl ImdbMovieLoader::parsePosterViewerUrl(const QString& html)
 
 void ImdbMovieLoader::parseAndAssignTags(const QString& html)
 {
-    QRegularExpression rx;
-    rx.setPatternOptions(QRegularExpression::DotMatchesEverythingOption | QRegularExpression::InvertedGreedinessOption);
-    if (m_loadAllTags) {
-        rx.setPattern(R"(<a href="/search/keyword[^"]+"\n?>([^<]+)</a>)");
-    } else {
-        rx.setPattern(R"(<a href="/keyword/[^"]+"[^>]*>([^<]+)</a>)");
+    static const HtmlPattern allTagsRx(
+        R"(<a href="/search/keyword[^"]+"\n?>([^<]+)</a>)", HtmlPattern::Lazy, R"(<a href="/search/keyword)");
+    static const HtmlPattern tagsRx(
+        R"(<a href="/keyword/[^"]+"[^>]*>([^<]+)</a>)", HtmlPattern::Lazy, R"(<a href="/keyword/)");
+
+    const QStringList tags = m_loadAllTags ? allTagsRx.capturedAll(html) : tagsRx.capturedAll(html);
+    for (const QString& tag : tags) {
+        m_movie.addTag(tag.trimmed());
     }
-
-
-    QRegularExpressionMatchIterator match = rx.globalMatch(html);
-    while (match.hasNext()) {
-        m_movie.addTag(match.next().captured(1).trimmed());
-    }
-}
-
-QString ImdbMovieLoader::parseActorImageUrl(const QString& html)
-{
-    QRegularExpression rx(R"re(<link rel=['"]image_src['"] href="([^"]+)">)re", //
-        QRegularExpression::InvertedGreedinessOption);
-
-    QRegularExpressionMatch match = rx.match(html);
-    if (!match.hasMatch()) {
-        return "";
-    }
-
-    return match.captured(1);
 }
 
 void ImdbMovieLoader::mergeActors()
@@ -240,10 +247,11 @@ void ImdbMovieLoader::mergeActors()
 void ImdbMovieLoader::parseAndAssignPoster(const QString& html)
 {
     // There should only be one image like this.
-    QString regex = QStringLiteral(R"url(<img src="(https://m\.media-amazon\.com/[^"]+)" srcSet=")url");
-    QRegularExpression rx(regex, QRegularExpression::InvertedGreedinessOption);
+    static const HtmlPattern posterRx(R"url(<img src="(https://m\.media-amazon\.com/[^"]+)" srcSet=")url",
+        QRegularExpression::InvertedGreedinessOption,
+        R"(<img src="https://m.media-amazon.com/)");
 
-    QRegularExpressionMatch match = rx.match(html);
+    const QRegularExpressionMatch match = posterRx.match(html);
     if (match.hasMatch()) {
         Poster p;
         p.thumbUrl = match.captured(1);
@@ -3,7 +3,6 @@
 #include "data/Storage.h"
 #include "globals/ScraperInfos.h"
 #include "movies/Movie.h"
-#include "network/NetworkManager.h"
 
 #include <QObject>
 #include <QString>
@@ -41,16 +40,19 @@ signals:
     void sigLoadDone(Movie& movie, ImdbMovieLoader* loader);
 
 private:
+    void loadAdditionalPages(const QUrl& posterViewerUrl);
     void loadPoster(const QUrl& posterViewerUrl);
     void loadTags();
     void loadActorImageUrls();
 
     void parseAndAssignInfos(const QString& html);
     void parseAndAssignPoster(const QString& html);
-    void parseAndStoreActors(const QString& html);
-    QUrl parsePosterViewerUrl(const QString& html);
+    void storeActors(const QVector<QPair<Actor, QUrl>>& actors);
     void parseAndAssignTags(const QString& html);
-    QString parseActorImageUrl(const QString& html);
+
+    // Pure extractions that may run in the background
+    static QVector<QPair<Actor, QUrl>> parseActors(const QString& html);
+    static QUrl parsePosterViewerUrl(const QString& html);
 
     void mergeActors();
     void decreaseDownloadCount();
@@ -63,7 +65,6 @@ private:
     ImdbId m_imdbId;
     Movie& m_movie;
     QSet<MovieScraperInfo> m_infos;
-    mediaelch::network::NetworkManager m_network;
     bool m_loadAllTags = false;
 
     QVector<QPair<Actor, QUrl>> m_actorUrls;
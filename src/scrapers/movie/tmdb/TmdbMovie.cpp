@@ -4,6 +4,7 @@
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "log/Log.h"
+#include "scrapers/ScraperError.h"
 #include "scrapers/movie/tmdb/TmdbMovieSearchJob.h"
 #include "settings/Settings.h"
 #include "ui/main/MainWindow.h"
@@ -367,11 +368,10 @@ void TmdbMovie::loadFinished()
         }
 
     } else {
-        showNetworkError(*reply);
         qCWarning(generic) << "Network Error (load)" << reply->errorString();
     }
 
-    movie->controller()->removeFromLoadsLeft(ScraperData::Infos);
+    movie->controller()->removeFromLoadsLeft(ScraperData::Infos, mediaelch::replyToScraperError(*reply));
 }
 
 void TmdbMovie::loadCollection(Movie* movie, const TmdbId& collectionTmdbId)
@@ -439,10 +439,9 @@ void TmdbMovie::loadCastsFinished()
         QString msg = QString::fromUtf8(reply->readAll());
         parseAndAssignInfos(msg, movie, infos);
     } else {
-        showNetworkError(*reply);
         qCWarning(generic) << "Network Error (casts)" << reply->errorString();
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Casts);
+    movie->controller()->removeFromLoadsLeft(ScraperData::Casts, mediaelch::replyToScraperError(*reply));
 }
 
 /**
@@ -463,10 +462,9 @@ void TmdbMovie::loadTrailersFinished()
         const QString msg = QString::fromUtf8(reply->readAll());
         parseAndAssignInfos(msg, movie, infos);
     } else {
-        showNetworkError(*reply);
         qCDebug(generic) << "Network Error (trailers)" << reply->errorString();
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Trailers);
+    movie->controller()->removeFromLoadsLeft(ScraperData::Trailers, mediaelch::replyToScraperError(*reply));
 }
 
 /**
@@ -487,10 +485,9 @@ void TmdbMovie::loadImagesFinished()
         QString msg = QString::fromUtf8(reply->readAll());
         parseAndAssignInfos(msg, movie, infos);
     } else {
-        showNetworkError(*reply);
         qCWarning(generic) << "Network Error (images)" << reply->errorString();
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Images);
+    movie->controller()->removeFromLoadsLeft(ScraperData::Images, mediaelch::replyToScraperError(*reply));
 }
 
 /**
@@ -511,10 +508,9 @@ void TmdbMovie::loadReleasesFinished()
         QString msg = QString::fromUtf8(reply->readAll());
         parseAndAssignInfos(msg, movie, infos);
     } else {
-        showNetworkError(*reply);
         qCWarning(generic) << "Network Error (releases)" << reply->errorString();
     }
-    movie->controller()->removeFromLoadsLeft(ScraperData::Releases);
+    movie->controller()->removeFromLoadsLeft(ScraperData::Releases, mediaelch::replyToScraperError(*reply));
 }
 
 /**
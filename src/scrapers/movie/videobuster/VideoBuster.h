@@ -41,7 +41,6 @@ private:
     VideoBusterApi m_api;
 
 private:
-    void parseAndAssignInfos(const QString& html, Movie* movie, QSet<MovieScraperInfo> infos);
     QString replaceEntities(const QString msg);
 };
 
@@ -4,6 +4,9 @@
 #include "globals/Meta.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "network/RequestCoalescer.h"
+
+#include <QTimer>
 
 namespace mediaelch {
 namespace scraper {
@@ -23,10 +26,18 @@ void VideoBusterApi::sendGetRequest(const QUrl& url, VideoBusterApi::ApiCallback
         return;
     }
 
+    const QString key = WebsiteCache::key(url, Locale::English);
+    auto flight = network::RequestCoalescer<QString, ScraperError>::shared().join(
+        key, std::move(callback), QString(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
+
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, flight, this]() {
         auto dls = makeDeleteLaterScope(reply);
 
         QString data;
@@ -43,7 +54,7 @@ void VideoBusterApi::sendGetRequest(const QUrl& url, VideoBusterApi::ApiCallback
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
-        cb(data, error);
+        flight->finish(data, error);
     });
 }
 
@@ -0,0 +1,238 @@
+#include "scrapers/movie/videobuster/VideoBusterParser.h"
+
+#include "globals/Helper.h"
+#include "log/Log.h"
+#include "movies/Movie.h"
+#include "scrapers/HtmlPattern.h"
+#include "settings/Settings.h"
+
+#include <QTextDocument>
+#include <chrono>
+
+namespace mediaelch {
+namespace scraper {
+
+void VideoBusterParser::parseInfos(Movie& movie, const QString& html, const QSet<MovieScraperInfo>& infos)
+{
+    qCDebug(generic) << "[VideoBuster] Parse and assign movie details";
+    movie.clear(infos);
+
+    static const HtmlPattern titleRx(
+        "<h1 itemprop=\"name\">([^<]*)</h1>", HtmlPattern::Lazy, "<h1 itemprop=\"name\">");
+    static const HtmlPattern originalTitleRx(
+        "<label>Originaltitel</label><br><span itemprop=\"alternateName\">(.*)</span>",
+        HtmlPattern::Lazy,
+        "<label>Originaltitel</label>");
+    static const HtmlPattern yearRx(
+        "<span itemprop=\"copyrightYear\">([0-9]*)</span>", HtmlPattern::Lazy, "<span itemprop=\"copyrightYear\">");
+    static const HtmlPattern countryRx(R"(<label>Produktion</label><br><a href="[^"]*">(.*)</a>)",
+        HtmlPattern::Lazy,
+        "<label>Produktion</label>");
+    // 2016 | FSK 0
+    static const HtmlPattern certificationRx("[0-9]{4} [|] FSK ([0-9]+)", HtmlPattern::Lazy);
+    static const HtmlPattern actorRx("<span itemprop=\"actor\" itemscope itemtype=\"http://schema.org/Person\"><a "
+                                     "href=\"[^\"]*\" itemprop=\"url\"><span itemprop=\"name\">(.*)</span></a></span>",
+        HtmlPattern::Lazy,
+        "<span itemprop=\"actor\"");
+    static const HtmlPattern directorsRx(
+        "<p><label>Regie</label><br>(.*)</p>", HtmlPattern::Lazy, "<p><label>Regie</label>");
+    static const HtmlPattern directorRx(
+        R"(<a href="/persondtl.php/[^"]*">(.*)</a>)", HtmlPattern::Lazy, R"(<a href="/persondtl)");
+    static const HtmlPattern tagsRx("<label>Schlagw&ouml;rter</label><br><span itemprop=\"keywords\">(.*)</span>",
+        HtmlPattern::Lazy,
+        "<label>Schlagw&ouml;rter</label>");
+    static const HtmlPattern tagRx(
+        R"(<a href="/titlesearch.php[^"]*">(.*)</a>)", HtmlPattern::Lazy, R"(<a href="/titlesearch)");
+    static const HtmlPattern studioRx("<label>Studio</label><br><span itemprop=\"publisher\" itemscope "
+                                      "itemtype=\"http://schema.org/Organization\">.*<span "
+                                      "itemprop=\"name\">(.*)</span></a></span>",
+        HtmlPattern::Lazy,
+        "<label>Studio</label>");
+    static const HtmlPattern runtimeRx("ca. ([0-9]*) Minuten", HtmlPattern::Lazy);
+    static const HtmlPattern ratingCountRx(
+        "<span itemprop=\"ratingCount\">([0-9]*)</span>", HtmlPattern::Lazy, "<span itemprop=\"ratingCount\">");
+    static const HtmlPattern ratingValueRx(
+        "<span itemprop=\"ratingValue\">(.*)</span>", HtmlPattern::Lazy, "<span itemprop=\"ratingValue\">");
+    static const HtmlPattern genreRx(
+        R"(<a href="/genrelist\.php/.*">(.*)</a>)", HtmlPattern::Lazy, R"(<a href="/genrelist)");
+    static const HtmlPattern taglineRx(R"(<p class="long_name" itemprop="alternativeHeadline">(.*)</p>)",
+        HtmlPattern::Lazy,
+        R"(<p class="long_name" itemprop="alternativeHeadline">)");
+    static const HtmlPattern overviewRx(
+        "<p itemprop=\"description\">(.*)</p>", HtmlPattern::Lazy, "<p itemprop=\"description\">");
+    static const HtmlPattern postersRx("<h3>Poster</h3><ul class=\"gallery_box  posters\">(.*)</ul>",
+        HtmlPattern::Lazy,
+        "<h3>Poster</h3>");
+    static const HtmlPattern posterRx("<a href=\"https://gfx.videobuster.de/archive/([^\"]*)\" data-title=\"[^\"]*\" "
+                                      "rel=\"gallery_posters\" target=\"_blank\" class=\"image\">",
+        HtmlPattern::Lazy,
+        "<a href=\"https://gfx");
+    static const HtmlPattern backdropsRx("<h3>Szenenbilder</h3><ul class=\"gallery_box  pictures\">(.*)</ul>",
+        HtmlPattern::Lazy,
+        "<h3>Szenenbilder</h3>");
+    static const HtmlPattern backdropRx("<a href=\"https://gfx.videobuster.de/archive/([^\"]*)\" data-title=\"[^\"]*\" "
+                                        "rel=\"gallery_pictures\" target=\"_blank\" class=\"image\">",
+        HtmlPattern::Lazy,
+        "<a href=\"https://gfx");
+
+    QRegularExpressionMatch match;
+
+    QTextDocument doc;
+
+    // Title
+    if (infos.contains(MovieScraperInfo::Title)) {
+        match = titleRx.match(html);
+        if (match.hasMatch()) {
+            movie.setName(match.captured(1).trimmed());
+        }
+        // Original Title
+        match = originalTitleRx.match(html);
+        if (match.hasMatch()) {
+            movie.setOriginalName(match.captured(1).trimmed());
+        }
+    }
+
+    // Year
+    if (infos.contains(MovieScraperInfo::Released)) {
+        match = yearRx.match(html);
+        if (match.hasMatch()) {
+            movie.setReleased(QDate::fromString(match.captured(1).trimmed(), "yyyy"));
+        }
+    }
+
+    // Country
+    if (infos.contains(MovieScraperInfo::Countries)) {
+        for (const QString& country : countryRx.capturedAll(html)) {
+            movie.addCountry(helper::mapCountry(country.trimmed()));
+        }
+    }
+
+    // MPAA
+    if (infos.contains(MovieScraperInfo::Certification)) {
+        match = certificationRx.match(html);
+        if (match.hasMatch()) {
+            movie.setCertification(helper::mapCertification(Certification::FSK(match.captured(1))));
+        }
+    }
+
+    // Actors
+
+    // clear actors
+    movie.setActors({});
+
+    if (infos.contains(MovieScraperInfo::Actors)) {
+        for (const QString& name : actorRx.capturedAll(html)) {
+            Actor a;
+            a.name = name.trimmed();
+            movie.addActor(a);
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Director)) {
+        match = directorsRx.match(html);
+        if (match.hasMatch()) {
+            QStringList directors;
+            for (const QString& director : directorRx.capturedAll(match.captured(1))) {
+                directors.append(director.trimmed());
+            }
+            movie.setDirector(directors.join(", "));
+        }
+    }
+
+    if (infos.contains(MovieScraperInfo::Tags)) {
+        match = tagsRx.match(html);
+        if (match.hasMatch()) {
+            for (const QString& tag : tagRx.capturedAll(match.captured(1))) {
+                movie.addTag(tag.trimmed());
+            }
+        }
+    }
+
+    // Studio
+    if (infos.contains(MovieScraperInfo::Studios)) {
+        match = studioRx.match(html);
+        if (match.hasMatch()) {
+            movie.addStudio(helper::mapStudio(match.captured(1).trimmed()));
+        }
+    }
+
+    // Runtime
+    if (infos.contains(MovieScraperInfo::Runtime)) {
+        match = runtimeRx.match(html);
+        if (match.hasMatch()) {
+            movie.setRuntime(std::chrono::minutes(match.captured(1).trimmed().toInt()));
+        }
+    }
+
+    // Rating
+    if (infos.contains(MovieScraperInfo::Rating)) {
+        Rating rating;
+        rating.source = "VideoBuster";
+        match = ratingCountRx.match(html);
+        if (match.hasMatch()) {
+            rating.voteCount = match.captured(1).trimmed().toInt();
+        }
+
+        match = ratingValueRx.match(html);
+        if (match.hasMatch()) {
+            rating.rating = match.captured(1).trimmed().replace(".", "").replace(",", ".").toDouble();
+        }
+        movie.ratings().setOrAddRating(rating);
+    }
+
+    // Genres
+    if (infos.contains(MovieScraperInfo::Genres)) {
+        for (const QString& genre : genreRx.capturedAll(html)) {
+            movie.addGenre(helper::mapGenre(genre.trimmed()));
+        }
+    }
+
+    // Tagline
+    if (infos.contains(MovieScraperInfo::Tagline)) {
+        match = taglineRx.match(html);
+        if (match.hasMatch()) {
+            movie.setTagline(match.captured(1).trimmed());
+        }
+    }
+
+    // Overview
+    if (infos.contains(MovieScraperInfo::Overview)) {
+        match = overviewRx.match(html);
+        if (match.hasMatch()) {
+            doc.setHtml(match.captured(1).trimmed());
+            movie.setOverview(doc.toPlainText());
+            if (Settings::instance()->usePlotForOutline()) {
+                movie.setOutline(doc.toPlainText());
+            }
+        }
+    }
+
+    // Posters
+    if (infos.contains(MovieScraperInfo::Poster)) {
+        match = postersRx.match(html);
+        if (match.hasMatch()) {
+            for (const QString& path : posterRx.capturedAll(match.captured(1))) {
+                Poster p;
+                p.thumbUrl = "https://gfx.videobuster.de/archive/" + path;
+                p.originalUrl = "https://gfx.videobuster.de/archive/" + path;
+                movie.images().addPoster(p);
+            }
+        }
+    }
+
+    // Backdrops
+    if (infos.contains(MovieScraperInfo::Backdrop)) {
+        match = backdropsRx.match(html);
+        if (match.hasMatch()) {
+            for (const QString& path : backdropRx.capturedAll(match.captured(1))) {
+                Poster p;
+                p.thumbUrl = "https://gfx.videobuster.de/archive/" + path;
+                p.originalUrl = "https://gfx.videobuster.de/archive/" + path;
+                movie.images().addBackdrop(p);
+            }
+        }
+    }
+}
+
+} // namespace scraper
+} // namespace mediaelch
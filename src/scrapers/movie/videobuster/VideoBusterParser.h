@@ -0,0 +1,24 @@
+#pragma once
+
+#include "globals/ScraperInfos.h"
+
+#include <QSet>
+#include <QString>
+
+class Movie;
+
+namespace mediaelch {
+namespace scraper {
+
+class VideoBusterParser
+{
+public:
+    /// \brief Parse the given HTML string and assign the requested details to the given movie.
+    /// \param movie Where to store the movie details into.
+    /// \param html HTML string of a movie page from videobuster.de
+    /// \param infos Details to assign. Others are not touched.
+    static void parseInfos(Movie& movie, const QString& html, const QSet<MovieScraperInfo>& infos);
+};
+
+} // namespace scraper
+} // namespace mediaelch
@@ -4,16 +4,28 @@
 #include "log/Log.h"
 #include "music/Album.h"
 #include "network/NetworkRequest.h"
+#include "network/RateLimiter.h"
+#include "network/RequestCoalescer.h"
 #include "scrapers/music/UniversalMusicScraper.h"
 
 #include <QDomDocument>
 #include <QJsonDocument>
+#include <QTimer>
 
 namespace mediaelch {
 namespace scraper {
 
 MusicBrainzApi::MusicBrainzApi(QObject* parent) : QObject(parent)
 {
+    // MusicBrainz blocks clients that send more than one request per second on average.
+    // See https://musicbrainz.org/doc/MusicBrainz_API/Rate_Limiting
+    // The limit is shared by all requests to musicbrainz.org, including the wikipedia
+    // extracts that UniversalMusicScraper loads.
+    network::RateLimiter::Limits limits;
+    limits.requestsPerSecond = 1.0;
+    limits.burst = 1;
+    limits.maxConcurrent = 1;
+    network::RateLimiter::instance()->setLimits(QStringLiteral("musicbrainz.org"), limits);
 }
 
 void MusicBrainzApi::sendGetRequest(const Locale& locale, const QUrl& url, MusicBrainzApi::ApiCallback callback)
@@ -27,27 +39,36 @@ void MusicBrainzApi::sendGetRequest(const Locale& locale, const QUrl& url, Music
         return;
     }
 
-    QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    const QString key = WebsiteCache::key(url, locale);
+    auto flight = network::RequestCoalescer<QString, ScraperError>::shared().join(
+        key, std::move(callback), QString(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
 
-    QNetworkReply* reply = m_network.getWithWatcher(request);
+    QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
-        auto dls = makeDeleteLaterScope(reply);
+    m_network.getWithWatcherRateLimited(request, [flight, locale, this](QNetworkReply* reply) {
+        connect(reply, &QNetworkReply::finished, this, [reply, flight, locale, this]() {
+            auto dls = makeDeleteLaterScope(reply);
 
-        QString data;
-        if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            QString data;
+            if (reply->error() == QNetworkReply::NoError) {
+                data = QString::fromUtf8(reply->readAll());
 
-        } else {
-            qCWarning(generic) << "[MusicBrainz] Network Error:" << reply->errorString() << "for URL" << reply->url();
-        }
+            } else {
+                qCWarning(generic) << "[MusicBrainz] Network Error:" << reply->errorString() << "for URL"
+                                   << reply->url();
+            }
 
-        if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), locale, data);
-        }
+            if (!data.isEmpty()) {
+                m_cache.addElement(reply->url(), locale, data);
+            }
 
-        ScraperError error = makeScraperError(data, *reply, {});
-        cb(data, error);
+            ScraperError error = makeScraperError(data, *reply, {});
+            flight->finish(data, error);
+        });
     });
 }
 
@@ -0,0 +1,47 @@
+#include "scrapers/music/MusicElementDownloads.h"
+
+namespace mediaelch {
+namespace scraper {
+
+quint64 MusicElementDownloads::start(const QObject* item, QSet<MusicScraperInfo> infos, QVector<Element> elements)
+{
+    Load load;
+    load.id = ++m_lastLoadId;
+    load.infos = std::move(infos);
+    load.elements = std::move(elements);
+    load.remaining = load.elements.size();
+    m_loads.insert(item, load);
+    return load.id;
+}
+
+bool MusicElementDownloads::store(const QObject* item, quint64 loadId, int index, QString contents)
+{
+    auto load = m_loads.find(item);
+    if (load == m_loads.end() || load->id != loadId || index < 0 || index >= load->elements.size()) {
+        return false;
+    }
+    Element& element = load->elements[index];
+    if (element.downloaded) {
+        return false;
+    }
+    element.contents = std::move(contents);
+    element.downloaded = true;
+    --load->remaining;
+    return load->remaining == 0;
+}
+
+MusicElementDownloads::Load MusicElementDownloads::take(const QObject* item)
+{
+    return m_loads.take(item);
+}
+
+void MusicElementDownloads::remove(const QObject* item, quint64 loadId)
+{
+    auto load = m_loads.find(item);
+    if (load != m_loads.end() && load->id == loadId) {
+        m_loads.erase(load);
+    }
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "globals/ScraperInfos.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief Download elements of the artists or albums that UniversalMusicScraper loads.
+///
+/// Each loadData() call starts a load with a new id that replaces a previous load of the
+/// same item.  Replies are mapped to their element by the load id and the element's index
+/// that were captured when the request was sent, so that replies don't have to be matched
+/// by their URL and replies of a replaced load are discarded.
+class MusicElementDownloads
+{
+public:
+    struct Element
+    {
+        QString source;
+        QString type;
+        QUrl url;
+        bool downloaded = false;
+        QString contents;
+    };
+
+    struct Load
+    {
+        quint64 id = 0;
+        QSet<MusicScraperInfo> infos;
+        QVector<Element> elements;
+        /// Number of elements that aren't downloaded, yet.
+        int remaining = 0;
+    };
+
+    /// \brief Starts a load of the item's elements that replaces any previous load of the item.
+    /// \return The new load's id.
+    quint64 start(const QObject* item, QSet<MusicScraperInfo> infos, QVector<Element> elements);
+    /// \brief Stores the contents of the element with the given index of the item's load.
+    /// \return True if it was the load's last element, which can then be taken with take().
+    ///         False if elements are still missing or if the load was replaced or removed.
+    bool store(const QObject* item, quint64 loadId, int index, QString contents);
+    /// \brief Removes the item's load and returns it.
+    Load take(const QObject* item);
+    /// \brief Removes the item's load, unless it was replaced by a load with another id.
+    void remove(const QObject* item, quint64 loadId);
+    bool isLoading(const QObject* item) const { return m_loads.contains(item); }
+
+private:
+    QHash<const QObject*, Load> m_loads;
+    quint64 m_lastLoadId = 0;
+};
+
+} // namespace scraper
+} // namespace mediaelch
@@ -10,6 +10,7 @@
 #include <QString>
 #include <QVector>
 #include <QWidget>
+#include <functional>
 
 class Album;
 class Artist;
@@ -22,10 +23,17 @@ class MusicScraper : public QObject, public ScraperInterface
     Q_OBJECT
 
 public:
+    using SearchCallback = std::function<void(QVector<ScraperSearchResult>)>;
+
     virtual QString name() const = 0;
     virtual QString identifier() const = 0;
     virtual void searchAlbum(QString artistName, QString searchStr) = 0;
     virtual void searchArtist(QString searchStr) = 0;
+    /// \brief Same as searchAlbum(QString, QString) but passes the results to the callback
+    ///        instead of emitting sigSearchDone(), so that several searches can run at once.
+    virtual void searchAlbum(QString artistName, QString searchStr, SearchCallback callback) = 0;
+    /// \brief Same as searchArtist(QString) but passes the results to the callback.
+    virtual void searchArtist(QString searchStr, SearchCallback callback) = 0;
     virtual void loadData(MusicBrainzId id, Artist* artist, QSet<MusicScraperInfo> infos) = 0;
     virtual void loadData(MusicBrainzId id, MusicBrainzId id2, Album* album, QSet<MusicScraperInfo> infos) = 0;
     virtual QSet<MusicScraperInfo> scraperSupports() = 0;
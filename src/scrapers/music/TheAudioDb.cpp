@@ -5,9 +5,11 @@
 #include "music/Album.h"
 #include "music/Artist.h"
 #include "network/NetworkRequest.h"
+#include "network/RequestCoalescer.h"
 #include "scrapers/music/UniversalMusicScraper.h"
 
 #include <QJsonArray>
+#include <QTimer>
 
 namespace mediaelch {
 namespace scraper {
@@ -27,11 +29,19 @@ void TheAudioDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheAud
         return;
     }
 
+    const QString key = WebsiteCache::key(url, locale);
+    auto flight = network::RequestCoalescer<QString, ScraperError>::shared().join(
+        key, std::move(callback), QString(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
+
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
 
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, flight, locale, this]() {
         auto dls = makeDeleteLaterScope(reply);
 
         QString data;
@@ -47,7 +57,7 @@ void TheAudioDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheAud
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
-        cb(data, error);
+        flight->finish(data, error);
     });
 }
 
@@ -1,6 +1,6 @@
 #include "UniversalMusicScraper.h"
 
-#include "data/Storage.h"
+#include "network/RateLimiter.h"
 #include "ui/main/MainWindow.h"
 
 #include <QDomDocument>
@@ -11,15 +11,47 @@
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QLabel>
-#include <QMutexLocker>
 #include <QRegularExpression>
 
+namespace {
+
+/// \brief Sets the limits of the sites that are loaded for each artist and album.
+/// MusicBrainz's limit is set by MusicBrainzApi.
+void setProviderLimits()
+{
+    using mediaelch::network::RateLimiter;
+
+    // Discogs allows 25 requests per minute for unauthenticated clients.
+    RateLimiter::Limits discogs;
+    discogs.requestsPerSecond = 25.0 / 60.0;
+    discogs.burst = 5;
+    discogs.maxConcurrent = 2;
+    RateLimiter::instance()->setLimits(QStringLiteral("www.discogs.com"), discogs);
+
+    // TheAudioDb allows 30 requests per minute with the free API key.
+    RateLimiter::Limits theAudioDb;
+    theAudioDb.requestsPerSecond = 0.5;
+    theAudioDb.burst = 5;
+    theAudioDb.maxConcurrent = 2;
+    RateLimiter::instance()->setLimits(QStringLiteral("www.theaudiodb.com"), theAudioDb);
+
+    // AllMusic has no documented limit, but its pages are large.
+    RateLimiter::Limits allMusic;
+    allMusic.requestsPerSecond = 4.0;
+    allMusic.burst = 4;
+    allMusic.maxConcurrent = 4;
+    RateLimiter::instance()->setLimits(QStringLiteral("www.allmusic.com"), allMusic);
+}
+
+} // namespace
+
 namespace mediaelch {
 namespace scraper {
 
 UniversalMusicScraper::UniversalMusicScraper(QObject* parent)
 {
     setParent(parent);
+    setProviderLimits();
 
     m_language = "en";
     m_prefer = "theaudiodb";
@@ -72,9 +104,16 @@ QString UniversalMusicScraper::identifier() const
 
 void UniversalMusicScraper::searchArtist(QString searchStr)
 {
-    m_musicBrainzApi.searchForArtist(m_language, searchStr, [this](QString html, ScraperError error) {
+    searchArtist(std::move(searchStr), [this](QVector<ScraperSearchResult> results) { //
+        emit sigSearchDone(results);
+    });
+}
+
+void UniversalMusicScraper::searchArtist(QString searchStr, SearchCallback callback)
+{
+    m_musicBrainzApi.searchForArtist(m_language, searchStr, [callback](QString html, ScraperError error) {
         if (error.hasError()) {
-            emit sigSearchDone({});
+            callback({});
             return;
         }
 
@@ -99,7 +138,7 @@ void UniversalMusicScraper::searchArtist(QString searchStr)
             }
         }
 
-        emit sigSearchDone(results);
+        callback(results);
     });
 }
 
@@ -132,112 +171,79 @@ void UniversalMusicScraper::loadData(MusicBrainzId mbId, Artist* artist, QSet<Mu
             }
         }
 
-        if (!m_artistDownloads.contains(artist)) {
-            m_artistDownloads.insert(artist, QVector<DownloadElement>());
-        }
-        m_artistDownloads[artist].clear();
-
+        QVector<DownloadElement> elements;
         const auto& artistMbId = artist->mbId();
 
         // TODO: Use their API
         // https://wiki.musicbrainz.org/MusicBrainz_API
-        appendDownloadElement(artist,
+        appendDownloadElement(elements,
             "musicbrainz",
             "musicbrainz_biography",
             QUrl(QStringLiteral("https://musicbrainz.org/artist/%1/wikipedia-extract").arg(artistMbId.toString())));
 
-        appendDownloadElement(artist, "theaudiodb", "tadb_data", m_theAudioDbApi.makeArtistUrl(artistMbId));
+        appendDownloadElement(elements, "theaudiodb", "tadb_data", m_theAudioDbApi.makeArtistUrl(artistMbId));
         appendDownloadElement(
-            artist, "theaudiodb", "tadb_discography", m_theAudioDbApi.makeArtistDiscographyUrl(artistMbId));
+            elements, "theaudiodb", "tadb_discography", m_theAudioDbApi.makeArtistDiscographyUrl(artistMbId));
 
         if (artist->allMusicId().isValid()) {
             const auto& amId = artist->allMusicId();
-            appendDownloadElement(artist, "allmusic", "am_data", m_allMusicApi.makeArtistUrl(amId));
-            appendDownloadElement(artist, "allmusic", "am_biography", m_allMusicApi.makeArtistBiographyUrl(amId));
+            appendDownloadElement(elements, "allmusic", "am_data", m_allMusicApi.makeArtistUrl(amId));
+            appendDownloadElement(elements, "allmusic", "am_biography", m_allMusicApi.makeArtistBiographyUrl(amId));
         }
         if (!discogsUrl.isEmpty()) {
             appendDownloadElement(
-                artist, "discogs", "discogs_data", QUrl(discogsUrl + "?type=Releases&subtype=Albums"));
+                elements, "discogs", "discogs_data", QUrl(discogsUrl + "?type=Releases&subtype=Albums"));
         }
 
-        for (const DownloadElement& elem : asConst(m_artistDownloads[artist])) {
-            QNetworkRequest request(elem.url);
-            request.setRawHeader(
-                "User-Agent", "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_10; rv:33.0) Gecko/20100101 Firefox/33.0");
-            if (elem.source == "musicbrainz") {
-                request.setRawHeader("Accept-Language", m_language.toUtf8());
-            }
-
-            QNetworkReply* elemReply = network()->getWithWatcher(request);
-            elemReply->setProperty("storage", Storage::toVariant(elemReply, artist));
-            elemReply->setProperty("infosToLoad", Storage::toVariant(elemReply, infos));
-            connect(elemReply, &QNetworkReply::finished, this, &UniversalMusicScraper::onArtistLoadFinished);
+        // Replaces the downloads of a previous call for the same artist.
+        const quint64 loadId = m_artistDownloads.start(artist, infos, elements);
+
+        // Each request waits for its site's rate limit, so elements of other sites are
+        // loaded while e.g. MusicBrainz is throttled.  The element's index is passed along
+        // so that replies don't have to be matched by their URL.
+        const QPointer<Artist> guard(artist);
+        for (int i = 0, n = elements.size(); i < n; ++i) {
+            network()->getWithWatcherRateLimited(
+                elementRequest(elements.at(i)), [this, artist, guard, loadId, i](QNetworkReply* reply) {
+                    connect(reply, &QNetworkReply::finished, this, [this, artist, guard, loadId, i, reply]() {
+                        onArtistElementFinished(artist, guard, loadId, i, reply);
+                    });
+                });
         }
     });
 }
 
-void UniversalMusicScraper::onArtistLoadFinished()
+void UniversalMusicScraper::onArtistElementFinished(Artist* artist,
+    const QPointer<Artist>& guard,
+    quint64 loadId,
+    int index,
+    QNetworkReply* reply)
 {
-    QMutexLocker locker(&m_artistMutex);
-
-    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    Artist* artist = reply->property("storage").value<Storage*>()->artist();
-    QSet<MusicScraperInfo> infos = reply->property("infosToLoad").value<Storage*>()->musicInfosToLoad();
     reply->deleteLater();
 
-    if (artist == nullptr) {
-        return;
-    }
-
-    if (!m_artistDownloads.contains(artist)) {
+    if (guard.isNull()) {
+        m_artistDownloads.remove(artist, loadId);
         return;
     }
-
-    int index = -1;
-    for (int i = 0, n = m_artistDownloads[artist].count(); i < n; ++i) {
-        if (m_artistDownloads[artist][i].url == reply->url()) {
-            index = i;
-            break;
-        }
-    }
-
-    if (index == -1) {
+    // Also false if the artist was loaded again in the meantime.
+    if (!m_artistDownloads.store(artist, loadId, index, elementContents(reply))) {
         return;
     }
 
-    if (reply->error() == QNetworkReply::NoError) {
-        m_artistDownloads[artist][index].contents = QString::fromUtf8(reply->readAll());
-    } else {
-        qCWarning(generic) << "Network Error (load)" << reply->errorString();
-    }
-    m_artistDownloads[artist][index].downloaded = true;
-
-    bool finished = true;
-    for (int i = 0, n = m_artistDownloads[artist].count(); i < n; ++i) {
-        if (!m_artistDownloads[artist][i].downloaded) {
-            finished = false;
-            break;
-        }
-    }
-
-    if (!finished) {
-        return;
-    }
-
-    for (const DownloadElement& elem : asConst(m_artistDownloads[artist])) {
+    const MusicElementDownloads::Load finished = m_artistDownloads.take(artist);
+    for (const DownloadElement& elem : finished.elements) {
         if (elem.source != m_prefer) {
             continue;
         }
-        processDownloadElement(elem, artist, infos);
+        processDownloadElement(elem, artist, finished.infos);
     }
-    for (const DownloadElement& elem : asConst(m_artistDownloads[artist])) {
+    for (const DownloadElement& elem : finished.elements) {
         if (elem.source == m_prefer) {
             continue;
         }
-        processDownloadElement(elem, artist, infos);
+        processDownloadElement(elem, artist, finished.infos);
     }
 
-    m_artistDownloads.remove(artist);
     artist->controller()->scraperLoadDone(this);
 }
 
@@ -268,6 +274,13 @@ void UniversalMusicScraper::processDownloadElement(DownloadElement elem, Artist*
 }
 
 void UniversalMusicScraper::searchAlbum(QString artistName, QString searchStr)
+{
+    searchAlbum(std::move(artistName), std::move(searchStr), [this](QVector<ScraperSearchResult> results) {
+        emit sigSearchDone(results);
+    });
+}
+
+void UniversalMusicScraper::searchAlbum(QString artistName, QString searchStr, SearchCallback callback)
 {
     QString year;
     QString cleanSearchStr = searchStr;
@@ -296,9 +309,9 @@ void UniversalMusicScraper::searchAlbum(QString artistName, QString searchStr)
         cleanSearchStr = searchStr;
     }
 
-    const auto callback = [this](QString html, ScraperError error) {
+    const auto parseResults = [callback](QString html, ScraperError error) {
         if (error.hasError()) {
-            emit sigSearchDone({});
+            callback({});
             return;
         }
 
@@ -362,13 +375,13 @@ void UniversalMusicScraper::searchAlbum(QString artistName, QString searchStr)
             results.append(result);
         }
 
-        emit sigSearchDone(results);
+        callback(results);
     };
 
     if (artistName.isEmpty()) {
-        m_musicBrainzApi.searchForAlbum(m_language, cleanSearchStr, callback);
+        m_musicBrainzApi.searchForAlbum(m_language, cleanSearchStr, parseResults);
     } else {
-        m_musicBrainzApi.searchForAlbumWithArtist(m_language, cleanSearchStr, artistName, callback);
+        m_musicBrainzApi.searchForAlbumWithArtist(m_language, cleanSearchStr, artistName, parseResults);
     }
 }
 
@@ -403,101 +416,91 @@ void UniversalMusicScraper::loadData(MusicBrainzId mbAlbumId,
             }
         }
 
-        if (!m_albumDownloads.contains(album)) {
-            m_albumDownloads.insert(album, QVector<DownloadElement>());
-        }
-        m_albumDownloads[album].clear();
-
-        appendDownloadElement(album,
+        QVector<DownloadElement> elements;
+        appendDownloadElement(elements,
             "theaudiodb",
             "tadb_data",
             QUrl(QString("https://www.theaudiodb.com/api/v1/json/%1/album-mb.php?i=%2")
                      .arg(m_tadbApiKey, album->mbReleaseGroupId().toString())));
         if (album->allMusicId().isValid()) {
-            appendDownloadElement(album,
+            appendDownloadElement(elements,
                 "allmusic",
                 "am_data",
                 QString("https://www.allmusic.com/album/%1").arg(album->allMusicId().toString()));
         }
         if (!discogsUrl.isEmpty()) {
-            appendDownloadElement(album, "discogs", "discogs_data", QUrl(discogsUrl));
+            appendDownloadElement(elements, "discogs", "discogs_data", QUrl(discogsUrl));
         }
 
-        for (const DownloadElement& elem : asConst(m_albumDownloads[album])) {
-            QNetworkRequest request(elem.url);
-            request.setRawHeader(
-                "User-Agent", "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_10; rv:33.0) Gecko/20100101 Firefox/33.0");
-            QNetworkReply* elemReply = network()->getWithWatcher(request);
-            elemReply->setProperty("storage", Storage::toVariant(elemReply, album));
-            elemReply->setProperty("infosToLoad", Storage::toVariant(elemReply, infos));
-            connect(elemReply, &QNetworkReply::finished, this, &UniversalMusicScraper::onAlbumLoadFinished);
+        // Replaces the downloads of a previous call for the same album.
+        const quint64 loadId = m_albumDownloads.start(album, infos, elements);
+
+        const QPointer<Album> guard(album);
+        for (int i = 0, n = elements.size(); i < n; ++i) {
+            network()->getWithWatcherRateLimited(
+                elementRequest(elements.at(i)), [this, album, guard, loadId, i](QNetworkReply* reply) {
+                    connect(reply, &QNetworkReply::finished, this, [this, album, guard, loadId, i, reply]() {
+                        onAlbumElementFinished(album, guard, loadId, i, reply);
+                    });
+                });
         }
     });
 }
 
-void UniversalMusicScraper::onAlbumLoadFinished()
+void UniversalMusicScraper::onAlbumElementFinished(Album* album,
+    const QPointer<Album>& guard,
+    quint64 loadId,
+    int index,
+    QNetworkReply* reply)
 {
-    QMutexLocker locker(&m_albumMutex);
-
-    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
-    Album* album = reply->property("storage").value<Storage*>()->album();
-    QSet<MusicScraperInfo> infos = reply->property("infosToLoad").value<Storage*>()->musicInfosToLoad();
     reply->deleteLater();
-    if (album == nullptr) {
-        return;
-    }
 
-    if (!m_albumDownloads.contains(album)) {
+    if (guard.isNull()) {
+        m_albumDownloads.remove(album, loadId);
         return;
     }
-
-    int index = -1;
-    for (int i = 0, n = m_albumDownloads[album].count(); i < n; ++i) {
-        if (m_albumDownloads[album][i].url == reply->url()) {
-            index = i;
-            break;
-        }
-    }
-    if (index == -1) {
-        return;
-    }
-
-    if (reply->error() == QNetworkReply::NoError) {
-        m_albumDownloads[album][index].contents = QString::fromUtf8(reply->readAll());
-    } else {
-        qCWarning(generic) << "Network Error (load)" << reply->errorString();
-    }
-    m_albumDownloads[album][index].downloaded = true;
-
-    bool finished = true;
-    for (int i = 0, n = m_albumDownloads[album].count(); i < n; ++i) {
-        if (!m_albumDownloads[album][i].downloaded) {
-            finished = false;
-            break;
-        }
-    }
-
-    if (!finished) {
+    // Also false if the album was loaded again in the meantime.
+    if (!m_albumDownloads.store(album, loadId, index, elementContents(reply))) {
         return;
     }
 
-    for (const DownloadElement& elem : asConst(m_albumDownloads[album])) {
+    const MusicElementDownloads::Load finished = m_albumDownloads.take(album);
+    for (const DownloadElement& elem : finished.elements) {
         if (elem.source != m_prefer) {
             continue;
         }
-        processDownloadElement(elem, album, infos);
+        processDownloadElement(elem, album, finished.infos);
     }
-    for (const DownloadElement& elem : asConst(m_albumDownloads[album])) {
+    for (const DownloadElement& elem : finished.elements) {
         if (elem.source == m_prefer) {
             continue;
         }
-        processDownloadElement(elem, album, infos);
+        processDownloadElement(elem, album, finished.infos);
     }
 
-    m_albumDownloads.remove(album);
     album->controller()->scraperLoadDone(this);
 }
 
+QString UniversalMusicScraper::elementContents(QNetworkReply* reply)
+{
+    if (reply->error() != QNetworkReply::NoError) {
+        qCWarning(generic) << "Network Error (load)" << reply->errorString();
+        return {};
+    }
+    return QString::fromUtf8(reply->readAll());
+}
+
+QNetworkRequest UniversalMusicScraper::elementRequest(const DownloadElement& elem) const
+{
+    QNetworkRequest request(elem.url);
+    request.setRawHeader(
+        "User-Agent", "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_10; rv:33.0) Gecko/20100101 Firefox/33.0");
+    if (elem.source == "musicbrainz") {
+        request.setRawHeader("Accept-Language", m_language.toUtf8());
+    }
+    return request;
+}
+
 void UniversalMusicScraper::processDownloadElement(DownloadElement elem, Album* album, QSet<MusicScraperInfo> infos)
 {
     if (elem.type == "tadb_data") {
@@ -653,30 +656,17 @@ bool UniversalMusicScraper::infosLeft(QSet<MusicScraperInfo> infos, Artist* arti
     return false;
 }
 
-void UniversalMusicScraper::appendDownloadElement(Artist* artist, QString source, QString type, QUrl url)
+void UniversalMusicScraper::appendDownloadElement(QVector<DownloadElement>& elements,
+    QString source,
+    QString type,
+    QUrl url)
 {
     DownloadElement elem;
     elem.type = type;
     elem.url = url;
     elem.downloaded = false;
     elem.source = source;
-    if (!m_artistDownloads.contains(artist)) {
-        m_artistDownloads.insert(artist, QVector<DownloadElement>());
-    }
-    m_artistDownloads[artist].append(elem);
-}
-
-void UniversalMusicScraper::appendDownloadElement(Album* album, QString source, QString type, QUrl url)
-{
-    DownloadElement elem;
-    elem.type = type;
-    elem.url = url;
-    elem.downloaded = false;
-    elem.source = source;
-    if (!m_albumDownloads.contains(album)) {
-        m_albumDownloads.insert(album, QVector<DownloadElement>());
-    }
-    m_albumDownloads[album].append(elem);
+    elements.append(elem);
 }
 
 } // namespace scraper
@@ -6,12 +6,15 @@
 #include "scrapers/music/AllMusic.h"
 #include "scrapers/music/Discogs.h"
 #include "scrapers/music/MusicBrainz.h"
+#include "scrapers/music/MusicElementDownloads.h"
 #include "scrapers/music/MusicScraper.h"
 #include "scrapers/music/TheAudioDb.h"
 
 #include <QComboBox>
-#include <QMutex>
+#include <QHash>
+#include <QNetworkReply>
 #include <QObject>
+#include <QPointer>
 #include <QWidget>
 
 namespace mediaelch {
@@ -28,6 +31,8 @@ public:
     QString identifier() const override;
     void searchAlbum(QString artistName, QString searchStr) override;
     void searchArtist(QString searchStr) override;
+    void searchAlbum(QString artistName, QString searchStr, SearchCallback callback) override;
+    void searchArtist(QString searchStr, SearchCallback callback) override;
     void loadData(MusicBrainzId mbId, Artist* artist, QSet<MusicScraperInfo> infos) override;
     void loadData(MusicBrainzId mbAlbumId,
         MusicBrainzId mbReleaseGroupId,
@@ -45,19 +50,21 @@ public:
     /// \todo Remove
     static bool shouldLoad(MusicScraperInfo info, QSet<MusicScraperInfo> infos, Album* album);
 
-private slots:
-    void onArtistLoadFinished();
-    void onAlbumLoadFinished();
-
 private:
-    struct DownloadElement
-    {
-        QString source;
-        QString type;
-        QUrl url;
-        bool downloaded;
-        QString contents;
-    };
+    using DownloadElement = MusicElementDownloads::Element;
+
+    void onArtistElementFinished(Artist* artist,
+        const QPointer<Artist>& guard,
+        quint64 loadId,
+        int index,
+        QNetworkReply* reply);
+    void onAlbumElementFinished(Album* album,
+        const QPointer<Album>& guard,
+        quint64 loadId,
+        int index,
+        QNetworkReply* reply);
+    static QString elementContents(QNetworkReply* reply);
+    QNetworkRequest elementRequest(const DownloadElement& elem) const;
 
     QString m_tadbApiKey;
     mediaelch::network::NetworkManager m_network;
@@ -66,10 +73,8 @@ private:
     QWidget* m_widget;
     QComboBox* m_box;
     QComboBox* m_preferBox;
-    QMap<Artist*, QVector<DownloadElement>> m_artistDownloads;
-    QMap<Album*, QVector<DownloadElement>> m_albumDownloads;
-    QMutex m_artistMutex;
-    QMutex m_albumMutex;
+    MusicElementDownloads m_artistDownloads;
+    MusicElementDownloads m_albumDownloads;
 
     mediaelch::scraper::MusicBrainzApi m_musicBrainzApi;
     mediaelch::scraper::MusicBrainz m_musicBrainz;
@@ -84,8 +89,7 @@ private:
 
     bool infosLeft(QSet<MusicScraperInfo> infos, Artist* artist);
     bool infosLeft(QSet<MusicScraperInfo> infos, Album* album);
-    void appendDownloadElement(Artist* artist, QString source, QString type, QUrl url);
-    void appendDownloadElement(Album* album, QString source, QString type, QUrl url);
+    static void appendDownloadElement(QVector<DownloadElement>& elements, QString source, QString type, QUrl url);
     void processDownloadElement(DownloadElement elem, Artist* artist, QSet<MusicScraperInfo> infos);
     void processDownloadElement(DownloadElement elem, Album* album, QSet<MusicScraperInfo> infos);
 };
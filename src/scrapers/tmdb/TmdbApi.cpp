@@ -5,6 +5,7 @@
 #include "globals/Meta.h"
 #include "log/Log.h"
 #include "network/HttpStatusCodes.h"
+#include "network/RequestCoalescer.h"
 #include "tv_shows/TvDbId.h"
 
 #include <QJsonArray>
@@ -68,10 +69,18 @@ void TmdbApi::sendGetRequest(const Locale& locale, const QUrl& url, TmdbApi::Api
         return;
     }
 
+    const QString key = WebsiteCache::key(url, locale);
+    auto flight = network::RequestCoalescer<QJsonDocument, ScraperError>::shared().join(
+        key, std::move(callback), QJsonDocument(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
+
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, flight, locale, this]() {
         auto dls = makeDeleteLaterScope(reply);
 
         QString data;
@@ -92,7 +101,7 @@ void TmdbApi::sendGetRequest(const Locale& locale, const QUrl& url, TmdbApi::Api
         }
 
         ScraperError error = makeScraperError(data, *reply, parseError);
-        cb(json, error);
+        flight->finish(json, error);
     });
 }
 
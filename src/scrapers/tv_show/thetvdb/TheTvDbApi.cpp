@@ -4,6 +4,7 @@
 #include "globals/Meta.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "network/RequestCoalescer.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -76,12 +77,20 @@ void TheTvDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheTvDbAp
         return;
     }
 
+    const QString key = WebsiteCache::key(url, locale);
+    auto flight = network::RequestCoalescer<QJsonDocument, ScraperError>::shared().join(
+        key, std::move(callback), QJsonDocument(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
+
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
     addHeadersToRequest(locale, request);
 
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, flight, locale, this]() {
         auto dls = makeDeleteLaterScope(reply);
 
         QString data;
@@ -102,7 +111,7 @@ void TheTvDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheTvDbAp
         }
 
         ScraperError error = makeScraperError(data, *reply, parseError);
-        cb(json, error);
+        flight->finish(json, error);
     });
 }
 
@@ -7,6 +7,7 @@
 #include "tv_shows/TvShow.h"
 
 #include <QObject>
+#include <QTimer>
 #include <utility>
 
 namespace mediaelch {
@@ -3,6 +3,7 @@
 #include "globals/Meta.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "network/RequestCoalescer.h"
 
 #include <QTimer>
 #include <QUrl>
@@ -39,10 +40,18 @@ void TvMazeApi::sendGetRequest(const QUrl& url, TvMazeApi::ApiCallback callback)
         return;
     }
 
+    const QString key = WebsiteCache::key(url, Locale::English);
+    auto flight = network::RequestCoalescer<QJsonDocument, ScraperError>::shared().join(
+        key, std::move(callback), QJsonDocument(), makeCanceledRequestError());
+    if (flight == nullptr) {
+        // An equal request is running; the callback is called with its response.
+        return;
+    }
+
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
-    connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
+    connect(reply, &QNetworkReply::finished, this, [reply, flight, this]() {
         auto dls = makeDeleteLaterScope(reply);
         QString data;
 
@@ -63,7 +72,7 @@ void TvMazeApi::sendGetRequest(const QUrl& url, TvMazeApi::ApiCallback callback)
         }
 
         ScraperError error = makeScraperError(data, *reply, parseError);
-        cb(json, error);
+        flight->finish(json, error);
     });
 }
 
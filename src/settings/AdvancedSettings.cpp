@@ -94,7 +94,7 @@ QString AdvancedSettings::customStylesheet() const
     return m_customStylesheet;
 }
 
-QHash<QString, QString> AdvancedSettings::genreMappings() const
+const QHash<QString, QString>& AdvancedSettings::genreMappings() const
 {
     return m_genreMappings;
 }
@@ -119,27 +119,27 @@ const mediaelch::FileFilter& AdvancedSettings::subtitleFilters() const
     return m_subtitleFilters;
 }
 
-QHash<QString, QString> AdvancedSettings::audioCodecMappings() const
+const QHash<QString, QString>& AdvancedSettings::audioCodecMappings() const
 {
     return m_audioCodecMappings;
 }
 
-QHash<QString, QString> AdvancedSettings::videoCodecMappings() const
+const QHash<QString, QString>& AdvancedSettings::videoCodecMappings() const
 {
     return m_videoCodecMappings;
 }
 
-QHash<QString, QString> AdvancedSettings::certificationMappings() const
+const QHash<QString, QString>& AdvancedSettings::certificationMappings() const
 {
     return m_certificationMappings;
 }
 
-QHash<QString, QString> AdvancedSettings::studioMappings() const
+const QHash<QString, QString>& AdvancedSettings::studioMappings() const
 {
     return m_studioMappings;
 }
 
-QHash<QString, QString> AdvancedSettings::countryMappings() const
+const QHash<QString, QString>& AdvancedSettings::countryMappings() const
 {
     return m_countryMappings;
 }
@@ -168,12 +168,17 @@ bool AdvancedSettings::writeThumbUrlsToNfo() const
     return m_writeThumbUrlsToNfo;
 }
 
+bool AdvancedSettings::atomicFileWrites() const
+{
+    return m_atomicFileWrites;
+}
+
 mediaelch::ThumbnailDimensions AdvancedSettings::episodeThumbnailDimensions() const
 {
     return m_episodeThumbnailDimensions;
 }
 
-bool AdvancedSettings::isFileExcluded(QString file) const
+bool AdvancedSettings::isFileExcluded(const QString& file) const
 {
     for (const auto& pattern : m_excludePatterns) {
         if (pattern.matchFilename(file)) {
@@ -183,7 +188,7 @@ bool AdvancedSettings::isFileExcluded(QString file) const
     return false;
 }
 
-bool AdvancedSettings::isFolderExcluded(QString dir) const
+bool AdvancedSettings::isFolderExcluded(const QString& dir) const
 {
     for (const auto& pattern : m_excludePatterns) {
         if (pattern.matchFoldername(dir)) {
@@ -193,6 +198,61 @@ bool AdvancedSettings::isFolderExcluded(QString dir) const
     return false;
 }
 
+namespace {
+
+QStringList movieExtraFileParts()
+{
+    return {"-trailer", "-sample", "-behindthescenes", "-deleted", "-featurette", "-interview", "-scene", "-short"};
+}
+
+} // namespace
+
+mediaelch::ScanExcludes AdvancedSettings::movieScanExcludes() const
+{
+    return scanExcludes(movieExtraFileParts(), {".actors", "extras", "extrafanart", "extrathumbs"});
+}
+
+mediaelch::ScanExcludes AdvancedSettings::movieOrganizerScanExcludes() const
+{
+    return scanExcludes(movieExtraFileParts(), {".actors", ".AppleDouble", "extras", "extrafanarts"});
+}
+
+mediaelch::ScanExcludes AdvancedSettings::tvShowScanExcludes() const
+{
+    return scanExcludes({"-trailer", "-sample"}, {".actors", "extras", "extrafanarts"});
+}
+
+mediaelch::ScanExcludes AdvancedSettings::concertScanExcludes() const
+{
+    return scanExcludes({"-trailer", "-sample"}, {".actors", "extras", "extrafanarts"});
+}
+
+mediaelch::ScanExcludes AdvancedSettings::musicScanExcludes() const
+{
+    // The music searcher skips "extrafanart" and "extrathumbs" case-sensitively itself.
+    return scanExcludes({}, {});
+}
+
+mediaelch::ScanExcludes AdvancedSettings::scanExcludes(const QStringList& extraFileParts,
+    const QStringList& extraFolderNames) const
+{
+    QVector<QRegularExpression> filePatterns;
+    QVector<QRegularExpression> folderPatterns;
+    for (const auto& pattern : m_excludePatterns) {
+        if (pattern.isFilePattern()) {
+            filePatterns << pattern.regex();
+        } else if (pattern.isFolderPattern()) {
+            folderPatterns << pattern.regex();
+        }
+    }
+
+    mediaelch::ScanExcludes excludes;
+    excludes.files = mediaelch::NameMatcher(filePatterns, extraFileParts, {});
+    excludes.folders = mediaelch::NameMatcher(folderPatterns, {}, {});
+    excludes.foldersWithExtras = mediaelch::NameMatcher(folderPatterns, {}, extraFolderNames);
+    return excludes;
+}
+
 bool AdvancedSettings::isUserDefined() const
 {
     return m_userDefined;
@@ -254,6 +314,7 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     printMap(out, settings.m_countryMappings);
 
     out << "    writeThumbUrlsToNfo:     " << (settings.m_writeThumbUrlsToNfo ? "true" : "false") << nl;
+    out << "    atomicFileWrites:        " << (settings.m_atomicFileWrites ? "true" : "false") << nl;
     out << "    episodeThumb dimensions: " << nl;
     out << "        width:               " << settings.m_episodeThumbnailDimensions.width << nl;
     out << "        height:              " << settings.m_episodeThumbnailDimensions.height << nl;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "file/FileFilter.h"
+#include "file/NameMatcher.h"
 #include "globals/Globals.h"
 #include "image/ThumbnailDimensions.h"
 #include "log/Log.h"
@@ -28,7 +29,7 @@ public:
 
     FileSearchExclude() = default; // required for QVector
 
-    bool matchFilename(QString filename) const
+    bool matchFilename(const QString& filename) const
     {
         if (m_type == ExcludeType::File) {
             return m_regex.isValid() && m_regex.match(filename).hasMatch();
@@ -36,7 +37,7 @@ public:
         return false;
     }
 
-    bool matchFoldername(QString folder) const
+    bool matchFoldername(const QString& folder) const
     {
         if (m_type == ExcludeType::Folder) {
             return m_regex.isValid() && m_regex.match(folder).hasMatch();
@@ -44,6 +45,10 @@ public:
         return false;
     }
 
+    bool isFilePattern() const { return m_type == ExcludeType::File; }
+    bool isFolderPattern() const { return m_type == ExcludeType::Folder; }
+    const QRegularExpression& regex() const { return m_regex; }
+
     QString toString() const { return excludeTypeToString(m_type) + ": " + m_regex.pattern(); }
 
 private:
@@ -70,6 +75,11 @@ private:
     QRegularExpression m_regex;
 };
 
+/// \brief Settings from advancedsettings.xml.
+///
+/// The settings are loaded once on startup and never modified afterwards, so they are an
+/// immutable snapshot that scanners and worker threads can read without locking. Mapping
+/// tables and exclude patterns are returned by reference to avoid copies in hot loops.
 class AdvancedSettings
 {
 public:
@@ -80,28 +90,40 @@ public:
     QLocale locale() const;
     QStringList sortTokens() const;
     QString customStylesheet() const;
-    QHash<QString, QString> genreMappings() const;
+    const QHash<QString, QString>& genreMappings() const;
 
     const mediaelch::FileFilter& movieFilters() const;
     const mediaelch::FileFilter& concertFilters() const;
     const mediaelch::FileFilter& tvShowFilters() const;
     const mediaelch::FileFilter& subtitleFilters() const;
 
-    QHash<QString, QString> audioCodecMappings() const;
-    QHash<QString, QString> videoCodecMappings() const;
-    QHash<QString, QString> certificationMappings() const;
-    QHash<QString, QString> studioMappings() const;
-    QHash<QString, QString> countryMappings() const;
+    const QHash<QString, QString>& audioCodecMappings() const;
+    const QHash<QString, QString>& videoCodecMappings() const;
+    const QHash<QString, QString>& certificationMappings() const;
+    const QHash<QString, QString>& studioMappings() const;
+    const QHash<QString, QString>& countryMappings() const;
 
     bool useFirstStudioOnly() const;
     bool forceCache() const;
     bool portableMode() const;
     int bookletCut() const;
     bool writeThumbUrlsToNfo() const;
+    bool atomicFileWrites() const;
     mediaelch::ThumbnailDimensions episodeThumbnailDimensions() const;
 
-    bool isFileExcluded(QString file) const;
-    bool isFolderExcluded(QString dir) const;
+    bool isFileExcluded(const QString& file) const;
+    bool isFolderExcluded(const QString& dir) const;
+
+    /// \brief Compiles the exclude patterns and the extras skipped by the media type's scanners.
+    /// Build the matchers once per scan and use them for all directory entries.
+    /// Each scanner keeps its own list of extras folders.
+    mediaelch::ScanExcludes movieScanExcludes() const;
+    /// \brief Excludes of the deprecated MovieFileSearcher::scanDir(), which skips other
+    ///        extras folders than the movie directory searcher.
+    mediaelch::ScanExcludes movieOrganizerScanExcludes() const;
+    mediaelch::ScanExcludes tvShowScanExcludes() const;
+    mediaelch::ScanExcludes concertScanExcludes() const;
+    mediaelch::ScanExcludes musicScanExcludes() const;
 
     /// \brief Returns true if the user has provided a custom advancedsettings.xml
     ///        "false" if default values are used.
@@ -112,6 +134,7 @@ public:
 
 private:
     void setLocale(QString locale);
+    mediaelch::ScanExcludes scanExcludes(const QStringList& extraFileParts, const QStringList& extraFolderNames) const;
 
 private:
     bool m_debugLog = false;
@@ -135,6 +158,7 @@ private:
     bool m_portableMode = false;
     int m_bookletCut = 2;
     bool m_writeThumbUrlsToNfo = true;
+    bool m_atomicFileWrites = true;
     bool m_useFirstStudioOnly = false;
     bool m_userDefined = false;
 };
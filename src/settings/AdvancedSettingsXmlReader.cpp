@@ -103,6 +103,9 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
         } else if (m_xml.name() == QLatin1String("writeThumbUrlsToNfo")) {
             expectBool(m_settings.m_writeThumbUrlsToNfo);
 
+        } else if (m_xml.name() == QLatin1String("atomicFileWrites")) {
+            expectBool(m_settings.m_atomicFileWrites);
+
         } else if (m_xml.name() == QLatin1String("episodeThumb")) {
             while (m_xml.readNextStartElement()) {
                 if (m_xml.name() == QLatin1String("width")) {
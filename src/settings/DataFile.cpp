@@ -2,6 +2,7 @@
 
 #include <QFileInfo>
 #include <QStringList>
+#include <algorithm>
 #include <utility>
 
 #include "file/FilenameUtils.h"
@@ -134,3 +135,20 @@ DataFileType DataFile::dataFileTypeForImageType(ImageType imageType)
     default: return DataFileType::NoType;
     }
 }
+
+DataFileTable::DataFileTable(QVector<DataFile> files) : m_all{std::move(files)}
+{
+    for (const DataFile& file : asConst(m_all)) {
+        m_byType[file.type()].append(file);
+    }
+    for (auto& typeFiles : m_byType) {
+        std::sort(typeFiles.begin(), typeFiles.end(), DataFile::lessThan);
+    }
+}
+
+const QVector<DataFile>& DataFileTable::files(DataFileType type) const
+{
+    static const QVector<DataFile> s_empty;
+    auto typeFiles = m_byType.constFind(type);
+    return typeFiles != m_byType.constEnd() ? *typeFiles : s_empty;
+}
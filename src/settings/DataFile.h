@@ -3,7 +3,9 @@
 #include "globals/Globals.h"
 #include "tv_shows/SeasonNumber.h"
 
+#include <QMap>
 #include <QString>
+#include <QVector>
 
 class DataFile
 {
@@ -24,3 +26,25 @@ private:
     int m_pos = 0;
     DataFileType m_type = DataFileType::NoType;
 };
+
+/// \brief Immutable table of data files, grouped by type and sorted by position.
+///
+/// The table is built once whenever the data file settings change. Hot paths such as
+/// KodiXml::nfoFilePath() and the image file name lookups use it instead of filtering
+/// and sorting all data files on each call. Because it is never modified after its
+/// construction, it can be read from any thread.
+class DataFileTable
+{
+public:
+    DataFileTable() = default;
+    explicit DataFileTable(QVector<DataFile> files);
+
+    /// \brief Data files of the given type, sorted by their position.
+    const QVector<DataFile>& files(DataFileType type) const;
+    /// \brief All data files in the order in which they were passed to the constructor.
+    const QVector<DataFile>& all() const { return m_all; }
+
+private:
+    QVector<DataFile> m_all;
+    QMap<DataFileType, QVector<DataFile>> m_byType;
+};
@@ -1,5 +1,6 @@
 #include "Settings.h"
 
+#include "file/FileWriter.h"
 #include "globals/Manager.h"
 #include "globals/ScraperInfos.h"
 #include "renamer/RenamerDialog.h"
@@ -80,6 +81,7 @@ Settings::Settings(QObject* parent) : QObject(parent)
     m_advancedSettings = std::move(advancedSettingsPair.first);
 
     qCDebug(generic) << m_advancedSettings;
+    mediaelch::FileWriter::global().setAtomicWrites(m_advancedSettings.atomicFileWrites());
 
     if (m_advancedSettings.portableMode()) {
         qCDebug(generic) << "[Windows] Using portable mode!";
@@ -133,6 +135,8 @@ Settings::Settings(QObject* parent) : QObject(parent)
     m_initialDataFilesFrodo.append(DataFile(DataFileType::ArtistThumb, "thumb.jpg", 0));
     m_initialDataFilesFrodo.append(DataFile(DataFileType::AlbumCdArt, "discart.png", 0));
     m_initialDataFilesFrodo.append(DataFile(DataFileType::AlbumThumb, "thumb.jpg", 0));
+    m_dataFileTableFrodo = DataFileTable(m_initialDataFilesFrodo);
+    m_dataFileTable = std::make_shared<const DataFileTable>(m_initialDataFilesFrodo);
 }
 
 /**
@@ -290,11 +294,7 @@ void Settings::loadSettings()
         }
     }
 
-    if (dataFiles.isEmpty()) {
-        m_dataFiles = m_initialDataFilesFrodo;
-    } else {
-        m_dataFiles = dataFiles;
-    }
+    setDataFiles(dataFiles.isEmpty() ? m_initialDataFilesFrodo : dataFiles);
 
     // Movie set artwork
     m_movieSetArtworkType = MovieSetArtworkType(settings()->value(KEY_MOVIE_SET_ARTWORK_STORING_TYPE, 0).toInt());
@@ -446,12 +446,13 @@ void Settings::saveSettings()
     settings()->setValue(KEY_SCRAPER_CURRENT_TV_SHOW_SCRAPER, m_currentTvShowScraper);
     settings()->setValue(KEY_SCRAPER_CURRENT_CONCERT_SCRAPER, m_currentConcertScraper);
 
+    const QVector<DataFile> allDataFiles = dataFileTable()->all();
     settings()->beginWriteArray(KEY_ALL_DATA_FILES);
-    for (int i = 0, n = m_dataFiles.count(); i < n; ++i) {
+    for (int i = 0, n = allDataFiles.count(); i < n; ++i) {
         settings()->setArrayIndex(i);
-        settings()->setValue("type", static_cast<int>(m_dataFiles.at(i).type()));
-        settings()->setValue("fileName", m_dataFiles.at(i).fileName());
-        settings()->setValue("pos", m_dataFiles.at(i).pos());
+        settings()->setValue("type", static_cast<int>(allDataFiles.at(i).type()));
+        settings()->setValue("fileName", allDataFiles.at(i).fileName());
+        settings()->setValue("pos", allDataFiles.at(i).pos());
     }
     settings()->endArray();
 
@@ -684,14 +685,7 @@ bool Settings::autoLoadStreamDetails() const
 
 QVector<DataFile> Settings::dataFiles(DataFileType dataType)
 {
-    QVector<DataFile> files;
-    for (const DataFile& file : asConst(m_dataFiles)) {
-        if (file.type() == dataType) {
-            files.append(file);
-        }
-    }
-    std::sort(files.begin(), files.end(), DataFile::lessThan);
-    return files;
+    return dataFileTable()->files(dataType);
 }
 
 QVector<DataFile> Settings::dataFiles(ImageType dataType)
@@ -702,17 +696,14 @@ QVector<DataFile> Settings::dataFiles(ImageType dataType)
 QVector<DataFile> Settings::dataFilesFrodo(DataFileType type)
 {
     if (type == DataFileType::NoType) {
-        return m_initialDataFilesFrodo;
+        return m_dataFileTableFrodo.all();
     }
+    return m_dataFileTableFrodo.files(type);
+}
 
-    QVector<DataFile> files;
-    for (const DataFile& file : asConst(m_initialDataFilesFrodo)) {
-        if (file.type() == type) {
-            files.append(file);
-        }
-    }
-    std::sort(files.begin(), files.end(), DataFile::lessThan);
-    return files;
+std::shared_ptr<const DataFileTable> Settings::dataFileTable() const
+{
+    return std::atomic_load(&m_dataFileTable);
 }
 
 bool Settings::usePlotForOutline() const
@@ -887,7 +878,7 @@ void Settings::setUseYoutubePluginUrls(bool use)
  */
 void Settings::setDataFiles(QVector<DataFile> files)
 {
-    m_dataFiles = files;
+    std::atomic_store(&m_dataFileTable, std::make_shared<const DataFileTable>(std::move(files)));
 }
 
 void Settings::setAutoLoadStreamDetails(bool autoLoad)
@@ -70,6 +70,11 @@ public:
     QVector<DataFile> dataFiles(DataFileType dataType);
     QVector<DataFile> dataFiles(ImageType dataType);
     QVector<DataFile> dataFilesFrodo(DataFileType type = DataFileType::NoType);
+    /// \brief Snapshot of the current data files, grouped by type and sorted.
+    ///
+    /// The snapshot is immutable and replaced atomically as a whole when the data files
+    /// change, so it can be used from worker threads and kept across items in hot loops.
+    std::shared_ptr<const DataFileTable> dataFileTable() const;
     bool usePlotForOutline() const;
     bool ignoreDuplicateOriginalTitle() const;
     void renamePatterns(Renamer::RenameType renameType,
@@ -231,8 +236,12 @@ private:
     QStringList m_csvExportMusicArtistFields;
     QStringList m_csvExportMusicAlbumFields;
 
-    QVector<DataFile> m_dataFiles;
+    /// Only access via std::atomic_load() and std::atomic_store(). These are atomic, but not
+    /// lock-free: libstdc++ guards them with a short internal lock.  Loops should therefore
+    /// get the snapshot once instead of calling dataFileTable() per item.
+    std::shared_ptr<const DataFileTable> m_dataFileTable;
     QVector<DataFile> m_initialDataFilesFrodo;
+    DataFileTable m_dataFileTableFrodo;
     bool m_usePlotForOutline = false;
     bool m_ignoreDuplicateOriginalTitle = true;
     bool m_ignoreArticlesWhenSorting = false;
@@ -3,9 +3,12 @@
 
 #include <QApplication>
 #include <QDir>
+#include <QMutexLocker>
 #include <algorithm>
 #include <utility>
 
+#include "data/DatabaseService.h"
+#include "data/StringPool.h"
 #include "file/NameFormatter.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
@@ -177,7 +180,58 @@ void TvShow::clearSeasonImageType(ImageType imageType)
  */
 void TvShow::addEpisode(TvShowEpisode* episode)
 {
+    QMutexLocker locker(&m_episodeIndexMutex);
     m_episodes.push_back(episode);
+    if (m_episodeIndexValid) {
+        addToEpisodeIndex(episode);
+    }
+}
+
+void TvShow::invalidateEpisodeIndex()
+{
+    QMutexLocker locker(&m_episodeIndexMutex);
+    m_episodeIndexValid = false;
+}
+
+qint64 TvShow::episodeIndexKey(SeasonNumber season, EpisodeNumber episode)
+{
+    return (static_cast<qint64>(season.toInt()) << 32) | static_cast<quint32>(episode.toInt());
+}
+
+void TvShow::ensureEpisodeIndex() const
+{
+    if (m_episodeIndexValid) {
+        return;
+    }
+    m_episodeByNumber.clear();
+    m_episodesBySeason.clear();
+    m_seasonOrder.clear();
+    m_episodesByFirstFile.clear();
+    for (TvShowEpisode* episode : m_episodes) {
+        addToEpisodeIndex(episode);
+    }
+    m_episodeIndexValid = true;
+}
+
+void TvShow::addToEpisodeIndex(TvShowEpisode* episode) const
+{
+    const SeasonNumber season = episode->seasonNumber();
+    // The first episode wins, e.g. if there are duplicates.
+    const qint64 key = episodeIndexKey(season, episode->episodeNumber());
+    if (!m_episodeByNumber.contains(key)) {
+        m_episodeByNumber.insert(key, episode);
+    }
+
+    auto seasonIt = m_episodesBySeason.find(season);
+    if (seasonIt == m_episodesBySeason.end()) {
+        seasonIt = m_episodesBySeason.insert(season, {});
+        m_seasonOrder.push_back(season);
+    }
+    seasonIt->push_back(episode);
+
+    if (!episode->files().isEmpty()) {
+        m_episodesByFirstFile[episode->files().first().toString()].push_back(episode);
+    }
 }
 
 /**
@@ -289,6 +343,8 @@ void TvShow::scrapeData(mediaelch::scraper::TvScraper* scraper,
                 database->addEpisodeToShowList(episode, showsSettingsId, episode->tvdbId());
             }
             database->cleanUpEpisodeList(showsSettingsId);
+            // Listeners may fill in missing episodes, which reads the episode list.
+            database->service()->flush();
 
             emit sigLoaded(this, showDetails, job->config().locale);
             job->deleteLater();
@@ -677,9 +733,12 @@ const QMap<SeasonNumber, QVector<Poster>>& TvShow::allSeasonThumbs() const
 
 TvShowEpisode* TvShow::episode(SeasonNumber season, EpisodeNumber episode)
 {
-    for (int i = 0, n = m_episodes.count(); i < n; ++i) {
-        if (m_episodes[i]->seasonNumber() == season && m_episodes[i]->episodeNumber() == episode) {
-            return m_episodes[i];
+    {
+        QMutexLocker locker(&m_episodeIndexMutex);
+        ensureEpisodeIndex();
+        TvShowEpisode* found = m_episodeByNumber.value(episodeIndexKey(season, episode), nullptr);
+        if (found != nullptr) {
+            return found;
         }
     }
     return new TvShowEpisode(QStringList(), this);
@@ -687,13 +746,17 @@ TvShowEpisode* TvShow::episode(SeasonNumber season, EpisodeNumber episode)
 
 QVector<SeasonNumber> TvShow::seasons(bool includeDummies) const
 {
+    QMutexLocker locker(&m_episodeIndexMutex);
+    ensureEpisodeIndex();
+    const auto isNotDummy = [](const TvShowEpisode* episode) { return !episode->isDummy(); };
     QVector<SeasonNumber> seasons;
-    for (TvShowEpisode* episode : m_episodes) {
-        if (episode->isDummy() && !includeDummies) {
+    for (const SeasonNumber& season : m_seasonOrder) {
+        if (season == SeasonNumber::NoSeason) {
             continue;
         }
-        if (!seasons.contains(episode->seasonNumber()) && episode->seasonNumber() != SeasonNumber::NoSeason) {
-            seasons.append(episode->seasonNumber());
+        const QVector<TvShowEpisode*> episodes = m_episodesBySeason.value(season);
+        if (includeDummies || std::any_of(episodes.cbegin(), episodes.cend(), isNotDummy)) {
+            seasons.append(season);
         }
     }
     return seasons;
@@ -705,14 +768,25 @@ const QVector<TvShowEpisode*>& TvShow::episodes() const
 }
 
 QVector<TvShowEpisode*> TvShow::episodes(SeasonNumber season) const
+{
+    QMutexLocker locker(&m_episodeIndexMutex);
+    ensureEpisodeIndex();
+    return m_episodesBySeason.value(season);
+}
+
+QVector<TvShowEpisode*> TvShow::episodes(const mediaelch::FileList& files) const
 {
     QVector<TvShowEpisode*> episodes;
-    for (TvShowEpisode* episode : m_episodes) {
-        if (episode->seasonNumber() == season) {
+    if (files.isEmpty()) {
+        return episodes;
+    }
+    QMutexLocker locker(&m_episodeIndexMutex);
+    ensureEpisodeIndex();
+    for (TvShowEpisode* episode : m_episodesByFirstFile.value(files.first().toString())) {
+        if (episode->files() == files) {
             episodes.push_back(episode);
         }
     }
-
     return episodes;
 }
 
@@ -819,11 +893,10 @@ void TvShow::setGenres(QStringList genres)
     m_genres.clear();
     for (const QString& genre : genres) {
         if (!genre.isEmpty()) {
-            m_genres.append(genre);
+            m_genres.append(mediaelch::StringPool::global().intern(genre));
         }
     }
 
-    m_genres = genres;
     setChanged(true);
 }
 
@@ -836,7 +909,7 @@ void TvShow::addGenre(QString genre)
     if (genre.isEmpty()) {
         return;
     }
-    m_genres.append(genre);
+    m_genres.append(mediaelch::StringPool::global().intern(genre));
     setChanged(true);
 }
 
@@ -1363,18 +1436,27 @@ void TvShow::setRuntime(std::chrono::minutes runtime)
 
 bool TvShow::isDummySeason(SeasonNumber season) const
 {
-    for (TvShowEpisode* episode : m_episodes) {
-        if (episode->seasonNumber() == season && !episode->isDummy()) {
-            return false;
-        }
+    QVector<TvShowEpisode*> episodes;
+    {
+        QMutexLocker locker(&m_episodeIndexMutex);
+        ensureEpisodeIndex();
+        episodes = m_episodesBySeason.value(season);
     }
-    return true;
+    return std::all_of(episodes.cbegin(), episodes.cend(), [](const TvShowEpisode* const episode) {
+        return episode->isDummy();
+    });
 }
 
 bool TvShow::hasDummyEpisodes(SeasonNumber season) const
 {
-    return std::any_of(m_episodes.cbegin(), m_episodes.cend(), [season](const TvShowEpisode* const episode) {
-        return episode->seasonNumber() == season && episode->isDummy();
+    QVector<TvShowEpisode*> episodes;
+    {
+        QMutexLocker locker(&m_episodeIndexMutex);
+        ensureEpisodeIndex();
+        episodes = m_episodesBySeason.value(season);
+    }
+    return std::any_of(episodes.cbegin(), episodes.cend(), [](const TvShowEpisode* const episode) {
+        return episode->isDummy();
     });
 }
 
@@ -1413,22 +1495,26 @@ bool TvShow::hideSpecialsInMissingEpisodes() const
 void TvShow::fillMissingEpisodes()
 {
     QVector<TvShowEpisode*> episodes = Manager::instance()->database()->showsEpisodes(this);
+
+    // Loading missing episodes may change their numbers, so we don't rely on the index being
+    // valid throughout the loop.
+    QSet<qint64> existingEpisodes;
+    {
+        QMutexLocker locker(&m_episodeIndexMutex);
+        ensureEpisodeIndex();
+        for (auto it = m_episodeByNumber.constBegin(); it != m_episodeByNumber.constEnd(); ++it) {
+            existingEpisodes.insert(it.key());
+        }
+    }
+
     for (TvShowEpisode* episode : episodes) {
         if (episode == nullptr) {
             qCCritical(generic) << "[TvShow] Episode loaded from database is a nullptr";
             continue;
         }
 
-        bool found = false;
-        for (int i = 0, n = m_episodes.count(); i < n; ++i) {
-            if (m_episodes[i]->seasonNumber() == episode->seasonNumber()
-                && m_episodes[i]->episodeNumber() == episode->episodeNumber()) {
-                found = true;
-                break;
-            }
-        }
-
-        if (found) {
+        const qint64 key = episodeIndexKey(episode->seasonNumber(), episode->episodeNumber());
+        if (existingEpisodes.contains(key)) {
             episode->deleteLater();
             continue;
         }
@@ -1438,10 +1524,14 @@ void TvShow::fillMissingEpisodes()
             continue;
         }
 
-        episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false, false);
+        if (episode->isHydrated()) {
+            // Cached by older versions without the episode's details in separate columns.
+            episode->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false, false);
+        }
         episode->setIsDummy(true);
         episode->setInfosLoaded(true);
         addEpisode(episode);
+        existingEpisodes.insert(key);
     }
 
     Manager::instance()->tvShowModel()->updateShow(this);
@@ -1451,7 +1541,11 @@ void TvShow::fillMissingEpisodes()
 void TvShow::clearMissingEpisodes()
 {
     const auto isDummyEpisode = [](TvShowEpisode* episode) { return episode->isDummy(); };
-    m_episodes.erase(std::remove_if(m_episodes.begin(), m_episodes.end(), isDummyEpisode), m_episodes.end());
+    {
+        QMutexLocker locker(&m_episodeIndexMutex);
+        m_episodes.erase(std::remove_if(m_episodes.begin(), m_episodes.end(), isDummyEpisode), m_episodes.end());
+        m_episodeIndexValid = false;
+    }
 
     Manager::instance()->tvShowModel()->updateShow(this);
     TvShowFilesWidget::instance().renewModel(true);
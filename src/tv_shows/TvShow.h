@@ -14,7 +14,9 @@
 #include "tv_shows/TvMazeId.h"
 #include "tv_shows/TvShowEpisode.h"
 
+#include <QHash>
 #include <QMetaType>
+#include <QMutex>
 #include <QObject>
 #include <QStringList>
 #include <QVector>
@@ -93,6 +95,12 @@ public:
     QVector<SeasonNumber> seasons(bool includeDummies = true) const;
     const QVector<TvShowEpisode*>& episodes() const;
     QVector<TvShowEpisode*> episodes(SeasonNumber season) const;
+    /// \brief Returns all episodes (including dummies) whose files are equal to the given ones,
+    ///        e.g. all episodes of a multi-episode file.
+    QVector<TvShowEpisode*> episodes(const mediaelch::FileList& files) const;
+    /// \brief Marks the episode index as outdated. Called by episodes whose season/episode
+    ///        numbers or files change.
+    void invalidateEpisodeIndex();
     TvShowModelItem* modelItem();
     bool hasChanged() const;
     bool infoLoaded() const;
@@ -217,8 +225,25 @@ signals:
     void sigLoaded(TvShow* show, QSet<ShowScraperInfo> details, mediaelch::Locale locale);
     void sigChanged(TvShow*);
 
+private:
+    static qint64 episodeIndexKey(SeasonNumber season, EpisodeNumber episode);
+    /// \brief Rebuilds the episode index if it is outdated. Requires m_episodeIndexMutex.
+    void ensureEpisodeIndex() const;
+    /// \brief Requires m_episodeIndexMutex.
+    void addToEpisodeIndex(TvShowEpisode* episode) const;
+
 private:
     QVector<TvShowEpisode*> m_episodes;
+    // Index of m_episodes for lookups by season/episode and by files.  Updated by addEpisode()
+    // and rebuilt lazily once it's invalidated, e.g. if an episode's season number changes.
+    // Const lookups may rebuild it, so all index members are guarded by the mutex.  Rebuilding
+    // reads m_episodes, which is why episodes are added and removed while holding it as well.
+    mutable QMutex m_episodeIndexMutex;
+    mutable bool m_episodeIndexValid = false;
+    mutable QHash<qint64, TvShowEpisode*> m_episodeByNumber;
+    mutable QHash<SeasonNumber, QVector<TvShowEpisode*>> m_episodesBySeason;
+    mutable QVector<SeasonNumber> m_seasonOrder;
+    mutable QHash<QString, QVector<TvShowEpisode*>> m_episodesByFirstFile;
     mediaelch::DirectoryPath m_dir;
     QString m_title;
     QString m_showTitle;
@@ -2,6 +2,7 @@
 
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "media_centers/MediaCenterInterface.h"
 #include "scrapers/tv_show/ShowMerger.h"
 #include "scrapers/tv_show/TvScraper.h"
@@ -48,12 +49,18 @@ void TvShowEpisode::initCounter()
 void TvShowEpisode::setFiles(const mediaelch::FileList& files)
 {
     m_files = files;
+    if (m_show != nullptr) {
+        m_show->invalidateEpisodeIndex();
+    }
     m_streamDetails = new StreamDetails(this, m_files);
 }
 
 void TvShowEpisode::setShow(TvShow* show)
 {
     m_show = show;
+    if (m_show != nullptr) {
+        m_show->invalidateEpisodeIndex();
+    }
     setParent(show);
 }
 
@@ -552,7 +559,15 @@ const StreamDetails* TvShowEpisode::streamDetails() const
 
 QString TvShowEpisode::nfoContent() const
 {
-    return m_nfoContent;
+    if (m_nfoContent.isEmpty()) {
+        return QString();
+    }
+    return QString::fromUtf8(qUncompress(m_nfoContent));
+}
+
+int TvShowEpisode::storedNfoContentSize() const
+{
+    return m_nfoContent.size();
 }
 
 int TvShowEpisode::databaseId() const
@@ -610,7 +625,12 @@ void TvShowEpisode::setUserRating(double rating)
  */
 void TvShowEpisode::setSeason(SeasonNumber season)
 {
+    const bool numberChanged = m_season != season;
     m_season = season;
+    // Invalidate after the change, so that a concurrent lookup can't rebuild the index with the old number.
+    if (m_show != nullptr && numberChanged) {
+        m_show->invalidateEpisodeIndex();
+    }
     setChanged(true);
 }
 
@@ -621,7 +641,12 @@ void TvShowEpisode::setSeason(SeasonNumber season)
  */
 void TvShowEpisode::setEpisode(EpisodeNumber episode)
 {
+    const bool numberChanged = m_episode != episode;
     m_episode = episode;
+    // Invalidate after the change, so that a concurrent lookup can't rebuild the index with the old number.
+    if (m_show != nullptr && numberChanged) {
+        m_show->invalidateEpisodeIndex();
+    }
     setChanged(true);
 }
 
@@ -852,7 +877,9 @@ void TvShowEpisode::removeTag(QString tag)
 
 void TvShowEpisode::setNfoContent(QString content)
 {
-    m_nfoContent = content;
+    // The NFO content is only needed to (re-)load details and to write the database,
+    // so we keep it compressed instead of storing several KB of UTF-16 per item.
+    m_nfoContent = content.isEmpty() ? QByteArray() : qCompress(content.toUtf8());
 }
 
 void TvShowEpisode::setDatabaseId(int id)
@@ -893,6 +920,41 @@ bool TvShowEpisode::isDummy() const
     return m_isDummy;
 }
 
+void TvShowEpisode::setHydrated(bool hydrated)
+{
+    m_hydrated = hydrated;
+}
+
+bool TvShowEpisode::isHydrated() const
+{
+    return m_hydrated;
+}
+
+int TvShowEpisode::episodeListId() const
+{
+    return m_episodeListId;
+}
+
+void TvShowEpisode::setEpisodeListId(int id)
+{
+    m_episodeListId = id;
+}
+
+void TvShowEpisode::hydrate(MediaCenterInterface* mediaCenterInterface)
+{
+    if (m_hydrated) {
+        return;
+    }
+    m_hydrated = true;
+    if (m_nfoContent.isEmpty() && m_episodeListId >= 0) {
+        setNfoContent(Manager::instance()->database()->showsEpisodeContent(m_episodeListId));
+    }
+    const bool isDummy = m_isDummy;
+    loadData(mediaCenterInterface, false, true);
+    m_isDummy = isDummy;
+    m_infoLoaded = true;
+}
+
 void TvShowEpisode::setWantThumbnailDownload(bool wantThumbnail)
 {
     m_wantThumbnailDownload = wantThumbnail;
@@ -89,9 +89,16 @@ public:
     const StreamDetails* streamDetails() const;
     bool streamDetailsLoaded() const;
     QString nfoContent() const;
+    /// \brief Size of the compressed NFO content that is kept in memory.
+    int storedNfoContentSize() const;
     int databaseId() const;
     bool syncNeeded() const;
     bool isDummy() const;
+    /// \brief False for missing episodes whose list details were loaded from the database
+    ///        without parsing their NFO content, see hydrate().
+    bool isHydrated() const;
+    /// \brief Id of the light episode in the show's episode list of the database, or -1.
+    int episodeListId() const;
     bool wantThumbnailDownload() const;
 
     void setShow(TvShow* show);
@@ -125,8 +132,14 @@ public:
     void setDatabaseId(int id);
     void setSyncNeeded(bool syncNeeded);
     void setIsDummy(bool dummy);
+    void setHydrated(bool hydrated);
+    void setEpisodeListId(int id);
     void setWantThumbnailDownload(bool wantThumbnail);
 
+    /// \brief Loads the NFO content of a light episode from the database and parses it.
+    ///        Does nothing if the episode is already hydrated.
+    void hydrate(MediaCenterInterface* mediaCenterInterface);
+
     void removeWriter(QString* writer);
     void removeDirector(QString* director);
     void removeTag(QString tag);
@@ -204,12 +217,15 @@ private:
     int m_episodeId = -1;
     bool m_streamDetailsLoaded = false;
     StreamDetails* m_streamDetails = nullptr;
-    QString m_nfoContent;
+    /// qCompress()ed UTF-8 NFO content.
+    QByteArray m_nfoContent;
     int m_databaseId = -1;
     bool m_syncNeeded = false;
     QSet<EpisodeScraperInfo> m_infosToLoad;
     QVector<ImageType> m_imagesToRemove;
     bool m_isDummy = false;
+    bool m_hydrated = true;
+    int m_episodeListId = -1;
     Actors m_actors;
     bool m_wantThumbnailDownload = false;
 };
@@ -119,6 +119,7 @@ void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
 
     // search for contents
     QVector<QStringList> contents;
+    m_scanExcludes = Settings::instance()->advanced()->tvShowScanExcludes();
     scanTvShowDir(path, showDir, contents);
     auto* show = new TvShow(showDir, this);
     show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
@@ -178,7 +179,7 @@ void TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path, QMap<Q
             return;
         }
 
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
+        if (m_scanExcludes.folders.matches(cDir)) {
             continue;
         }
 
@@ -207,14 +208,8 @@ void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath
             return;
         }
 
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
-        }
-
-        // Skip "Extras" folder
-        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
-            || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
+        // Skip excluded and "Extras" folders
+        if (m_scanExcludes.foldersWithExtras.matches(cDir)) {
             continue;
         }
 
@@ -239,11 +234,8 @@ void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath
     QStringList files;
     QStringList entries = getFiles(path);
     for (const QString& file : entries) {
-        if (Settings::instance()->advanced()->isFileExcluded(file)) {
-            continue;
-        }
-        // Skip Trailers and Sample files
-        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+        // Skip excluded, Trailers and Sample files
+        if (m_scanExcludes.files.matches(file)) {
             continue;
         }
         files.append(file);
@@ -551,6 +543,7 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
 QMap<QString, QVector<QStringList>> TvShowFileSearcher::readTvShowContent(bool forceReload)
 {
     QMap<QString, QVector<QStringList>> contents;
+    m_scanExcludes = Settings::instance()->advanced()->tvShowScanExcludes();
     for (const SettingsDir& dir : asConst(m_directories)) {
         if (m_aborted) {
             break;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "file/NameMatcher.h"
 #include "file/Path.h"
 #include "tv_shows/TvShowEpisode.h"
 
@@ -39,6 +40,8 @@ private:
         QVector<QStringList>& contents);
     QStringList getFiles(const mediaelch::DirectoryPath& path);
     bool m_aborted;
+    /// Built once per scan.
+    mediaelch::ScanExcludes m_scanExcludes;
 
 private:
     Database& database();
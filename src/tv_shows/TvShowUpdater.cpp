@@ -1,5 +1,6 @@
 #include "TvShowUpdater.h"
 
+#include "data/DatabaseService.h"
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
@@ -73,6 +74,8 @@ void TvShowUpdater::updateShow(TvShow* show, bool force)
             database->addEpisodeToShowList(episode, showsSettingsId, episode->tvdbId());
         }
         database->cleanUpEpisodeList(showsSettingsId);
+        // fillMissingEpisodes() reads the episode list that was just written.
+        database->service()->flush();
 
         show->fillMissingEpisodes();
     });
@@ -16,6 +16,8 @@
 #include "globals/ImagePreviewDialog.h"
 #include "globals/LocaleStringCompare.h"
 #include "globals/Manager.h"
+#include "globals/MessageIds.h"
+#include "globals/SaveQueue.h"
 #include "ui/concerts/ConcertFilesWidget.h"
 #include "ui/concerts/ConcertSearch.h"
 #include "ui/notifications/NotificationBox.h"
@@ -440,27 +442,17 @@ void ConcertWidget::onSaveInformation()
         concerts.append(m_concert);
     }
 
-    setDisabledTrue();
-    m_savingWidget->show();
-
-    if (concerts.count() == 1) {
-        m_concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
-        m_concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
-        updateConcertInfo();
-        NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_concert->title()));
-    } else {
-        for (Concert* concert : concerts) {
-            if (concert->hasChanged()) {
-                concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
-                concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
-                if (m_concert == concert) {
-                    updateConcertInfo();
-                }
-            }
-        }
-        NotificationBox::instance()->showSuccess(tr("Concerts Saved"));
+    if (concerts.count() > 1) {
+        saveInBackground(concerts, tr("Concerts Saved"));
+        return;
     }
 
+    setDisabledTrue();
+    m_savingWidget->show();
+    m_concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
+    m_concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
+    updateConcertInfo();
+    NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_concert->title()));
     setEnabledTrue();
     m_savingWidget->hide();
     ui->buttonRevert->setVisible(false);
@@ -471,22 +463,68 @@ void ConcertWidget::onSaveInformation()
  */
 void ConcertWidget::onSaveAll()
 {
+    QVector<Concert*> concerts;
+    for (Concert* concert : Manager::instance()->concertModel()->concerts()) {
+        if (concert->hasChanged()) {
+            concerts.append(concert);
+        }
+    }
+    saveInBackground(concerts, tr("All Concerts Saved"));
+}
+
+/// \brief Saves the given concerts using a SaveQueue, so that the UI stays responsive.
+void ConcertWidget::saveInBackground(const QVector<Concert*>& concerts, const QString& successMessage)
+{
+    if (m_saveQueue != nullptr) {
+        qCInfo(generic) << "[ConcertWidget] Still saving, ignoring save request";
+        return;
+    }
     setDisabledTrue();
     m_savingWidget->show();
 
-    for (Concert* concert : Manager::instance()->concertModel()->concerts()) {
-        if (concert->hasChanged()) {
-            concert->controller()->saveData(Manager::instance()->mediaCenterInterfaceConcert());
-            concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert(), true);
-            if (m_concert == concert) {
-                updateConcertInfo();
-            }
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterfaceConcert();
+    m_saveQueue = new mediaelch::SaveQueue(Manager::instance()->database()->service(), this);
+    QPointer<ConcertWidget> widget(this);
+    for (Concert* concert : concerts) {
+        if (!concert->hasChanged()) {
+            continue;
         }
+        m_saveQueue->add(
+            concert,
+            [concert, mediaCenter]() { return concert->controller()->saveData(mediaCenter); },
+            [widget, concert, mediaCenter](bool success) {
+                if (!success) {
+                    // saveData() marks the concert as unchanged before its files are written.
+                    concert->setChanged(true);
+                    return;
+                }
+                // The NFO file is written by now; its content is stored in the concert.
+                concert->controller()->loadData(mediaCenter, true, false);
+                if (!widget.isNull() && widget->m_concert == concert) {
+                    widget->updateConcertInfo();
+                }
+            });
     }
-    setEnabledTrue();
-    m_savingWidget->hide();
-    NotificationBox::instance()->showSuccess(tr("All Concerts Saved"));
-    ui->buttonRevert->setVisible(false);
+
+    NotificationBox::instance()->showProgressBar(
+        tr("Saving concerts..."), Constants::ConcertWidgetSaveProgressMessageId);
+    connect(m_saveQueue, &mediaelch::SaveQueue::progress, this, [](int done, int total) {
+        NotificationBox::instance()->progressBarProgress(done, total, Constants::ConcertWidgetSaveProgressMessageId);
+    });
+    connect(m_saveQueue, &mediaelch::SaveQueue::finished, this, [this, successMessage](int failed) {
+        setEnabledTrue();
+        m_savingWidget->hide();
+        NotificationBox::instance()->hideProgressBar(Constants::ConcertWidgetSaveProgressMessageId);
+        if (failed > 0) {
+            NotificationBox::instance()->showError(tr("%n concert(s) could not be saved", "", failed));
+        } else {
+            NotificationBox::instance()->showSuccess(successMessage);
+        }
+        ui->buttonRevert->setVisible(false);
+        m_saveQueue->deleteLater();
+        m_saveQueue = nullptr;
+    });
+    m_saveQueue->start();
 }
 
 /**
@@ -16,6 +16,10 @@ class ConcertWidget;
 
 class ClosableImage;
 
+namespace mediaelch {
+class SaveQueue;
+}
+
 /**
  * \brief The ConcertWidget class
  */
@@ -80,5 +84,7 @@ private:
     QPointer<Concert> m_concert = nullptr;
     QMovie* m_loadingMovie;
     QLabel* m_savingWidget;
+    QPointer<mediaelch::SaveQueue> m_saveQueue;
     void updateImages(QVector<ImageType> images);
+    void saveInBackground(const QVector<Concert*>& concerts, const QString& successMessage);
 };
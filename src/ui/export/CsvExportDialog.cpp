@@ -3,6 +3,7 @@
 
 #include "globals/Manager.h"
 #include "globals/Meta.h"
+#include "movies/Movie.h"
 #include "settings/Settings.h"
 
 #include <QDateTime>
@@ -123,6 +124,7 @@ void CsvExportDialog::onExport()
     // Movies ------------------------------------------
     if (!m_shouldAbort && ui->checkMovies->isChecked()) {
         const QVector<Movie*>& movies = Manager::instance()->movieModel()->movies();
+        MovieController::hydrate(movies);
 
         int processedCount = 0;
         ui->exportProgress->setRange(0, movies.size());
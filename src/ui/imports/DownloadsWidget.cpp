@@ -41,11 +41,19 @@ DownloadsWidget::DownloadsWidget(QWidget* parent) : QWidget(parent), ui(new Ui::
 #endif
 
     m_extractor = new Extractor(this);
+    m_importsRescanTimer.setSingleShot(true);
+    m_importsRescanTimer.setInterval(1000);
+    connect(&m_importsRescanTimer, &QTimer::timeout, this, [this]() { scanDownloadFolders(false, true); });
     m_makeMkvDialog = new MakeMkvDialog(this);
 
     connect(m_extractor, &Extractor::sigError, this, &DownloadsWidget::onExtractorError);
     connect(m_extractor, &Extractor::sigFinished, this, &DownloadsWidget::onExtractorFinished);
     connect(m_extractor, &Extractor::sigProgress, this, &DownloadsWidget::onExtractorProgress);
+    connect(m_extractor, &Extractor::sigFileExtracted, this, [this]() {
+        if (!m_importsRescanTimer.isActive()) {
+            m_importsRescanTimer.start();
+        }
+    });
     connect(ui->btnImportMakeMkv, &QAbstractButton::clicked, this, &DownloadsWidget::onImportWithMakeMkv);
 
     connect(Manager::instance()->tvShowFileSearcher(),
@@ -249,6 +257,7 @@ void DownloadsWidget::updateImportsList(const QMap<QString, mediaelch::DownloadF
     ui->tableImports->clearContents();
     ui->tableImports->setRowCount(0);
 
+    QStringList baseNames;
     QMapIterator<QString, mediaelch::DownloadFileSearcher::Import> it(imports);
     while (it.hasNext()) {
         it.next();
@@ -258,6 +267,7 @@ void DownloadsWidget::updateImportsList(const QMap<QString, mediaelch::DownloadF
 
         int row = ui->tableImports->rowCount();
         ui->tableImports->insertRow(row);
+        baseNames << it.value().baseName;
         auto* itemBaseName = new MyTableWidgetItem(it.value().baseName);
         itemBaseName->setData(Qt::UserRole, it.value().baseName);
         auto* itemFileCount = new MyTableWidgetItem(tr("%n files", "", files.length()), files.length());
@@ -267,10 +277,6 @@ void DownloadsWidget::updateImportsList(const QMap<QString, mediaelch::DownloadF
         ui->tableImports->setItem(row, 1, itemFileCount);
         ui->tableImports->setItem(row, 2, new MyTableWidgetItem(it.value().size, true));
 
-        QString guessedType;
-        QString guessedDir;
-        bool guessed = Manager::instance()->database()->guessImport(it.value().baseName, guessedType, guessedDir);
-
         auto* importType = new QComboBox(this);
         importType->setProperty("baseName", it.value().baseName);
         importType->addItem(tr("Movie"), "movie");
@@ -298,46 +304,69 @@ void DownloadsWidget::updateImportsList(const QMap<QString, mediaelch::DownloadF
         connect(actions, &ImportActions::sigDialogClosed, this, &DownloadsWidget::scanDownloadsAndImports);
 
         onChangeImportType(0, importType);
+    }
+
+    // Guessing compares the names with all previous imports, so it doesn't block the UI.
+    const int guessRequest = ++m_importGuessRequest;
+    Manager::instance()->database()->guessImports(
+        baseNames, this, [this, guessRequest](QHash<QString, Database::ImportGuess> guesses) {
+            if (guessRequest == m_importGuessRequest) {
+                applyImportGuesses(guesses);
+            }
+        });
+}
 
-        if (guessed) {
-            importType->blockSignals(true);
-            importDetail->blockSignals(true);
-            if (guessedType == "movie") {
-                importType->setCurrentIndex(0);
-                onChangeImportType(0, importType);
-                for (int i = 0, n = importDetail->count(); i < n; ++i) {
-                    if (importDetail->itemText(i) == guessedDir) {
-                        importDetail->setCurrentIndex(i);
-                        onChangeImportDetail(i, importDetail);
-                        break;
-                    }
+void DownloadsWidget::applyImportGuesses(const QHash<QString, Database::ImportGuess>& guesses)
+{
+    for (int row = 0, rowCount = ui->tableImports->rowCount(); row < rowCount; ++row) {
+        const QString baseName = ui->tableImports->item(row, 0)->data(Qt::UserRole).toString();
+        if (!guesses.contains(baseName)) {
+            continue;
+        }
+        const Database::ImportGuess guess = guesses.value(baseName);
+        auto* importType = dynamic_cast<QComboBox*>(ui->tableImports->cellWidget(row, 3));
+        auto* importDetail = dynamic_cast<QComboBox*>(ui->tableImports->cellWidget(row, 4));
+        if (importType == nullptr || importDetail == nullptr) {
+            continue;
+        }
+        importType->blockSignals(true);
+        importDetail->blockSignals(true);
+        if (guess.type == "movie") {
+            importType->setCurrentIndex(0);
+            onChangeImportType(0, importType);
+            for (int i = 0, n = importDetail->count(); i < n; ++i) {
+                if (importDetail->itemText(i) == guess.path) {
+                    importDetail->setCurrentIndex(i);
+                    onChangeImportDetail(i, importDetail);
+                    break;
                 }
-            } else if (guessedType == "tvshow") {
-                importType->setCurrentIndex(1);
-                onChangeImportType(1, importType);
-                for (int i = 0, n = importDetail->count(); i < n; ++i) {
-                    if (importDetail->itemData(i, Qt::UserRole).value<TvShow*>()->dir().toString() == guessedDir) {
-                        importDetail->setCurrentIndex(i);
-                        onChangeImportDetail(i, importDetail);
-                        break;
-                    }
+            }
+        } else if (guess.type == "tvshow") {
+            importType->setCurrentIndex(1);
+            onChangeImportType(1, importType);
+            for (int i = 0, n = importDetail->count(); i < n; ++i) {
+                if (importDetail->itemData(i, Qt::UserRole).value<TvShow*>()->dir().toString() == guess.path) {
+                    importDetail->setCurrentIndex(i);
+                    onChangeImportDetail(i, importDetail);
+                    break;
                 }
-            } else if (guessedType == "concert") {
-                importType->setCurrentIndex(2);
-                onChangeImportType(2, importType);
-                for (int i = 0, n = importDetail->count(); i < n; ++i) {
-                    if (importDetail->itemText(i) == guessedDir) {
-                        importDetail->setCurrentIndex(i);
-                        onChangeImportDetail(i, importDetail);
-                        break;
-                    }
+            }
+        } else if (guess.type == "concert") {
+            importType->setCurrentIndex(2);
+            onChangeImportType(2, importType);
+            for (int i = 0, n = importDetail->count(); i < n; ++i) {
+                if (importDetail->itemText(i) == guess.path) {
+                    importDetail->setCurrentIndex(i);
+                    onChangeImportDetail(i, importDetail);
+                    break;
                 }
             }
-            importType->blockSignals(false);
-            importDetail->blockSignals(false);
         }
+        importType->blockSignals(false);
+        importDetail->blockSignals(false);
     }
 }
+
 void DownloadsWidget::onChangeImportType(int currentIndex)
 {
     auto* box = dynamic_cast<QComboBox*>(QObject::sender());
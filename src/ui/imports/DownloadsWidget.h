@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/Database.h"
 #include "imports/DownloadFileSearcher.h"
 #include "imports/Extractor.h"
 #include "ui/imports/MakeMkvDialog.h"
@@ -7,8 +8,10 @@
 #include <QComboBox>
 #include <QElapsedTimer>
 #include <QFileInfo>
+#include <QHash>
 #include <QMap>
 #include <QMutex>
+#include <QTimer>
 #include <QWidget>
 
 namespace Ui {
@@ -48,12 +51,20 @@ private slots:
 
     void onScanFinished(mediaelch::DownloadFileSearcher* searcher);
 
+private:
+    void applyImportGuesses(const QHash<QString, Database::ImportGuess>& guesses);
+
 private:
     Ui::DownloadsWidget* ui;
 
     QMap<QString, mediaelch::DownloadFileSearcher::Package> m_packages;
     QMap<QString, mediaelch::DownloadFileSearcher::Import> m_imports;
     Extractor* m_extractor;
+    /// Rescans the imports shortly after unrar has extracted a file, so that
+    /// extracted files can be imported before the whole package is extracted.
+    QTimer m_importsRescanTimer;
+    /// Only the guesses of the latest imports list are applied.
+    int m_importGuessRequest = 0;
 
     QMutex m_mutex;
     QElapsedTimer m_scanTimer;
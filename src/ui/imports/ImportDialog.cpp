@@ -2,6 +2,7 @@
 #include "ui_ImportDialog.h"
 
 #include "data/ImageCache.h"
+#include "file/FileTransferQueue.h"
 #include "file/NameFormatter.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
@@ -11,6 +12,7 @@
 #include "tv_shows/TvShowFileSearcher.h"
 #include "tv_shows/model/SeasonModelItem.h"
 #include "tv_shows/model/TvShowModelItem.h"
+#include "ui/notifications/NotificationBox.h"
 #include "ui/notifications/Notificator.h"
 
 #include <QMessageBox>
@@ -31,8 +33,6 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     loadingMovie->start();
     ui->loading->setMovie(loadingMovie);
 
-    m_timer.setInterval(500);
-
     m_posterDownloadManager = new DownloadManager(this);
     connect(m_posterDownloadManager,
         &DownloadManager::sigDownloadFinished,
@@ -44,7 +44,6 @@ ImportDialog::ImportDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Import
     connect(ui->concertSearchWidget, &ConcertSearchWidget::sigResultClicked, this, &ImportDialog::onConcertChosen);
     connect(ui->tvShowSearchWidget, &TvShowSearchWidget::sigResultClicked, this, &ImportDialog::onTvShowChosen);
     connect(ui->btnImport, &QAbstractButton::clicked, this, &ImportDialog::onImport);
-    connect(&m_timer, &QTimer::timeout, this, &ImportDialog::onFileWatcherTimeout);
 }
 
 ImportDialog::~ImportDialog()
@@ -102,6 +101,7 @@ int ImportDialog::exec()
     ui->btnReject->setVisible(true);
     ui->btnAccept->setVisible(false);
     ui->progressBar->setValue(0);
+    ui->progressBar->resetFormat();
     ui->labelLoading->setVisible(true);
 
     ui->chkKeepSourceFiles->setChecked(Settings::instance()->keepDownloadSource());
@@ -278,6 +278,11 @@ void ImportDialog::onMovieChosen()
     ui->formLayout->setEnabled(false);
 
     m_movie = new Movie(files());
+    connect(m_movie->controller(),
+        &MovieController::sigLoadError,
+        this,
+        &ImportDialog::onMovieLoadError,
+        Qt::UniqueConnection);
     m_movie->controller()->loadData(
         ids, Manager::instance()->scrapers().movieScraper(ui->movieSearchWidget->scraperId()), infosToLoad);
     connect(m_movie->controller(),
@@ -381,6 +386,12 @@ QString ImportDialog::importDir()
     return m_importDir;
 }
 
+void ImportDialog::onMovieLoadError(Movie* movie, mediaelch::ScraperError error)
+{
+    Q_UNUSED(movie);
+    NotificationBox::instance()->showScraperError(error);
+}
+
 void ImportDialog::onMovieLoadDone(Movie* movie)
 {
     if (movie != m_movie) {
@@ -609,51 +620,46 @@ void ImportDialog::onImport()
     ui->loading->setVisible(true);
     ui->btnImport->setEnabled(false);
     ui->btnReject->setEnabled(false);
-    m_worker = new FileWorker();
-    m_worker->setFiles(m_filesToMove);
-    m_workerThread = new QThread(this);
-    if (ui->chkKeepSourceFiles->isChecked()) {
-        connect(m_workerThread.data(), &QThread::started, m_worker.data(), &FileWorker::copyFiles);
-    } else {
-        connect(m_workerThread.data(), &QThread::started, m_worker.data(), &FileWorker::moveFiles);
-    }
-    connect(m_workerThread.data(), &QThread::finished, m_worker.data(), &QObject::deleteLater);
-    connect(m_workerThread.data(), &QThread::finished, m_workerThread.data(), &QObject::deleteLater);
-    connect(m_worker.data(), &FileWorker::sigFinished, m_workerThread.data(), &QThread::quit);
-    connect(m_worker.data(), &FileWorker::sigFinished, this, &ImportDialog::onMovingFilesFinished);
-    m_worker->moveToThread(m_workerThread);
-    m_workerThread->start();
-    m_timer.start();
-}
 
-void ImportDialog::onFileWatcherTimeout()
-{
-    qint64 sourceSize = 0;
-    qint64 destinationSize = 0;
+    using mediaelch::FileTransfer;
+    using mediaelch::FileTransferQueue;
+    FileTransferQueue::Options options;
+    options.transfer.mode =
+        ui->chkKeepSourceFiles->isChecked() ? FileTransfer::Mode::Copy : FileTransfer::Mode::Move;
+    // Sources of moves to other volumes are only removed if their copy is intact.
+    options.transfer.verifyChecksum = true;
+    m_transferQueue = new FileTransferQueue(options, this);
     QMapIterator<QString, QString> it(m_filesToMove);
     while (it.hasNext()) {
         it.next();
-        QFileInfo sourceFi(it.key());
-        sourceSize += sourceFi.size();
-
-        QFileInfo destFi(it.value());
-        if (!destFi.exists()) {
-            continue;
-        }
-        destinationSize += destFi.size();
+        m_transferQueue->add(it.key(), it.value());
     }
+    connect(m_transferQueue.data(), &FileTransferQueue::progress, this, &ImportDialog::onTransferProgress);
+    connect(m_transferQueue.data(), &FileTransferQueue::finished, this, &ImportDialog::onMovingFilesFinished);
+    connect(m_transferQueue.data(), &FileTransferQueue::finished, m_transferQueue.data(), &QObject::deleteLater);
+    m_transferQueue->start();
+}
 
-    if (sourceSize == 0) {
+void ImportDialog::onTransferProgress(qint64 bytesDone, qint64 bytesTotal, qint64 bytesPerSecond)
+{
+    if (bytesTotal == 0) {
         return;
     }
-
-    ui->progressBar->setValue(qRound(static_cast<float>(destinationSize) * 100.0f / static_cast<float>(sourceSize)));
+    ui->progressBar->setValue(qRound(static_cast<double>(bytesDone) * 100.0 / static_cast<double>(bytesTotal)));
+    ui->progressBar->setFormat(
+        tr("%p% (%1 MB/s)").arg(static_cast<double>(bytesPerSecond) / 1000000.0, 0, 'f', 1));
 }
 
-void ImportDialog::onMovingFilesFinished()
+void ImportDialog::onMovingFilesFinished(int failed)
 {
     ui->progressBar->setValue(100);
-    m_timer.stop();
+    ui->progressBar->resetFormat();
+    if (failed > 0) {
+        qCWarning(generic) << "[ImportDialog]" << failed << "files could not be imported";
+        Notificator::instance()->notify(Notificator::Warning,
+            tr("Import failed"),
+            tr("%n files could not be imported. Importing them again resumes the transfer.", "", failed));
+    }
     if (m_type == "movie") {
         m_movie->setFiles(m_newFiles);
         m_movie->setInSeparateFolder(m_separateFolders);
@@ -664,7 +670,6 @@ void ImportDialog::onMovingFilesFinished()
         m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
         m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
         Manager::instance()->database()->add(m_movie, mediaelch::DirectoryPath(importDir()));
-        Manager::instance()->database()->commit();
         Manager::instance()->movieModel()->addMovie(m_movie);
         m_movie = nullptr;
 
@@ -700,7 +705,6 @@ void ImportDialog::onMovingFilesFinished()
         m_concert->controller()->saveData(Manager::instance()->mediaCenterInterface());
         m_concert->controller()->loadData(Manager::instance()->mediaCenterInterface());
         Manager::instance()->database()->add(m_concert, mediaelch::DirectoryPath(importDir()));
-        Manager::instance()->database()->commit();
         Manager::instance()->concertModel()->addConcert(m_concert);
         m_concert = nullptr;
     }
@@ -3,8 +3,8 @@
 #include "concerts/Concert.h"
 #include "globals/DownloadManager.h"
 #include "globals/DownloadManagerElement.h"
-#include "imports/FileWorker.h"
 #include "movies/Movie.h"
+#include "scrapers/ScraperError.h"
 #include "renamer/RenamerDialog.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
@@ -12,13 +12,15 @@
 #include <QCloseEvent>
 #include <QDialog>
 #include <QPointer>
-#include <QThread>
-#include <QTimer>
 
 namespace Ui {
 class ImportDialog;
 }
 
+namespace mediaelch {
+class FileTransferQueue;
+}
+
 class ImportDialog : public QDialog
 {
     Q_OBJECT
@@ -44,13 +46,14 @@ public slots:
 private slots:
     void onMovieChosen();
     void onMovieLoadDone(Movie* movie);
+    void onMovieLoadError(Movie* movie, mediaelch::ScraperError error);
     void onConcertChosen();
     void onConcertLoadDone(Concert* concert);
     void onTvShowChosen();
     void onEpisodeLoadDone(TvShowEpisode* episode);
     void onImport();
-    void onFileWatcherTimeout();
-    void onMovingFilesFinished();
+    void onTransferProgress(qint64 bytesDone, qint64 bytesTotal, qint64 bytesPerSecond);
+    void onMovingFilesFinished(int failed);
     void onEpisodeDownloadFinished(DownloadManagerElement elem);
 
 private:
@@ -64,10 +67,8 @@ private:
     QStringList m_extraFiles;
     QString m_importDir;
     bool m_separateFolders = false;
-    QTimer m_timer;
     QMap<QString, QString> m_filesToMove;
-    QPointer<QThread> m_workerThread;
-    QPointer<FileWorker> m_worker;
+    QPointer<mediaelch::FileTransferQueue> m_transferQueue;
     QStringList m_newFiles;
     DownloadManager* m_posterDownloadManager = nullptr;
 
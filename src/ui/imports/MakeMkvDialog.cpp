@@ -6,6 +6,7 @@
 #include "log/Log.h"
 #include "renamer/RenamerDialog.h"
 #include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "ui/notifications/NotificationBox.h"
 #include "ui/notifications/Notificator.h"
 
 #include <QMessageBox>
@@ -260,12 +261,20 @@ void MakeMkvDialog::onMovieChosen()
     ui->btnImport->setEnabled(false);
 
     m_movie = new Movie(QStringList());
+    connect(
+        m_movie->controller(), &MovieController::sigLoadError, this, &MakeMkvDialog::onLoadError, Qt::UniqueConnection);
     m_movie->controller()->loadData(
         ids, Manager::instance()->scrapers().movieScraper(ui->movieSearchWidget->scraperId()), infosToLoad);
     connect(
         m_movie->controller(), &MovieController::sigLoadDone, this, &MakeMkvDialog::onLoadDone, Qt::UniqueConnection);
 }
 
+void MakeMkvDialog::onLoadError(Movie* movie, mediaelch::ScraperError error)
+{
+    Q_UNUSED(movie);
+    NotificationBox::instance()->showScraperError(error);
+}
+
 void MakeMkvDialog::onLoadDone(Movie* movie)
 {
     if (movie != m_movie) {
@@ -380,7 +389,6 @@ void MakeMkvDialog::importFinished()
     m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
     m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
     Manager::instance()->database()->add(m_movie, mediaelch::DirectoryPath(ui->comboImportDir->currentText()));
-    Manager::instance()->database()->commit();
     Manager::instance()->movieModel()->addMovie(m_movie);
     m_movie = nullptr;
 
@@ -2,6 +2,7 @@
 
 #include "imports/MakeMkvCon.h"
 #include "movies/Movie.h"
+#include "scrapers/ScraperError.h"
 
 #include <QDialog>
 #include <QMap>
@@ -33,6 +34,7 @@ private slots:
     void onImportComplete();
     void onMovieChosen();
     void onLoadDone(Movie* movie);
+    void onLoadError(Movie* movie, mediaelch::ScraperError error);
     void onImport();
     void onDiscBackedUp();
     void onTrackImported(int trackId);
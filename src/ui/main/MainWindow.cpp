@@ -230,6 +230,17 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     connect(ui->movieDuplicatesWidget, &MovieDuplicates::sigJumpToMovie,     this, &MainWindow::onJumpToMovie);
     // clang-format on
 
+    connect(Manager::instance()->movieFileSearcher(),
+        &mediaelch::MovieFileSearcher::directoryOutdated,
+        this,
+        &MainWindow::onMovieDirectoryOutdated);
+    connect(m_fileScannerDialog, &QDialog::finished, this, [this]() {
+        if (m_movieReloadPending) {
+            // The dialog is still closing; start the next scan afterwards.
+            QTimer::singleShot(0, this, &MainWindow::onMovieDirectoryOutdated);
+        }
+    });
+
 #ifdef Q_OS_WIN
     setStyleSheet(styleSheet() + " #centralWidget { border-bottom: 1px solid rgba(0, 0, 0, 100); } ");
 
@@ -681,6 +692,24 @@ void MainWindow::onTriggerReloadAll()
     m_fileScannerDialog->exec();
 }
 
+void MainWindow::onMovieDirectoryOutdated()
+{
+    if (m_fileScannerDialog->isVisible()) {
+        m_movieReloadPending = true;
+        return;
+    }
+    m_movieReloadPending = false;
+    if (!Manager::instance()->movieFileSearcher()->hasOutdatedDirectories()) {
+        // Already scanned by a previous reload.
+        return;
+    }
+
+    qCInfo(generic) << "[MainWindow] Movie directories changed on disk, reloading movies";
+    m_fileScannerDialog->setForceReload(false);
+    m_fileScannerDialog->setReloadType(FileScannerDialog::ReloadType::Movies);
+    m_fileScannerDialog->exec();
+}
+
 void MainWindow::onKodiSyncFinished()
 {
     ui->movieFilesWidget->movieSelectedEmitter();
@@ -67,6 +67,9 @@ private slots:
     void onJumpToMovie(Movie* movie);
     void updateTvShows();
     void onCommandBarOpen();
+    /// \brief Reloads movies if the snapshot of a movie directory turned out to be outdated.
+    ///        Waits for the file scanner dialog if it is currently shown.
+    void onMovieDirectoryOutdated();
 
 private:
     MainWidgets currentTab() const;
@@ -97,4 +100,5 @@ private:
     static MainWindow* m_instance;
     QColor m_buttonColor;
     QColor m_buttonActiveColor;
+    bool m_movieReloadPending = false;
 };
@@ -283,6 +283,7 @@ void SetsWidget::onSortTitleChanged(QTableWidgetItem* item)
         return;
     }
     auto* movie = ui->movies->item(item->row(), 0)->data(Qt::UserRole).value<Movie*>();
+    movie->controller()->hydrate();
     movie->setSortTitle(item->text());
     ui->movies->sortByColumn(1, Qt::AscendingOrder);
     if (!m_moviesToSave[movie->set().name].contains(movie)) {
@@ -316,6 +317,7 @@ void SetsWidget::onAddMovie()
     }
 
     QString setName = ui->sets->item(ui->sets->currentRow(), 0)->text();
+    MovieController::hydrate(movies);
     for (Movie* movie : movies) {
         if (movie->set().name == setName) {
             continue;
@@ -346,6 +348,7 @@ void SetsWidget::onRemoveMovie()
         return;
     }
     auto* movie = ui->movies->item(ui->movies->currentRow(), 0)->data(Qt::UserRole).value<Movie*>();
+    movie->controller()->hydrate();
     m_sets[movie->set().name].removeOne(movie);
     if (!m_moviesToSave[movie->set().name].contains(movie)) {
         m_moviesToSave[movie->set().name].append(movie);
@@ -531,6 +534,7 @@ void SetsWidget::onRemoveMovieSet()
     QString origSetName = ui->sets->item(ui->sets->currentRow(), 0)->data(Qt::UserRole).toString();
     ui->sets->removeRow(ui->sets->currentRow());
 
+    MovieController::hydrate(m_sets[origSetName]);
     for (Movie* movie : m_sets[origSetName]) {
         movie->setSet(MovieSet{});
         movie->setSortTitle("");
@@ -560,6 +564,7 @@ void SetsWidget::onSetNameChanged(QTableWidgetItem* item)
         m_moviesToSave.insert(newName, QVector<Movie*>());
     }
 
+    MovieController::hydrate(m_sets[origSetName]);
     for (Movie* movie : m_sets[origSetName]) {
         m_moviesToSave[newName].append(movie);
         MovieSet set;
@@ -153,11 +153,17 @@ void CertificationWidget::onCertificationNameChanged(QTableWidgetItem* item)
         return;
     }
 
+    QVector<Movie*> movies;
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->certification() == origName) {
-            movie->setCertification(newName);
+            movies << movie;
         }
     }
+    // Load all details of the movies so that none are lost when they are saved.
+    MovieController::hydrate(movies);
+    for (Movie* movie : asConst(movies)) {
+        movie->setCertification(newName);
+    }
 
     ui->certificationName->setText(newName.toString());
     item->setData(Qt::UserRole, newName.toString());
@@ -220,11 +226,17 @@ void CertificationWidget::deleteCertification()
         Certification(ui->certifications->item(ui->certifications->currentRow(), 0)->data(Qt::UserRole).toString());
     ui->certifications->removeRow(ui->certifications->currentRow());
 
+    QVector<Movie*> movies;
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->certification() == certification) {
-            movie->setCertification(Certification::NoCertification);
+            movies << movie;
         }
     }
+    // Load all details of the movies so that none are lost when they are saved.
+    MovieController::hydrate(movies);
+    for (Movie* movie : asConst(movies)) {
+        movie->setCertification(Certification::NoCertification);
+    }
     m_addedCertifications.removeOne(certification);
 }
 
@@ -243,6 +255,7 @@ void CertificationWidget::removeMovie()
     }
 
     auto* movie = ui->movies->item(ui->movies->currentRow(), 0)->data(Qt::UserRole).value<Movie*>();
+    movie->controller()->hydrate();
     movie->setCertification(Certification::NoCertification);
     ui->movies->removeRow(ui->movies->currentRow());
 }
@@ -265,6 +278,7 @@ void CertificationWidget::addMovie()
         return;
     }
 
+    MovieController::hydrate(movies);
     for (Movie* movie : movies) {
         movie->setCertification(cert);
     }
@@ -156,12 +156,18 @@ void GenreWidget::onGenreNameChanged(QTableWidgetItem* item)
         return;
     }
 
+    QVector<Movie*> movies;
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->genres().contains(origName)) {
-            movie->removeGenre(origName);
-            if (!movie->genres().contains(newName)) {
-                movie->addGenre(newName);
-            }
+            movies << movie;
+        }
+    }
+    // Load all details of the movies so that none are lost when they are saved.
+    MovieController::hydrate(movies);
+    for (Movie* movie : asConst(movies)) {
+        movie->removeGenre(origName);
+        if (!movie->genres().contains(newName)) {
+            movie->addGenre(newName);
         }
     }
     ui->genreName->setText(newName);
@@ -223,11 +229,17 @@ void GenreWidget::deleteGenre()
     QString origGenreName = ui->genres->item(ui->genres->currentRow(), 0)->data(Qt::UserRole).toString();
     ui->genres->removeRow(ui->genres->currentRow());
 
+    QVector<Movie*> movies;
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->genres().contains(genreName)) {
-            movie->removeGenre(genreName);
+            movies << movie;
         }
     }
+    // Load all details of the movies so that none are lost when they are saved.
+    MovieController::hydrate(movies);
+    for (Movie* movie : asConst(movies)) {
+        movie->removeGenre(genreName);
+    }
 
     m_addedGenres.removeOne(origGenreName);
 }
@@ -248,6 +260,7 @@ void GenreWidget::removeMovie()
 
     QString genreName = ui->genres->item(ui->genres->currentRow(), 0)->data(Qt::UserRole).toString();
     auto* movie = ui->movies->item(ui->movies->currentRow(), 0)->data(Qt::UserRole).value<Movie*>();
+    movie->controller()->hydrate();
     movie->removeGenre(genreName);
     ui->movies->removeRow(ui->movies->currentRow());
 }
@@ -269,6 +282,7 @@ void GenreWidget::addMovie()
     }
 
     QString genreName = ui->genres->item(ui->genres->currentRow(), 0)->text();
+    MovieController::hydrate(movies);
     for (Movie* movie : movies) {
         if (movie->genres().contains(genreName)) {
             continue;
@@ -190,9 +190,13 @@ void MovieFilesWidget::markAsWatched()
 {
     m_contextMenu->close();
 
+    QVector<Movie*> movies;
     for (const QModelIndex& index : ui->files->selectionModel()->selectedRows(0)) {
         const int row = index.model()->data(index, Qt::UserRole).toInt();
-        Movie* movie = Manager::instance()->movieModel()->movie(row);
+        movies << Manager::instance()->movieModel()->movie(row);
+    }
+    MovieController::hydrate(movies);
+    for (Movie* movie : asConst(movies)) {
         if (movie->playcount() < 1) {
             movie->setPlayCount(1);
         }
@@ -200,7 +204,7 @@ void MovieFilesWidget::markAsWatched()
             movie->setLastPlayed(QDateTime::currentDateTime());
         }
     }
-    if (ui->files->selectionModel()->selectedRows(0).count() > 0) {
+    if (!movies.isEmpty()) {
         movieSelectedEmitter();
     }
 }
@@ -209,12 +213,16 @@ void MovieFilesWidget::markAsUnwatched()
 {
     m_contextMenu->close();
 
+    QVector<Movie*> movies;
     for (const QModelIndex& index : ui->files->selectionModel()->selectedRows(0)) {
         const int row = index.model()->data(index, Qt::UserRole).toInt();
-        Movie* movie = Manager::instance()->movieModel()->movie(row);
+        movies << Manager::instance()->movieModel()->movie(row);
+    }
+    MovieController::hydrate(movies);
+    for (Movie* movie : asConst(movies)) {
         movie->setPlayCount(0);
     }
-    if (ui->files->selectionModel()->selectedRows(0).count() > 0) {
+    if (!movies.isEmpty()) {
         movieSelectedEmitter();
     }
 }
@@ -228,6 +236,7 @@ void MovieFilesWidget::loadStreamDetails()
         Movie* movie = Manager::instance()->movieModel()->movie(row);
         movies.append(movie);
     }
+    MovieController::hydrate(movies);
     if (movies.count() == 1) {
         movies.at(0)->controller()->loadStreamDetailsFromFile();
         movies.at(0)->setChanged(true);
@@ -6,6 +6,7 @@
 #include "scrapers/movie/imdb/ImdbMovie.h"
 #include "scrapers/movie/tmdb/TmdbMovie.h"
 #include "settings/Settings.h"
+#include "ui/notifications/NotificationBox.h"
 #include "ui/small_widgets/MyCheckBox.h"
 
 MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget* parent) : QDialog(parent), ui(new Ui::MovieMultiScrapeDialog)
@@ -175,6 +176,12 @@ void MovieMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
+void MovieMultiScrapeDialog::onLoadError(Movie* movie, mediaelch::ScraperError error)
+{
+    Q_UNUSED(movie);
+    NotificationBox::instance()->showScraperError(error);
+}
+
 void MovieMultiScrapeDialog::scrapeNext()
 {
     using namespace mediaelch::scraper;
@@ -214,6 +221,11 @@ void MovieMultiScrapeDialog::scrapeNext()
         this,
         &MovieMultiScrapeDialog::scrapeNext,
         Qt::UniqueConnection);
+    connect(m_currentMovie->controller(),
+        &MovieController::sigLoadError,
+        this,
+        &MovieMultiScrapeDialog::onLoadError,
+        Qt::UniqueConnection);
     connect(m_currentMovie->controller(),
         &MovieController::sigDownloadProgress,
         this,
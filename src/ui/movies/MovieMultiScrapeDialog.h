@@ -2,6 +2,7 @@
 
 #include "globals/ScraperResult.h"
 #include "movies/Movie.h"
+#include "scrapers/ScraperError.h"
 #include "scrapers/movie/MovieIdentifier.h"
 
 #include <QDialog>
@@ -38,6 +39,7 @@ private slots:
     void onScrapingFinished();
     void onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob);
     void scrapeNext();
+    void onLoadError(Movie* movie, mediaelch::ScraperError error);
     void onProgress(Movie* movie, int current, int maximum);
     void onChkToggled();
     void onChkAllToggled();
@@ -9,6 +9,7 @@
 #include "globals/LocaleStringCompare.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
+#include "globals/SaveQueue.h"
 #include "globals/TrailerDialog.h"
 #include "image/ImageCapture.h"
 #include "scrapers/movie/custom/CustomMovieScraper.h"
@@ -357,6 +358,8 @@ void MovieWidget::setMovie(Movie* movie)
 {
     using namespace std::chrono;
     qCDebug(generic) << "Entered, movie=" << movie->name();
+    // Load all details before the movie can be edited; loadData() does nothing for changed movies.
+    movie->controller()->hydrate();
     movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
     if (!movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         movie->controller()->loadStreamDetailsFromFile();
@@ -375,6 +378,8 @@ void MovieWidget::setMovie(Movie* movie)
         &MovieWidget::onInfoLoadDone,
         Qt::UniqueConnection);
     connect(m_movie->controller(), &MovieController::sigLoadDone, this, &MovieWidget::onLoadDone, Qt::UniqueConnection);
+    connect(
+        m_movie->controller(), &MovieController::sigLoadError, this, &MovieWidget::onLoadError, Qt::UniqueConnection);
     connect(m_movie->controller(),
         &MovieController::sigDownloadProgress,
         this,
@@ -460,6 +465,12 @@ void MovieWidget::onInfoLoadDone(Movie* movie)
     }
 }
 
+void MovieWidget::onLoadError(Movie* movie, mediaelch::ScraperError error)
+{
+    Q_UNUSED(movie);
+    NotificationBox::instance()->showScraperError(error);
+}
+
 void MovieWidget::onLoadDone(Movie* movie)
 {
     emit actorDownloadFinished(Constants::MovieProgressMessageId + movie->movieId());
@@ -878,44 +889,25 @@ void MovieWidget::onPlayLocalTrailer()
 void MovieWidget::saveInformation()
 {
     qCDebug(generic) << "[Movie] Save movie";
-    setDisabledTrue();
 
     QVector<Movie*> movies = MovieFilesWidget::instance()->selectedMovies();
     if (movies.isEmpty()) {
         movies.append(m_movie);
     }
 
-    m_savingWidget->show();
     if (movies.count() > 1) {
-        int counter = 0;
-        const int moviesToSave = movies.count();
-
-        NotificationBox::instance()->showProgressBar(tr("Saving movies..."), Constants::MovieWidgetProgressMessageId);
-        NotificationBox::instance()->progressBarProgress(0, moviesToSave, Constants::MovieWidgetProgressMessageId);
-        QApplication::processEvents();
-        for (Movie* movie : movies) {
-            if (movie->hasChanged()) {
-                counter++;
-                NotificationBox::instance()->progressBarProgress(
-                    counter, moviesToSave, Constants::MovieWidgetProgressMessageId);
-                QApplication::processEvents();
-                movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-                movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-                if (m_movie == movie) {
-                    updateMovieInfo();
-                }
-            }
-        }
-        NotificationBox::instance()->hideProgressBar(Constants::MovieWidgetProgressMessageId);
-        NotificationBox::instance()->showSuccess(tr("Movies Saved"));
-    } else {
-        const int id = NotificationBox::instance()->showMessage(tr("Saving movie..."));
-        m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-        m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-        updateMovieInfo();
-        NotificationBox::instance()->removeMessage(id);
-        NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_movie->name()));
+        saveInBackground(movies, tr("Movies Saved"));
+        return;
     }
+
+    setDisabledTrue();
+    m_savingWidget->show();
+    const int id = NotificationBox::instance()->showMessage(tr("Saving movie..."));
+    m_movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    m_movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
+    updateMovieInfo();
+    NotificationBox::instance()->removeMessage(id);
+    NotificationBox::instance()->showSuccess(tr("<b>\"%1\"</b> Saved").arg(m_movie->name()));
     setEnabledTrue();
     m_savingWidget->hide();
     ui->buttonRevert->setVisible(false);
@@ -927,40 +919,67 @@ void MovieWidget::saveInformation()
 void MovieWidget::saveAll()
 {
     qCDebug(generic) << "[Movies] Save all movies";
-    setDisabledTrue();
-    m_savingWidget->show();
-
-    int counter = 0;
-    int moviesToSave = 0;
+    QVector<Movie*> movies;
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->hasChanged()) {
-            moviesToSave++;
+            movies.append(movie);
         }
     }
+    saveInBackground(movies, tr("All Movies Saved"));
+}
 
-    NotificationBox::instance()->showProgressBar(tr("Saving movies..."), Constants::MovieWidgetProgressMessageId);
-    NotificationBox::instance()->progressBarProgress(0, moviesToSave, Constants::MovieWidgetProgressMessageId);
-    QApplication::processEvents();
+/// \brief Saves the given movies using a SaveQueue, so that the UI stays responsive.
+void MovieWidget::saveInBackground(const QVector<Movie*>& movies, const QString& successMessage)
+{
+    if (m_saveQueue != nullptr) {
+        qCInfo(generic) << "[MovieWidget] Still saving, ignoring save request";
+        return;
+    }
+    setDisabledTrue();
+    m_savingWidget->show();
 
-    const auto movies = Manager::instance()->movieModel()->movies();
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
+    m_saveQueue = new mediaelch::SaveQueue(Manager::instance()->database()->service(), this);
+    QPointer<MovieWidget> widget(this);
     for (Movie* movie : movies) {
-        if (movie->hasChanged()) {
-            counter++;
-            NotificationBox::instance()->progressBarProgress(
-                counter, moviesToSave, Constants::MovieWidgetProgressMessageId);
-            QApplication::processEvents();
-            movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-            movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-            if (m_movie == movie) {
-                updateMovieInfo();
-            }
+        if (!movie->hasChanged()) {
+            continue;
         }
+        m_saveQueue->add(
+            movie,
+            [movie, mediaCenter]() { return movie->controller()->saveData(mediaCenter); },
+            [widget, movie, mediaCenter](bool success) {
+                if (!success) {
+                    // saveData() marks the movie as unchanged before its files are written.
+                    movie->setChanged(true);
+                    return;
+                }
+                // The NFO file is written by now; its content is stored in the movie.
+                movie->controller()->loadData(mediaCenter, true, false);
+                if (!widget.isNull() && widget->m_movie == movie) {
+                    widget->updateMovieInfo();
+                }
+            });
     }
-    setEnabledTrue();
-    m_savingWidget->hide();
-    NotificationBox::instance()->hideProgressBar(Constants::MovieWidgetProgressMessageId);
-    NotificationBox::instance()->showSuccess(tr("All Movies Saved"));
-    ui->buttonRevert->setVisible(false);
+
+    NotificationBox::instance()->showProgressBar(tr("Saving movies..."), Constants::MovieWidgetProgressMessageId);
+    connect(m_saveQueue, &mediaelch::SaveQueue::progress, this, [](int done, int total) {
+        NotificationBox::instance()->progressBarProgress(done, total, Constants::MovieWidgetProgressMessageId);
+    });
+    connect(m_saveQueue, &mediaelch::SaveQueue::finished, this, [this, successMessage](int failed) {
+        setEnabledTrue();
+        m_savingWidget->hide();
+        NotificationBox::instance()->hideProgressBar(Constants::MovieWidgetProgressMessageId);
+        if (failed > 0) {
+            NotificationBox::instance()->showError(tr("%n movie(s) could not be saved", "", failed));
+        } else {
+            NotificationBox::instance()->showSuccess(successMessage);
+        }
+        ui->buttonRevert->setVisible(false);
+        m_saveQueue->deleteLater();
+        m_saveQueue = nullptr;
+    });
+    m_saveQueue->start();
 }
 
 /// \brief Revert changes for current movie
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "movies/Movie.h"
+#include "scrapers/ScraperError.h"
 
 #include <QCompleter>
 #include <QLabel>
@@ -17,6 +18,10 @@ class MovieWidget;
 
 class ClosableImage;
 
+namespace mediaelch {
+class SaveQueue;
+}
+
 class MovieWidget : public QWidget
 {
     Q_OBJECT
@@ -51,6 +56,7 @@ private slots:
     void onInfoLoadDone(Movie* movie);
     void onLoadStarted(Movie* movie);
     void onLoadDone(Movie* movie);
+    void onLoadError(Movie* movie, mediaelch::ScraperError error);
     void onLoadImagesStarted(Movie* movie);
     void onLoadingImages(Movie* movie, QVector<ImageType> imageTypes);
     void onDownloadProgress(Movie* movie, int current, int maximum);
@@ -115,6 +121,7 @@ private slots:
 
 private:
     void updateImage(ImageType imageType, ClosableImage* image);
+    void saveInBackground(const QVector<Movie*>& movies, const QString& successMessage);
 
 private:
     Ui::MovieWidget* ui;
@@ -125,6 +132,7 @@ private:
     QVector<QVector<QLineEdit*>> m_streamDetailsAudio;
     QVector<QVector<QLineEdit*>> m_streamDetailsSubtitles;
     QLabel* m_backgroundLabel;
+    QPointer<mediaelch::SaveQueue> m_saveQueue;
 
     void updateImages(QVector<ImageType> images);
 };
@@ -4,6 +4,7 @@
 #include "globals/Manager.h"
 #include "music/Album.h"
 #include "music/Artist.h"
+#include "music/MusicScrapeScheduler.h"
 #include "settings/Settings.h"
 
 MusicMultiScrapeDialog::MusicMultiScrapeDialog(QWidget* parent) : QDialog(parent), ui(new Ui::MusicMultiScrapeDialog)
@@ -99,7 +100,7 @@ bool MusicMultiScrapeDialog::isExecuted() const
 
 int MusicMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    abortScraping();
     ui->itemCounter->setVisible(false);
     ui->btnCancel->setVisible(true);
     ui->btnClose->setVisible(false);
@@ -122,61 +123,57 @@ int MusicMultiScrapeDialog::exec()
 
 void MusicMultiScrapeDialog::accept()
 {
-    disconnectScrapers();
+    abortScraping();
     m_executed = false;
     QDialog::accept();
 }
 
 void MusicMultiScrapeDialog::reject()
 {
-    disconnectScrapers();
+    abortScraping();
     m_executed = false;
-    if (m_currentAlbum != nullptr) {
-        m_currentAlbum->controller()->abortDownloads();
-    }
-    if (m_currentArtist != nullptr) {
-        m_currentArtist->controller()->abortDownloads();
-    }
-    m_queue.clear();
     QDialog::reject();
 }
 
-void MusicMultiScrapeDialog::disconnectScrapers() const
+void MusicMultiScrapeDialog::abortScraping()
 {
-    using namespace mediaelch::scraper;
-    for (MusicScraper* scraper : Manager::instance()->scrapers().musicScrapers()) {
-        disconnect(scraper, &MusicScraper::sigSearchDone, this, &MusicMultiScrapeDialog::onSearchFinished);
+    if (m_scheduler != nullptr) {
+        m_scheduler->abort();
+        m_scheduler->deleteLater();
+        m_scheduler = nullptr;
     }
+    m_currentArtist = nullptr;
+    m_currentAlbum = nullptr;
 }
 
 void MusicMultiScrapeDialog::onStartScraping()
 {
-    disconnectScrapers();
-
     ui->groupBox->setEnabled(false);
     ui->btnStartScraping->setEnabled(false);
     ui->chkAutoSave->setEnabled(false);
     ui->chkScrapeAllAlbums->setEnabled(false);
 
+    abortScraping();
     m_scraperInterface = Manager::instance()->scrapers().musicScrapers().at(0);
-    connect(m_scraperInterface,
-        &mediaelch::scraper::MusicScraper::sigSearchDone,
-        this,
-        &MusicMultiScrapeDialog::onSearchFinished,
-        Qt::UniqueConnection);
+    // Several items are scraped at once so that the scrape is bound by the sites' rate limits
+    // and not by the time each request takes.
+    m_scheduler = new mediaelch::MusicScrapeScheduler(m_scraperInterface, this);
+    m_scheduler->setArtistInfos(m_artistInfosToLoad);
+    m_scheduler->setAlbumInfos(m_albumInfosToLoad);
+    using mediaelch::MusicScrapeScheduler;
+    connect(m_scheduler, &MusicScrapeScheduler::artistStarted, this, &MusicMultiScrapeDialog::onArtistStarted);
+    connect(m_scheduler, &MusicScrapeScheduler::albumStarted, this, &MusicMultiScrapeDialog::onAlbumStarted);
+    connect(m_scheduler, &MusicScrapeScheduler::artistFinished, this, &MusicMultiScrapeDialog::onArtistFinished);
+    connect(m_scheduler, &MusicScrapeScheduler::albumFinished, this, &MusicMultiScrapeDialog::onAlbumFinished);
+    connect(m_scheduler, &MusicScrapeScheduler::progress, this, &MusicMultiScrapeDialog::onScrapeProgress);
+    connect(m_scheduler, &MusicScrapeScheduler::finished, this, &MusicMultiScrapeDialog::onScrapingFinished);
 
     QVector<Album*> queueAlbums;
     for (Artist* artist : m_artists) {
-        QueueItem item1{};
-        item1.album = nullptr;
-        item1.artist = artist;
-        m_queue.append(item1);
+        m_scheduler->add(artist);
         if (ui->chkScrapeAllAlbums->isChecked()) {
             for (Album* album : artist->albums()) {
-                QueueItem item2{};
-                item2.album = album;
-                item2.artist = nullptr;
-                m_queue.append(item2);
+                m_scheduler->add(album);
                 queueAlbums.append(album);
             }
         }
@@ -184,18 +181,15 @@ void MusicMultiScrapeDialog::onStartScraping()
 
     for (Album* album : m_albums) {
         if (!queueAlbums.contains(album)) {
-            QueueItem item{};
-            item.album = album;
-            item.artist = nullptr;
-            m_queue.append(item);
+            m_scheduler->add(album);
             queueAlbums.append(album);
         }
     }
 
-    ui->itemCounter->setText(QString("0/%1").arg(m_queue.count()));
+    ui->itemCounter->setText(QString("0/%1").arg(m_scheduler->count()));
     ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(m_queue.count());
-    scrapeNext();
+    ui->progressAll->setMaximum(m_scheduler->count());
+    m_scheduler->start();
 }
 
 void MusicMultiScrapeDialog::onScrapingFinished()
@@ -209,112 +203,64 @@ void MusicMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
-void MusicMultiScrapeDialog::scrapeNext()
+void MusicMultiScrapeDialog::onArtistStarted(Artist* artist)
 {
     if (!isExecuted()) {
         return;
     }
+    m_currentArtist = artist;
+    m_currentAlbum = nullptr;
+    ui->itemName->setText(artist->name().trimmed());
+    ui->progressItem->setValue(0);
+    connect(artist->controller(),
+        &ArtistController::sigDownloadProgress,
+        this,
+        elchOverload<Artist*, int, int>(&MusicMultiScrapeDialog::onProgress),
+        Qt::UniqueConnection);
+}
 
-    if ((m_currentAlbum != nullptr) && ui->chkAutoSave->isChecked()) {
-        m_currentAlbum->controller()->saveData(Manager::instance()->mediaCenterInterface());
-    }
-
-    if ((m_currentArtist != nullptr) && ui->chkAutoSave->isChecked()) {
-        m_currentArtist->controller()->saveData(Manager::instance()->mediaCenterInterface());
-    }
-
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
+void MusicMultiScrapeDialog::onAlbumStarted(Album* album)
+{
+    if (!isExecuted()) {
         return;
     }
-
-    QueueItem item = m_queue.dequeue();
-    m_currentAlbum = item.album;
-    m_currentArtist = item.artist;
-    if (m_currentAlbum != nullptr) {
-        ui->itemName->setText(m_currentAlbum->title().trimmed());
-    } else if (m_currentArtist != nullptr) {
-        ui->itemName->setText(m_currentArtist->name().trimmed());
-    }
-    ui->itemCounter->setText(
-        QString("%1/%2").arg(ui->progressAll->maximum() - m_queue.count()).arg(ui->progressAll->maximum()));
-    ui->progressAll->setValue(ui->progressAll->maximum() - m_queue.size() - 1);
+    m_currentAlbum = album;
+    m_currentArtist = nullptr;
+    ui->itemName->setText(album->title().trimmed());
     ui->progressItem->setValue(0);
+    connect(album->controller(),
+        &AlbumController::sigDownloadProgress,
+        this,
+        elchOverload<Album*, int, int>(&MusicMultiScrapeDialog::onProgress),
+        Qt::UniqueConnection);
+}
 
-    if (m_currentAlbum != nullptr) {
-        connect(m_currentAlbum->controller(),
-            &AlbumController::sigLoadDone,
-            this,
-            &MusicMultiScrapeDialog::scrapeNext,
-            Qt::UniqueConnection);
-
-        connect(m_currentAlbum->controller(),
-            &AlbumController::sigDownloadProgress,
-            this,
-            elchOverload<Album*, int, int>(&MusicMultiScrapeDialog::onProgress),
-            Qt::UniqueConnection);
-
-        if (m_currentAlbum->mbAlbumId().isValid()) {
-            m_currentAlbum->controller()->loadData(m_currentAlbum->mbAlbumId(),
-                m_currentAlbum->mbReleaseGroupId(),
-                m_scraperInterface,
-                m_albumInfosToLoad);
-
-        } else {
-            m_scraperInterface->searchAlbum(
-                (m_currentAlbum->artist().isEmpty() && (m_currentAlbum->artistObj() != nullptr))
-                    ? m_currentAlbum->artistObj()->name().trimmed()
-                    : m_currentAlbum->artist().trimmed(),
-                m_currentAlbum->title());
-        }
-
-    } else if (m_currentArtist != nullptr) {
-        connect(m_currentArtist->controller(),
-            &ArtistController::sigLoadDone,
-            this,
-            &MusicMultiScrapeDialog::scrapeNext,
-            Qt::UniqueConnection);
-
-        connect(m_currentArtist->controller(),
-            &ArtistController::sigDownloadProgress,
-            this,
-            elchOverload<Artist*, int, int>(&MusicMultiScrapeDialog::onProgress),
-            Qt::UniqueConnection);
-
-        if (m_currentArtist->mbId().isValid()) {
-            m_currentArtist->controller()->loadData(m_currentArtist->mbId(), m_scraperInterface, m_artistInfosToLoad);
+void MusicMultiScrapeDialog::onArtistFinished(Artist* artist)
+{
+    if (isExecuted() && ui->chkAutoSave->isChecked()) {
+        artist->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    }
+}
 
-        } else {
-            m_scraperInterface->searchArtist(m_currentArtist->name().trimmed());
-        }
+void MusicMultiScrapeDialog::onAlbumFinished(Album* album)
+{
+    if (isExecuted() && ui->chkAutoSave->isChecked()) {
+        album->controller()->saveData(Manager::instance()->mediaCenterInterface());
     }
 }
 
-void MusicMultiScrapeDialog::onSearchFinished(QVector<ScraperSearchResult> results)
+void MusicMultiScrapeDialog::onScrapeProgress(int done, int total)
 {
     if (!isExecuted()) {
         return;
     }
-    if (results.isEmpty()) {
-        scrapeNext();
-        return;
-    }
-
-    if (m_currentArtist != nullptr) {
-        m_currentArtist->controller()->loadData(
-            MusicBrainzId(results.first().id), m_scraperInterface, m_artistInfosToLoad);
-    } else if (m_currentAlbum != nullptr) {
-        m_currentAlbum->controller()->loadData(MusicBrainzId(results.first().id),
-            MusicBrainzId(results.first().id2),
-            m_scraperInterface,
-            m_albumInfosToLoad);
-    }
+    ui->itemCounter->setText(QString("%1/%2").arg(done).arg(total));
+    ui->progressAll->setValue(done);
 }
 
 void MusicMultiScrapeDialog::onProgress(Artist* artist, int current, int maximum)
 {
-    Q_UNUSED(artist);
-    if (!isExecuted()) {
+    if (!isExecuted() || artist != m_currentArtist) {
         return;
     }
     ui->progressItem->setValue(maximum - current);
@@ -323,8 +269,7 @@ void MusicMultiScrapeDialog::onProgress(Artist* artist, int current, int maximum
 
 void MusicMultiScrapeDialog::onProgress(Album* album, int current, int maximum)
 {
-    Q_UNUSED(album);
-    if (!isExecuted()) {
+    if (!isExecuted() || album != m_currentAlbum) {
         return;
     }
     ui->progressItem->setValue(maximum - current);
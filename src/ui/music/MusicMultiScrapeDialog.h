@@ -2,16 +2,18 @@
 
 #include "globals/Globals.h"
 #include "globals/ScraperInfos.h"
-#include "globals/ScraperResult.h"
 #include "scrapers/music/MusicScraper.h"
 
 #include <QDialog>
-#include <QQueue>
 #include <QVector>
 
 class Album;
 class Artist;
 
+namespace mediaelch {
+class MusicScrapeScheduler;
+}
+
 namespace Ui {
 class MusicMultiScrapeDialog;
 }
@@ -36,25 +38,23 @@ private slots:
     void onChkAllToggled(bool toggled);
     void onStartScraping();
     void onScrapingFinished();
-    void onSearchFinished(QVector<ScraperSearchResult> results);
-    void scrapeNext();
+    void onArtistStarted(Artist* artist);
+    void onAlbumStarted(Album* album);
+    void onArtistFinished(Artist* artist);
+    void onAlbumFinished(Album* album);
+    void onScrapeProgress(int done, int total);
     void onProgress(Artist* artist, int current, int maximum);
     void onProgress(Album* album, int current, int maximum);
 
 private:
     Ui::MusicMultiScrapeDialog* ui;
 
-    struct QueueItem
-    {
-        Artist* artist;
-        Album* album;
-    };
-
-    void disconnectScrapers() const;
     bool isExecuted() const;
+    void abortScraping();
 
-    QQueue<QueueItem> m_queue;
     bool m_executed;
+    mediaelch::MusicScrapeScheduler* m_scheduler = nullptr;
+    /// Most recently started item; its progress is shown.
     Artist* m_currentArtist = nullptr;
     Album* m_currentAlbum = nullptr;
     QSet<MusicScraperInfo> m_artistInfosToLoad;
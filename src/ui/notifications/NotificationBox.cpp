@@ -50,6 +50,15 @@ void NotificationBox::adjustSize()
     resize(this->size().width(), height);
 }
 
+void NotificationBox::showScraperError(const mediaelch::ScraperError& error)
+{
+    using namespace std::chrono_literals;
+    // TODO: 404 not necessary but avoids false positives at the moment.
+    if (error.hasError() && !error.is404()) {
+        showError(error.message, 6s);
+    }
+}
+
 /**
  * \todo: use type to display different styles
  */
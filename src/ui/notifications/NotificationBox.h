@@ -1,6 +1,7 @@
 #pragma once
 
 #include "globals/Globals.h"
+#include "scrapers/ScraperError.h"
 #include "ui/main/Message.h"
 
 #include <QSize>
@@ -48,6 +49,10 @@ public:
         return showMessage(message, NotificationType::NotificationInfo, timeout);
     }
 
+    /// \brief Shows the error of a scraper load. "Not found" errors are not shown, because
+    ///        some providers return them for IDs of other providers.
+    void showScraperError(const mediaelch::ScraperError& error);
+
     void showProgressBar(QString message, int id, bool unique = false);
     int addProgressBar(QString message);
     void hideProgressBar(int id);
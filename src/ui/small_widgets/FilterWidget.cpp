@@ -5,8 +5,8 @@
 
 #include "globals/Globals.h"
 #include "globals/Helper.h"
-#include "globals/LocaleStringCompare.h"
 #include "globals/Manager.h"
+#include "movies/MovieFacetIndex.h"
 #include "ui/main/MainWindow.h"
 #include "ui/main/Navbar.h"
 
@@ -38,10 +38,13 @@ FilterWidget::FilterWidget(QWidget* parent) :
 FilterWidget::~FilterWidget()
 {
     // Delete original filters
-    // todo: There are still memory leaks when using setupMovieFilters()
     for (Filter* filter : m_availableMovieFilters) {
         delete filter;
     }
+    for (const QHash<QString, Filter*>& filters : m_movieFacetFilters) {
+        qDeleteAll(filters);
+    }
+    qDeleteAll(m_movieLabelFilters);
     for (Filter* filter : m_availableTvShowFilters) {
         delete filter;
     }
@@ -288,121 +291,58 @@ void FilterWidget::setupFilters()
 
 /**
  * \brief Sets up movie filters
+ * Genres, studios, etc. are taken from the movie model's facet index. The filters
+ * are only rebuilt if the index has changed since the last call.
  */
 QVector<Filter*> FilterWidget::setupMovieFilters()
 {
-    // Load available genres/directors/etc.
-
-    QStringList years;
-    QStringList genres;
-    QStringList certifications;
-    QStringList studios;
-    QStringList countries;
-    QStringList tags;
-    QStringList directors;
-    QStringList videocodecs;
-    // TODO: QVector<MovieSet>
-    QStringList sets;
-
-    const auto copyNotEmptyUnique = [](const QStringList& from, QStringList& to) {
-        for (const QString& str : from) {
-            if (!str.isEmpty() && !to.contains(str)) {
-                to.append(str);
-            }
-        }
-    };
-
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
-        copyNotEmptyUnique(movie->genres(), genres);
-        copyNotEmptyUnique(movie->studios(), studios);
-        copyNotEmptyUnique(movie->countries(), countries);
-        copyNotEmptyUnique(movie->tags(), tags);
+    using mediaelch::MovieFacet;
+    using mediaelch::MovieFacetIndex;
 
-        if (!directors.contains(movie->director())) {
-            directors.append(movie->director());
-        }
-        if (!videocodecs.contains(movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Codec))) {
-            videocodecs.append(movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::Codec));
-        }
-        if (movie->released().isValid() && !years.contains(QString::number(movie->released().year()))) {
-            years.append(QString::number(movie->released().year()));
-        }
-        const auto certStr = movie->certification().toString();
-        if (movie->certification().isValid() && !certifications.contains(certStr)) {
-            certifications.append(certStr);
-        }
-        if (!movie->set().name.isEmpty() && !sets.contains(movie->set().name)) {
-            sets.append(movie->set().name);
-        }
+    const MovieFacetIndex& index = Manager::instance()->movieModel()->facetIndex();
+    if (m_movieFiltersValid && m_movieFiltersRevision == index.revision()) {
+        return m_movieFilters;
     }
 
-    const auto sortByLocaleCompare = [](QStringList& list) {
-        std::sort(list.begin(), list.end(), LocaleStringCompare());
-    };
-    sortByLocaleCompare(certifications);
-    sortByLocaleCompare(genres);
-    sortByLocaleCompare(years);
-    sortByLocaleCompare(studios);
-    sortByLocaleCompare(countries);
-    sortByLocaleCompare(tags);
-    sortByLocaleCompare(directors);
-    sortByLocaleCompare(videocodecs);
-    sortByLocaleCompare(sets);
-
-    // Set new filters
-
-    const auto setNewFilters = [](const QStringList& filtersToApply, QString filterTypeName, MovieFilters infoType) {
-        QVector<Filter*> newFilters;
-        for (const QString& filterName : filtersToApply) {
-            newFilters << new Filter(QStringLiteral("%1 \"%2\"").arg(filterTypeName, filterName),
-                filterName,
-                QStringList() << filterTypeName << filterName,
-                infoType,
-                true);
-        }
-        return newFilters;
-    };
-
     // clang-format off
-    QVector<Filter *> movieGenreFilters         = setNewFilters(genres,         tr("Genre"),         MovieFilters::Genres);
-    QVector<Filter *> movieStudioFilters        = setNewFilters(studios,        tr("Studio"),        MovieFilters::Studio);
-    QVector<Filter *> movieCountryFilters       = setNewFilters(countries,      tr("Country"),       MovieFilters::Country);
-    QVector<Filter *> movieSetsFilters          = setNewFilters(sets,           tr("Set"),           MovieFilters::Set);
-    QVector<Filter *> movieTagsFilters          = setNewFilters(tags,           tr("Tag"),           MovieFilters::Tags);
-    QVector<Filter *> movieDirectorFilters      = setNewFilters(directors,      tr("Director"),      MovieFilters::Director);
-    QVector<Filter *> movieVideoCodecFilters    = setNewFilters(videocodecs,    tr("Video codec"),   MovieFilters::VideoCodec);
-    QVector<Filter *> movieCertificationFilters = setNewFilters(certifications, tr("Certification"), MovieFilters::Certification);
+    const QVector<QPair<MovieFacet, QString>> facets = {
+        {MovieFacet::Genre,         tr("Genre")},
+        {MovieFacet::Studio,        tr("Studio")},
+        {MovieFacet::Country,       tr("Country")},
+        {MovieFacet::Year,          tr("Year")},
+        {MovieFacet::Certification, tr("Certification")},
+        {MovieFacet::Set,           tr("Set")},
+        {MovieFacet::Tag,           tr("Tag")},
+        {MovieFacet::Director,      tr("Director")},
+        {MovieFacet::VideoCodec,    tr("Video codec")},
+    };
     // clang-format on
 
-    QVector<Filter*> movieYearFilters;
-    for (const QString& year : years) {
-        movieYearFilters << new Filter(
-            tr("Released %1").arg(year), year, QStringList() << tr("Year") << year, MovieFilters::Released, true);
-    }
-
-    QVector<Filter*> movieLabelFilters;
-    QMapIterator<ColorLabel, QString> it(helper::labels());
-    while (it.hasNext()) {
-        it.next();
-        movieLabelFilters << new Filter(tr("Label \"%1\"").arg(it.value()),
-            it.value(),
-            QStringList() << tr("Label") << it.value(),
-            MovieFilters::Label,
-            true,
-            it.key());
+    QVector<Filter*> filters = m_availableMovieFilters;
+    for (const auto& facet : facets) {
+        QHash<QString, Filter*>& facetFilters = m_movieFacetFilters[static_cast<int>(facet.first)];
+        for (const MovieFacetIndex::ValueCount& value : index.values(facet.first)) {
+            Filter*& filter = facetFilters[value.value];
+            if (filter == nullptr) {
+                filter = new Filter(QString(),
+                    value.value,
+                    QStringList() << facet.second << value.value,
+                    MovieFacetIndex::filterInfo(facet.first),
+                    true);
+            }
+            const QString text = (facet.first == MovieFacet::Year)
+                                     ? tr("Released %1").arg(value.value)
+                                     : QStringLiteral("%1 \"%2\"").arg(facet.second, value.value);
+            filter->setText(QStringLiteral("%1 (%2)").arg(text).arg(value.count));
+            filters << filter;
+        }
     }
+    filters << m_movieLabelFilters;
 
-    return QVector<Filter*>() << m_availableMovieFilters   //
-                              << movieGenreFilters         //
-                              << movieStudioFilters        //
-                              << movieCountryFilters       //
-                              << movieYearFilters          //
-                              << movieCertificationFilters //
-                              << movieSetsFilters          //
-                              << movieTagsFilters          //
-                              << movieDirectorFilters      //
-                              << movieVideoCodecFilters    //
-                              << movieLabelFilters;
+    m_movieFilters = filters;
+    m_movieFiltersRevision = index.revision();
+    m_movieFiltersValid = true;
+    return m_movieFilters;
 }
 
 QVector<Filter*> FilterWidget::setupTvShowFilters()
@@ -504,6 +444,18 @@ void FilterWidget::initAvailableFilters()
     m_availableMovieFilters << new Filter(tr("Movie has no external Subtitle"),   tr("No External Subtitle"), {tr("Subtitle"), tr("External Subtitle"), tr("No Subtitle"), tr("No External Subtitle")}, MovieFilters::HasExternalSubtitle, false);
     // clang-format on
 
+    m_movieFacetFilters.resize(static_cast<int>(mediaelch::MovieFacet::Last) + 1);
+    QMapIterator<ColorLabel, QString> it(helper::labels());
+    while (it.hasNext()) {
+        it.next();
+        m_movieLabelFilters << new Filter(tr("Label \"%1\"").arg(it.value()),
+            it.value(),
+            QStringList() << tr("Label") << it.value(),
+            MovieFilters::Label,
+            true,
+            it.key());
+    }
+
     m_availableTvShowFilters << new Filter(tr("Title"), "", QStringList(), TvShowFilters::Title, true);
     m_availableConcertFilters << new Filter(tr("Title"), "", QStringList(), ConcertFilters::Title, true);
     m_availableMusicFilters << new Filter(tr("Title"), "", QStringList(), MusicFilters::Title, true);
@@ -3,6 +3,7 @@
 #include "globals/Filter.h"
 #include "globals/Globals.h"
 
+#include <QHash>
 #include <QKeyEvent>
 #include <QListWidget>
 #include <QWidget>
@@ -51,6 +52,15 @@ private:
     QVector<Filter*> m_availableConcertFilters;
     QVector<Filter*> m_availableMusicFilters;
 
+    // Movie filters for each value of a MovieFacet, e.g. genre "Action". They are reused
+    // so that active filters stay valid when the available values change.
+    QVector<QHash<QString, Filter*>> m_movieFacetFilters;
+    QVector<Filter*> m_movieLabelFilters;
+    // Assembled movie filters; valid until the revision of the movie facet index changes.
+    QVector<Filter*> m_movieFilters;
+    quint64 m_movieFiltersRevision = 0;
+    bool m_movieFiltersValid = false;
+
     QListWidget* m_list = nullptr;
     QVector<Filter*> m_activeFilters;
     QMap<MainWidgets, QVector<Filter*>> m_storedFilters;
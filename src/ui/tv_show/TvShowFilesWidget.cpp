@@ -1,17 +1,22 @@
 #include "TvShowFilesWidget.h"
 #include "ui_TvShowFilesWidget.h"
 
+#include <QBuffer>
 #include <QCheckBox>
 #include <QDesktopServices>
 #include <QMessageBox>
 
 #include "globals/Globals.h"
 #include "globals/Manager.h"
+#include "globals/MessageIds.h"
+#include "image/ImageCaptureQueue.h"
 #include "log/Log.h"
+#include "settings/Settings.h"
 #include "tv_shows/TvShowUpdater.h"
 #include "tv_shows/model/EpisodeModelItem.h"
 #include "tv_shows/model/SeasonModelItem.h"
 #include "tv_shows/model/TvShowModelItem.h"
+#include "ui/notifications/NotificationBox.h"
 #include "ui/small_widgets/LoadingStreamDetails.h"
 #include "ui/tv_show/TvShowMultiScrapeDialog.h"
 
@@ -308,6 +313,68 @@ void TvShowFilesWidget::loadStreamDetails()
     emitSelected(ui->files->currentIndex());
 }
 
+/// \brief Captures thumbnails of all selected episodes that don't have one, in the background.
+void TvShowFilesWidget::captureMissingThumbnails()
+{
+    using namespace mediaelch;
+
+    m_contextMenu->close();
+
+    if (m_captureQueue != nullptr) {
+        qCInfo(generic) << "[TvShowFilesWidget] Still capturing thumbnails, ignoring request";
+        return;
+    }
+
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterfaceTvShow();
+    const ThumbnailDimensions dimensions = Settings::instance()->advanced()->episodeThumbnailDimensions();
+
+    m_captureQueue = new ImageCaptureQueue(this);
+    const QVector<TvShowEpisode*> episodes = selectedEpisodes();
+    for (TvShowEpisode* episode : episodes) {
+        if (episode->files().isEmpty() || !episode->thumbnailImage().isNull()
+            || !mediaCenter->imageFileName(episode, ImageType::TvShowEpisodeThumb).isEmpty()) {
+            continue;
+        }
+        m_captureQueue->add(episode,
+            episode->files().first(),
+            episode->streamDetails(),
+            dimensions,
+            false,
+            [episode](const QImage& image) {
+                QByteArray ba;
+                QBuffer buffer(&ba);
+                buffer.open(QIODevice::WriteOnly);
+                image.save(&buffer, "JPG", 85);
+                episode->setThumbnailImage(ba);
+            });
+    }
+
+    if (m_captureQueue->count() == 0) {
+        NotificationBox::instance()->showInfo(tr("All selected episodes have a thumbnail"));
+        m_captureQueue->deleteLater();
+        m_captureQueue = nullptr;
+        return;
+    }
+
+    NotificationBox::instance()->showProgressBar(
+        tr("Capturing episode thumbnails"), Constants::TvShowThumbnailCaptureMessageId);
+    connect(m_captureQueue, &ImageCaptureQueue::progress, this, [](int done, int total) {
+        NotificationBox::instance()->progressBarProgress(done, total, Constants::TvShowThumbnailCaptureMessageId);
+    });
+    connect(m_captureQueue, &ImageCaptureQueue::finished, this, [this](int failed) {
+        NotificationBox::instance()->hideProgressBar(Constants::TvShowThumbnailCaptureMessageId);
+        if (failed > 0) {
+            NotificationBox::instance()->showError(tr("%n thumbnail(s) could not be captured", "", failed));
+        } else {
+            NotificationBox::instance()->showSuccess(tr("Thumbnails captured"));
+        }
+        m_captureQueue->deleteLater();
+        m_captureQueue = nullptr;
+        emitSelected(ui->files->currentIndex());
+    });
+    m_captureQueue->start();
+}
+
 void TvShowFilesWidget::markForSyncBool(bool markForSync)
 {
     m_contextMenu->close();
@@ -752,6 +819,7 @@ void TvShowFilesWidget::setupContextMenu()
     auto* actionMarkAsWatched     = new QAction(tr("Mark as watched"),                   this);
     auto* actionMarkAsUnwatched   = new QAction(tr("Mark as unwatched"),                 this);
     auto* actionLoadStreamDetails = new QAction(tr("Load Stream Details"),               this);
+    auto* actionCaptureThumbnails = new QAction(tr("Capture Missing Thumbnails"),        this);
     auto* actionMarkForSync       = new QAction(tr("Add to Synchronization Queue"),      this);
     auto* actionUnmarkForSync     = new QAction(tr("Remove from Synchronization Queue"), this);
     auto* actionOpenFolder        = new QAction(tr("Open TV Show Folder"),               this);
@@ -762,6 +830,7 @@ void TvShowFilesWidget::setupContextMenu()
     connect(actionMarkAsWatched,     &QAction::triggered, this, &TvShowFilesWidget::markAsWatched);
     connect(actionMarkAsUnwatched,   &QAction::triggered, this, &TvShowFilesWidget::markAsUnwatched);
     connect(actionLoadStreamDetails, &QAction::triggered, this, &TvShowFilesWidget::loadStreamDetails);
+    connect(actionCaptureThumbnails, &QAction::triggered, this, &TvShowFilesWidget::captureMissingThumbnails);
     connect(actionMarkForSync,       &QAction::triggered, this, &TvShowFilesWidget::markForSync);
     connect(actionUnmarkForSync,     &QAction::triggered, this, &TvShowFilesWidget::unmarkForSync);
     connect(actionOpenFolder,        &QAction::triggered, this, &TvShowFilesWidget::openFolder);
@@ -789,6 +858,7 @@ void TvShowFilesWidget::setupContextMenu()
     m_contextMenu->addAction(actionMarkAsUnwatched);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionLoadStreamDetails);
+    m_contextMenu->addAction(actionCaptureThumbnails);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionMarkForSync);
     m_contextMenu->addAction(actionUnmarkForSync);
@@ -18,6 +18,10 @@ class TvShowFilesWidget;
 
 class TvShowBaseModelItem;
 
+namespace mediaelch {
+class ImageCaptureQueue;
+}
+
 /// The TvShowFilesWidget class is responsible for showing a list of TV shows
 /// with correct sorting and filtering. Internally, a TvShowTreeView is used
 /// to display the TV shows with their seasons and episodes.
@@ -55,6 +59,7 @@ private slots:
     void markAsWatched();
     void markAsUnwatched();
     void loadStreamDetails();
+    void captureMissingThumbnails();
     void markForSyncBool(bool markForSync);
     void markForSync();
     void unmarkForSync();
@@ -80,4 +85,6 @@ private:
 
     QAction* m_actionShowMissingEpisodes = nullptr;
     QAction* m_actionHideSpecialsInMissingEpisodes = nullptr;
+
+    mediaelch::ImageCaptureQueue* m_captureQueue = nullptr;
 };
@@ -5,6 +5,7 @@
 
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
+#include "globals/SaveQueue.h"
 #include "tv_shows/TvShow.h"
 #include "tv_shows/TvShowEpisode.h"
 #include "ui/notifications/NotificationBox.h"
@@ -151,34 +152,7 @@ void TvShowWidget::onSaveInformation()
         }
     }
 
-    const int itemsToSave = shows.count() + episodes.count();
-    int itemsSaved = 0;
-    NotificationBox::instance()->showProgressBar(
-        tr("Saving changed TV Shows and Episodes"), Constants::TvShowWidgetSaveProgressMessageId);
-    QApplication::processEvents();
-
-    for (int i = 0, n = shows.count(); i < n; ++i) {
-        itemsSaved++;
-        if (shows.at(i)->hasChanged()) {
-            shows.at(i)->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-            NotificationBox::instance()->progressBarProgress(
-                itemsSaved, itemsToSave, Constants::TvShowWidgetSaveProgressMessageId);
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        }
-    }
-
-    for (int i = 0, n = episodes.count(); i < n; ++i) {
-        itemsSaved++;
-        if (episodes.at(i)->hasChanged()) {
-            episodes.at(i)->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-            NotificationBox::instance()->progressBarProgress(
-                itemsSaved, itemsToSave, Constants::TvShowWidgetSaveProgressMessageId);
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        }
-    }
-
-    NotificationBox::instance()->hideProgressBar(Constants::TvShowWidgetSaveProgressMessageId);
-    NotificationBox::instance()->showSuccess(tr("TV Shows and Episodes Saved"));
+    saveInBackground(shows, episodes, tr("TV Shows and Episodes Saved"));
 }
 
 /**
@@ -187,44 +161,74 @@ void TvShowWidget::onSaveInformation()
 void TvShowWidget::onSaveAll()
 {
     qCDebug(generic) << "[TvShowWidget] Save all episodes";
-    QVector<TvShow*> shows = Manager::instance()->tvShowModel()->tvShows();
-    int episodesToSave = 0;
-    int episodesSaved = 0;
-    for (int i = 0, n = shows.count(); i < n; ++i) {
-        if (shows[i]->hasChanged()) {
-            episodesToSave++;
+    QVector<TvShow*> shows;
+    QVector<TvShowEpisode*> episodes;
+    for (TvShow* show : Manager::instance()->tvShowModel()->tvShows()) {
+        if (show->hasChanged()) {
+            shows.append(show);
         }
-        for (int x = 0, y = shows[i]->episodes().count(); x < y; ++x) {
-            if (shows[i]->episodes().at(x)->hasChanged()) {
-                episodesToSave++;
+        for (TvShowEpisode* episode : show->episodes()) {
+            if (episode->hasChanged()) {
+                episodes.append(episode);
             }
         }
     }
-    qCDebug(generic) << "episodesToSave=" << episodesToSave;
+    qCDebug(generic) << "[TvShowWidget] Items to save:" << (shows.count() + episodes.count());
+    saveInBackground(shows, episodes, tr("All TV Shows and Episodes Saved"));
+}
+
+/// \brief Saves the given shows and episodes using a SaveQueue, so that saving
+///        thousands of episodes doesn't block the UI.
+void TvShowWidget::saveInBackground(const QVector<TvShow*>& shows,
+    const QVector<TvShowEpisode*>& episodes,
+    const QString& successMessage)
+{
+    if (m_saveQueue != nullptr) {
+        qCInfo(generic) << "[TvShowWidget] Still saving, ignoring save request";
+        return;
+    }
+
+    MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterfaceTvShow();
+    m_saveQueue = new mediaelch::SaveQueue(Manager::instance()->database()->service(), this);
+    // saveData() marks items as unchanged before their files are written.
+    for (TvShow* show : shows) {
+        m_saveQueue->add(
+            show,
+            [show, mediaCenter]() { return !show->hasChanged() || show->saveData(mediaCenter); },
+            [show](bool success) {
+                if (!success) {
+                    show->setChanged(true);
+                }
+            });
+    }
+    for (TvShowEpisode* episode : episodes) {
+        // Episodes of multi-episode files are saved together, so the episode may already be saved.
+        m_saveQueue->add(
+            episode,
+            [episode, mediaCenter]() { return !episode->hasChanged() || episode->saveData(mediaCenter); },
+            [episode](bool success) {
+                if (!success) {
+                    episode->setChanged(true);
+                }
+            });
+    }
 
     NotificationBox::instance()->showProgressBar(
         tr("Saving changed TV Shows and Episodes"), Constants::TvShowWidgetSaveProgressMessageId);
-    QApplication::processEvents();
-
-    for (int i = 0, n = shows.count(); i < n; ++i) {
-        if (shows[i]->hasChanged()) {
-            qCDebug(generic) << "SAVING TV SHOW" << shows[i]->title();
-            shows[i]->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-            NotificationBox::instance()->progressBarProgress(
-                ++episodesSaved, episodesToSave, Constants::TvShowWidgetSaveProgressMessageId);
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    connect(m_saveQueue, &mediaelch::SaveQueue::progress, this, [](int done, int total) {
+        NotificationBox::instance()->progressBarProgress(done, total, Constants::TvShowWidgetSaveProgressMessageId);
+    });
+    connect(m_saveQueue, &mediaelch::SaveQueue::finished, this, [this, successMessage](int failed) {
+        NotificationBox::instance()->hideProgressBar(Constants::TvShowWidgetSaveProgressMessageId);
+        if (failed > 0) {
+            NotificationBox::instance()->showError(tr("%n TV show(s) or episode(s) could not be saved", "", failed));
+        } else {
+            NotificationBox::instance()->showSuccess(successMessage);
         }
-        for (int x = 0, y = shows[i]->episodes().count(); x < y; ++x) {
-            if (shows[i]->episodes().at(x)->hasChanged()) {
-                shows[i]->episodes().at(x)->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-                NotificationBox::instance()->progressBarProgress(
-                    ++episodesSaved, episodesToSave, Constants::TvShowWidgetSaveProgressMessageId);
-                QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-            }
-        }
-    }
-    NotificationBox::instance()->hideProgressBar(Constants::TvShowWidgetSaveProgressMessageId);
-    NotificationBox::instance()->showSuccess(tr("All TV Shows and Episodes Saved"));
+        m_saveQueue->deleteLater();
+        m_saveQueue = nullptr;
+    });
+    m_saveQueue->start();
 }
 
 /**
@@ -3,6 +3,7 @@
 #include "globals/Globals.h"
 #include "tv_shows/SeasonNumber.h"
 
+#include <QPointer>
 #include <QWidget>
 
 namespace Ui {
@@ -12,6 +13,10 @@ class TvShowWidget;
 class TvShow;
 class TvShowEpisode;
 
+namespace mediaelch {
+class SaveQueue;
+}
+
 /**
  * \brief The TvShowWidget class
  */
@@ -45,5 +50,10 @@ signals:
     void sigDownloadsFinished(int);
 
 private:
+    void saveInBackground(const QVector<TvShow*>& shows,
+        const QVector<TvShowEpisode*>& episodes,
+        const QString& successMessage);
+
     Ui::TvShowWidget* ui;
+    QPointer<mediaelch::SaveQueue> m_saveQueue;
 };
@@ -328,6 +328,7 @@ void TvShowWidgetEpisode::setEpisode(TvShowEpisode* episode)
 {
     qCDebug(generic) << "Entered, episode=" << episode->title();
     m_episode = episode;
+    episode->hydrate(Manager::instance()->mediaCenterInterfaceTvShow());
     if (!episode->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails() && !episode->isDummy()) {
         // Loading stream details als marks the episode as changed...
         // TODO: Refactor the "hasChanged" stuff...
@@ -0,0 +1,89 @@
+#include "test/test_helpers.h"
+
+#include "globals/ScraperInfos.h"
+#include "movies/Movie.h"
+#include "scrapers/movie/imdb/ImdbMovieParser.h"
+#include "scrapers/movie/videobuster/VideoBusterParser.h"
+#include "test/integration/resource_dir.h"
+
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <functional>
+#include <iostream>
+
+using namespace mediaelch;
+using namespace mediaelch::scraper;
+
+namespace {
+
+constexpr int ITERATIONS = 20;
+
+/// Saved pages in test/resources/scrapers/<scraper>/*.html. The directory can be
+/// overridden with the environment variable MEDIAELCH_HTML_FIXTURES.
+QStringList htmlFixtures(const QString& scraper)
+{
+    QString dir = QString::fromLocal8Bit(qgetenv("MEDIAELCH_HTML_FIXTURES"));
+    dir = dir.isEmpty() ? resourceDir().filePath("scrapers") : dir;
+
+    QStringList files;
+    QDirIterator it(dir + "/" + scraper, {"*.html"}, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files << it.next();
+    }
+    files.sort();
+    return files;
+}
+
+QString readFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+void benchmarkParser(const QString& scraper, const std::function<void(const QString&, Movie*)>& parse)
+{
+    const QStringList files = htmlFixtures(scraper);
+    if (files.isEmpty()) {
+        WARN("No saved HTML pages for " << scraper.toStdString() << " found; skipping");
+        return;
+    }
+
+    for (const QString& path : files) {
+        const QString html = readFile(path);
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            Movie movie;
+            parse(html, &movie);
+        }
+        const double msPerPage = static_cast<double>(timer.nsecsElapsed()) / 1e6 / ITERATIONS;
+        std::cout << scraper.toStdString() << " " << QFileInfo(path).fileName().toStdString() << ": " << msPerPage
+                  << " ms/page (" << html.size() << " chars)" << std::endl;
+    }
+}
+
+} // namespace
+
+// Not run by default. Run it with:
+//   ./mediaelch_test_integration --resource-dir ../test/resources "[benchmark]"
+TEST_CASE("Benchmark HTML parsers of movie scrapers", "[.][benchmark][scraper]")
+{
+    SECTION("IMDb")
+    {
+        benchmarkParser("imdb", [](const QString& html, Movie* movie) {
+            ImdbMovieParser::parseInfos(*movie, html, allMovieScraperInfos(), false);
+        });
+    }
+
+    SECTION("VideoBuster")
+    {
+        benchmarkParser("videobuster", [](const QString& html, Movie* movie) {
+            VideoBusterParser::parseInfos(*movie, html, allMovieScraperInfos());
+        });
+    }
+}
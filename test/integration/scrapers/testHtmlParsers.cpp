@@ -0,0 +1,130 @@
+#include "test/test_helpers.h"
+
+#include "globals/ScraperInfos.h"
+#include "movies/Movie.h"
+#include "scrapers/HtmlPattern.h"
+#include "scrapers/movie/imdb/ImdbMovieParser.h"
+#include "scrapers/movie/videobuster/VideoBusterParser.h"
+#include "test/integration/resource_dir.h"
+
+#include <chrono>
+
+using namespace mediaelch::scraper;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Runs every HtmlPattern additionally over the whole page while it exists, i.e. like the
+/// scrapers did before patterns were anchored.
+class AnchorVerification
+{
+public:
+    AnchorVerification() { HtmlPattern::setVerifyAnchors(true); }
+    ~AnchorVerification() { HtmlPattern::setVerifyAnchors(false); }
+
+    /// Patterns whose anchored results differ, joined for Catch's output.
+    QString mismatches() const { return HtmlPattern::anchorMismatches().join("\n"); }
+};
+
+} // namespace
+
+TEST_CASE("IMDb movie parser", "[scraper][imdb][parse_data]")
+{
+    AnchorVerification verification;
+
+    SECTION("page with summary and storyline")
+    {
+        Movie movie;
+        const QString html = getFileContent("scrapers/imdb/tt0111161.html");
+        ImdbMovieParser::parseInfos(movie, html, allMovieScraperInfos(), false);
+
+        CHECK(movie.name() == "The Shawshank Redemption");
+        CHECK(movie.director() == "Frank Darabont");
+        CHECK(movie.writer() == "Stephen King, Frank Darabont");
+        CHECK(movie.genres() == QStringList{"Drama"});
+        CHECK(movie.tagline() == "Fear can hold you prisoner. Hope can set you free.");
+        CHECK(movie.tags() == QStringList{"wrongful imprisonment", "prison", "escape from prison"});
+        CHECK(movie.released() == QDate(1994, 10, 14));
+        CHECK(movie.certification() == Certification("R"));
+        CHECK(movie.runtime() == 142min);
+        CHECK(movie.outline().startsWith("Two imprisoned men bond over a number of years"));
+        CHECK(movie.overview().startsWith("Chronicles the experiences of a formerly successful banker"));
+        REQUIRE(movie.ratings().size() == 1);
+        CHECK(movie.ratings().first().rating == Approx(9.3));
+        CHECK(movie.ratings().first().voteCount == 2245360);
+        CHECK(movie.top250() == 1);
+        CHECK(movie.studios() == QStringList{"Castle Rock Entertainment"});
+        CHECK(movie.countries() == QStringList{"USA"});
+        CHECK(verification.mismatches() == "");
+    }
+
+    SECTION("tags are not taken from the movie page if all tags are loaded")
+    {
+        Movie movie;
+        const QString html = getFileContent("scrapers/imdb/tt0111161.html");
+        ImdbMovieParser::parseInfos(movie, html, allMovieScraperInfos(), true);
+        CHECK(movie.tags().isEmpty());
+    }
+
+    SECTION("page with star box and original title")
+    {
+        Movie movie;
+        const QString html = getFileContent("scrapers/imdb/tt0082096.html");
+        ImdbMovieParser::parseInfos(movie, html, allMovieScraperInfos(), false);
+
+        CHECK(movie.name() == "The Boat");
+        CHECK(movie.originalName() == "Das Boot");
+        CHECK(movie.director() == "Wolfgang Petersen");
+        CHECK(movie.writer() == "Wolfgang Petersen, Lothar G. Buchheim");
+        CHECK(movie.genres() == QStringList{"Adventure", "Drama", "Thriller"});
+        CHECK(movie.released() == QDate(1981, 9, 17));
+        CHECK(movie.runtime() == 149min);
+        CHECK(movie.outline().startsWith("A German U-boat stalks the frigid waters"));
+        REQUIRE(movie.ratings().size() == 1);
+        CHECK(movie.ratings().first().rating == Approx(8.4));
+        CHECK(movie.ratings().first().voteCount == 226321);
+        CHECK(movie.top250() == 77);
+        CHECK(movie.countries() == QStringList{"West Germany"});
+        CHECK(verification.mismatches() == "");
+    }
+
+    SECTION("only requested details are assigned")
+    {
+        Movie movie;
+        const QString html = getFileContent("scrapers/imdb/tt0111161.html");
+        ImdbMovieParser::parseInfos(movie, html, {MovieScraperInfo::Title}, false);
+        CHECK(movie.name() == "The Shawshank Redemption");
+        CHECK(movie.director().isEmpty());
+        CHECK(movie.genres().isEmpty());
+        CHECK_FALSE(movie.released().isValid());
+    }
+}
+
+TEST_CASE("VideoBuster movie parser", "[scraper][videobuster][parse_data]")
+{
+    AnchorVerification verification;
+
+    Movie movie;
+    const QString html = getFileContent("scrapers/videobuster/das-boot.html");
+    VideoBusterParser::parseInfos(movie, html, allMovieScraperInfos());
+
+    CHECK(movie.name() == "Das Boot");
+    CHECK(movie.originalName() == "Das Boot");
+    CHECK(movie.tagline() == "Director's Cut");
+    CHECK(movie.released() == QDate(1981, 1, 1));
+    CHECK(movie.countries() == QStringList{"Deutschland"});
+    CHECK(movie.certification() == Certification::FSK("12"));
+    CHECK(movie.actors().size() == 2);
+    CHECK(movie.director() == "Wolfgang Petersen");
+    CHECK(movie.tags() == QStringList{"U-Boot", "Zweiter Weltkrieg"});
+    CHECK(movie.studios() == QStringList{"Bavaria Film"});
+    CHECK(movie.runtime() == 149min);
+    REQUIRE(movie.ratings().size() == 1);
+    CHECK(movie.ratings().first().rating == Approx(4.5));
+    CHECK(movie.ratings().first().voteCount == 1234);
+    CHECK(movie.genres() == QStringList{"Kriegsfilm", "Drama"});
+    CHECK(movie.overview().startsWith("Herbst 1941: Das deutsche U-Boot U 96"));
+    CHECK(movie.images().posters().size() == 1);
+    CHECK(movie.images().backdrops().size() == 2);
+    CHECK(verification.mismatches() == "");
+}
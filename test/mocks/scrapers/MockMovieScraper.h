@@ -0,0 +1,55 @@
+#pragma once
+
+#include "scrapers/movie/MovieScraper.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+/// \brief Movie scraper that records loads instead of scraping.
+///        Loads have to be finished by calling Movie::controller()->scraperLoadDone().
+class MockMovieScraper : public mediaelch::scraper::MovieScraper
+{
+public:
+    struct Load
+    {
+        QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> ids;
+        Movie* movie = nullptr;
+        QSet<MovieScraperInfo> infos;
+    };
+
+    explicit MockMovieScraper(QString identifier, QObject* parent = nullptr) : MovieScraper(parent)
+    {
+        m_meta.identifier = std::move(identifier);
+        m_meta.name = m_meta.identifier;
+        m_meta.supportedDetails = allMovieScraperInfos();
+    }
+
+    const ScraperMeta& meta() const override { return m_meta; }
+    void initialize() override {}
+    bool isInitialized() const override { return true; }
+    mediaelch::scraper::MovieSearchJob* search(mediaelch::scraper::MovieSearchJob::Config) override
+    {
+        return nullptr;
+    }
+
+    void loadData(QHash<MovieScraper*, mediaelch::scraper::MovieIdentifier> ids,
+        Movie* movie,
+        QSet<MovieScraperInfo> infos) override
+    {
+        loads.push_back({std::move(ids), movie, std::move(infos)});
+    }
+
+    QSet<MovieScraperInfo> scraperNativelySupports() override { return m_meta.supportedDetails; }
+    void changeLanguage(mediaelch::Locale) override {}
+    QWidget* settingsWidget() override { return nullptr; }
+    bool hasSettings() const override { return false; }
+    void loadSettings(ScraperSettings&) override {}
+    void saveSettings(ScraperSettings&) override {}
+
+    QVector<Load> loads;
+
+private:
+    ScraperMeta m_meta;
+};
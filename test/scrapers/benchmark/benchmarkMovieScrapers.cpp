@@ -0,0 +1,146 @@
+#include "test/test_helpers.h"
+
+#include "network/ReplayTransport.h"
+#include "scrapers/movie/adultdvdempire/AdultDvdEmpire.h"
+#include "scrapers/movie/aebn/AEBN.h"
+#include "scrapers/movie/hotmovies/HotMovies.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "scrapers/movie/videobuster/VideoBuster.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace mediaelch::scraper;
+using mediaelch::network::ReplayTransport;
+
+namespace {
+
+void waitForInitialization(MovieScraper& scraper)
+{
+    if (scraper.isInitialized()) {
+        return;
+    }
+    scraper.initialize();
+    QElapsedTimer timer;
+    timer.start();
+    while (!scraper.isInitialized() && timer.elapsed() < 30000) {
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 100);
+    }
+}
+
+/// \brief Scrapes all movies; at most \p concurrent movies at the same time.
+void scrapeMovies(MovieScraper& scraper, const QStringList& ids, int concurrent)
+{
+    std::vector<std::unique_ptr<Movie>> movies;
+    QEventLoop loop;
+    int next = 0;
+    int done = 0;
+
+    std::function<void()> startNext = [&]() {
+        if (next >= ids.size()) {
+            return;
+        }
+        movies.push_back(std::make_unique<Movie>(QStringList{}));
+        Movie* movie = movies.back().get();
+        QObject::connect(movie->controller(), &MovieController::sigInfoLoadDone, &loop, [&]() {
+            ++done;
+            if (done == ids.size()) {
+                loop.quit();
+            } else {
+                startNext();
+            }
+        });
+        scraper.loadData({{nullptr, MovieIdentifier(ids[next++])}}, movie, scraper.meta().supportedDetails);
+    };
+
+    for (int i = 0; i < concurrent; ++i) {
+        startNext();
+    }
+    if (!ids.isEmpty()) {
+        loop.exec();
+    }
+}
+
+void benchmarkScraper(MovieScraper& scraper, const QStringList& ids)
+{
+    waitForInitialization(scraper);
+
+    // "single": one movie after another, "multi": all at once like the multi-scrape dialog.
+    for (const bool multi : {false, true}) {
+        ReplayTransport::instance().resetStatistics();
+        QElapsedTimer timer;
+        timer.start();
+
+        scrapeMovies(scraper, ids, multi ? ids.size() : 1);
+
+        const double elapsedMs = qMax<double>(1.0, static_cast<double>(timer.elapsed()));
+        const auto stats = ReplayTransport::instance().statistics();
+        const double items = ids.size();
+        std::cout << scraper.meta().name.toStdString() << " (" << (multi ? "multi" : "single") << "): "
+                  << (items * 60000.0 / elapsedMs) << " movies/min, " << (stats.requests / items)
+                  << " requests/movie, " << (static_cast<double>(stats.bytes) / items) << " bytes/movie";
+        if (stats.missing > 0) {
+            std::cout << ", " << stats.missing << " responses not recorded";
+        }
+        std::cout << std::endl;
+    }
+}
+
+} // namespace
+
+// Not run by default. Requests go through the ReplayTransport, e.g.:
+//   MEDIAELCH_HTTP_REPLAY=record ./mediaelch_test_scrapers "[benchmark]"
+//   MEDIAELCH_HTTP_REPLAY=replay MEDIAELCH_HTTP_LATENCY_MS=80 ./mediaelch_test_scrapers "[benchmark]"
+// See also the "scraper_benchmark" target. Committed recordings only exist for the IMDb
+// and VideoBuster movies; re-record to benchmark the other scrapers.
+TEST_CASE("Benchmark movie scrapers", "[.][benchmark][scraper]")
+{
+    if (!ReplayTransport::instance().isEnabled()) {
+        WARN("Set MEDIAELCH_HTTP_REPLAY to \"record\" or \"replay\" to run scraper benchmarks");
+        return;
+    }
+
+    SECTION("TMDb")
+    {
+        TmdbMovie tmdb;
+        benchmarkScraper(tmdb, {"tt2277860", "tt0111161", "tt2987732", "tt3159708"});
+    }
+
+    SECTION("IMDb")
+    {
+        ImdbMovie imdb;
+        benchmarkScraper(imdb, {"tt0111161", "tt0082096"});
+    }
+
+    SECTION("VideoBuster")
+    {
+        VideoBuster videoBuster;
+        benchmarkScraper(videoBuster, {"/dvd-bluray-verleih/3937/das-boot"});
+    }
+
+    SECTION("AEBN")
+    {
+        AEBN aebn;
+        benchmarkScraper(aebn, {"188623", "159236"});
+    }
+
+    SECTION("HotMovies")
+    {
+        HotMovies hotMovies;
+        benchmarkScraper(hotMovies,
+            {"https://www.hotmovies.com/video/292788/Magic-Mike-XXXL-A-Hardcore-Parody/",
+                "https://www.hotmovies.com/video/214343/-M-Is-For-Mischief-Number-3/"});
+    }
+
+    SECTION("AdultDvdEmpire")
+    {
+        AdultDvdEmpire adultDvdEmpire;
+        benchmarkScraper(adultDvdEmpire, {"/1745335/magic-mike-xxxl-porn-movies.html"});
+    }
+}
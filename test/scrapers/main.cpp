@@ -2,6 +2,7 @@
 #include "third_party/catch2/catch.hpp"
 
 #include "globals/Meta.h"
+#include "network/ReplayTransport.h"
 
 #include <QApplication>
 
@@ -9,6 +10,8 @@ int main(int argc, char** argv)
 {
     QApplication app(argc, argv);
     registerAllMetaTypes();
+    // Allows running scraper tests offline with recorded responses
+    mediaelch::network::ReplayTransport::instance().configureFromEnvironment();
     Catch::Session session; // NOLINT(clang-analyzer-core.uninitialized.UndefReturn)
     const int res = session.run(argc, argv);
     return res;
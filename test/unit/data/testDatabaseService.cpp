@@ -0,0 +1,175 @@
+#include "test/test_helpers.h"
+
+#include "data/DatabaseService.h"
+
+#include <QFuture>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+const QString readerConnection = QStringLiteral("testDatabaseServiceReader");
+
+QString createDatabase(const QTemporaryDir& dir)
+{
+    const QString file = dir.filePath("test.sqlite");
+    {
+        QSqlDatabase db = QSqlDatabase::contains(readerConnection)
+                              ? QSqlDatabase::database(readerConnection, false)
+                              : QSqlDatabase::addDatabase("QSQLITE", readerConnection);
+        db.close();
+        db.setDatabaseName(file);
+        REQUIRE(db.open());
+        QSqlQuery query(db);
+        REQUIRE(query.exec("PRAGMA journal_mode=WAL;"));
+        REQUIRE(query.exec("CREATE TABLE items (id integer PRIMARY KEY AUTOINCREMENT, name text)"));
+    }
+    return file;
+}
+
+int itemCount()
+{
+    QSqlQuery query(QSqlDatabase::database(readerConnection));
+    REQUIRE(query.exec("SELECT COUNT(*) FROM items"));
+    REQUIRE(query.next());
+    return query.value(0).toInt();
+}
+
+int countItems(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    query.exec("SELECT COUNT(*) FROM items");
+    return query.next() ? query.value(0).toInt() : -1;
+}
+
+DatabaseService::WriteJob insertItem(const QString& name)
+{
+    return [name](QSqlDatabase& db) {
+        QSqlQuery query(db);
+        query.prepare("INSERT INTO items(name) VALUES(:name)");
+        query.bindValue(":name", name);
+        query.exec();
+    };
+}
+
+} // namespace
+
+TEST_CASE("DatabaseService writes on its own connection", "[data][database]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString file = createDatabase(dir);
+
+    SECTION("writes are visible to other connections after flush")
+    {
+        DatabaseService service(file);
+        service.write(insertItem("a"));
+        service.write(insertItem("b"));
+        service.flush();
+        CHECK(itemCount() == 2);
+    }
+
+    SECTION("writes that are queued shortly after each other share a transaction")
+    {
+        DatabaseService service(file);
+        for (int i = 0; i < 10; ++i) {
+            service.write(insertItem(QString::number(i)));
+        }
+        service.flush();
+        CHECK(service.writeCount() == 10);
+        CHECK(service.transactionCount() == 1);
+    }
+
+    SECTION("writeAndWait returns the job's result")
+    {
+        DatabaseService service(file);
+        service.write(insertItem("a"));
+        const int id = service.writeAndWait<int>([](QSqlDatabase& db) {
+            QSqlQuery query(db);
+            query.exec("INSERT INTO items(name) VALUES('b')");
+            return query.lastInsertId().toInt();
+        });
+        CHECK(id == 2);
+    }
+
+    SECTION("held writes are executed but only committed once they are released")
+    {
+        DatabaseService service(file);
+        service.holdWrites();
+        service.write(insertItem("a"));
+        // The write job sees the uncommitted row of the previous one.
+        const int count = service.writeAndWait<int>([](QSqlDatabase& db) {
+            QSqlQuery query(db);
+            query.exec("SELECT COUNT(*) FROM items");
+            return query.next() ? query.value(0).toInt() : -1;
+        });
+        CHECK(count == 1);
+        CHECK(itemCount() == 0);
+        CHECK(service.transactionCount() == 0);
+
+        service.releaseWrites();
+        service.flush();
+        CHECK(itemCount() == 1);
+        CHECK(service.transactionCount() == 1);
+    }
+
+    SECTION("flush commits held writes")
+    {
+        DatabaseService service(file);
+        service.holdWrites();
+        service.write(insertItem("a"));
+        service.flush();
+        CHECK(itemCount() == 1);
+        service.releaseWrites();
+    }
+
+    SECTION("reads see the writes that were queued before them")
+    {
+        DatabaseService service(file);
+        service.write(insertItem("a"));
+        QFuture<int> count = service.read<int>(countItems);
+        service.write(insertItem("b"));
+        CHECK(count.result() >= 1);
+        service.flush();
+        CHECK(service.read<int>(countItems).result() == 2);
+    }
+
+    SECTION("reads wait for held writes without committing them early")
+    {
+        DatabaseService service(file);
+        service.holdWrites();
+        service.write(insertItem("a"));
+        QFuture<int> count = service.read<int>(countItems);
+        service.write(insertItem("b"));
+        CHECK(service.transactionCount() == 0);
+        service.releaseWrites();
+        CHECK(count.result() == 2);
+        CHECK(service.transactionCount() == 1);
+    }
+
+    SECTION("reads use read-only connections")
+    {
+        DatabaseService service(file);
+        const auto insert = [](QSqlDatabase& db) {
+            QSqlQuery query(db);
+            return query.exec("INSERT INTO items(name) VALUES('a')");
+        };
+        CHECK_FALSE(service.read<bool>(insert).result());
+    }
+
+    SECTION("queued writes are committed when the service is destroyed")
+    {
+        {
+            DatabaseService service(file);
+            service.holdWrites();
+            service.write(insertItem("a"));
+            service.write(insertItem("b"));
+        }
+        CHECK(itemCount() == 2);
+    }
+
+    QSqlDatabase::database(readerConnection, false).close();
+}
@@ -0,0 +1,181 @@
+#include "test/test_helpers.h"
+
+#include "data/MovieListQuery.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+using namespace mediaelch;
+
+namespace {
+
+QSqlDatabase createDatabase()
+{
+    QSqlDatabase db = QSqlDatabase::contains("testMovieListQuery")
+                          ? QSqlDatabase::database("testMovieListQuery")
+                          : QSqlDatabase::addDatabase("QSQLITE", "testMovieListQuery");
+    db.setDatabaseName(":memory:");
+    REQUIRE(db.open());
+
+    QSqlQuery query(db);
+    query.exec("DROP TABLE IF EXISTS movies");
+    query.exec("DROP TABLE IF EXISTS movieFiles");
+    REQUIRE(query.exec("CREATE TABLE movies (idMovie integer PRIMARY KEY, title text, released text, "
+                       "genres text, rating real, hasPoster integer, path text)"));
+    REQUIRE(query.exec("CREATE TABLE movieFiles (idMovie integer, file text)"));
+
+    const QString sep = MovieListQuery::listSeparator();
+    const QVector<QVariantList> movies{
+        {1, "Star Wars", "1977-05-25", "Action" + sep + "Science Fiction", 8.6, 1, QByteArray("/movies")},
+        {2, "Stardust", "2007-08-10", "Fantasy" + sep + "Romance", 7.6, 0, QByteArray("/movies")},
+        {3, "Drama 100%", "2010-01-01", "Drama", 6.0, 1, QByteArray("/other")},
+        {4, "The Dramatic Story", "2015-01-01", "Action Drama", 5.0, 0, QByteArray("/other")},
+    };
+    for (const QVariantList& movie : movies) {
+        query.prepare("INSERT INTO movies VALUES (?, ?, ?, ?, ?, ?, ?)");
+        for (const QVariant& value : movie) {
+            query.addBindValue(value);
+        }
+        REQUIRE(query.exec());
+        query.prepare("INSERT INTO movieFiles VALUES (?, ?)");
+        query.addBindValue(movie.first());
+        query.addBindValue(movie.last().toByteArray() + "/" + movie.at(1).toString().toUtf8() + ".mkv");
+        REQUIRE(query.exec());
+    }
+    return db;
+}
+
+QVector<QVector<QVariant>> readAll(MovieListQuery& query, QSqlDatabase db)
+{
+    QVector<QVector<QVariant>> rows;
+    const bool ok = query.exec(db, [&rows](const QVector<QVariant>& values) {
+        rows << values;
+        return true;
+    });
+    INFO(query.errorString().toStdString());
+    REQUIRE(ok);
+    return rows;
+}
+
+QStringList titles(MovieListQuery& query, QSqlDatabase db)
+{
+    REQUIRE(query.setFields({"title"}));
+    QStringList result;
+    for (const QVector<QVariant>& row : readAll(query, db)) {
+        result << row.first().toString();
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("MovieListQuery reads selected fields", "[data][database]")
+{
+    QSqlDatabase db = createDatabase();
+    MovieListQuery query;
+
+    SECTION("fields have their types")
+    {
+        REQUIRE(query.setFields({"id", "title", "year", "genres", "rating", "poster", "directory", "files"}));
+        const auto rows = readAll(query, db);
+        REQUIRE(rows.size() == 4);
+        CHECK(rows[0][0].toInt() == 1);
+        CHECK(rows[0][1].toString() == "Star Wars");
+        CHECK(rows[0][2].toInt() == 1977);
+        CHECK(rows[0][3].toStringList() == QStringList{"Action", "Science Fiction"});
+        CHECK(rows[0][4].toDouble() == Approx(8.6));
+        CHECK(rows[0][5].toBool());
+        CHECK(rows[0][6].toString() == "/movies");
+        CHECK(rows[0][7].toStringList() == QStringList{"/movies/Star Wars.mkv"});
+    }
+
+    SECTION("unknown fields are rejected")
+    {
+        CHECK_FALSE(query.setFields({"title", "unknown"}));
+        CHECK(query.fieldNames() == QStringList{"id", "title", "year", "imdbId"});
+    }
+
+    SECTION("reading stops if the callback returns false")
+    {
+        int count = 0;
+        REQUIRE(query.setFields({"title"}));
+        REQUIRE(query.exec(db, [&count](const QVector<QVariant>&) { return ++count < 2; }));
+        CHECK(count == 2);
+    }
+
+    SECTION("limit")
+    {
+        query.setLimit(3);
+        CHECK(titles(query, db) == QStringList{"Star Wars", "Stardust", "Drama 100%"});
+    }
+}
+
+TEST_CASE("MovieListQuery filters in SQL", "[data][database]")
+{
+    QSqlDatabase db = createDatabase();
+    MovieListQuery query;
+
+    SECTION("text")
+    {
+        REQUIRE(query.addFilter("title~star"));
+        CHECK(titles(query, db) == QStringList{"Star Wars", "Stardust"});
+    }
+
+    SECTION("text equality is case-insensitive")
+    {
+        REQUIRE(query.addFilter("title=stardust"));
+        CHECK(titles(query, db) == QStringList{"Stardust"});
+    }
+
+    SECTION("LIKE wildcards in values are literal")
+    {
+        REQUIRE(query.addFilter("title~%"));
+        CHECK(titles(query, db) == QStringList{"Drama 100%"});
+    }
+
+    SECTION("list elements are compared as a whole")
+    {
+        REQUIRE(query.addFilter("genres=drama"));
+        CHECK(titles(query, db) == QStringList{"Drama 100%"});
+    }
+
+    SECTION("list elements are not matched across separators")
+    {
+        REQUIRE(query.addFilter("genres=Action"));
+        CHECK(titles(query, db) == QStringList{"Star Wars"});
+    }
+
+    SECTION("list elements can be excluded")
+    {
+        REQUIRE(query.addFilter("genres!=Action"));
+        CHECK(titles(query, db) == QStringList{"Stardust", "Drama 100%", "The Dramatic Story"});
+    }
+
+    SECTION("numbers")
+    {
+        REQUIRE(query.addFilter("year>=2007"));
+        REQUIRE(query.addFilter("rating > 6"));
+        CHECK(titles(query, db) == QStringList{"Stardust"});
+    }
+
+    SECTION("booleans")
+    {
+        REQUIRE(query.addFilter("poster=yes"));
+        CHECK(titles(query, db) == QStringList{"Star Wars", "Drama 100%"});
+    }
+
+    SECTION("directory")
+    {
+        query.setDirectory("/other");
+        CHECK(titles(query, db) == QStringList{"Drama 100%", "The Dramatic Story"});
+    }
+
+    SECTION("invalid filters are rejected")
+    {
+        CHECK_FALSE(query.addFilter("title"));
+        CHECK_FALSE(query.addFilter("unknown=1"));
+        CHECK_FALSE(query.addFilter("year~19"));
+        CHECK_FALSE(query.addFilter("year=abc"));
+        CHECK_FALSE(query.addFilter("genres>Drama"));
+    }
+}
@@ -0,0 +1,69 @@
+#include "test/test_helpers.h"
+
+#include "data/StringPool.h"
+
+using namespace mediaelch;
+
+TEST_CASE("StringPool interns strings", "[data]")
+{
+    StringPool pool;
+
+    SECTION("equal strings share their data")
+    {
+        QString first = pool.intern(QStringLiteral("Action").toLower());
+        QString second = pool.intern(QStringLiteral("ACTION").toLower());
+        CHECK(first == "action");
+        CHECK(first.constData() == second.constData());
+    }
+
+    SECTION("different strings are kept apart")
+    {
+        CHECK(pool.intern("Drama") == "Drama");
+        CHECK(pool.intern("Comedy") == "Comedy");
+        CHECK(pool.statistics().strings == 2);
+    }
+
+    SECTION("empty strings are not pooled")
+    {
+        CHECK(pool.intern("").isEmpty());
+        CHECK(pool.statistics().strings == 0);
+        CHECK(pool.statistics().lookups == 0);
+    }
+
+    SECTION("strings that are only referenced by the pool are released")
+    {
+        QString kept = pool.intern(QStringLiteral("Drama").toLower());
+        pool.intern(QStringLiteral("Comedy").toLower());
+        CHECK(pool.releaseUnused() == 1);
+        CHECK(pool.statistics().strings == 1);
+        CHECK(pool.statistics().evicted == 1);
+        CHECK(pool.intern(QStringLiteral("DRAMA").toLower()).constData() == kept.constData());
+    }
+
+    SECTION("large pools are swept automatically")
+    {
+        for (int i = 0; i < 1024; ++i) {
+            pool.intern(QString::number(i));
+        }
+        CHECK(pool.statistics().strings == 1024);
+        pool.intern("Drama");
+        CHECK(pool.statistics().strings == 1);
+        CHECK(pool.statistics().evicted == 1024);
+    }
+
+    SECTION("statistics count lookups and hits")
+    {
+        pool.intern("Drama");
+        pool.intern("Drama");
+        pool.intern("Comedy");
+        const StringPool::Statistics stats = pool.statistics();
+        CHECK(stats.strings == 2);
+        CHECK(stats.lookups == 3);
+        CHECK(stats.hits == 1);
+        CHECK(stats.bytes == 11 * static_cast<qint64>(sizeof(QChar)));
+
+        pool.clear();
+        CHECK(pool.statistics().strings == 0);
+        CHECK(pool.statistics().lookups == 0);
+    }
+}
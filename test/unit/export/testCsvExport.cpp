@@ -0,0 +1,135 @@
+#include "test/test_helpers.h"
+
+#include "export/CsvExport.h"
+#include "globals/Globals.h"
+#include "movies/Movie.h"
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace mediaelch;
+
+namespace {
+
+std::unique_ptr<TvShow> createShow(const QString& title, int episodeCount)
+{
+    auto show = std::make_unique<TvShow>();
+    show->setTitle(title);
+    for (int i = 1; i <= episodeCount; ++i) {
+        auto* episode = new TvShowEpisode({}, show.get());
+        episode->setSeason(SeasonNumber(1 + i / 100));
+        episode->setEpisode(EpisodeNumber(i));
+        episode->setTitle(QStringLiteral("Episode %1").arg(i));
+        episode->setOverview(QStringLiteral("Overview of episode %1,\nwith a line break.").arg(i));
+        show->addEpisode(episode);
+    }
+    return show;
+}
+
+} // namespace
+
+TEST_CASE("CsvMovieExport writes selected columns", "[export]")
+{
+    Movie movie;
+    movie.setName("Movie, Title");
+    movie.setOverview("First line\nSecond line with \"quotes\"");
+    movie.setTagline("Not exported");
+
+    using Field = CsvMovieExport::Field;
+    const QVector<Field> fields{Field::Title, Field::Overview};
+
+    QString output;
+    QTextStream stream(&output);
+    int callbacks = 0;
+
+    SECTION("CSV")
+    {
+        CsvMovieExport exporter(stream, fields);
+        exporter.setSeparator(",");
+        exporter.setReplacement(";");
+        exporter.exportMovies({&movie}, [&callbacks]() { ++callbacks; });
+        stream.flush();
+
+        CHECK(output == "movie_title,movie_overview\nMovie; Title,First line\\nSecond line with \"quotes\"\n");
+        CHECK(callbacks == 1);
+    }
+
+    SECTION("JSON Lines")
+    {
+        CsvMovieExport exporter(stream, fields);
+        exporter.setFormat(CsvMediaExport::Format::JsonLines);
+        exporter.exportMovies({&movie}, [&callbacks]() { ++callbacks; });
+        stream.flush();
+
+        CHECK(output
+              == "{\"movie_title\":\"Movie, Title\","
+                 "\"movie_overview\":\"First line\\nSecond line with \\\"quotes\\\"\"}\n");
+        CHECK(callbacks == 1);
+    }
+}
+
+TEST_CASE("CsvTvEpisodeExport keeps the order of large exports", "[export]")
+{
+    // More episodes than are formatted in one chunk, so that chunks are formatted in parallel.
+    auto first = createShow("First", 2500);
+    auto empty = createShow("Empty", 0);
+    auto second = createShow("Second", 1200);
+
+    using Field = CsvTvEpisodeExport::Field;
+    QString output;
+    QTextStream stream(&output);
+    CsvTvEpisodeExport exporter(stream, {Field::ShowTitle, Field::EpisodeNumber});
+    exporter.setSeparator(",");
+
+    int callbacks = 0;
+    exporter.exportEpisodes({first.get(), empty.get(), second.get()}, [&callbacks]() { ++callbacks; });
+    stream.flush();
+
+    const QStringList lines = output.split('\n', ElchSplitBehavior::SkipEmptyParts);
+    REQUIRE(lines.size() == 1 + 2500 + 1200);
+    CHECK(lines.at(0) == "show_title,episode_number");
+    CHECK(lines.at(1) == "First,1");
+    CHECK(lines.at(2500) == "First,2500");
+    CHECK(lines.at(2501) == "Second,1");
+    CHECK(lines.at(3700) == "Second,1200");
+    CHECK(callbacks == 3);
+}
+
+TEST_CASE("CsvTvEpisodeExport benchmark", "[.][benchmark][export]")
+{
+    // 1000 shows with 100 episodes each.
+    std::vector<std::unique_ptr<TvShow>> shows;
+    QVector<TvShow*> showPointers;
+    for (int i = 0; i < 1000; ++i) {
+        shows.push_back(createShow(QStringLiteral("Show %1").arg(i), 100));
+        showPointers << shows.back().get();
+    }
+
+    using Field = CsvTvEpisodeExport::Field;
+    const QVector<Field> fields{Field::ShowTitle, Field::EpisodeSeason, Field::EpisodeNumber, Field::EpisodeTitle};
+
+    for (const auto format : {CsvMediaExport::Format::Csv, CsvMediaExport::Format::JsonLines}) {
+        QString output;
+        QTextStream stream(&output);
+        CsvTvEpisodeExport exporter(stream, fields);
+        exporter.setFormat(format);
+
+        QElapsedTimer timer;
+        timer.start();
+        exporter.exportEpisodes(showPointers, []() {});
+        stream.flush();
+        const qint64 elapsed = timer.elapsed();
+
+        CHECK(output.count('\n') >= 100 * 1000);
+        std::cout << "CsvTvEpisodeExport: 100000 episodes as "
+                  << (format == CsvMediaExport::Format::Csv ? "CSV" : "JSON Lines") << ": " << elapsed << "ms"
+                  << std::endl;
+    }
+}
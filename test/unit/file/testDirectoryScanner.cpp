@@ -0,0 +1,106 @@
+#include "test/test_helpers.h"
+
+#include "file/DirectoryScanner.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+void createFile(const QString& path)
+{
+    QFileInfo info(path);
+    REQUIRE(QDir().mkpath(info.absolutePath()));
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write("data");
+}
+
+QStringList scanFiles(const QString& root, DirectoryScanner::Options options)
+{
+    QStringList files;
+    DirectoryScanner scanner(options);
+    scanner.scan({root}, [&files, &root](const DirectoryScanner::Directory& directory) {
+        for (const DirectoryScanner::Entry& entry : directory.entries) {
+            files << directory.filePath(entry).mid(root.length() + 1) + (entry.isDir ? "/" : "");
+        }
+    });
+    files.sort();
+    return files;
+}
+
+} // namespace
+
+TEST_CASE("DirectoryScanner lists directory trees", "[file]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString root = QDir::cleanPath(dir.path());
+
+    createFile(root + "/Movie A/Movie A.mkv");
+    createFile(root + "/Movie A/Movie A.nfo");
+    createFile(root + "/Movie B/CD1/Movie B.avi");
+    createFile(root + "/Movie C/VIDEO_TS/VIDEO_TS.IFO");
+    for (int i = 0; i < 50; ++i) {
+        createFile(QStringLiteral("%1/Many/%2/Movie %2.mkv").arg(root).arg(i));
+    }
+
+    DirectoryScanner::Options options;
+    options.nameFilters = QStringList{"*.mkv", "*.AVI", "VIDEO_TS.IFO"};
+    options.maxConcurrencyPerVolume = 4;
+
+    SECTION("all matching entries are found")
+    {
+        const QStringList files = scanFiles(root, options);
+        CHECK(files.size() == 53);
+        CHECK(files.contains("Movie A/Movie A.mkv"));
+        CHECK(files.contains("Movie B/CD1/Movie B.avi"));
+        CHECK(files.contains("Movie C/VIDEO_TS/VIDEO_TS.IFO"));
+        CHECK(files.contains("Many/42/Movie 42.mkv"));
+        CHECK_FALSE(files.contains("Movie A/Movie A.nfo"));
+    }
+
+    SECTION("name filters apply to directories")
+    {
+        createFile(root + "/Folder.mkv/Movie F.mkv");
+        const QStringList files = scanFiles(root, options);
+        CHECK(files.contains("Folder.mkv/"));
+        CHECK(files.contains("Folder.mkv/Movie F.mkv"));
+    }
+
+    SECTION("non-recursive scans only list the root")
+    {
+        createFile(root + "/Root.mkv");
+        options.recursive = false;
+        CHECK(scanFiles(root, options) == QStringList{"Root.mkv"});
+    }
+
+    SECTION("file details are read if requested")
+    {
+        options.fileDetails = true;
+        DirectoryScanner scanner(options);
+        bool detailsSet = true;
+        scanner.scan({root + "/Movie A"}, [&detailsSet](const DirectoryScanner::Directory& directory) {
+            for (const DirectoryScanner::Entry& entry : directory.entries) {
+                detailsSet = detailsSet && entry.size == 4 && entry.lastModified.isValid();
+            }
+        });
+        CHECK(detailsSet);
+    }
+
+    SECTION("aborted scans stop")
+    {
+        DirectoryScanner scanner(options);
+        int directories = 0;
+        scanner.scan({root}, [&scanner, &directories](const DirectoryScanner::Directory&) {
+            ++directories;
+            scanner.abort();
+        });
+        CHECK(directories == 1);
+    }
+}
@@ -0,0 +1,168 @@
+#include "test/test_helpers.h"
+
+#include "file/FileTransferQueue.h"
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTimer>
+
+using namespace mediaelch;
+
+namespace {
+
+QByteArray testData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        data[i] = static_cast<char>((i * 31 + i / 7) % 251);
+    }
+    return data;
+}
+
+void writeFile(const QString& filePath, const QByteArray& data)
+{
+    QFile file(filePath);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    REQUIRE(file.write(data) == data.size());
+}
+
+QByteArray readFile(const QString& filePath)
+{
+    QFile file(filePath);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+bool transfer(const QString& source,
+    const QString& destination,
+    FileTransfer::Mode mode,
+    qint64* bytes = nullptr,
+    bool renameOnSameVolume = true)
+{
+    FileTransfer::Options options;
+    options.mode = mode;
+    options.verifyChecksum = true;
+    options.renameOnSameVolume = renameOnSameVolume;
+    std::atomic_bool aborted{false};
+    qint64 transferred = 0;
+    const bool success = FileTransfer::transfer(
+        source, destination, options, aborted, [&transferred](qint64 count) { transferred += count; });
+    if (bytes != nullptr) {
+        *bytes = transferred;
+    }
+    return success;
+}
+
+} // namespace
+
+TEST_CASE("FileTransfer copies and moves files", "[file]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QByteArray data = testData(3 * 1024 * 1024 + 17);
+    const QString source = dir.filePath("source.mkv");
+    const QString destination = dir.filePath("Movie (2020)/Movie.mkv");
+    writeFile(source, data);
+
+    SECTION("copies keep the source and create the destination's directory")
+    {
+        qint64 bytes = 0;
+        CHECK(transfer(source, destination, FileTransfer::Mode::Copy, &bytes));
+        CHECK(bytes == data.size());
+        CHECK(readFile(destination) == data);
+        CHECK(QFileInfo::exists(source));
+        CHECK_FALSE(QFileInfo::exists(FileTransfer::partFileName(destination)));
+    }
+
+    SECTION("moves remove the source")
+    {
+        qint64 bytes = 0;
+        CHECK(transfer(source, destination, FileTransfer::Mode::Move, &bytes));
+        CHECK(bytes == data.size());
+        CHECK(readFile(destination) == data);
+        CHECK_FALSE(QFileInfo::exists(source));
+    }
+
+    SECTION("moves are copied if they can't be renamed")
+    {
+        // A part file of a previous move to another volume. It is only used by the copy path.
+        REQUIRE(QDir().mkpath(QFileInfo(destination).absolutePath()));
+        writeFile(FileTransfer::partFileName(destination), data.left(1024 * 1024));
+
+        qint64 bytes = 0;
+        CHECK(transfer(source, destination, FileTransfer::Mode::Move, &bytes, false));
+        CHECK(bytes == data.size());
+        CHECK(readFile(destination) == data);
+        CHECK_FALSE(QFileInfo::exists(source));
+        CHECK_FALSE(QFileInfo::exists(FileTransfer::partFileName(destination)));
+    }
+
+    SECTION("existing destination files are not overwritten")
+    {
+        REQUIRE(QDir().mkpath(QFileInfo(destination).absolutePath()));
+        writeFile(destination, "existing");
+        CHECK_FALSE(transfer(source, destination, FileTransfer::Mode::Move));
+        CHECK(readFile(destination) == "existing");
+        CHECK(QFileInfo::exists(source));
+    }
+
+    SECTION("part files are resumed")
+    {
+        REQUIRE(QDir().mkpath(QFileInfo(destination).absolutePath()));
+        // The end of the part file is broken, as if the system crashed while writing it.
+        QByteArray part = data.left(2 * 1024 * 1024);
+        part.replace(part.size() - 100, 100, QByteArray(100, '\0'));
+        writeFile(FileTransfer::partFileName(destination), part);
+
+        qint64 bytes = 0;
+        CHECK(transfer(source, destination, FileTransfer::Mode::Copy, &bytes));
+        CHECK(bytes == data.size());
+        CHECK(readFile(destination) == data);
+    }
+}
+
+TEST_CASE("FileTransferQueue transfers all files", "[file]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    FileTransferQueue::Options options;
+    options.maxTransfersPerVolume = 3;
+    FileTransferQueue queue(options);
+
+    qint64 totalSize = 0;
+    for (int i = 0; i < 8; ++i) {
+        const QByteArray data = testData(100 * 1024 + i);
+        totalSize += data.size();
+        const QString source = dir.filePath(QStringLiteral("source/%1.mkv").arg(i));
+        QDir().mkpath(dir.filePath("source"));
+        writeFile(source, data);
+        queue.add(source, dir.filePath(QStringLiteral("target/%1/%1.mkv").arg(i)));
+    }
+    // Missing source files fail but don't stop the other transfers.
+    queue.add(dir.filePath("missing.mkv"), dir.filePath("target/missing.mkv"));
+
+    int failed = -1;
+    int filesFinished = 0;
+    QEventLoop loop;
+    QObject::connect(&queue, &FileTransferQueue::fileFinished, [&filesFinished]() { ++filesFinished; });
+    QObject::connect(&queue, &FileTransferQueue::finished, [&](int failedFiles) {
+        failed = failedFiles;
+        loop.quit();
+    });
+    QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+    queue.start();
+    loop.exec();
+
+    CHECK(failed == 1);
+    CHECK(filesFinished == 9);
+    CHECK(queue.bytesTotal() == totalSize);
+    CHECK(queue.bytesDone() == totalSize);
+    CHECK_FALSE(queue.isRunning());
+    for (int i = 0; i < 8; ++i) {
+        CHECK(readFile(dir.filePath(QStringLiteral("target/%1/%1.mkv").arg(i))) == testData(100 * 1024 + i));
+    }
+}
@@ -0,0 +1,61 @@
+#include "test/test_helpers.h"
+
+#include "file/FileWriter.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+static QByteArray readFile(const QString& filePath)
+{
+    QFile file(filePath);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+TEST_CASE("FileWriter skips unchanged files", "[file]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString filePath = dir.filePath("sub/movie.nfo");
+
+    FileWriter writer;
+
+    SECTION("writes new files and creates their directory")
+    {
+        CHECK(writer.write(filePath, "<movie/>") == FileWriter::Result::Written);
+        CHECK(readFile(filePath) == "<movie/>");
+        CHECK(writer.statistics().written == 1);
+    }
+
+    SECTION("skips files with equal content")
+    {
+        REQUIRE(writer.write(filePath, "<movie/>") == FileWriter::Result::Written);
+        const QDateTime lastModified = QFileInfo(filePath).lastModified();
+
+        CHECK(writer.write(filePath, "<movie/>") == FileWriter::Result::Skipped);
+        CHECK(QFileInfo(filePath).lastModified() == lastModified);
+        CHECK(writer.statistics().skipped == 1);
+        CHECK(writer.statistics().bytesSkipped == 8);
+    }
+
+    SECTION("compares files that were written by others")
+    {
+        FileWriter other;
+        REQUIRE(other.write(filePath, "<movie/>") == FileWriter::Result::Written);
+
+        CHECK(writer.write(filePath, "<movie/>") == FileWriter::Result::Skipped);
+        CHECK(writer.write(filePath, "<movie></movie>") == FileWriter::Result::Written);
+        CHECK(readFile(filePath) == "<movie></movie>");
+    }
+
+    SECTION("overwrites files in-place if atomic writes are disabled")
+    {
+        writer.setAtomicWrites(false);
+        REQUIRE(writer.write(filePath, "<movie/>") == FileWriter::Result::Written);
+        CHECK(writer.write(filePath, "<tvshow/>") == FileWriter::Result::Written);
+        CHECK(readFile(filePath) == "<tvshow/>");
+    }
+}
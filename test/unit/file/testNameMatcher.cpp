@@ -0,0 +1,142 @@
+#include "test/test_helpers.h"
+
+#include "file/NameMatcher.h"
+
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QVector>
+#include <iostream>
+
+using namespace mediaelch;
+
+namespace {
+
+QStringList extrasParts()
+{
+    return {"-trailer", "-sample", "-behindthescenes", "-deleted", "-featurette", "-interview", "-scene", "-short"};
+}
+
+QVector<QRegularExpression> userPatterns()
+{
+    return {QRegularExpression("^\\._"), QRegularExpression("\\.part$"), QRegularExpression("(?i)^thumbs\\.db$")};
+}
+
+} // namespace
+
+TEST_CASE("NameMatcher matches combined rules", "[file]")
+{
+    SECTION("empty matcher matches nothing")
+    {
+        NameMatcher matcher;
+        CHECK(matcher.isEmpty());
+        CHECK_FALSE(matcher.matches(""));
+        CHECK_FALSE(matcher.matches("Movie.mkv"));
+    }
+
+    SECTION("patterns, parts and names")
+    {
+        NameMatcher matcher(userPatterns(), extrasParts(), {"extrafanart", ".actors"});
+        CHECK_FALSE(matcher.isEmpty());
+
+        CHECK(matcher.matches("._Movie.mkv"));
+        CHECK(matcher.matches("Movie.mkv.part"));
+        CHECK(matcher.matches("Thumbs.db"));
+        CHECK(matcher.matches("Movie-TRAILER.mkv"));
+        CHECK(matcher.matches("Movie-featurette.mkv"));
+        CHECK(matcher.matches("ExtraFanart"));
+        CHECK(matcher.matches(".actors"));
+
+        CHECK_FALSE(matcher.matches("Movie.mkv"));
+        CHECK_FALSE(matcher.matches("Movie.part.mkv"));
+        CHECK_FALSE(matcher.matches("my extrafanart"));
+        CHECK_FALSE(matcher.matches("Movie trailer.mkv"));
+    }
+
+    SECTION("patterns keep their options")
+    {
+        NameMatcher matcher({QRegularExpression("^sample", QRegularExpression::CaseInsensitiveOption),
+                                QRegularExpression("^Extra")},
+            {},
+            {});
+        CHECK(matcher.matches("SAMPLE.mkv"));
+        CHECK(matcher.matches("Extra.mkv"));
+        CHECK_FALSE(matcher.matches("extra.mkv"));
+    }
+
+    SECTION("patterns with backreferences are matched separately")
+    {
+        NameMatcher matcher({QRegularExpression("^(a)b\\1$"), QRegularExpression("^c$")}, {"-x"}, {});
+        CHECK(matcher.matches("aba"));
+        CHECK(matcher.matches("c"));
+        CHECK(matcher.matches("a-x"));
+        CHECK_FALSE(matcher.matches("abc"));
+    }
+
+    SECTION("invalid patterns are ignored")
+    {
+        NameMatcher matcher({QRegularExpression("(")}, {}, {"extras"});
+        CHECK(matcher.matches("extras"));
+        CHECK_FALSE(matcher.matches("("));
+    }
+
+    SECTION("wildcards match whole names")
+    {
+        NameMatcher matcher = NameMatcher::fromWildcards({"*.mkv", "VIDEO_TS.IFO", "*.r[0-9][0-9]", "file?.avi"});
+        CHECK(matcher.matches("Movie.mkv"));
+        CHECK(matcher.matches("VIDEO_TS.IFO"));
+        CHECK(matcher.matches("archive.r01"));
+        CHECK(matcher.matches("file1.avi"));
+
+        CHECK_FALSE(matcher.matches("Movie.mkv.part"));
+        CHECK_FALSE(matcher.matches("Movie.MKV"));
+        CHECK_FALSE(matcher.matches("archive.rar"));
+        CHECK_FALSE(matcher.matches("file12.avi"));
+        CHECK_FALSE(matcher.matches("XVIDEO_TS.IFO"));
+    }
+}
+
+TEST_CASE("NameMatcher benchmark", "[.][benchmark][file]")
+{
+    // Synthetic tree with one million entries; every tenth entry is an extra.
+    const int count = 1000 * 1000;
+    QStringList entries;
+    entries.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString suffix = (i % 10 == 0) ? extrasParts().at(i % 8) : QString();
+        entries << QStringLiteral("Some Movie Title (%1)%2.mkv").arg(i).arg(suffix);
+    }
+    const QStringList& names = entries;
+
+    const QVector<QRegularExpression> patterns = userPatterns();
+    const QStringList parts = extrasParts();
+
+    QElapsedTimer timer;
+    timer.start();
+    int separateMatches = 0;
+    for (const QString& name : names) {
+        bool excluded = false;
+        for (const QRegularExpression& pattern : patterns) {
+            if (pattern.match(name).hasMatch()) {
+                excluded = true;
+                break;
+            }
+        }
+        for (int i = 0; !excluded && i < parts.size(); ++i) {
+            excluded = name.contains(parts.at(i), Qt::CaseInsensitive);
+        }
+        separateMatches += excluded ? 1 : 0;
+    }
+    const qint64 separateMs = timer.restart();
+
+    const NameMatcher matcher(patterns, parts, {});
+    int combinedMatches = 0;
+    for (const QString& name : names) {
+        combinedMatches += matcher.matches(name) ? 1 : 0;
+    }
+    const qint64 combinedMs = timer.elapsed();
+
+    CHECK(separateMatches == combinedMatches);
+    std::cout << "NameMatcher: " << count << " names, separate rules: " << separateMs
+              << "ms, combined matcher: " << combinedMs << "ms" << std::endl;
+}
@@ -0,0 +1,97 @@
+#include "test/test_helpers.h"
+
+#include "globals/SaveQueue.h"
+
+#include <QFile>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+QByteArray fileContent(const QString& filePath)
+{
+    QFile file(filePath);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+void runQueue(SaveQueue& queue)
+{
+    QSignalSpy finished(&queue, &SaveQueue::finished);
+    queue.start();
+    REQUIRE((!finished.isEmpty() || finished.wait(10000)));
+}
+
+} // namespace
+
+TEST_CASE("SaveQueue writes files in the background", "[save]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QObject item1;
+    QObject item2;
+    SaveQueue queue(nullptr);
+    QVector<bool> results;
+    const auto remember = [&results](bool success) { results.push_back(success); };
+
+    SECTION("writes to the same file are executed in order")
+    {
+        const QString file = dir.filePath("movie.nfo");
+        QVector<QObject*> items;
+        for (int i = 0; i < 20; ++i) {
+            items.push_back(new QObject(&item1));
+            queue.add(items.last(), [file, i]() { return SaveQueue::writeFile(file, QByteArray::number(i)); });
+        }
+        runQueue(queue);
+        CHECK(fileContent(file) == "19");
+    }
+
+    SECTION("removals are executed in order with writes to the same file")
+    {
+        const QString file = dir.filePath("poster.jpg");
+        queue.add(&item1, [file]() { return SaveQueue::writeFile(file, "poster"); });
+        queue.add(&item2, [file]() { return SaveQueue::removeFile(file); }, remember);
+        runQueue(queue);
+        CHECK_FALSE(QFile::exists(file));
+        REQUIRE(results.size() == 1);
+        CHECK(results.first());
+    }
+
+    SECTION("completion reports failed background writes")
+    {
+        // A file where a directory is expected can't be written to.
+        REQUIRE(SaveQueue::writeFile(dir.filePath("blocked"), "file"));
+        const QString good = dir.filePath("good/movie.nfo");
+        const QString bad = dir.filePath("blocked/movie.nfo");
+        queue.add(&item1, [good]() { return SaveQueue::writeFile(good, "good"); }, remember);
+        queue.add(&item2, [bad]() { return SaveQueue::writeFile(bad, "bad"); }, remember);
+
+        QSignalSpy finished(&queue, &SaveQueue::finished);
+        runQueue(queue);
+        CHECK(finished.first().first().toInt() == 1);
+        REQUIRE(results.size() == 2);
+        CHECK(results.count(true) == 1);
+        CHECK(results.count(false) == 1);
+        CHECK(fileContent(good) == "good");
+    }
+
+    SECTION("destroyed items are neither saved nor completed")
+    {
+        bool saved = false;
+        auto* destroyed = new QObject;
+        queue.add(
+            destroyed,
+            [&saved]() {
+                saved = true;
+                return true;
+            },
+            remember);
+        delete destroyed;
+        runQueue(queue);
+        CHECK_FALSE(saved);
+        CHECK(results.isEmpty());
+    }
+}
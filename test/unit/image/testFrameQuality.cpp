@@ -0,0 +1,72 @@
+#include "test/test_helpers.h"
+
+#include "image/ImageCaptureQueue.h"
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+#include <QVector>
+
+using namespace mediaelch;
+
+namespace {
+
+QImage checkerboard(int cellSize)
+{
+    QImage image(320, 180, QImage::Format_RGB32);
+    QPainter painter(&image);
+    for (int y = 0; y < image.height(); y += cellSize) {
+        for (int x = 0; x < image.width(); x += cellSize) {
+            const bool isDark = ((x / cellSize) + (y / cellSize)) % 2 == 0;
+            painter.fillRect(x, y, cellSize, cellSize, isDark ? QColor(40, 40, 40) : QColor(210, 210, 210));
+        }
+    }
+    return image;
+}
+
+QImage filled(QColor color)
+{
+    QImage image(320, 180, QImage::Format_RGB32);
+    image.fill(color);
+    return image;
+}
+
+/// Blurs by scaling down and up again.
+QImage blurred(const QImage& image)
+{
+    return image.scaled(image.width() / 16, image.height() / 16, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+        .scaled(image.size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+} // namespace
+
+TEST_CASE("FrameQuality rejects unsuitable frames", "[image]")
+{
+    CHECK_FALSE(FrameQuality::measure(filled(Qt::black)).isUsable());
+    CHECK_FALSE(FrameQuality::measure(filled(Qt::white)).isUsable());
+    CHECK_FALSE(FrameQuality::measure(filled(QColor(30, 90, 160))).isUsable());
+    CHECK_FALSE(FrameQuality::measure(QImage()).isUsable());
+    CHECK(FrameQuality::measure(checkerboard(8)).isUsable());
+}
+
+TEST_CASE("FrameQuality prefers sharp frames", "[image]")
+{
+    const QImage sharp = checkerboard(8);
+    const FrameQuality sharpQuality = FrameQuality::measure(sharp);
+    const FrameQuality blurredQuality = FrameQuality::measure(blurred(sharp));
+    CHECK(sharpQuality.sharpness > blurredQuality.sharpness);
+    CHECK(sharpQuality.isBetterThan(blurredQuality));
+
+    SECTION("best frame")
+    {
+        const QVector<QImage> images{filled(Qt::black), QImage(), blurred(sharp), sharp, filled(Qt::white)};
+        CHECK(FrameQuality::bestFrame(images) == 3);
+    }
+
+    SECTION("unusable frames are used if there is nothing better")
+    {
+        CHECK(FrameQuality::bestFrame({QImage(), filled(Qt::black)}) == 1);
+        CHECK(FrameQuality::bestFrame({QImage(), QImage()}) == -1);
+        CHECK(FrameQuality::bestFrame({}) == -1);
+    }
+}
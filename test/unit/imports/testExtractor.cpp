@@ -0,0 +1,30 @@
+#include "test/test_helpers.h"
+
+#include "imports/Extractor.h"
+
+TEST_CASE("Extractor finds extracted files in unrar's output", "[imports]")
+{
+    SECTION("files are reported once unrar prints OK")
+    {
+        CHECK(Extractor::extractedFileFromOutput("Extracting  Movie.2020.mkv                OK ")
+              == "Movie.2020.mkv");
+        CHECK(Extractor::extractedFileFromOutput("Extracting  Movie 2020/Movie 2020.mkv     OK\r")
+              == "Movie 2020/Movie 2020.mkv");
+    }
+
+    SECTION("progress updated with backspaces is ignored")
+    {
+        CHECK(Extractor::extractedFileFromOutput("Extracting  Movie.mkv   12%\b\b\b\b 58%\b\b\b\b100%\b\b\b\b  OK")
+              == "Movie.mkv");
+        CHECK(Extractor::extractedFileFromOutput("...         Movie.mkv   74%\b\b\b\b  OK") == "Movie.mkv");
+    }
+
+    SECTION("incomplete files, directories and other lines are no extracted files")
+    {
+        CHECK(Extractor::extractedFileFromOutput("Extracting  Movie.mkv   12%").isEmpty());
+        CHECK(Extractor::extractedFileFromOutput("Extracting from Movie.part01.rar").isEmpty());
+        CHECK(Extractor::extractedFileFromOutput("Creating    Movie 2020                    OK").isEmpty());
+        CHECK(Extractor::extractedFileFromOutput("All OK").isEmpty());
+        CHECK(Extractor::extractedFileFromOutput("").isEmpty());
+    }
+}
@@ -0,0 +1,178 @@
+#include "test/test_helpers.h"
+
+#include "imports/Extractor.h"
+#include "imports/ImportPipeline.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+/// Records extractions, which the test then finishes in any order.
+class FakeExtractor : public Extractor
+{
+public:
+    void extract(QString baseName, QStringList, QString) override { started.append(baseName); }
+    void stopExtraction(QString baseName) override
+    {
+        stopped.append(baseName);
+        emit sigFinished(baseName, false);
+    }
+
+    QStringList started;
+    QStringList stopped;
+};
+
+void writeFile(const QString& filePath)
+{
+    REQUIRE(QDir().mkpath(QFileInfo(filePath).absolutePath()));
+    QFile file(filePath);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    REQUIRE(file.write(filePath.toUtf8()) > 0);
+}
+
+DownloadFileSearcher::Package makePackage(const QTemporaryDir& dir, const QString& baseName)
+{
+    const QString archive = dir.filePath("downloads/" + baseName + "/" + baseName + ".rar");
+    writeFile(archive);
+    DownloadFileSearcher::Package package;
+    package.baseName = baseName;
+    package.files = QStringList{archive};
+    package.size = 0;
+    return package;
+}
+
+ImportPipeline::Options makeOptions(const QTemporaryDir& dir)
+{
+    ImportPipeline::Options options;
+    options.targetDirectory = dir.filePath("imports");
+    options.importFilters = QStringList{"*.mkv", "*.srt"};
+    options.maxExtractions = 2;
+    options.maxExtractionsPerVolume = 2;
+    return options;
+}
+
+} // namespace
+
+TEST_CASE("ImportPipeline schedules extractions", "[imports]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    auto* extractor = new FakeExtractor;
+    ImportPipeline::Options options = makeOptions(dir);
+
+    SECTION("no more than the maximum number of packages are extracted at once")
+    {
+        ImportPipeline pipeline(options, extractor);
+        QSignalSpy finished(&pipeline, &ImportPipeline::finished);
+        for (const QString baseName : {"a", "b", "c"}) {
+            pipeline.add(makePackage(dir, baseName));
+        }
+        CHECK(extractor->started.isEmpty());
+
+        pipeline.start();
+        CHECK(extractor->started == QStringList{"a", "b"});
+
+        emit extractor->sigFinished("b", true);
+        CHECK(extractor->started == QStringList{"a", "b", "c"});
+        emit extractor->sigFinished("a", false);
+        CHECK(finished.isEmpty());
+        emit extractor->sigFinished("c", true);
+
+        REQUIRE(finished.size() == 1);
+        CHECK(finished.first().at(0).toInt() == 1);
+        CHECK(finished.first().at(1).toInt() == 0);
+        CHECK_FALSE(pipeline.isRunning());
+    }
+
+    SECTION("extractions are limited per volume")
+    {
+        options.maxExtractions = 4;
+        options.maxExtractionsPerVolume = 1;
+        ImportPipeline pipeline(options, extractor);
+        pipeline.add(makePackage(dir, "a"));
+        pipeline.add(makePackage(dir, "b"));
+        pipeline.start();
+        CHECK(extractor->started == QStringList{"a"});
+        emit extractor->sigFinished("a", true);
+        CHECK(extractor->started == QStringList{"a", "b"});
+    }
+
+    SECTION("finished is emitted at once without packages")
+    {
+        ImportPipeline pipeline(options, extractor);
+        QSignalSpy finished(&pipeline, &ImportPipeline::finished);
+        pipeline.start();
+        CHECK(finished.size() == 1);
+    }
+
+    SECTION("aborts stop running extractions and count waiting packages as failed")
+    {
+        options.maxExtractions = 1;
+        ImportPipeline pipeline(options, extractor);
+        QSignalSpy finished(&pipeline, &ImportPipeline::finished);
+        pipeline.add(makePackage(dir, "a"));
+        pipeline.add(makePackage(dir, "b"));
+        pipeline.start();
+        pipeline.abort();
+
+        CHECK(extractor->stopped == QStringList{"a"});
+        CHECK(extractor->started == QStringList{"a"});
+        REQUIRE(finished.size() == 1);
+        CHECK(finished.first().at(0).toInt() == 2);
+    }
+}
+
+TEST_CASE("ImportPipeline imports extracted files", "[imports]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    auto* extractor = new FakeExtractor;
+    ImportPipeline pipeline(makeOptions(dir), extractor);
+    QSignalSpy imported(&pipeline, &ImportPipeline::fileImported);
+    QSignalSpy finished(&pipeline, &ImportPipeline::finished);
+
+    const DownloadFileSearcher::Package package = makePackage(dir, "Movie");
+    const QDir extracted = QFileInfo(package.files.first()).dir();
+    const QDir target(dir.filePath("imports/Movie"));
+    pipeline.add(package);
+    pipeline.start();
+
+    const QStringList files{"CD1/movie.mkv",
+        "CD2/movie.mkv",
+        "movie.srt",
+        "readme.txt",
+        "Sample/movie.mkv",
+        "movie-sample.mkv",
+        "movie.sample.mkv"};
+    for (const QString& file : files) {
+        writeFile(extracted.filePath(file));
+        emit extractor->sigFileExtracted("Movie", extracted.filePath(file));
+    }
+    emit extractor->sigFinished("Movie", true);
+    REQUIRE((!finished.isEmpty() || finished.wait(10000)));
+
+    SECTION("files keep their path inside the package")
+    {
+        CHECK(imported.size() == 3);
+        CHECK(QFileInfo::exists(target.filePath("CD1/movie.mkv")));
+        CHECK(QFileInfo::exists(target.filePath("CD2/movie.mkv")));
+        CHECK(QFileInfo::exists(target.filePath("movie.srt")));
+        CHECK_FALSE(QFileInfo::exists(extracted.filePath("CD1/movie.mkv")));
+        CHECK(finished.first().at(1).toInt() == 0);
+    }
+
+    SECTION("samples and other files are not imported")
+    {
+        CHECK(QFileInfo::exists(extracted.filePath("readme.txt")));
+        CHECK(QFileInfo::exists(extracted.filePath("Sample/movie.mkv")));
+        CHECK(QFileInfo::exists(extracted.filePath("movie-sample.mkv")));
+        CHECK(QFileInfo::exists(extracted.filePath("movie.sample.mkv")));
+        CHECK_FALSE(target.exists("Sample"));
+    }
+}
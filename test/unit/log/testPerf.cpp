@@ -0,0 +1,109 @@
+#include "test/test_helpers.h"
+
+#include "log/Perf.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+namespace {
+
+perf::Entry entryByName(const QString& name)
+{
+    for (const perf::Entry& entry : perf::entries()) {
+        if (entry.name == name) {
+            return entry;
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+TEST_CASE("perf records timers and counters", "[log][perf]")
+{
+    perf::reset();
+
+    SECTION("nothing is recorded if disabled")
+    {
+        perf::setEnabled(false);
+        perf::count("test.counter");
+        perf::count(QStringLiteral("test.dynamic"));
+        {
+            perf::ScopedTimer timer("test.timer");
+        }
+        CHECK(perf::entries().isEmpty());
+    }
+
+    SECTION("counters are summed up")
+    {
+        perf::setEnabled(true);
+        perf::count("test.counter");
+        perf::count("test.counter", 4);
+        perf::count(QStringLiteral("test.dynamic"));
+        CHECK(entryByName("test.counter").count == 5);
+        CHECK(entryByName("test.counter").totalUs == 0);
+        CHECK(entryByName("test.dynamic").count == 1);
+    }
+
+    SECTION("timers count scopes and entries are sorted by name")
+    {
+        perf::setEnabled(true);
+        {
+            perf::ScopedTimer timer("test.b");
+        }
+        {
+            perf::ScopedTimer timer("test.b");
+        }
+        {
+            perf::ScopedTimer timer("test.a");
+        }
+        const QVector<perf::Entry> entries = perf::entries();
+        REQUIRE(entries.size() == 2);
+        CHECK(entries[0].name == "test.a");
+        CHECK(entries[1].name == "test.b");
+        CHECK(entries[1].count == 2);
+        CHECK(entries[1].maxUs <= entries[1].totalUs);
+    }
+
+    SECTION("reset removes all measurements")
+    {
+        perf::setEnabled(true);
+        perf::count("test.counter");
+        perf::reset();
+        CHECK(perf::entries().isEmpty());
+    }
+
+    SECTION("trace is only written if it was recorded")
+    {
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        const QString file = dir.filePath("trace.json");
+
+        perf::setEnabled(true, false);
+        {
+            perf::ScopedTimer timer("test.timer");
+        }
+        CHECK_FALSE(perf::writeChromeTrace(file));
+
+        perf::setEnabled(true, true);
+        {
+            perf::ScopedTimer timer("test.timer");
+        }
+        REQUIRE(perf::writeChromeTrace(file));
+
+        QFile json(file);
+        REQUIRE(json.open(QIODevice::ReadOnly));
+        const QJsonArray events = QJsonDocument::fromJson(json.readAll()).object()["traceEvents"].toArray();
+        REQUIRE(events.size() == 1);
+        CHECK(events[0].toObject()["name"].toString() == "test.timer");
+        CHECK(events[0].toObject()["ph"].toString() == "X");
+    }
+
+    perf::setEnabled(false);
+    perf::reset();
+}
@@ -0,0 +1,96 @@
+#include "test/test_helpers.h"
+
+#include "movies/Movie.h"
+#include "movies/MovieFacetIndex.h"
+
+using namespace mediaelch;
+
+namespace {
+
+QStringList valueNames(const MovieFacetIndex& index, MovieFacet facet)
+{
+    QStringList names;
+    for (const MovieFacetIndex::ValueCount& value : index.values(facet)) {
+        names << QStringLiteral("%1:%2").arg(value.value).arg(value.count);
+    }
+    return names;
+}
+
+} // namespace
+
+TEST_CASE("MovieFacetIndex indexes movie details", "[movie][filter]")
+{
+    MovieFacetIndex index;
+    Movie first(QStringList{"/movies/first.mkv"});
+    first.addGenre("Drama");
+    first.addGenre("Action");
+    first.addGenre("Drama");
+    first.setDirector("Director A");
+    first.setReleased(QDate(2001, 2, 3));
+    Movie second(QStringList{"/movies/second.mkv"});
+    second.addGenre("Drama");
+    second.addStudio("Studio B");
+
+    index.addMovie(&first);
+    index.addMovie(&second);
+
+    SECTION("values are sorted and counted once per movie")
+    {
+        CHECK(valueNames(index, MovieFacet::Genre) == QStringList{"Action:1", "Drama:2"});
+        CHECK(valueNames(index, MovieFacet::Director) == QStringList{"Director A:1"});
+        CHECK(valueNames(index, MovieFacet::Year) == QStringList{"2001:1"});
+        CHECK(valueNames(index, MovieFacet::Studio) == QStringList{"Studio B:1"});
+        CHECK(index.values(MovieFacet::Tag).isEmpty());
+    }
+
+    SECTION("posting lists contain movie ids")
+    {
+        CHECK(index.movies(MovieFacet::Genre, "Drama") == QSet<int>{first.movieId(), second.movieId()});
+        CHECK(index.movies(MovieFacet::Genre, "Action") == QSet<int>{first.movieId()});
+        CHECK(index.movies(MovieFacet::Genre, "Comedy").isEmpty());
+        CHECK(index.count(MovieFacet::Genre, "Drama") == 2);
+        CHECK(index.count(MovieFacet::Genre, "Comedy") == 0);
+    }
+
+    SECTION("adding a movie again updates its values")
+    {
+        first.removeGenre("Action");
+        first.addGenre("Comedy");
+        index.addMovie(&first);
+        CHECK(valueNames(index, MovieFacet::Genre) == QStringList{"Comedy:1", "Drama:2"});
+        CHECK(index.count(MovieFacet::Genre, "Action") == 0);
+    }
+
+    SECTION("the revision only changes if values change")
+    {
+        const quint64 revision = index.revision();
+        index.addMovie(&first);
+        CHECK(index.revision() == revision);
+
+        first.addTag("Favorite");
+        index.addMovie(&first);
+        CHECK(index.revision() > revision);
+        CHECK(index.count(MovieFacet::Tag, "Favorite") == 1);
+    }
+
+    SECTION("removed movies are removed from all values")
+    {
+        CHECK(index.contains(first.movieId()));
+        index.removeMovie(first.movieId());
+        CHECK_FALSE(index.contains(first.movieId()));
+        CHECK(valueNames(index, MovieFacet::Genre) == QStringList{"Drama:1"});
+        CHECK(index.values(MovieFacet::Director).isEmpty());
+        CHECK(index.values(MovieFacet::Year).isEmpty());
+
+        const quint64 revision = index.revision();
+        index.removeMovie(first.movieId());
+        CHECK(index.revision() == revision);
+    }
+
+    SECTION("clear removes everything")
+    {
+        index.clear();
+        CHECK(index.values(MovieFacet::Genre).isEmpty());
+        CHECK(index.movies(MovieFacet::Genre, "Drama").isEmpty());
+    }
+}
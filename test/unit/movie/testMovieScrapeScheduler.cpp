@@ -0,0 +1,211 @@
+#include "test/test_helpers.h"
+
+#include "movies/Movie.h"
+#include "movies/MovieController.h"
+#include "movies/MovieScrapeScheduler.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "test/mocks/scrapers/MockMovieScraper.h"
+
+#include <QSignalSpy>
+#include <memory>
+#include <vector>
+
+using namespace mediaelch;
+using namespace mediaelch::scraper;
+
+namespace {
+
+std::unique_ptr<Movie> makeMovie(const QString& imdbId)
+{
+    auto movie = std::make_unique<Movie>();
+    movie->setName("Movie " + imdbId);
+    if (!imdbId.isEmpty()) {
+        movie->setImdbId(ImdbId(imdbId));
+    }
+    return movie;
+}
+
+/// Finishes the movie's load like a scraper whose movie has no images.
+void finish(const MockMovieScraper::Load& load)
+{
+    load.movie->controller()->scraperLoadDone(nullptr, ScraperError());
+}
+
+/// Finishes the movie's load like a scraper whose request failed.
+void fail(const MockMovieScraper::Load& load)
+{
+    ScraperError error;
+    error.error = ScraperError::Type::NetworkError;
+    error.message = "Network Error";
+    load.movie->controller()->scraperLoadDone(nullptr, error);
+}
+
+QStringList loadedIds(const MockMovieScraper& scraper)
+{
+    QStringList ids;
+    for (const MockMovieScraper::Load& load : scraper.loads) {
+        ids << load.ids.values().first().str();
+    }
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("MovieScrapeScheduler scrapes several movies at once", "[movie][scheduler]")
+{
+    MockMovieScraper scraper(ImdbMovie::ID);
+    MovieScrapeScheduler scheduler(&scraper);
+    scheduler.setInfos({MovieScraperInfo::Title});
+    scheduler.setMaxConcurrentItems(2);
+    QSignalSpy movieFinished(&scheduler, &MovieScrapeScheduler::movieFinished);
+    QSignalSpy progress(&scheduler, &MovieScrapeScheduler::progress);
+    QSignalSpy finished(&scheduler, &MovieScrapeScheduler::finished);
+
+    std::vector<std::unique_ptr<Movie>> movies;
+    for (const QString id : {"tt0000001", "tt0000002", "tt0000003", "tt0000004"}) {
+        movies.push_back(makeMovie(id));
+        scheduler.add(movies.back().get());
+    }
+
+    SECTION("movies are only started after start()")
+    {
+        CHECK(scraper.loads.isEmpty());
+        CHECK(scheduler.count() == 4);
+    }
+
+    SECTION("no more than the maximum number of movies are in flight")
+    {
+        scheduler.start();
+        REQUIRE(scraper.loads.size() == 2);
+        CHECK(scraper.loads.at(0).infos == QSet<MovieScraperInfo>{MovieScraperInfo::Title});
+
+        finish(scraper.loads.at(1));
+        REQUIRE(scraper.loads.size() == 3);
+        finish(scraper.loads.at(0));
+        REQUIRE(scraper.loads.size() == 4);
+        CHECK(loadedIds(scraper) == QStringList{"tt0000001", "tt0000002", "tt0000003", "tt0000004"});
+        CHECK(finished.isEmpty());
+
+        finish(scraper.loads.at(3));
+        finish(scraper.loads.at(2));
+        CHECK(movieFinished.size() == 4);
+        CHECK(progress.size() == 4);
+        CHECK(finished.size() == 1);
+        CHECK_FALSE(scheduler.isRunning());
+    }
+
+    SECTION("queued movies that are destroyed are skipped")
+    {
+        movies.at(2).reset();
+        scheduler.start();
+        finish(scraper.loads.at(0));
+        CHECK(loadedIds(scraper) == QStringList{"tt0000001", "tt0000002", "tt0000004"});
+        CHECK(progress.size() == 2);
+    }
+
+    SECTION("running movies that are destroyed are completed")
+    {
+        scheduler.start();
+        movies.at(0).reset();
+        movies.at(1).reset();
+        REQUIRE(scraper.loads.size() == 4);
+        finish(scraper.loads.at(2));
+        finish(scraper.loads.at(3));
+        CHECK(movieFinished.size() == 2);
+        CHECK(progress.size() == 4);
+        CHECK(finished.size() == 1);
+    }
+
+    SECTION("aborted movies are not reported")
+    {
+        scheduler.start();
+        scheduler.abort();
+        finish(scraper.loads.at(0));
+        CHECK(scraper.loads.size() == 2);
+        CHECK(movieFinished.isEmpty());
+        CHECK(finished.isEmpty());
+    }
+}
+
+TEST_CASE("MovieScrapeScheduler skips movies without usable ID", "[movie][scheduler]")
+{
+    SECTION("IMDb needs an IMDb ID")
+    {
+        MockMovieScraper scraper(ImdbMovie::ID);
+        MovieScrapeScheduler scheduler(&scraper);
+        scheduler.setOnlyWithId(true);
+        QSignalSpy skipped(&scheduler, &MovieScrapeScheduler::movieSkipped);
+        QSignalSpy finished(&scheduler, &MovieScrapeScheduler::finished);
+
+        auto withoutId = makeMovie("");
+        auto withId = makeMovie("tt0000001");
+        scheduler.add(withoutId.get());
+        scheduler.add(withId.get());
+        scheduler.start();
+
+        REQUIRE(skipped.size() == 1);
+        CHECK(skipped.first().at(0).value<Movie*>() == withoutId.get());
+        CHECK(loadedIds(scraper) == QStringList{"tt0000001"});
+        finish(scraper.loads.at(0));
+        CHECK(finished.size() == 1);
+    }
+
+    SECTION("TMDb loads movies by their TMDb ID or, if missing, by their IMDb ID")
+    {
+        MockMovieScraper scraper(TmdbMovie::ID);
+        MovieScrapeScheduler scheduler(&scraper);
+        scheduler.setOnlyWithId(true);
+        QSignalSpy skipped(&scheduler, &MovieScrapeScheduler::movieSkipped);
+
+        auto withImdbId = makeMovie("tt0000001");
+        auto withTmdbId = makeMovie("");
+        withTmdbId->setTmdbId(TmdbId("550"));
+        auto withoutId = makeMovie("");
+        scheduler.add(withImdbId.get());
+        scheduler.add(withTmdbId.get());
+        scheduler.add(withoutId.get());
+        scheduler.start();
+
+        CHECK(loadedIds(scraper) == QStringList{"tt0000001", "550"});
+        CHECK(skipped.size() == 1);
+    }
+}
+
+TEST_CASE("MovieScrapeScheduler reports movies whose load failed", "[movie][scheduler]")
+{
+    MockMovieScraper scraper(ImdbMovie::ID);
+    MovieScrapeScheduler scheduler(&scraper);
+    QSignalSpy movieFinished(&scheduler, &MovieScrapeScheduler::movieFinished);
+    QSignalSpy movieFailed(&scheduler, &MovieScrapeScheduler::movieFailed);
+    QSignalSpy finished(&scheduler, &MovieScrapeScheduler::finished);
+
+    auto failing = makeMovie("tt0000001");
+    auto loaded = makeMovie("tt0000002");
+    scheduler.add(failing.get());
+    scheduler.add(loaded.get());
+    scheduler.start();
+    REQUIRE(scraper.loads.size() == 2);
+
+    fail(scraper.loads.at(0));
+    finish(scraper.loads.at(1));
+
+    REQUIRE(movieFailed.size() == 1);
+    CHECK(movieFailed.first().at(0).value<Movie*>() == failing.get());
+    CHECK(movieFailed.first().at(1).toString() == "Network Error");
+    REQUIRE(movieFinished.size() == 1);
+    CHECK(movieFinished.first().at(0).value<Movie*>() == loaded.get());
+    CHECK(finished.size() == 1);
+
+    SECTION("the error is reset when the movie is loaded again")
+    {
+        MovieScrapeScheduler retry(&scraper);
+        QSignalSpy retryFinished(&retry, &MovieScrapeScheduler::movieFinished);
+        retry.add(failing.get());
+        retry.start();
+        REQUIRE(scraper.loads.size() == 3);
+        finish(scraper.loads.at(2));
+        CHECK(retryFinished.size() == 1);
+        CHECK_FALSE(failing->controller()->loadError().hasError());
+    }
+}
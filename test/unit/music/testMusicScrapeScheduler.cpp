@@ -0,0 +1,218 @@
+#include "test/test_helpers.h"
+
+#include "music/Album.h"
+#include "music/AlbumController.h"
+#include "music/Artist.h"
+#include "music/ArtistController.h"
+#include "music/MusicScrapeScheduler.h"
+
+#include <QPointer>
+#include <QSignalSpy>
+#include <memory>
+
+using namespace mediaelch;
+
+namespace {
+
+/// Records searches and loads, which the test then answers in any order.
+class FakeMusicScraper : public scraper::MusicScraper
+{
+public:
+    QString name() const override { return "Fake"; }
+    QString identifier() const override { return "fake"; }
+    void searchAlbum(QString, QString) override {}
+    void searchArtist(QString) override {}
+    void searchAlbum(QString, QString, SearchCallback callback) override { searches.append(std::move(callback)); }
+    void searchArtist(QString, SearchCallback callback) override { searches.append(std::move(callback)); }
+    void loadData(MusicBrainzId id, Artist* artist, QSet<MusicScraperInfo>) override
+    {
+        artistLoads.append(artist);
+        loadedIds.append(id.toString());
+    }
+    void loadData(MusicBrainzId id, MusicBrainzId, Album* album, QSet<MusicScraperInfo>) override
+    {
+        albumLoads.append(album);
+        loadedIds.append(id.toString());
+    }
+    QSet<MusicScraperInfo> scraperSupports() override { return {MusicScraperInfo::Name}; }
+    QWidget* settingsWidget() override { return nullptr; }
+    bool hasSettings() const override { return false; }
+    void loadSettings(ScraperSettings&) override {}
+    void saveSettings(ScraperSettings&) override {}
+
+    /// Finishes the artist's load like a scraper that found no images.
+    static void finish(Artist* artist) { artist->controller()->scraperLoadDone(nullptr); }
+    static void finish(Album* album) { album->controller()->scraperLoadDone(nullptr); }
+
+    QVector<SearchCallback> searches;
+    QVector<QPointer<Artist>> artistLoads;
+    QVector<QPointer<Album>> albumLoads;
+    QStringList loadedIds;
+};
+
+std::unique_ptr<Artist> makeArtist(const QString& mbId)
+{
+    auto artist = std::make_unique<Artist>();
+    artist->setName("Artist " + mbId);
+    if (!mbId.isEmpty()) {
+        artist->setMbId(MusicBrainzId(mbId));
+    }
+    return artist;
+}
+
+ScraperSearchResult searchResult(const QString& id)
+{
+    ScraperSearchResult result;
+    result.id = id;
+    result.id2 = id + "-group";
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("MusicScrapeScheduler scrapes several items at once", "[music][scheduler]")
+{
+    FakeMusicScraper scraper;
+    MusicScrapeScheduler scheduler(&scraper);
+    scheduler.setMaxConcurrentItems(2);
+    QSignalSpy artistFinished(&scheduler, &MusicScrapeScheduler::artistFinished);
+    QSignalSpy progress(&scheduler, &MusicScrapeScheduler::progress);
+    QSignalSpy finished(&scheduler, &MusicScrapeScheduler::finished);
+
+    std::vector<std::unique_ptr<Artist>> artists;
+    for (const QString id : {"a", "b", "c", "d"}) {
+        artists.push_back(makeArtist(id));
+        scheduler.add(artists.back().get());
+    }
+
+    SECTION("items are only started after start()")
+    {
+        CHECK(scraper.artistLoads.isEmpty());
+        CHECK(scheduler.count() == 4);
+    }
+
+    SECTION("no more than the maximum number of items are in flight")
+    {
+        scheduler.start();
+        REQUIRE(scraper.artistLoads.size() == 2);
+
+        // Items may finish in any order; each finished item starts the next one.
+        FakeMusicScraper::finish(scraper.artistLoads.at(1));
+        REQUIRE(scraper.artistLoads.size() == 3);
+        FakeMusicScraper::finish(scraper.artistLoads.at(0));
+        REQUIRE(scraper.artistLoads.size() == 4);
+        CHECK(scraper.loadedIds == QStringList{"a", "b", "c", "d"});
+        CHECK(finished.isEmpty());
+
+        FakeMusicScraper::finish(scraper.artistLoads.at(3));
+        FakeMusicScraper::finish(scraper.artistLoads.at(2));
+        CHECK(artistFinished.size() == 4);
+        CHECK(progress.size() == 4);
+        CHECK(progress.last().at(0).toInt() == 4);
+        CHECK(finished.size() == 1);
+        CHECK_FALSE(scheduler.isRunning());
+    }
+
+    SECTION("a finished item is only counted once")
+    {
+        scheduler.start();
+        FakeMusicScraper::finish(scraper.artistLoads.at(0));
+        FakeMusicScraper::finish(scraper.artistLoads.at(0));
+        CHECK(artistFinished.size() == 1);
+        CHECK(progress.size() == 1);
+    }
+
+    SECTION("queued items that are destroyed are skipped")
+    {
+        artists.at(2).reset();
+        scheduler.start();
+        FakeMusicScraper::finish(scraper.artistLoads.at(0));
+        // "c" was skipped, so "d" is started instead.
+        CHECK(scraper.loadedIds == QStringList{"a", "b", "d"});
+        CHECK(progress.size() == 2);
+    }
+
+    SECTION("running items that are destroyed are completed")
+    {
+        scheduler.start();
+        artists.at(0).reset();
+        CHECK(scraper.loadedIds == QStringList{"a", "b", "c"});
+        CHECK(progress.size() == 1);
+
+        artists.at(1).reset();
+        FakeMusicScraper::finish(scraper.artistLoads.at(2));
+        FakeMusicScraper::finish(scraper.artistLoads.at(3));
+        CHECK(artistFinished.size() == 2);
+        CHECK(finished.size() == 1);
+    }
+
+    SECTION("aborted items are not reported")
+    {
+        scheduler.start();
+        scheduler.abort();
+        FakeMusicScraper::finish(scraper.artistLoads.at(0));
+        CHECK(scraper.artistLoads.size() == 2);
+        CHECK(artistFinished.isEmpty());
+        CHECK(finished.isEmpty());
+    }
+}
+
+TEST_CASE("MusicScrapeScheduler searches items without ID", "[music][scheduler]")
+{
+    FakeMusicScraper scraper;
+    MusicScrapeScheduler scheduler(&scraper);
+    QSignalSpy artistFinished(&scheduler, &MusicScrapeScheduler::artistFinished);
+    QSignalSpy albumFinished(&scheduler, &MusicScrapeScheduler::albumFinished);
+    QSignalSpy finished(&scheduler, &MusicScrapeScheduler::finished);
+
+    SECTION("the first search result is loaded")
+    {
+        auto artist = makeArtist("");
+        Album album;
+        album.setTitle("Album");
+        album.setArtist("Artist");
+        scheduler.add(artist.get());
+        scheduler.add(&album);
+        scheduler.start();
+        REQUIRE(scraper.searches.size() == 2);
+
+        // Searches may finish in any order.
+        scraper.searches.at(1)({searchResult("album-id"), searchResult("other")});
+        scraper.searches.at(0)({searchResult("artist-id")});
+        CHECK(scraper.loadedIds == QStringList{"album-id", "artist-id"});
+        REQUIRE(scraper.albumLoads.size() == 1);
+        REQUIRE(scraper.artistLoads.size() == 1);
+
+        FakeMusicScraper::finish(scraper.albumLoads.at(0));
+        FakeMusicScraper::finish(scraper.artistLoads.at(0));
+        CHECK(albumFinished.size() == 1);
+        CHECK(artistFinished.size() == 1);
+        CHECK(finished.size() == 1);
+    }
+
+    SECTION("items without search results are skipped")
+    {
+        auto artist = makeArtist("");
+        scheduler.add(artist.get());
+        scheduler.start();
+        REQUIRE(scraper.searches.size() == 1);
+        scraper.searches.at(0)({});
+        CHECK(scraper.artistLoads.isEmpty());
+        CHECK(artistFinished.isEmpty());
+        CHECK(finished.size() == 1);
+    }
+
+    SECTION("search results of destroyed items are ignored")
+    {
+        auto artist = makeArtist("");
+        scheduler.add(artist.get());
+        scheduler.start();
+        REQUIRE(scraper.searches.size() == 1);
+        artist.reset();
+        CHECK(finished.size() == 1);
+
+        scraper.searches.at(0)({searchResult("artist-id")});
+        CHECK(scraper.artistLoads.isEmpty());
+        CHECK(finished.size() == 1);
+    }
+}
@@ -0,0 +1,75 @@
+#include "test/test_helpers.h"
+
+#include "network/RateLimiter.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+
+using namespace mediaelch::network;
+
+TEST_CASE("RateLimiter limits requests per host", "[network]")
+{
+    RateLimiter limiter;
+    int started = 0;
+    const auto start = [&started]() { ++started; };
+
+    SECTION("hosts without limits are not throttled")
+    {
+        for (int i = 0; i < 20; ++i) {
+            limiter.acquire("example.com", start);
+        }
+        CHECK(started == 20);
+        CHECK(limiter.running("example.com") == 20);
+    }
+
+    SECTION("limits concurrent requests")
+    {
+        RateLimiter::Limits limits;
+        limits.maxConcurrent = 2;
+        limiter.setLimits("example.com", limits);
+
+        limiter.acquire("example.com", start);
+        limiter.acquire("example.com", start);
+        limiter.acquire("example.com", start);
+        CHECK(started == 2);
+        CHECK(limiter.waiting("example.com") == 1);
+
+        limiter.finished("example.com");
+        CHECK(started == 3);
+        CHECK(limiter.waiting("example.com") == 0);
+
+        // Other hosts are independent.
+        limiter.acquire("example.org", start);
+        CHECK(started == 4);
+    }
+
+    SECTION("starts a burst at once and the rest at the configured rate")
+    {
+        RateLimiter::Limits limits;
+        limits.requestsPerSecond = 50.0;
+        limits.burst = 3;
+        limiter.setLimits("example.com", limits);
+
+        for (int i = 0; i < 5; ++i) {
+            limiter.acquire("example.com", start);
+        }
+        CHECK(started == 3);
+
+        QElapsedTimer timer;
+        timer.start();
+        QEventLoop loop;
+        QTimer poll;
+        QObject::connect(&poll, &QTimer::timeout, [&]() {
+            if (started == 5 || timer.elapsed() > 5000) {
+                loop.quit();
+            }
+        });
+        poll.start(5);
+        loop.exec();
+
+        CHECK(started == 5);
+        // Two more tokens at 50 per second take at least 40ms.
+        CHECK(timer.elapsed() >= 30);
+    }
+}
@@ -0,0 +1,146 @@
+#include "test/test_helpers.h"
+
+#include "network/ReplayTransport.h"
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QTemporaryDir>
+#include <QUrlQuery>
+
+using namespace mediaelch::network;
+
+namespace {
+
+struct Result
+{
+    QNetworkReply::NetworkError error = QNetworkReply::NoError;
+    QByteArray body;
+};
+
+/// Sends a GET request through the transport and waits for its reply.
+Result get(QNetworkAccessManager& qnam, const QUrl& url)
+{
+    QNetworkReply* reply =
+        ReplayTransport::instance().send(qnam, QNetworkAccessManager::GetOperation, QNetworkRequest(url), {});
+    if (!reply->isFinished()) {
+        QEventLoop loop;
+        QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    Result result{reply->error(), reply->readAll()};
+    reply->deleteLater();
+    return result;
+}
+
+QUrl withQuery(QUrl url, const QString& apiKey, const QString& language)
+{
+    QUrlQuery query;
+    query.addQueryItem("api_key", apiKey);
+    query.addQueryItem("language", language);
+    url.setQuery(query);
+    return url;
+}
+
+void setMode(ReplayTransport::Mode mode, const QString& directory)
+{
+    ReplayTransport::Config config;
+    config.mode = mode;
+    config.directory = directory;
+    ReplayTransport::instance().setConfig(config);
+    ReplayTransport::instance().resetStatistics();
+}
+
+/// Turns the transport off again at the end of a test, even if it fails.
+struct DisableTransportOnExit
+{
+    ~DisableTransportOnExit() { setMode(ReplayTransport::Mode::Off, {}); }
+};
+
+} // namespace
+
+TEST_CASE("ReplayTransport ignores credentials", "[network]")
+{
+    const QUrl url("https://api.example.com/3/movie/550");
+    const QString key = ReplayTransport::fileKey(
+        QNetworkAccessManager::GetOperation, QNetworkRequest(withQuery(url, "secret", "en")), {});
+
+    SECTION("credentials are removed from URLs")
+    {
+        const QUrl stripped = ReplayTransport::withoutCredentials(withQuery(url, "secret", "en"));
+        CHECK(stripped.toString() == "https://api.example.com/3/movie/550?language=en");
+        CHECK(ReplayTransport::withoutCredentials(url) == url);
+    }
+
+    SECTION("keys don't depend on API keys in the URL")
+    {
+        const QString otherKey = ReplayTransport::fileKey(
+            QNetworkAccessManager::GetOperation, QNetworkRequest(withQuery(url, "other", "en")), {});
+        const QString otherLanguage = ReplayTransport::fileKey(
+            QNetworkAccessManager::GetOperation, QNetworkRequest(withQuery(url, "secret", "de")), {});
+        CHECK(key == otherKey);
+        CHECK(key != otherLanguage);
+    }
+
+    SECTION("keys don't depend on API keys in JSON bodies")
+    {
+        const QNetworkRequest login(QUrl("https://api.example.com/login"));
+        const auto post = QNetworkAccessManager::PostOperation;
+        CHECK(ReplayTransport::fileKey(post, login, R"({"apikey": "secret", "user": "a"})")
+              == ReplayTransport::fileKey(post, login, R"({"apikey": "other", "user": "a"})"));
+        CHECK(ReplayTransport::fileKey(post, login, R"({"apikey": "secret", "user": "a"})")
+              != ReplayTransport::fileKey(post, login, R"({"apikey": "secret", "user": "b"})"));
+    }
+}
+
+TEST_CASE("ReplayTransport replays recorded responses", "[network]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString recordings = dir.filePath("http");
+    const QByteArray content = "<html><body>Fight Club</body></html>";
+    {
+        QFile page(dir.filePath("page.html"));
+        REQUIRE(page.open(QIODevice::WriteOnly));
+        page.write(content);
+    }
+    const QUrl pageUrl = QUrl::fromLocalFile(dir.filePath("page.html"));
+    QNetworkAccessManager qnam;
+    DisableTransportOnExit disableTransport;
+
+    // Responses are recorded from a local file, so that the test doesn't need a network.
+    setMode(ReplayTransport::Mode::Record, recordings);
+    const Result recorded = get(qnam, withQuery(pageUrl, "secret", "en"));
+    CHECK(recorded.error == QNetworkReply::NoError);
+    CHECK(recorded.body == content);
+
+    const QStringList files = QDir(recordings).entryList(QDir::Files, QDir::Name);
+    REQUIRE(files.size() == 2);
+    for (const QString& file : files) {
+        QFile recording(QDir(recordings).filePath(file));
+        REQUIRE(recording.open(QIODevice::ReadOnly));
+        CHECK_FALSE(recording.readAll().contains("secret"));
+    }
+
+    // The page is gone, so the response can only come from the recording.
+    REQUIRE(QFile::remove(dir.filePath("page.html")));
+    setMode(ReplayTransport::Mode::Replay, recordings);
+
+    SECTION("recorded responses are replayed with other API keys")
+    {
+        const Result replayed = get(qnam, withQuery(pageUrl, "other", "en"));
+        CHECK(replayed.error == QNetworkReply::NoError);
+        CHECK(replayed.body == content);
+        CHECK(ReplayTransport::instance().statistics().requests == 1);
+        CHECK(ReplayTransport::instance().statistics().missing == 0);
+        CHECK(ReplayTransport::instance().statistics().bytes == content.size());
+    }
+
+    SECTION("requests without a recording fail")
+    {
+        const Result missing = get(qnam, withQuery(pageUrl, "secret", "de"));
+        CHECK(missing.error == QNetworkReply::ContentNotFoundError);
+        CHECK(ReplayTransport::instance().statistics().missing == 1);
+    }
+}
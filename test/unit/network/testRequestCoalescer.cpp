@@ -0,0 +1,100 @@
+#include "test/test_helpers.h"
+
+#include "network/RequestCoalescer.h"
+#include "network/WebsiteCache.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <memory>
+
+using namespace mediaelch;
+using namespace mediaelch::network;
+
+TEST_CASE("RequestCoalescer coalesces equal requests", "[network]")
+{
+    RequestCoalescer<QString, int> coalescer;
+    QStringList responses;
+    const auto callback = [&responses](QString data, int code) {
+        responses << QStringLiteral("%1:%2").arg(data).arg(code);
+    };
+
+    SECTION("only the first caller sends the request")
+    {
+        auto flight = coalescer.join("a", callback, "canceled", 0);
+        REQUIRE(flight != nullptr);
+        CHECK(coalescer.join("a", callback, "canceled", 0) == nullptr);
+        CHECK(coalescer.join("a", callback, "canceled", 0) == nullptr);
+        auto other = coalescer.join("b", callback, "canceled", 0);
+        CHECK(other != nullptr);
+        CHECK(coalescer.waiting("a") == 3);
+
+        flight->finish("response", 200);
+        CHECK(responses == QStringList{"response:200", "response:200", "response:200"});
+        CHECK(coalescer.waiting("a") == 0);
+        CHECK(coalescer.waiting("b") == 1);
+        other->finish("other", 200);
+    }
+
+    SECTION("requests are sent again after they finished")
+    {
+        auto first = coalescer.join("a", callback, "canceled", 0);
+        first->finish("first", 200);
+        auto second = coalescer.join("a", callback, "canceled", 0);
+        REQUIRE(second != nullptr);
+        second->finish("second", 404);
+        CHECK(responses == QStringList{"first:200", "second:404"});
+    }
+
+    SECTION("flights are only finished once")
+    {
+        auto first = coalescer.join("a", callback, "canceled", 0);
+        first->finish("first", 200);
+        auto second = coalescer.join("a", callback, "canceled", 0);
+        first->finish("late", 200);
+        first.reset();
+        CHECK(responses == QStringList{"first:200"});
+        CHECK(coalescer.waiting("a") == 1);
+        second->finish("second", 200);
+        CHECK(responses == QStringList{"first:200", "second:200"});
+    }
+
+    SECTION("callbacks may join again")
+    {
+        std::shared_ptr<RequestCoalescer<QString, int>::Flight> again;
+        const auto joinAgain = [&](QString, int) { again = coalescer.join("a", callback, "canceled", 0); };
+        auto flight = coalescer.join("a", joinAgain, "canceled", 0);
+        flight->finish("response", 200);
+        REQUIRE(again != nullptr);
+        CHECK(coalescer.waiting("a") == 1);
+        again->finish("again", 200);
+    }
+
+    SECTION("waiting callbacks get the fallback response if the flight is destroyed")
+    {
+        auto flight = coalescer.join("a", callback, "canceled", 0);
+        coalescer.join("a", callback, "canceled", 0);
+        flight.reset();
+        // The key is free at once, but callbacks are called from the event loop.
+        CHECK(coalescer.waiting("a") == 0);
+        CHECK(responses.isEmpty());
+        QCoreApplication::processEvents();
+        CHECK(responses == QStringList{"canceled:0", "canceled:0"});
+
+        auto next = coalescer.join("a", callback, "canceled", 0);
+        REQUIRE(next != nullptr);
+        next->finish("next", 200);
+    }
+}
+
+TEST_CASE("WebsiteCache is shared by all instances", "[network]")
+{
+    const QUrl url("https://example.com/test-website-cache");
+    scraper::WebsiteCache first;
+    scraper::WebsiteCache second;
+
+    first.addElement(url, Locale::English, "data");
+    CHECK(second.hasValidElement(url, Locale::English));
+    CHECK(second.getElement(url, Locale::English) == "data");
+    CHECK_FALSE(second.hasValidElement(url, Locale("de-DE")));
+    CHECK(scraper::WebsiteCache::key(url, Locale::English) != scraper::WebsiteCache::key(url, Locale("de-DE")));
+}
@@ -0,0 +1,85 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "test/mocks/scrapers/MockMovieScraper.h"
+
+using namespace mediaelch::scraper;
+
+TEST_CASE("CustomMovieScraper plans loads of its sub-scrapers", "[scraper][movie][custom]")
+{
+    MockMovieScraper tmdb(TmdbMovie::ID);
+    MockMovieScraper imdb(ImdbMovie::ID);
+    MockMovieScraper other("other");
+    const QVector<MovieScraper*> scrapers{&tmdb, &imdb, &other};
+
+    const TmdbId tmdbId("123");
+    const ImdbId imdbId("tt0123456");
+
+    SECTION("TMDb only is loaded by its TMDb ID")
+    {
+        const QHash<MovieScraperInfo, MovieScraper*> scraperByInfo{
+            {MovieScraperInfo::Title, &tmdb}, {MovieScraperInfo::Overview, &tmdb}};
+        const auto plan = CustomMovieScraper::planFetches(scrapers, scraperByInfo, {}, tmdbId, ImdbId());
+        REQUIRE(plan.ready.size() == 1);
+        CHECK(plan.waitingForImdbId.isEmpty());
+        CHECK(plan.ready[0].scraper == &tmdb);
+        CHECK(plan.ready[0].id.str() == "123");
+        CHECK(plan.ready[0].infos == QSet<MovieScraperInfo>{MovieScraperInfo::Title, MovieScraperInfo::Overview});
+    }
+
+    SECTION("TMDb falls back to the IMDb ID")
+    {
+        const QHash<MovieScraperInfo, MovieScraper*> scraperByInfo{{MovieScraperInfo::Title, &tmdb}};
+        const auto plan = CustomMovieScraper::planFetches(scrapers, scraperByInfo, {}, TmdbId(), imdbId);
+        REQUIRE(plan.ready.size() == 1);
+        CHECK(plan.ready[0].id.str() == "tt0123456");
+    }
+
+    SECTION("IMDb only is loaded right away if its ID is known")
+    {
+        const QHash<MovieScraperInfo, MovieScraper*> scraperByInfo{{MovieScraperInfo::Rating, &imdb}};
+        const auto plan = CustomMovieScraper::planFetches(scrapers, scraperByInfo, {}, tmdbId, imdbId);
+        REQUIRE(plan.ready.size() == 1);
+        CHECK(plan.waitingForImdbId.isEmpty());
+        CHECK(plan.ready[0].scraper == &imdb);
+        CHECK(plan.ready[0].id.str() == "tt0123456");
+    }
+
+    SECTION("IMDb only waits for the IMDb ID otherwise")
+    {
+        const QHash<MovieScraperInfo, MovieScraper*> scraperByInfo{{MovieScraperInfo::Rating, &imdb}};
+        const auto plan = CustomMovieScraper::planFetches(scrapers, scraperByInfo, {}, tmdbId, ImdbId());
+        CHECK(plan.ready.isEmpty());
+        REQUIRE(plan.waitingForImdbId.size() == 1);
+        CHECK(plan.waitingForImdbId[0].scraper == &imdb);
+        CHECK(plan.waitingForImdbId[0].infos == QSet<MovieScraperInfo>{MovieScraperInfo::Rating});
+    }
+
+    SECTION("mixed selections are grouped per scraper in the order of the scrapers")
+    {
+        const QHash<MovieScraperInfo, MovieScraper*> scraperByInfo{{MovieScraperInfo::Rating, &imdb},
+            {MovieScraperInfo::Title, &tmdb},
+            {MovieScraperInfo::Poster, &other},
+            {MovieScraperInfo::Genres, &imdb}};
+        QHash<MovieScraper*, MovieIdentifier> ids;
+        ids.insert(&other, MovieIdentifier("other-42"));
+
+        const auto plan = CustomMovieScraper::planFetches(scrapers, scraperByInfo, ids, tmdbId, ImdbId());
+        REQUIRE(plan.ready.size() == 2);
+        CHECK(plan.ready[0].scraper == &tmdb);
+        CHECK(plan.ready[1].scraper == &other);
+        CHECK(plan.ready[1].id.str() == "other-42");
+        REQUIRE(plan.waitingForImdbId.size() == 1);
+        const QSet<MovieScraperInfo> imdbInfos{MovieScraperInfo::Rating, MovieScraperInfo::Genres};
+        CHECK(plan.waitingForImdbId[0].infos == imdbInfos);
+    }
+
+    SECTION("scrapers without selected details are not loaded")
+    {
+        const auto plan = CustomMovieScraper::planFetches(scrapers, {}, {}, tmdbId, imdbId);
+        CHECK(plan.ready.isEmpty());
+        CHECK(plan.waitingForImdbId.isEmpty());
+    }
+}
@@ -0,0 +1,94 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/music/MusicElementDownloads.h"
+
+#include <QObject>
+
+using namespace mediaelch::scraper;
+
+namespace {
+
+QVector<MusicElementDownloads::Element> elements(const QStringList& types)
+{
+    QVector<MusicElementDownloads::Element> result;
+    for (const QString& type : types) {
+        MusicElementDownloads::Element element;
+        element.type = type;
+        element.url = QUrl("https://example.com/" + type);
+        result.append(element);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("MusicElementDownloads maps replies to elements", "[scraper][music]")
+{
+    MusicElementDownloads downloads;
+    QObject artist;
+    QObject otherArtist;
+
+    SECTION("replies are stored by index, independent of their order")
+    {
+        const quint64 load = downloads.start(&artist, {MusicScraperInfo::Name}, elements({"a", "b", "c"}));
+        CHECK_FALSE(downloads.store(&artist, load, 2, "C"));
+        CHECK_FALSE(downloads.store(&artist, load, 0, "A"));
+        CHECK(downloads.store(&artist, load, 1, "B"));
+
+        const MusicElementDownloads::Load finished = downloads.take(&artist);
+        CHECK_FALSE(downloads.isLoading(&artist));
+        CHECK(finished.infos == QSet<MusicScraperInfo>{MusicScraperInfo::Name});
+        REQUIRE(finished.elements.size() == 3);
+        CHECK(finished.elements.at(0).contents == "A");
+        CHECK(finished.elements.at(1).contents == "B");
+        CHECK(finished.elements.at(2).contents == "C");
+        CHECK(finished.elements.at(2).type == "c");
+    }
+
+    SECTION("loads of different items are independent")
+    {
+        const quint64 load = downloads.start(&artist, {}, elements({"a"}));
+        const quint64 otherLoad = downloads.start(&otherArtist, {}, elements({"a", "b"}));
+        CHECK(load != otherLoad);
+        CHECK_FALSE(downloads.store(&otherArtist, load, 0, "wrong load"));
+        CHECK(downloads.store(&artist, load, 0, "A"));
+        CHECK_FALSE(downloads.store(&otherArtist, otherLoad, 0, "A"));
+        CHECK(downloads.isLoading(&otherArtist));
+    }
+
+    SECTION("repeated replies for the same element are ignored")
+    {
+        const quint64 load = downloads.start(&artist, {}, elements({"a", "b"}));
+        CHECK_FALSE(downloads.store(&artist, load, 0, "A"));
+        CHECK_FALSE(downloads.store(&artist, load, 0, "again"));
+        CHECK_FALSE(downloads.store(&artist, load, 5, "out of range"));
+        CHECK(downloads.store(&artist, load, 1, "B"));
+        CHECK(downloads.take(&artist).elements.at(0).contents == "A");
+    }
+
+    SECTION("replies of a superseded load are discarded")
+    {
+        const quint64 first = downloads.start(&artist, {}, elements({"a", "b"}));
+        CHECK_FALSE(downloads.store(&artist, first, 0, "old A"));
+        const quint64 second = downloads.start(&artist, {}, elements({"a", "b"}));
+        CHECK(first != second);
+
+        CHECK_FALSE(downloads.store(&artist, first, 1, "old B"));
+        CHECK_FALSE(downloads.store(&artist, second, 0, "new A"));
+        CHECK(downloads.store(&artist, second, 1, "new B"));
+        const MusicElementDownloads::Load finished = downloads.take(&artist);
+        CHECK(finished.id == second);
+        CHECK(finished.elements.at(0).contents == "new A");
+        CHECK(finished.elements.at(1).contents == "new B");
+    }
+
+    SECTION("a superseded load can't remove its successor")
+    {
+        const quint64 first = downloads.start(&artist, {}, elements({"a"}));
+        const quint64 second = downloads.start(&artist, {}, elements({"a"}));
+        downloads.remove(&artist, first);
+        CHECK(downloads.isLoading(&artist));
+        downloads.remove(&artist, second);
+        CHECK_FALSE(downloads.isLoading(&artist));
+    }
+}
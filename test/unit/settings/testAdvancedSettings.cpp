@@ -42,6 +42,7 @@ TEST_CASE("Advanced Settings XML", "[settings]")
             <genres>
                 <map from="SciFi" to="Science Fiction" />
             </genres>
+            <atomicFileWrites>false</atomicFileWrites>
         )xml");
 
         AdvancedSettings settings = AdvancedSettingsXmlReader::loadFromXml(emptyXml).first;
@@ -50,6 +51,7 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         CHECK(settings.logFile() == "./MediaElchTest.log");
         REQUIRE(settings.genreMappings().size() == 1);
         CHECK(settings.genreMappings()["SciFi"] == "Science Fiction");
+        CHECK_FALSE(settings.atomicFileWrites());
     }
 
     const auto checkEpisodeThumbValues = [](const auto& pair) {
@@ -140,6 +142,27 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         }
     }
 
+    SECTION("scan excludes keep each scanner's extras folders")
+    {
+        AdvancedSettings settings;
+        const mediaelch::ScanExcludes movies = settings.movieScanExcludes();
+        CHECK(movies.foldersWithExtras.matches("ExtraFanart"));
+        CHECK(movies.foldersWithExtras.matches("extrathumbs"));
+        CHECK_FALSE(movies.foldersWithExtras.matches(".AppleDouble"));
+        CHECK_FALSE(movies.foldersWithExtras.matches("extrafanarts"));
+        CHECK(movies.files.matches("Movie-Trailer.mkv"));
+
+        const mediaelch::ScanExcludes organizer = settings.movieOrganizerScanExcludes();
+        CHECK(organizer.foldersWithExtras.matches(".AppleDouble"));
+        CHECK(organizer.foldersWithExtras.matches("extrafanarts"));
+        CHECK_FALSE(organizer.foldersWithExtras.matches("extrafanart"));
+        CHECK_FALSE(organizer.foldersWithExtras.matches("extrathumbs"));
+
+        const mediaelch::ScanExcludes tvShows = settings.tvShowScanExcludes();
+        CHECK(tvShows.foldersWithExtras.matches("Extras"));
+        CHECK_FALSE(tvShows.files.matches("Episode-deleted.mkv"));
+    }
+
     SECTION("read attributes correctly")
     {
         QString xml = addBaseXml(R"xml(
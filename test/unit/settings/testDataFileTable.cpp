@@ -0,0 +1,77 @@
+#include "test/test_helpers.h"
+
+#include "settings/DataFile.h"
+
+#include <QStringList>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+QStringList fileNames(const QVector<DataFile>& files)
+{
+    QStringList names;
+    for (const DataFile& file : files) {
+        names << file.fileName();
+    }
+    return names;
+}
+
+} // namespace
+
+TEST_CASE("DataFileTable groups and sorts data files", "[settings]")
+{
+    const DataFileTable table({
+        DataFile(DataFileType::MoviePoster, "<baseFileName>-poster.jpg", 1),
+        DataFile(DataFileType::MovieNfo, "<baseFileName>.nfo", 0),
+        DataFile(DataFileType::MoviePoster, "poster.jpg", 0),
+        DataFile(DataFileType::MoviePoster, "folder.jpg", 2),
+    });
+
+    SECTION("files are sorted by their position")
+    {
+        CHECK(fileNames(table.files(DataFileType::MoviePoster))
+              == QStringList{"poster.jpg", "<baseFileName>-poster.jpg", "folder.jpg"});
+        CHECK(fileNames(table.files(DataFileType::MovieNfo)) == QStringList{"<baseFileName>.nfo"});
+    }
+
+    SECTION("types without files are empty")
+    {
+        CHECK(table.files(DataFileType::MovieBackdrop).isEmpty());
+        CHECK(table.files(DataFileType::NoType).isEmpty());
+        CHECK(DataFileTable().files(DataFileType::MoviePoster).isEmpty());
+    }
+
+    SECTION("all() keeps the original order")
+    {
+        CHECK(fileNames(table.all())
+              == QStringList{"<baseFileName>-poster.jpg", "<baseFileName>.nfo", "poster.jpg", "folder.jpg"});
+    }
+
+    SECTION("snapshots can be read while they are replaced")
+    {
+        // Same publication scheme as Settings::setDataFiles() and Settings::dataFileTable().
+        auto current = std::make_shared<const DataFileTable>(table.all());
+        std::atomic_int wrongLookups{0};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i) {
+            readers.emplace_back([&current, &wrongLookups]() {
+                for (int j = 0; j < 1000; ++j) {
+                    const auto snapshot = std::atomic_load(&current);
+                    if (snapshot->files(DataFileType::MoviePoster).size() != 3) {
+                        ++wrongLookups;
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < 100; ++i) {
+            std::atomic_store(&current, std::make_shared<const DataFileTable>(table.all()));
+        }
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        CHECK(wrongLookups == 0);
+    }
+}
@@ -0,0 +1,81 @@
+#include "test/test_helpers.h"
+
+#include "tv_shows/TvShow.h"
+#include "tv_shows/TvShowEpisode.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+TvShowEpisode* addEpisode(TvShow& show, int season, int episode, const QString& file)
+{
+    auto* ep = new TvShowEpisode(QStringList{file}, &show);
+    ep->setSeason(SeasonNumber(season));
+    ep->setEpisode(EpisodeNumber(episode));
+    show.addEpisode(ep);
+    return ep;
+}
+
+} // namespace
+
+TEST_CASE("TvShow looks up episodes by their index", "[show]")
+{
+    TvShow show;
+    TvShowEpisode* s1e1 = addEpisode(show, 1, 1, "/shows/a/S01E01.mkv");
+    TvShowEpisode* s1e2 = addEpisode(show, 1, 2, "/shows/a/S01E02E03.mkv");
+    TvShowEpisode* s1e3 = addEpisode(show, 1, 3, "/shows/a/S01E02E03.mkv");
+    TvShowEpisode* s2e1 = addEpisode(show, 2, 1, "/shows/a/S02E01.mkv");
+
+    SECTION("by season and episode number")
+    {
+        CHECK(show.episode(SeasonNumber(1), EpisodeNumber(1)) == s1e1);
+        CHECK(show.episode(SeasonNumber(2), EpisodeNumber(1)) == s2e1);
+        CHECK(show.episodes(SeasonNumber(1)) == QVector<TvShowEpisode*>{s1e1, s1e2, s1e3});
+        CHECK(show.seasons() == QVector<SeasonNumber>{SeasonNumber(1), SeasonNumber(2)});
+    }
+
+    SECTION("by files, e.g. for multi-episode files")
+    {
+        CHECK(show.episodes(mediaelch::FileList(QStringList{"/shows/a/S01E02E03.mkv"}))
+              == QVector<TvShowEpisode*>{s1e2, s1e3});
+        CHECK(show.episodes(mediaelch::FileList(QStringList{"/shows/a/unknown.mkv"})).isEmpty());
+    }
+
+    SECTION("episodes added after a lookup are found")
+    {
+        CHECK(show.episodes(SeasonNumber(3)).isEmpty());
+        TvShowEpisode* s3e1 = addEpisode(show, 3, 1, "/shows/a/S03E01.mkv");
+        CHECK(show.episode(SeasonNumber(3), EpisodeNumber(1)) == s3e1);
+        CHECK(show.seasons().size() == 3);
+    }
+
+    SECTION("changing an episode's numbers or files invalidates the index")
+    {
+        CHECK(show.episode(SeasonNumber(2), EpisodeNumber(1)) == s2e1);
+        s2e1->setSeason(SeasonNumber(4));
+        s2e1->setEpisode(EpisodeNumber(5));
+        CHECK(show.episode(SeasonNumber(4), EpisodeNumber(5)) == s2e1);
+        CHECK(show.episodes(SeasonNumber(2)).isEmpty());
+
+        s1e1->setFiles(QStringList{"/shows/a/renamed.mkv"});
+        CHECK(show.episodes(mediaelch::FileList(QStringList{"/shows/a/renamed.mkv"})).size() == 1);
+        CHECK(show.episodes(mediaelch::FileList(QStringList{"/shows/a/S01E01.mkv"})).isEmpty());
+    }
+
+    SECTION("concurrent lookups rebuild the index only once at a time")
+    {
+        show.invalidateEpisodeIndex();
+        std::vector<std::thread> threads;
+        std::vector<int> counts(8, 0);
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&show, &counts, i]() { counts[i] = show.episodes(SeasonNumber(1)).size(); });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        for (int count : counts) {
+            CHECK(count == 3);
+        }
+    }
+}